@@ -0,0 +1,113 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file bufferpoolbench
+/// @brief Compares @c BufferPool with the general-purpose allocator on a packet-like workload: every thread keeps a
+///        window of buffers in flight, replacing the oldest with a new one of a varying size, and writes to each.
+///
+/// Usage: bufferpool_bench [threads] [buffers per thread] [window]
+/// @{
+
+// Class Header
+#include <BufferPool.h>
+
+// From C++ STL
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using libdsa::libstructures::BufferHandle;
+    using libdsa::libstructures::BufferPool;
+
+    /// @brief Sizes cycled through, mostly small messages with the occasional large read.
+    constexpr size_t SIZES[] = {64, 200, 1400, 64, 300, 9000, 128, 1400};
+    constexpr size_t SIZE_COUNT = sizeof(SIZES) / sizeof(SIZES[0]);
+
+    template <typename Body>
+    double timeThreads(size_t threads, Body body)
+    {
+        std::vector<std::thread> workers;
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t t = 0; t < threads; ++t)
+        {
+            workers.emplace_back(body);
+        }
+
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double measureMalloc(size_t threads, size_t buffers, size_t window)
+    {
+        return timeThreads(threads, [buffers, window]() {
+            std::vector<char *> inFlight(window, nullptr);
+
+            for (size_t i = 0; i < buffers; ++i)
+            {
+                char *&slot = inFlight[i % window];
+                std::free(slot);
+
+                const size_t size = SIZES[i % SIZE_COUNT];
+                slot = static_cast<char *>(std::malloc(size));
+                std::memset(slot, static_cast<int>(i), size);
+            }
+
+            for (char *buffer : inFlight)
+            {
+                std::free(buffer);
+            }
+        });
+    }
+
+    double measurePool(BufferPool &pool, size_t threads, size_t buffers, size_t window)
+    {
+        return timeThreads(threads, [&pool, buffers, window]() {
+            std::vector<BufferHandle> inFlight(window);
+
+            for (size_t i = 0; i < buffers; ++i)
+            {
+                BufferHandle &slot = inFlight[i % window];
+                slot.reset();
+
+                slot = pool.acquire(SIZES[i % SIZE_COUNT]);
+                std::memset(slot.data(), static_cast<int>(i), slot.size());
+            }
+        });
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const size_t maxThreads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::thread::hardware_concurrency();
+    const size_t buffers = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 2000000;
+    const size_t window = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 256;
+
+    std::printf("buffers per thread=%zu, window=%zu\n", buffers, window);
+    std::printf("%8s %16s %16s %10s\n", "threads", "malloc Mops/s", "pool Mops/s", "speedup");
+
+    BufferPool pool;
+
+    for (size_t threads = 1; threads <= std::max<size_t>(maxThreads, 1); threads *= 2)
+    {
+        const double operations = static_cast<double>(threads * buffers);
+        const double allocator = operations / measureMalloc(threads, buffers, window) / 1e6;
+        const double pooled = operations / measurePool(pool, threads, buffers, window) / 1e6;
+
+        std::printf("%8zu %16.1f %16.1f %9.2fx\n", threads, allocator, pooled, pooled / allocator);
+    }
+
+    std::printf("slabs allocated: %zu\n", pool.slabCount());
+    return 0;
+}
+
+/// @}
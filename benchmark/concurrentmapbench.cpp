@@ -0,0 +1,192 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file concurrentmapbench
+/// @brief Measures how lookups on @c ConcurrentMap scale with reader threads while one writer keeps updating, against
+///        an @c std::map behind an @c std::shared_mutex.
+///
+/// Usage: concurrentmap_bench [keys] [milliseconds per run] [max readers]
+/// @{
+
+// Class Header
+#include <concurrentmap.h>
+
+// From C++ STL
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /// @brief Lookups between two writes, matching a workload that is 99% lookups.
+    constexpr uint64_t READS_PER_WRITE = 99;
+
+    struct alignas(64) Counter
+    {
+        std::atomic<uint64_t> _value{0};
+    };
+
+    class ConcurrentMapAdapter
+    {
+        public:
+            bool find(uint64_t key, uint64_t &value) const
+            {
+                return _map.Find(key, value);
+            }
+
+            void assign(uint64_t key, uint64_t value)
+            {
+                _map.InsertOrAssign(key, value);
+            }
+
+        private:
+            libdsa::structures::tree::ConcurrentMap<uint64_t, uint64_t> _map;
+    };
+
+    class LockedMapAdapter
+    {
+        public:
+            bool find(uint64_t key, uint64_t &value) const
+            {
+                std::shared_lock<std::shared_mutex> lock(_mutex);
+                auto found = _map.find(key);
+
+                if (found == _map.end())
+                {
+                    return false;
+                }
+
+                value = found->second;
+                return true;
+            }
+
+            void assign(uint64_t key, uint64_t value)
+            {
+                std::unique_lock<std::shared_mutex> lock(_mutex);
+                _map[key] = value;
+            }
+
+        private:
+            mutable std::shared_mutex _mutex;
+            std::map<uint64_t, uint64_t> _map;
+    };
+
+    /// @brief Runs @p readers lookup threads and one paced writer for @p duration.
+    ///
+    /// @return Lookups per second summed over all readers.
+    template <typename Map>
+    double run(Map &map, uint64_t keys, size_t readers, std::chrono::milliseconds duration)
+    {
+        std::vector<Counter> counters(readers);
+        std::atomic<bool> stop{false};
+        std::atomic<uint64_t> sink{0};
+        std::vector<std::thread> threads;
+
+        for (size_t reader = 0; reader < readers; ++reader)
+        {
+            threads.emplace_back([&, reader]() {
+                std::mt19937_64 generator(reader);
+                uint64_t found = 0;
+                uint64_t done = 0;
+
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    for (int i = 0; i < 256; ++i)
+                    {
+                        uint64_t value = 0;
+                        found += map.find(generator() % keys, value) ? value : 0;
+                    }
+
+                    done += 256;
+
+                    // Only this thread writes its counter, so a plain store is enough.
+                    counters[reader]._value.store(done, std::memory_order_relaxed);
+                }
+
+                sink.fetch_add(found, std::memory_order_relaxed);
+            });
+        }
+
+        threads.emplace_back([&]() {
+            std::mt19937_64 generator(~0ULL);
+            uint64_t writes = 0;
+
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                uint64_t reads = 0;
+
+                for (Counter &counter : counters)
+                {
+                    reads += counter._value.load(std::memory_order_relaxed);
+                }
+
+                if (reads >= writes * READS_PER_WRITE)
+                {
+                    map.assign(generator() % keys, writes++);
+                }
+                else
+                {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+            }
+        });
+
+        const auto start = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(duration);
+        stop.store(true);
+
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        uint64_t total = 0;
+
+        for (Counter &counter : counters)
+        {
+            total += counter._value.load();
+        }
+
+        return static_cast<double>(total) / seconds;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const uint64_t keys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const std::chrono::milliseconds duration(argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 500);
+    const size_t maxReaders = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 64;
+
+    ConcurrentMapAdapter concurrent;
+    LockedMapAdapter locked;
+
+    for (uint64_t key = 0; key < keys; key += 2)
+    {
+        concurrent.assign(key, key);
+        locked.assign(key, key);
+    }
+
+    std::printf("keys=%llu, run=%lldms, hardware threads=%u\n", static_cast<unsigned long long>(keys),
+                static_cast<long long>(duration.count()), std::thread::hardware_concurrency());
+    std::printf("%8s %22s %22s\n", "readers", "ConcurrentMap Mops/s", "shared_mutex Mops/s");
+
+    for (size_t readers = 1; readers <= maxReaders; readers *= 2)
+    {
+        const double lockFree = run(concurrent, keys, readers, duration);
+        const double withLock = run(locked, keys, readers, duration);
+
+        std::printf("%8zu %22.2f %22.2f\n", readers, lockFree / 1e6, withLock / 1e6);
+    }
+
+    return 0;
+}
+
+/// @}
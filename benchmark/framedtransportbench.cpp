@@ -0,0 +1,169 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file framedtransportbench
+/// @brief Measures a loopback server echoing small length-prefixed messages, once answering each message with its
+///        own send and once through the batching of @c FramedTransport.  Every client writes a burst of messages
+///        per round and reads all the echoes back before the next round.
+///
+/// Usage: framedtransport_bench [connections] [rounds] [burst] [message bytes] [client threads]
+/// @{
+
+// Class Header
+#include <FramedTransport.h>
+
+// From the transport tests
+#include <loopbackclient.h>
+
+// From C++ STL
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using libdsa::libstructures::BufferView;
+    using libdsa::libstructures::FramedTransport;
+    using libdsa::libstructures::TcpServerTransport;
+    using loopback::connectClient;
+    using loopback::readExactly;
+
+    /// @brief Runs the echo workload once.
+    /// @param batched Whether replies go through @c FramedTransport::sendMessage() or straight to the transport.
+    /// @return Elapsed seconds, or a negative value if the run failed.
+    double measure(bool batched, size_t connections, size_t rounds, size_t burst, size_t messageSize, size_t threads)
+    {
+        TcpServerTransport server(htonl(INADDR_LOOPBACK), 0);
+        FramedTransport framed(server);
+
+        FramedTransport::Callbacks callbacks;
+        callbacks.onMessage = [&](uint64_t connection, const char *data, size_t size) {
+            if (batched)
+            {
+                framed.sendMessage(connection, data, size);
+                return;
+            }
+
+            char header[FramedTransport::HEADER_SIZE];
+            FramedTransport::encodeHeader(static_cast<uint32_t>(size), header);
+
+            const BufferView views[] = {BufferView(header, sizeof(header)), BufferView(data, size)};
+            server.sendv(connection, views, 2);
+        };
+        framed.setCallbacks(callbacks);
+
+        if (!server.open())
+        {
+            return -1.0;
+        }
+
+        std::thread loop([&server]() { server.run(); });
+
+        std::vector<int> clients;
+
+        for (size_t i = 0; i < connections; ++i)
+        {
+            clients.push_back(connectClient(server.port()));
+        }
+
+        std::atomic<bool> failed(std::find(clients.begin(), clients.end(), -1) != clients.end());
+        std::vector<std::thread> workers;
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t t = 0; t < threads && !failed.load(); ++t)
+        {
+            workers.emplace_back([&, t]() {
+                std::string message(FramedTransport::HEADER_SIZE, '\0');
+                FramedTransport::encodeHeader(static_cast<uint32_t>(messageSize), &message[0]);
+                message.append(messageSize, static_cast<char>('a' + t % 26));
+
+                std::string messages;
+
+                for (size_t i = 0; i < burst; ++i)
+                {
+                    messages += message;
+                }
+
+                std::string replies(messages.size(), '\0');
+
+                for (size_t round = 0; round < rounds && !failed.load(); ++round)
+                {
+                    for (size_t i = t; i < connections; i += threads)
+                    {
+                        if (::send(clients[i], messages.data(), messages.size(), 0) !=
+                            static_cast<ssize_t>(messages.size()))
+                        {
+                            failed.store(true);
+                        }
+                    }
+
+                    for (size_t i = t; i < connections; i += threads)
+                    {
+                        if (!readExactly(clients[i], &replies[0], replies.size()) || replies != messages)
+                        {
+                            failed.store(true);
+                        }
+                    }
+                }
+            });
+        }
+
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        server.stop();
+        loop.join();
+
+        for (int client : clients)
+        {
+            if (client >= 0)
+            {
+                ::close(client);
+            }
+        }
+
+        return failed.load() ? -1.0 : elapsed;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const size_t connections = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100;
+    const size_t rounds = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200;
+    const size_t burst = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 64;
+    const size_t messageSize = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 32;
+    const size_t threads = argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 4;
+
+    std::printf("connections=%zu, rounds=%zu, burst=%zu, message=%zuB, client threads=%zu\n", connections, rounds,
+                burst, messageSize, threads);
+    std::printf("%12s %12s %14s %12s\n", "replies", "time ms", "messages/s", "MB/s");
+
+    for (bool batched : {false, true})
+    {
+        const char *name = batched ? "batched" : "per message";
+        const double elapsed = measure(batched, connections, rounds, burst, messageSize, threads);
+
+        if (elapsed < 0.0)
+        {
+            std::fprintf(stderr, "%s run failed\n", name);
+            return 1;
+        }
+
+        const double messages = static_cast<double>(connections * rounds * burst);
+        std::printf("%12s %12.1f %14.0f %12.1f\n", name, elapsed * 1e3, messages / elapsed,
+                    messages * static_cast<double>(FramedTransport::HEADER_SIZE + messageSize) / elapsed / 1e6);
+    }
+
+    return 0;
+}
+
+/// @}
@@ -0,0 +1,152 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file multireactorbench
+/// @brief Measures how a loopback echo server on @c MultiReactorServer scales with its number of reactors.  The
+///        reactor count doubles from one up to the maximum; client threads keep one message in flight on every
+///        connection, round after round, and share the machine with the reactors.
+///
+/// Usage: multireactor_bench [max reactors] [connections] [rounds] [message bytes] [client threads]
+/// @{
+
+// Class Header
+#include <MultiReactorServer.h>
+
+// From the transport tests
+#include <loopbackclient.h>
+
+// From C++ STL
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using libdsa::libstructures::MultiReactorServer;
+    using libdsa::libstructures::TcpServerTransport;
+    using loopback::connectClient;
+    using loopback::readExactly;
+
+    /// @brief Runs the echo workload once on @p reactors reactors.
+    /// @return Elapsed seconds, or a negative value if the run failed.
+    double measure(size_t reactors, size_t connections, size_t rounds, size_t messageSize, size_t threads)
+    {
+        MultiReactorServer server(htonl(INADDR_LOOPBACK), 0, reactors);
+
+        for (size_t i = 0; i < reactors; ++i)
+        {
+            TcpServerTransport &reactor = server.reactor(i);
+
+            TcpServerTransport::Callbacks callbacks;
+            callbacks.onRead = [&reactor](uint64_t connection, const char *data, size_t size) {
+                reactor.send(connection, data, size);
+            };
+            reactor.setCallbacks(callbacks);
+        }
+
+        if (!server.start())
+        {
+            return -1.0;
+        }
+
+        std::vector<int> clients;
+
+        for (size_t i = 0; i < connections; ++i)
+        {
+            clients.push_back(connectClient(server.port()));
+        }
+
+        std::atomic<bool> failed(std::find(clients.begin(), clients.end(), -1) != clients.end());
+        std::vector<std::thread> workers;
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t t = 0; t < threads && !failed.load(); ++t)
+        {
+            workers.emplace_back([&, t]() {
+                const std::string message(messageSize, static_cast<char>('a' + t % 26));
+                std::string reply(messageSize, '\0');
+
+                for (size_t round = 0; round < rounds && !failed.load(); ++round)
+                {
+                    for (size_t i = t; i < connections; i += threads)
+                    {
+                        if (::send(clients[i], message.data(), message.size(), 0) != static_cast<ssize_t>(messageSize))
+                        {
+                            failed.store(true);
+                        }
+                    }
+
+                    for (size_t i = t; i < connections; i += threads)
+                    {
+                        if (!readExactly(clients[i], &reply[0], messageSize) || reply != message)
+                        {
+                            failed.store(true);
+                        }
+                    }
+                }
+            });
+        }
+
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        server.stop();
+
+        for (int client : clients)
+        {
+            if (client >= 0)
+            {
+                ::close(client);
+            }
+        }
+
+        return failed.load() ? -1.0 : elapsed;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const size_t cpus = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t maxReactors = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : std::max<size_t>(cpus / 2, 1);
+    const size_t connections = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 512;
+    const size_t rounds = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 200;
+    const size_t messageSize = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 64;
+    const size_t threads = argc > 5 ? std::strtoull(argv[5], nullptr, 10) : std::max<size_t>(cpus / 2, 1);
+
+    std::printf("cpus=%zu, connections=%zu, rounds=%zu, message=%zuB, client threads=%zu\n", cpus, connections,
+                rounds, messageSize, threads);
+    std::printf("%10s %12s %14s %12s %10s\n", "reactors", "time ms", "messages/s", "MB/s", "speedup");
+
+    double baseline = 0.0;
+
+    for (size_t reactors = 1; reactors <= maxReactors; reactors *= 2)
+    {
+        const double elapsed = measure(reactors, connections, rounds, messageSize, threads);
+
+        if (elapsed < 0.0)
+        {
+            std::fprintf(stderr, "run with %zu reactors failed\n", reactors);
+            return 1;
+        }
+
+        const double messages = static_cast<double>(connections * rounds);
+        const double rate = messages / elapsed;
+        baseline = reactors == 1 ? rate : baseline;
+
+        std::printf("%10zu %12.1f %14.0f %12.1f %9.2fx\n", reactors, elapsed * 1e3, rate,
+                    rate * static_cast<double>(messageSize) / 1e6, rate / baseline);
+    }
+
+    return 0;
+}
+
+/// @}
@@ -0,0 +1,96 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file paralleltreebench
+/// @brief Measures @c parallelReduce over a large random @c TreeNode tree against a sequential fold, for a growing
+///        number of workers.
+///
+/// Usage: paralleltree_bench [nodes] [max workers] [cutoff depth]
+/// @{
+
+// Class Header
+#include <paralleltree.h>
+
+// From C++ STL
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using Node = libdsa::structures::utilities::TreeNode<uint64_t>;
+
+    /// @brief Stand-in for a per-node analytic that costs more than an addition.
+    double work(uint64_t datum)
+    {
+        return std::sqrt(static_cast<double>(datum)) * std::log1p(static_cast<double>(datum));
+    }
+
+    template <typename Function>
+    double seconds(Function function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    const size_t maxWorkers = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+    const size_t cutoff = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : libdsa::common::DEFAULT_CUTOFF_DEPTH;
+
+    // Random recursive tree: each node hangs off a uniformly chosen earlier node.
+    std::vector<std::unique_ptr<Node>> nodes;
+    std::mt19937_64 generator(42);
+    nodes.reserve(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        nodes.push_back(std::make_unique<Node>(i));
+
+        if (i != 0)
+        {
+            nodes[generator() % i]->children.push_back(nodes[i].get());
+        }
+    }
+
+    const Node *root = nodes.front().get();
+    auto map = [](uint64_t datum) { return work(datum); };
+    auto combine = [](double a, double b) { return a + b; };
+
+    double expected = 0.0;
+    const double sequential = seconds([&]() {
+        expected = libdsa::common::detail::sequentialReduce(root, 0.0, map, combine);
+    });
+
+    std::printf("nodes=%zu, cutoff depth=%zu, sequential=%.1fms\n", count, cutoff, sequential * 1e3);
+    std::printf("%8s %12s %10s\n", "workers", "time ms", "speedup");
+
+    for (size_t workers = 1; workers <= maxWorkers; workers *= 2)
+    {
+        libdsa::common::WorkStealingPool pool(workers);
+        double result = 0.0;
+        const double parallel = seconds([&]() {
+            result = libdsa::common::parallelReduce(pool, root, 0.0, map, combine, cutoff);
+        });
+
+        if (std::abs(result - expected) > 1e-6 * std::abs(expected))
+        {
+            std::fprintf(stderr, "result mismatch: %f != %f\n", result, expected);
+            return 1;
+        }
+
+        std::printf("%8zu %12.1f %10.2f\n", workers, parallel * 1e3, sequential / parallel);
+    }
+
+    return 0;
+}
+
+/// @}
@@ -0,0 +1,155 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file transportbackendbench
+/// @brief Measures a loopback echo server on @c TcpServerTransport with the epoll and the io_uring backend.  Client
+///        threads keep one message in flight on every one of their connections, round after round.
+///
+/// Usage: transportbackend_bench [connections] [rounds] [message bytes] [client threads]
+/// @{
+
+// Class Header
+#include <TcpServerTransport.h>
+
+// From the transport tests
+#include <loopbackclient.h>
+
+// From C++ STL
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using libdsa::libstructures::TcpServerTransport;
+    using loopback::connectClient;
+    using loopback::readExactly;
+
+    const char *name(TcpServerTransport::Backend backend)
+    {
+        return backend == TcpServerTransport::Backend::IO_URING ? "io_uring" : "epoll";
+    }
+
+    /// @brief Runs the echo workload once.
+    /// @return Elapsed seconds, or a negative value if the run failed.
+    double measure(TcpServerTransport::Backend requested, size_t connections, size_t rounds, size_t messageSize,
+                   size_t threads, TcpServerTransport::Backend &used)
+    {
+        TcpServerTransport server(htonl(INADDR_LOOPBACK), 0, requested);
+
+        TcpServerTransport::Callbacks callbacks;
+        callbacks.onRead = [&server](uint64_t connection, const char *data, size_t size) {
+            server.send(connection, data, size);
+        };
+        server.setCallbacks(callbacks);
+
+        if (!server.open())
+        {
+            return -1.0;
+        }
+
+        used = server.backend();
+        std::thread loop([&server]() { server.run(); });
+
+        std::vector<int> clients;
+
+        for (size_t i = 0; i < connections; ++i)
+        {
+            clients.push_back(connectClient(server.port()));
+        }
+
+        std::atomic<bool> failed(std::find(clients.begin(), clients.end(), -1) != clients.end());
+        std::vector<std::thread> workers;
+        const auto start = std::chrono::steady_clock::now();
+
+        for (size_t t = 0; t < threads && !failed.load(); ++t)
+        {
+            workers.emplace_back([&, t]() {
+                const std::string message(messageSize, static_cast<char>('a' + t % 26));
+                std::string reply(messageSize, '\0');
+
+                for (size_t round = 0; round < rounds && !failed.load(); ++round)
+                {
+                    for (size_t i = t; i < connections; i += threads)
+                    {
+                        if (::send(clients[i], message.data(), message.size(), 0) != static_cast<ssize_t>(messageSize))
+                        {
+                            failed.store(true);
+                        }
+                    }
+
+                    for (size_t i = t; i < connections; i += threads)
+                    {
+                        if (!readExactly(clients[i], &reply[0], messageSize) || reply != message)
+                        {
+                            failed.store(true);
+                        }
+                    }
+                }
+            });
+        }
+
+        for (std::thread &worker : workers)
+        {
+            worker.join();
+        }
+
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        server.stop();
+        loop.join();
+
+        for (int client : clients)
+        {
+            if (client >= 0)
+            {
+                ::close(client);
+            }
+        }
+
+        return failed.load() ? -1.0 : elapsed;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const size_t connections = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000;
+    const size_t rounds = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200;
+    const size_t messageSize = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 64;
+    const size_t threads = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 4;
+
+    std::printf("connections=%zu, rounds=%zu, message=%zuB, client threads=%zu\n", connections, rounds, messageSize,
+                threads);
+    std::printf("%10s %12s %14s %12s\n", "backend", "time ms", "messages/s", "MB/s");
+
+    for (TcpServerTransport::Backend requested :
+         {TcpServerTransport::Backend::EPOLL, TcpServerTransport::Backend::IO_URING})
+    {
+        TcpServerTransport::Backend used = requested;
+        const double elapsed = measure(requested, connections, rounds, messageSize, threads, used);
+
+        if (elapsed < 0.0)
+        {
+            std::fprintf(stderr, "%s run failed\n", name(requested));
+            return 1;
+        }
+
+        if (used != requested)
+        {
+            std::printf("%s is not available, measured %s instead\n", name(requested), name(used));
+        }
+
+        const double messages = static_cast<double>(connections * rounds);
+        std::printf("%10s %12.1f %14.0f %12.1f\n", name(used), elapsed * 1e3, messages / elapsed,
+                    messages * static_cast<double>(messageSize) / elapsed / 1e6);
+    }
+
+    return 0;
+}
+
+/// @}
@@ -0,0 +1,277 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file transportbench
+/// @brief Measures loopback throughput and latency between @c TcpClientTransport and an echo server on
+///        @c TcpServerTransport.  Two workloads run in turn over the same number of connections: ping-pong, with one
+///        message in flight per connection, and streaming, which keeps a window of messages in flight per connection.
+///        Every message carries the time it was sent, and each echo records its round trip in a @c LatencyHistogram,
+///        so streaming latencies include the time spent queued behind the rest of the window.
+///
+/// Usage: transport_bench [connections] [message bytes] [seconds] [client threads] [stream window]
+/// @{
+
+// Class Header
+#include <TcpClientTransport.h>
+
+// From libtransport
+#include <TcpServerTransport.h>
+
+// From libutilities
+#include <latencyhistogram.h>
+
+// From C++ STL
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    using libdsa::libstructures::TcpClientTransport;
+    using libdsa::libstructures::TcpServerTransport;
+    using libdsa::structures::utilities::LatencyHistogram;
+
+    /// @brief Bytes at the start of every message holding its send time.
+    constexpr size_t STAMP_SIZE = sizeof(uint64_t);
+
+    uint64_t nowNanoseconds()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    struct Result
+    {
+        double elapsed = 0.0;
+        uint64_t messages = 0;
+        LatencyHistogram latency;
+        bool failed = false;
+    };
+
+    /// @brief Drives the connections @p thread owns out of @p connections until @p seconds have passed.
+    void runClient(uint16_t port, size_t thread, size_t threads, size_t connections, size_t messageSize,
+                   size_t window, double seconds, Result &result)
+    {
+        // Progress through the message currently arriving on one connection.
+        struct Flow
+        {
+            size_t inFlight = 0;
+            size_t offset = 0;
+            char stamp[STAMP_SIZE];
+        };
+
+        TcpClientTransport client;
+        std::unordered_map<uint64_t, Flow> flows;
+        std::string message(messageSize, static_cast<char>('a' + thread % 26));
+        size_t connected = 0;
+        bool sending = true;
+
+        auto sendOne = [&](uint64_t id) {
+            const uint64_t stamp = nowNanoseconds();
+            std::memcpy(&message[0], &stamp, STAMP_SIZE);
+            client.send(id, message.data(), message.size());
+            ++flows[id].inFlight;
+        };
+
+        TcpClientTransport::Callbacks callbacks;
+        callbacks.onConnect = [&](uint64_t id) {
+            client.setNoDelay(id, true);
+            ++connected;
+        };
+        callbacks.onClose = [&](uint64_t) { result.failed = true; };
+        callbacks.onRead = [&](uint64_t id, const char *data, size_t size) {
+            Flow &flow = flows[id];
+
+            while (size > 0)
+            {
+                const size_t wanted = flow.offset < STAMP_SIZE ? STAMP_SIZE - flow.offset : messageSize - flow.offset;
+                const size_t taken = std::min(wanted, size);
+
+                if (flow.offset < STAMP_SIZE)
+                {
+                    std::memcpy(flow.stamp + flow.offset, data, taken);
+                }
+
+                data += taken;
+                size -= taken;
+                flow.offset += taken;
+
+                if (flow.offset == messageSize)
+                {
+                    uint64_t sent;
+                    std::memcpy(&sent, flow.stamp, STAMP_SIZE);
+                    result.latency.record(nowNanoseconds() - sent);
+                    ++result.messages;
+                    --flow.inFlight;
+                    flow.offset = 0;
+                }
+            }
+
+            while (sending && flow.inFlight < window)
+            {
+                sendOne(id);
+            }
+        };
+
+        client.setCallbacks(callbacks);
+
+        if (!client.open())
+        {
+            result.failed = true;
+            return;
+        }
+
+        std::vector<uint64_t> mine;
+
+        for (size_t i = thread; i < connections; i += threads)
+        {
+            mine.push_back(client.connect(htonl(INADDR_LOOPBACK), port));
+        }
+
+        const auto connectDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+        while (connected < mine.size() && !result.failed && std::chrono::steady_clock::now() < connectDeadline)
+        {
+            client.poll(10);
+        }
+
+        if (connected < mine.size() || std::find(mine.begin(), mine.end(), 0) != mine.end())
+        {
+            result.failed = true;
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto deadline = start + std::chrono::duration<double>(seconds);
+
+        for (uint64_t id : mine)
+        {
+            for (size_t i = 0; i < window; ++i)
+            {
+                sendOne(id);
+            }
+        }
+
+        while (!result.failed && std::chrono::steady_clock::now() < deadline)
+        {
+            client.poll(1);
+        }
+
+        // Let the messages still in flight come back so every one sent is accounted for.
+        sending = false;
+        const auto drainDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        auto draining = [&]() {
+            return std::any_of(flows.begin(), flows.end(), [](const auto &flow) { return flow.second.inFlight > 0; });
+        };
+
+        while (!result.failed && draining() && std::chrono::steady_clock::now() < drainDeadline)
+        {
+            client.poll(1);
+        }
+
+        result.failed = result.failed || draining();
+        result.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        client.setCallbacks(TcpClientTransport::Callbacks());
+    }
+
+    /// @brief Runs one workload against a fresh echo server.
+    Result measure(size_t connections, size_t messageSize, double seconds, size_t threads, size_t window)
+    {
+        TcpServerTransport server(htonl(INADDR_LOOPBACK), 0);
+
+        TcpServerTransport::Callbacks callbacks;
+        callbacks.onAccept = [&server](uint64_t connection) { server.setNoDelay(connection, true); };
+        callbacks.onRead = [&server](uint64_t connection, const char *data, size_t size) {
+            server.send(connection, data, size);
+        };
+        server.setCallbacks(callbacks);
+
+        Result total;
+
+        if (!server.open())
+        {
+            total.failed = true;
+            return total;
+        }
+
+        std::thread serverThread([&server]() { server.run(); });
+        std::vector<Result> results(threads);
+        std::vector<std::thread> clients;
+
+        for (size_t t = 0; t < threads; ++t)
+        {
+            clients.emplace_back([&, t]() {
+                runClient(server.port(), t, threads, connections, messageSize, window, seconds, results[t]);
+            });
+        }
+
+        for (std::thread &client : clients)
+        {
+            client.join();
+        }
+
+        server.stop();
+        serverThread.join();
+        server.close();
+
+        for (const Result &result : results)
+        {
+            total.elapsed = std::max(total.elapsed, result.elapsed);
+            total.messages += result.messages;
+            total.latency.merge(result.latency);
+            total.failed = total.failed || result.failed;
+        }
+
+        return total;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const size_t connections = std::max<size_t>(argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64, 1);
+    const size_t messageSize = std::max<size_t>(argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64, STAMP_SIZE);
+    const double seconds = argc > 3 ? std::strtod(argv[3], nullptr) : 2.0;
+    const size_t threads = std::max<size_t>(argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 1, 1);
+    const size_t window = std::max<size_t>(argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 64, 1);
+
+    std::printf("connections=%zu, message=%zuB, seconds=%.1f, client threads=%zu, stream window=%zu\n", connections,
+                messageSize, seconds, threads, window);
+    std::printf("%10s %14s %10s %10s %10s %10s %10s\n", "workload", "messages/s", "MB/s", "p50 us", "p99 us",
+                "p999 us", "max us");
+
+    const struct
+    {
+        const char *name;
+        size_t window;
+    } workloads[] = {{"ping-pong", 1}, {"stream", window}};
+
+    for (const auto &workload : workloads)
+    {
+        const Result result = measure(connections, messageSize, seconds, std::min(threads, connections),
+                                      workload.window);
+
+        if (result.failed || result.elapsed <= 0.0)
+        {
+            std::fprintf(stderr, "%s run failed\n", workload.name);
+            return 1;
+        }
+
+        const double rate = static_cast<double>(result.messages) / result.elapsed;
+
+        std::printf("%10s %14.0f %10.1f %10.1f %10.1f %10.1f %10.1f\n", workload.name, rate,
+                    rate * static_cast<double>(messageSize) / 1e6, result.latency.percentile(50) / 1e3,
+                    result.latency.percentile(99) / 1e3, result.latency.percentile(99.9) / 1e3,
+                    result.latency.max() / 1e3);
+    }
+
+    return 0;
+}
+
+/// @}
@@ -0,0 +1,264 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file paralleltree
+/// @{
+
+#ifndef PARALLELTREE_H_
+#define PARALLELTREE_H_
+
+/// @details Parallel traversals and reductions over n-ary @c TreeNode trees, forked on a @c WorkStealingPool.  Every
+/// subtree whose root lies above the cutoff depth becomes a task of its own.  Below the cutoff a subtree is walked
+/// sequentially with an explicit stack, so the cost of a task is paid only where it buys parallelism and a deep tree
+/// cannot overflow the call stack.  Leaf children are always handled inline.  If a worker is idle, forking continues
+/// below the cutoff (down to @c MAX_FORK_DEPTH), which keeps lopsided trees busy on every core.
+
+// From C++ STL
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// From libparallel
+#include <workstealingpool.h>
+
+// From libutilities
+#include <node.h>
+
+namespace libdsa
+{
+    namespace common
+    {
+        /// @brief Depth below which subtrees run sequentially unless a worker is idle.
+        constexpr size_t DEFAULT_CUTOFF_DEPTH = 8;
+
+        /// @brief Depth below which subtrees always run sequentially.  Bounds how deeply fork-join frames nest on
+        ///        one thread's stack.
+        constexpr size_t MAX_FORK_DEPTH = 64;
+
+        /// @brief Calls @p visit on every datum, each node before any of its descendants.  Distinct subtrees are
+        ///        visited concurrently, so @p visit must be safe to call from several threads.
+        template <typename type, typename Visit>
+        void parallelPreOrder(WorkStealingPool &pool, structures::utilities::TreeNode<type> *root, Visit visit,
+                              size_t cutoffDepth = DEFAULT_CUTOFF_DEPTH);
+
+        /// @brief Calls @p visit on every datum, each node after all of its descendants.  Distinct subtrees are
+        ///        visited concurrently, so @p visit must be safe to call from several threads.
+        template <typename type, typename Visit>
+        void parallelPostOrder(WorkStealingPool &pool, structures::utilities::TreeNode<type> *root, Visit visit,
+                               size_t cutoffDepth = DEFAULT_CUTOFF_DEPTH);
+
+        /// @brief Maps every datum with @p map and folds the results with @p combine.
+        ///
+        /// @details The result equals the sequential fold in pre-order starting from @p identity, provided
+        ///          @p combine is associative and @p identity is neutral for it.  @p combine need not be commutative.
+        template <typename type, typename Result, typename Map, typename Combine>
+        Result parallelReduce(WorkStealingPool &pool, const structures::utilities::TreeNode<type> *root,
+                              Result identity, Map map, Combine combine, size_t cutoffDepth = DEFAULT_CUTOFF_DEPTH);
+
+        namespace detail
+        {
+            inline bool shouldFork(const WorkStealingPool &pool, size_t depth, size_t cutoffDepth)
+            {
+                return depth < cutoffDepth || (depth < MAX_FORK_DEPTH && pool.hasIdleWorkers());
+            }
+
+            template <typename type, typename Visit>
+            void sequentialPreOrder(structures::utilities::TreeNode<type> *root, const Visit &visit)
+            {
+                std::vector<structures::utilities::TreeNode<type> *> stack{root};
+
+                while (!stack.empty())
+                {
+                    structures::utilities::TreeNode<type> *node = stack.back();
+                    stack.pop_back();
+                    visit(node->_datum);
+
+                    stack.insert(stack.end(), node->children.rbegin(), node->children.rend());
+                }
+            }
+
+            template <typename type, typename Visit>
+            void sequentialPostOrder(structures::utilities::TreeNode<type> *root, const Visit &visit)
+            {
+                // The flag is set once a node's children have been pushed, so the second time it surfaces it is done.
+                std::vector<std::pair<structures::utilities::TreeNode<type> *, bool>> stack{{root, false}};
+
+                while (!stack.empty())
+                {
+                    auto &[node, expanded] = stack.back();
+
+                    if (expanded || node->children.empty())
+                    {
+                        visit(node->_datum);
+                        stack.pop_back();
+                        continue;
+                    }
+
+                    expanded = true;
+                    structures::utilities::TreeNode<type> *parent = node;
+
+                    for (auto child = parent->children.rbegin(); child != parent->children.rend(); ++child)
+                    {
+                        stack.emplace_back(*child, false);
+                    }
+                }
+            }
+
+            template <typename type, typename Result, typename Map, typename Combine>
+            Result sequentialReduce(const structures::utilities::TreeNode<type> *root, Result result, const Map &map,
+                                    const Combine &combine)
+            {
+                std::vector<const structures::utilities::TreeNode<type> *> stack{root};
+
+                while (!stack.empty())
+                {
+                    const structures::utilities::TreeNode<type> *node = stack.back();
+                    stack.pop_back();
+                    result = combine(std::move(result), map(node->_datum));
+
+                    stack.insert(stack.end(), node->children.rbegin(), node->children.rend());
+                }
+
+                return result;
+            }
+
+            template <typename type, typename Visit>
+            void preOrder(WorkStealingPool &pool, structures::utilities::TreeNode<type> *node, const Visit &visit,
+                          size_t depth, size_t cutoffDepth)
+            {
+                if (!shouldFork(pool, depth, cutoffDepth))
+                {
+                    sequentialPreOrder(node, visit);
+                    return;
+                }
+
+                visit(node->_datum);
+                WorkStealingPool::TaskGroup group(pool);
+
+                for (structures::utilities::TreeNode<type> *child : node->children)
+                {
+                    if (child->children.empty())
+                    {
+                        visit(child->_datum);
+                    }
+                    else
+                    {
+                        group.run([&pool, child, &visit, depth, cutoffDepth]() {
+                            preOrder(pool, child, visit, depth + 1, cutoffDepth);
+                        });
+                    }
+                }
+
+                group.wait();
+            }
+
+            template <typename type, typename Visit>
+            void postOrder(WorkStealingPool &pool, structures::utilities::TreeNode<type> *node, const Visit &visit,
+                           size_t depth, size_t cutoffDepth)
+            {
+                if (!shouldFork(pool, depth, cutoffDepth))
+                {
+                    sequentialPostOrder(node, visit);
+                    return;
+                }
+
+                WorkStealingPool::TaskGroup group(pool);
+
+                for (structures::utilities::TreeNode<type> *child : node->children)
+                {
+                    if (child->children.empty())
+                    {
+                        visit(child->_datum);
+                    }
+                    else
+                    {
+                        group.run([&pool, child, &visit, depth, cutoffDepth]() {
+                            postOrder(pool, child, visit, depth + 1, cutoffDepth);
+                        });
+                    }
+                }
+
+                group.wait();
+                visit(node->_datum);
+            }
+
+            template <typename type, typename Result, typename Map, typename Combine>
+            Result reduce(WorkStealingPool &pool, const structures::utilities::TreeNode<type> *node,
+                          const Result &identity, const Map &map, const Combine &combine, size_t depth,
+                          size_t cutoffDepth)
+            {
+                if (!shouldFork(pool, depth, cutoffDepth))
+                {
+                    return sequentialReduce(node, identity, map, combine);
+                }
+
+                // One slot per child so the partial results can be combined in order once they are all in.
+                std::vector<Result> partials(node->children.size(), identity);
+                WorkStealingPool::TaskGroup group(pool);
+
+                for (size_t i = 0; i < node->children.size(); ++i)
+                {
+                    const structures::utilities::TreeNode<type> *child = node->children[i];
+
+                    if (child->children.empty())
+                    {
+                        partials[i] = map(child->_datum);
+                    }
+                    else
+                    {
+                        Result *slot = &partials[i];
+                        group.run([&pool, child, slot, &identity, &map, &combine, depth, cutoffDepth]() {
+                            *slot = reduce(pool, child, identity, map, combine, depth + 1, cutoffDepth);
+                        });
+                    }
+                }
+
+                group.wait();
+
+                Result result = map(node->_datum);
+
+                for (Result &partial : partials)
+                {
+                    result = combine(std::move(result), std::move(partial));
+                }
+
+                return result;
+            }
+        } // detail
+
+        template <typename type, typename Visit>
+        void parallelPreOrder(WorkStealingPool &pool, structures::utilities::TreeNode<type> *root, Visit visit,
+                              size_t cutoffDepth)
+        {
+            if (root != nullptr)
+            {
+                detail::preOrder(pool, root, visit, 0, cutoffDepth);
+            }
+        }
+
+        template <typename type, typename Visit>
+        void parallelPostOrder(WorkStealingPool &pool, structures::utilities::TreeNode<type> *root, Visit visit,
+                               size_t cutoffDepth)
+        {
+            if (root != nullptr)
+            {
+                detail::postOrder(pool, root, visit, 0, cutoffDepth);
+            }
+        }
+
+        template <typename type, typename Result, typename Map, typename Combine>
+        Result parallelReduce(WorkStealingPool &pool, const structures::utilities::TreeNode<type> *root,
+                              Result identity, Map map, Combine combine, size_t cutoffDepth)
+        {
+            if (root == nullptr)
+            {
+                return identity;
+            }
+
+            return combine(identity, detail::reduce(pool, root, identity, map, combine, 0, cutoffDepth));
+        }
+    } // common
+} // libdsa
+
+#endif // PARALLELTREE_H_
+
+/// @}
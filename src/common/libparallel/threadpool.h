@@ -0,0 +1,210 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file threadpool
+/// @{
+
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+// From C++ STL
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace libdsa
+{
+    namespace common
+    {
+        /// @brief Fixed size pool of worker threads pulling tasks from a shared queue.  Intended for coarse grained
+        ///        work such as streaming through large ranges, where one queue lock per task is negligible.
+        class ThreadPool
+        {
+        public:
+            /// @brief Constructor.  Starts the worker threads immediately.
+            /// @param threadCount Number of workers.  Zero selects the number of hardware threads.
+            explicit ThreadPool(size_t threadCount = 0);
+
+            /// @brief Destructor.  Finishes every queued task and joins the workers.
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool &) = delete;
+            ThreadPool &operator=(const ThreadPool &) = delete;
+
+            /// @brief Gets the number of worker threads.
+            size_t size() const;
+
+            /// @brief Queues a task.
+            /// @param task Callable taking no arguments.
+            /// @return A future holding the task's result or exception.
+            template <typename Task>
+            std::future<typename std::invoke_result<Task>::type> submit(Task task);
+
+            /// @brief Splits [begin, end) into contiguous chunks, runs @p function(chunkBegin, chunkEnd) on the pool for
+            ///        each of them and waits for all of them.  The first exception from any chunk is rethrown once
+            ///        every chunk has finished.
+            /// @param begin First index.
+            /// @param end One past the last index.
+            /// @param grain Chunk boundaries are rounded to a multiple of this many indices.
+            /// @param function Callable taking the chunk's begin and end indices.
+            template <typename Function>
+            void parallelFor(size_t begin, size_t end, size_t grain, Function function);
+
+        private:
+            /// @brief Loop run by every worker.
+            void _work();
+
+            std::vector<std::thread> _workers;
+            std::queue<std::function<void()>> _tasks;
+            std::mutex _mutex;
+            std::condition_variable _condition;
+            bool _stopping;
+        }; // ThreadPool
+
+        inline libdsa::common::ThreadPool::ThreadPool(size_t threadCount) : _stopping(false)
+        {
+            if (threadCount == 0)
+            {
+                threadCount = std::max(1U, std::thread::hardware_concurrency());
+            }
+
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                _workers.emplace_back(&ThreadPool::_work, this);
+            }
+        }
+
+        inline libdsa::common::ThreadPool::~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+
+            _condition.notify_all();
+
+            for (std::thread &worker : _workers)
+            {
+                worker.join();
+            }
+        }
+
+        inline size_t libdsa::common::ThreadPool::size() const
+        {
+            return _workers.size();
+        }
+
+        template <typename Task>
+        std::future<typename std::invoke_result<Task>::type> libdsa::common::ThreadPool::submit(Task task)
+        {
+            using Result = typename std::invoke_result<Task>::type;
+
+            // std::function must be copyable, so the move-only packaged_task is held through a shared pointer.
+            auto packaged = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+            std::future<Result> result = packaged->get_future();
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+
+                if (_stopping)
+                {
+                    throw std::runtime_error("ThreadPool - Cannot submit to a pool that is shutting down.");
+                }
+
+                _tasks.emplace([packaged]() { (*packaged)(); });
+            }
+
+            _condition.notify_one();
+            return result;
+        }
+
+        template <typename Function>
+        void libdsa::common::ThreadPool::parallelFor(size_t begin, size_t end, size_t grain, Function function)
+        {
+            if (begin >= end)
+            {
+                return;
+            }
+
+            grain = std::max<size_t>(grain, 1);
+
+            // One chunk per worker, rounded up to the grain so chunk boundaries fall on whole grains.
+            const size_t total = end - begin;
+            size_t chunk = (total + _workers.size() - 1) / _workers.size();
+            chunk = ((chunk + grain - 1) / grain) * grain;
+
+            std::vector<std::future<void>> pending;
+            std::exception_ptr failure;
+
+            try
+            {
+                for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += chunk)
+                {
+                    const size_t chunkEnd = std::min(end, chunkBegin + chunk);
+                    pending.push_back(submit([function, chunkBegin, chunkEnd]() { function(chunkBegin, chunkEnd); }));
+                }
+            }
+            catch (...)
+            {
+                failure = std::current_exception();
+            }
+
+            // Every chunk is waited for before anything is rethrown, since the chunks may still be using the
+            // caller's stack.
+            for (std::future<void> &future : pending)
+            {
+                try
+                {
+                    future.get();
+                }
+                catch (...)
+                {
+                    if (!failure)
+                    {
+                        failure = std::current_exception();
+                    }
+                }
+            }
+
+            if (failure)
+            {
+                std::rethrow_exception(failure);
+            }
+        }
+
+        inline void libdsa::common::ThreadPool::_work()
+        {
+            for (;;)
+            {
+                std::function<void()> task;
+
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _condition.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+
+                    if (_stopping && _tasks.empty())
+                    {
+                        return;
+                    }
+
+                    task = std::move(_tasks.front());
+                    _tasks.pop();
+                }
+
+                task();
+            }
+        }
+    } // common
+} // libdsa
+
+#endif // THREADPOOL_H_
+
+/// @}
@@ -0,0 +1,413 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file workstealingpool
+/// @{
+
+#ifndef WORKSTEALINGPOOL_H_
+#define WORKSTEALINGPOOL_H_
+
+/// @details Fork-join scheduler for fine grained, recursive work.  Every worker owns a deque.  A task forked on a
+/// worker goes to the back of that worker's deque, and the worker takes its own work back from the same end, so a
+/// recursion keeps running on the data it just touched.  An idle worker steals from the front of another deque,
+/// which holds the oldest and usually largest piece of work.  Tasks forked from outside the pool go to a shared
+/// queue.
+///
+/// A thread waiting for a @c TaskGroup runs queued tasks instead of blocking, so nested fork-join never deadlocks
+/// and never leaves a core idle while work is available.  Each task it picks up runs on top of the waiting frame, so
+/// past @c MAX_HELP_DEPTH nested tasks a waiting thread only runs tasks of the group it waits for, and otherwise
+/// yields until the rest finish elsewhere.
+
+// From C++ STL
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace libdsa
+{
+    namespace common
+    {
+        class WorkStealingPool
+        {
+        private:
+            struct Task;
+
+        public:
+            /// @brief A set of forked tasks that are joined together.  Every task run through a group must finish
+            ///        before @c wait() returns.
+            class TaskGroup
+            {
+            public:
+                explicit TaskGroup(WorkStealingPool &pool);
+
+                /// @brief Destructor.  Waits for outstanding tasks but drops their exceptions.
+                ~TaskGroup();
+
+                TaskGroup(const TaskGroup &) = delete;
+                TaskGroup &operator=(const TaskGroup &) = delete;
+
+                /// @brief Forks @p function.  It may run on any worker, or on the thread that later waits.
+                template <typename Function>
+                void run(Function function);
+
+                /// @brief Runs queued tasks until every task of this group has finished, then rethrows the first
+                ///        exception any of them threw.
+                void wait();
+
+            private:
+                friend class WorkStealingPool;
+
+                void _help();
+
+                WorkStealingPool &_pool;
+                std::atomic<size_t> _pending;
+                std::mutex _errorMutex;
+                std::exception_ptr _error;
+            }; // TaskGroup
+
+            /// @brief Tasks a thread may run on top of its own waiting frames while it helps before it only runs
+            ///        tasks of the group it waits for.  Bounds the stack that helping adds to a recursion.
+            static constexpr size_t MAX_HELP_DEPTH = 64;
+
+            /// @brief Constructor.  Starts the worker threads immediately.
+            /// @param threadCount Number of workers.  Zero selects the number of hardware threads.
+            explicit WorkStealingPool(size_t threadCount = 0);
+
+            /// @brief Destructor.  Joins the workers.  Every task group must have been waited for.
+            ~WorkStealingPool();
+
+            WorkStealingPool(const WorkStealingPool &) = delete;
+            WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+            /// @brief Gets the number of worker threads.
+            size_t size() const;
+
+            /// @brief True while at least one worker is asleep for lack of work.  Recursive algorithms use this to
+            ///        keep splitting below their usual cutoff when the split would be picked up straight away.
+            bool hasIdleWorkers() const;
+
+        private:
+            struct Task
+            {
+                std::function<void()> _function;
+                TaskGroup *_group;
+            };
+
+            /// @brief A task deque and the lock guarding it, on a cache line of its own.
+            struct alignas(64) Queue
+            {
+                std::mutex _mutex;
+                std::deque<Task *> _tasks;
+            };
+
+            /// @brief Which pool the calling thread works for, and its queue index there.
+            struct WorkerIdentity
+            {
+                const WorkStealingPool *_pool = nullptr;
+                size_t _index = 0;
+            };
+
+            static WorkerIdentity &_identity();
+
+            /// @brief Tasks the calling thread is running on top of a @c TaskGroup it is waiting for.
+            static size_t &_helpDepth();
+
+            /// @brief Index of the calling thread's queue in this pool, or @c size() for outside threads.
+            size_t _localIndex() const;
+
+            void _push(Task *task);
+
+            /// @brief Takes a task from the caller's own queue first, then the shared queue, then by stealing.
+            Task *_take(size_t localIndex);
+
+            /// @brief Takes the newest task of the caller's own queue, but only if it belongs to @p group.
+            Task *_takeOwn(size_t localIndex, const TaskGroup *group);
+
+            void _execute(Task *task);
+
+            void _work(size_t index);
+
+            /// @brief Fixed before any worker starts, since workers read it while the later ones are still launching.
+            size_t _workerCount;
+
+            /// @brief One queue per worker plus the shared queue for outside threads, at index @c size().
+            std::unique_ptr<Queue[]> _queues;
+            std::vector<std::thread> _workers;
+
+            /// @brief Tasks pushed but not yet taken.  Sleeping workers wait for this to become nonzero.
+            std::atomic<size_t> _queued;
+            std::atomic<size_t> _sleeping;
+            std::mutex _sleepMutex;
+            std::condition_variable _condition;
+            bool _stopping;
+        }; // WorkStealingPool
+
+        inline libdsa::common::WorkStealingPool::TaskGroup::TaskGroup(WorkStealingPool &pool)
+            : _pool(pool), _pending(0)
+        {
+            // Intentionally empty constructor
+        }
+
+        inline libdsa::common::WorkStealingPool::TaskGroup::~TaskGroup()
+        {
+            _help();
+        }
+
+        template <typename Function>
+        void libdsa::common::WorkStealingPool::TaskGroup::run(Function function)
+        {
+            std::unique_ptr<Task> task(new Task{std::move(function), this});
+
+            // Counted before it is visible to the workers, and uncounted again if the queue could not take it.
+            _pending.fetch_add(1, std::memory_order_relaxed);
+
+            try
+            {
+                _pool._push(task.get());
+            }
+            catch (...)
+            {
+                _pending.fetch_sub(1, std::memory_order_relaxed);
+                throw;
+            }
+
+            task.release();
+        }
+
+        inline void libdsa::common::WorkStealingPool::TaskGroup::wait()
+        {
+            _help();
+
+            std::exception_ptr error;
+
+            {
+                std::lock_guard<std::mutex> lock(_errorMutex);
+                std::swap(error, _error);
+            }
+
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        inline void libdsa::common::WorkStealingPool::TaskGroup::_help()
+        {
+            const size_t localIndex = _pool._localIndex();
+            size_t &depth = _helpDepth();
+
+            while (_pending.load(std::memory_order_acquire) != 0)
+            {
+                // Running this group's own newest task is no deeper than running the recursion serially, so only
+                // picking up unrelated work is capped.
+                Task *task = depth < MAX_HELP_DEPTH ? _pool._take(localIndex) : _pool._takeOwn(localIndex, this);
+
+                if (task != nullptr)
+                {
+                    ++depth;
+                    _pool._execute(task);
+                    --depth;
+                }
+                else
+                {
+                    // The remaining tasks of this group are running elsewhere.
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        inline libdsa::common::WorkStealingPool::WorkStealingPool(size_t threadCount)
+            : _queued(0), _sleeping(0), _stopping(false)
+        {
+            if (threadCount == 0)
+            {
+                threadCount = std::max(1U, std::thread::hardware_concurrency());
+            }
+
+            _workerCount = threadCount;
+            _queues.reset(new Queue[threadCount + 1]);
+            _workers.reserve(threadCount);
+
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                _workers.emplace_back(&WorkStealingPool::_work, this, i);
+            }
+        }
+
+        inline libdsa::common::WorkStealingPool::~WorkStealingPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_sleepMutex);
+                _stopping = true;
+            }
+
+            _condition.notify_all();
+
+            for (std::thread &worker : _workers)
+            {
+                worker.join();
+            }
+        }
+
+        inline size_t libdsa::common::WorkStealingPool::size() const
+        {
+            return _workerCount;
+        }
+
+        inline bool libdsa::common::WorkStealingPool::hasIdleWorkers() const
+        {
+            return _sleeping.load(std::memory_order_relaxed) != 0;
+        }
+
+        inline libdsa::common::WorkStealingPool::WorkerIdentity &libdsa::common::WorkStealingPool::_identity()
+        {
+            thread_local WorkerIdentity identity;
+            return identity;
+        }
+
+        inline size_t &libdsa::common::WorkStealingPool::_helpDepth()
+        {
+            thread_local size_t depth = 0;
+            return depth;
+        }
+
+        inline size_t libdsa::common::WorkStealingPool::_localIndex() const
+        {
+            const WorkerIdentity &identity = _identity();
+            return identity._pool == this ? identity._index : size();
+        }
+
+        inline void libdsa::common::WorkStealingPool::_push(Task *task)
+        {
+            Queue &queue = _queues[_localIndex()];
+
+            {
+                std::lock_guard<std::mutex> lock(queue._mutex);
+                queue._tasks.push_back(task);
+            }
+
+            // Pairs with the sleeping worker raising _sleeping before it rechecks _queued, so either the worker sees
+            // this task or this thread sees the sleeper.
+            _queued.fetch_add(1);
+
+            if (_sleeping.load() != 0)
+            {
+                std::lock_guard<std::mutex> lock(_sleepMutex);
+                _condition.notify_one();
+            }
+        }
+
+        inline libdsa::common::WorkStealingPool::Task *libdsa::common::WorkStealingPool::_take(size_t localIndex)
+        {
+            const size_t queueCount = size() + 1;
+
+            // Newest task from the caller's own queue.
+            {
+                Queue &own = _queues[localIndex];
+                std::lock_guard<std::mutex> lock(own._mutex);
+
+                if (!own._tasks.empty())
+                {
+                    Task *task = own._tasks.back();
+                    own._tasks.pop_back();
+                    _queued.fetch_sub(1);
+                    return task;
+                }
+            }
+
+            // Oldest task from everyone else, starting after the caller to spread thieves over the victims.
+            for (size_t offset = 1; offset < queueCount; ++offset)
+            {
+                Queue &victim = _queues[(localIndex + offset) % queueCount];
+                std::unique_lock<std::mutex> lock(victim._mutex, std::try_to_lock);
+
+                if (lock.owns_lock() && !victim._tasks.empty())
+                {
+                    Task *task = victim._tasks.front();
+                    victim._tasks.pop_front();
+                    _queued.fetch_sub(1);
+                    return task;
+                }
+            }
+
+            return nullptr;
+        }
+
+        inline libdsa::common::WorkStealingPool::Task *
+        libdsa::common::WorkStealingPool::_takeOwn(size_t localIndex, const TaskGroup *group)
+        {
+            Queue &own = _queues[localIndex];
+            std::lock_guard<std::mutex> lock(own._mutex);
+
+            if (own._tasks.empty() || own._tasks.back()->_group != group)
+            {
+                return nullptr;
+            }
+
+            Task *task = own._tasks.back();
+            own._tasks.pop_back();
+            _queued.fetch_sub(1);
+            return task;
+        }
+
+        inline void libdsa::common::WorkStealingPool::_execute(Task *task)
+        {
+            std::unique_ptr<Task> owned(task);
+            TaskGroup *group = owned->_group;
+
+            try
+            {
+                owned->_function();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(group->_errorMutex);
+
+                if (!group->_error)
+                {
+                    group->_error = std::current_exception();
+                }
+            }
+
+            // The task's captures must be gone before the group can be released.
+            owned.reset();
+            group->_pending.fetch_sub(1, std::memory_order_release);
+        }
+
+        inline void libdsa::common::WorkStealingPool::_work(size_t index)
+        {
+            _identity() = WorkerIdentity{this, index};
+
+            for (;;)
+            {
+                if (Task *task = _take(index))
+                {
+                    _execute(task);
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(_sleepMutex);
+                _sleeping.fetch_add(1);
+                _condition.wait(lock, [this]() { return _stopping || _queued.load() != 0; });
+                _sleeping.fetch_sub(1);
+
+                if (_stopping && _queued.load() == 0)
+                {
+                    return;
+                }
+            }
+        }
+    } // common
+} // libdsa
+
+#endif // WORKSTEALINGPOOL_H_
+
+/// @}
@@ -0,0 +1,76 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file alignedallocator
+/// @{
+
+#ifndef ALIGNEDALLOCATOR_H_
+#define ALIGNEDALLOCATOR_H_
+
+// From C++ STL
+#include <cstddef>
+#include <new>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace utilities
+        {
+            /// @brief Size of a cache line on the targeted x86-64 and AArch64 hardware.
+            constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+            /// @brief Minimal allocator that hands out storage aligned to @c ALIGNMENT bytes.  Used by the
+            ///        word-packed containers so that a block of words never straddles two cache lines.
+            ///
+            /// @tparam T The type of element being allocated.
+            /// @tparam ALIGNMENT The alignment in bytes.  Must be a power of two.
+            template <typename T, std::size_t ALIGNMENT = CACHE_LINE_SIZE>
+            struct AlignedAllocator
+            {
+                static_assert((ALIGNMENT & (ALIGNMENT - 1)) == 0, "AlignedAllocator - Alignment must be a power of two.");
+
+                using value_type = T;
+
+                template <typename U>
+                struct rebind
+                {
+                    using other = AlignedAllocator<U, ALIGNMENT>;
+                };
+
+                AlignedAllocator() noexcept = default;
+
+                template <typename U>
+                AlignedAllocator(const AlignedAllocator<U, ALIGNMENT> &) noexcept
+                {
+                    // Intentionally empty constructor.
+                }
+
+                T *allocate(std::size_t count)
+                {
+                    return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t(ALIGNMENT)));
+                }
+
+                void deallocate(T *pointer, std::size_t) noexcept
+                {
+                    ::operator delete(pointer, std::align_val_t(ALIGNMENT));
+                }
+
+                template <typename U>
+                bool operator==(const AlignedAllocator<U, ALIGNMENT> &) const noexcept
+                {
+                    return true;
+                }
+
+                template <typename U>
+                bool operator!=(const AlignedAllocator<U, ALIGNMENT> &) const noexcept
+                {
+                    return false;
+                }
+            }; // AlignedAllocator
+        } // utilities
+    } // structures
+} // libdsa
+
+#endif // ALIGNEDALLOCATOR_H_
+
+/// @}
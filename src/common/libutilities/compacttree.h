@@ -0,0 +1,442 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file compacttree
+/// @{
+
+#ifndef COMPACTTREE_H_
+#define COMPACTTREE_H_
+
+/// @details The @c CompactTree stores an n-ary tree in an arena instead of one heap block per node.  Nodes live in
+/// fixed-size blocks and refer to each other by 32-bit index using the first-child/next-sibling layout, so a node
+/// costs its datum plus 12 bytes and there is no per-node allocation or child vector.  Blocks never move once
+/// allocated, which keeps references to data valid while the tree grows, and @c reset() drops every node at once
+/// while keeping the blocks for the next tree.
+
+// From C++ STL
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// From libutilities
+#include <node.h>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace utilities
+        {
+            /// @brief Index of a node in a @c CompactTree.
+            using NodeIndex = uint32_t;
+
+            /// @brief Index that refers to no node, e.g. the next sibling of a last child.
+            constexpr NodeIndex NULL_INDEX = std::numeric_limits<NodeIndex>::max();
+
+            template <typename type>
+            struct CompactTreeNode
+            {
+                type _datum;
+                NodeIndex _firstChild;
+                NodeIndex _lastChild;
+                NodeIndex _nextSibling;
+
+                CompactTreeNode(const type &datum)
+                    : _datum(datum), _firstChild(NULL_INDEX), _lastChild(NULL_INDEX), _nextSibling(NULL_INDEX)
+                {
+                    // Intentionally empty constructor
+                }
+            }; // CompactTreeNode
+
+            template <typename type>
+            class CompactTree
+            {
+                public:
+
+                    using Node = CompactTreeNode<type>;
+
+                    /// @brief Number of nodes in one arena block.
+                    static constexpr size_t BLOCK_SIZE = size_t(1) << 14;
+
+                    /// @brief Largest number of nodes a tree can hold, since @c NULL_INDEX is reserved.
+                    static constexpr size_t MAX_NODES = NULL_INDEX;
+
+                    CompactTree();
+
+                    /// @brief Copies the tree hanging off @p root, keeping the order of every node's children.
+                    explicit CompactTree(const TreeNode<type> *root);
+
+                    CompactTree(const CompactTree &) = delete;
+                    CompactTree &operator=(const CompactTree &) = delete;
+
+                    CompactTree(CompactTree &&other) noexcept;
+                    CompactTree &operator=(CompactTree &&other) noexcept;
+
+                    ~CompactTree();
+
+                    /// @brief Creates the root node.
+                    ///
+                    /// @throw std::runtime_error if the tree already has a root.
+                    NodeIndex addRoot(const type &datum);
+
+                    /// @brief Appends a new last child to @p parent.
+                    ///
+                    /// @throw std::out_of_range if @p parent is not a node of this tree.
+                    NodeIndex addChild(NodeIndex parent, const type &datum);
+
+                    /// @brief Index of the root, or @c NULL_INDEX if the tree is empty.
+                    NodeIndex root() const;
+
+                    NodeIndex firstChild(NodeIndex node) const;
+
+                    NodeIndex nextSibling(NodeIndex node) const;
+
+                    /// @brief Counts the children of @p node by walking them.
+                    size_t childCount(NodeIndex node) const;
+
+                    type &datum(NodeIndex node);
+
+                    const type &datum(NodeIndex node) const;
+
+                    /// @brief Direct access to a node without a bounds check.
+                    const Node &node(NodeIndex index) const;
+
+                    /// @brief Calls @p function on every datum in pre-order, without recursion.
+                    template <typename Function>
+                    void preOrder(Function function) const;
+
+                    /// @brief Drops every node.  The blocks are kept for reuse, so this is O(1) when @p type is
+                    ///        trivially destructible.
+                    void reset();
+
+                    /// @brief Drops every node and returns the blocks to the allocator.
+                    void release();
+
+                    size_t size() const;
+
+                    bool empty() const;
+
+                    /// @brief Number of nodes the allocated blocks can hold.
+                    size_t capacity() const;
+
+                private:
+
+                    Node *_slot(NodeIndex node) const;
+
+                    void _checkIndex(NodeIndex node) const;
+
+                    NodeIndex _create(const type &datum);
+
+                    void _destroyNodes();
+
+                    std::vector<Node *> _blocks;
+                    size_t _size;
+            }; // CompactTree
+
+            template <typename type>
+            libdsa::structures::utilities::CompactTree<type>::CompactTree() : _size(0)
+            {
+                // Intentionally empty constructor
+            }
+
+            template <typename type>
+            libdsa::structures::utilities::CompactTree<type>::CompactTree(const TreeNode<type> *root) : _size(0)
+            {
+                if (root == nullptr)
+                {
+                    return;
+                }
+
+                try
+                {
+                    // Pairs of source node and the index it was copied to, walked depth first.
+                    std::vector<std::pair<const TreeNode<type> *, NodeIndex>> pending;
+                    pending.emplace_back(root, addRoot(root->_datum));
+
+                    while (!pending.empty())
+                    {
+                        auto [source, index] = pending.back();
+                        pending.pop_back();
+
+                        for (const TreeNode<type> *child : source->children)
+                        {
+                            pending.emplace_back(child, addChild(index, child->_datum));
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    // The destructor does not run for a constructor that throws.
+                    release();
+                    throw;
+                }
+            }
+
+            template <typename type>
+            libdsa::structures::utilities::CompactTree<type>::CompactTree(CompactTree &&other) noexcept
+                : _blocks(std::move(other._blocks)), _size(other._size)
+            {
+                other._blocks.clear();
+                other._size = 0;
+            }
+
+            template <typename type>
+            libdsa::structures::utilities::CompactTree<type> &
+            libdsa::structures::utilities::CompactTree<type>::operator=(CompactTree &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    release();
+                    _blocks = std::move(other._blocks);
+                    _size = other._size;
+                    other._blocks.clear();
+                    other._size = 0;
+                }
+
+                return *this;
+            }
+
+            template <typename type>
+            libdsa::structures::utilities::CompactTree<type>::~CompactTree()
+            {
+                release();
+            }
+
+            template <typename type>
+            typename libdsa::structures::utilities::CompactTree<type>::Node *
+            libdsa::structures::utilities::CompactTree<type>::_slot(NodeIndex node) const
+            {
+                return _blocks[node / BLOCK_SIZE] + node % BLOCK_SIZE;
+            }
+
+            template <typename type>
+            void libdsa::structures::utilities::CompactTree<type>::_checkIndex(NodeIndex node) const
+            {
+                if (node >= _size)
+                {
+                    throw std::out_of_range("CompactTree - Node index out of range.");
+                }
+            }
+
+            template <typename type>
+            libdsa::structures::utilities::NodeIndex
+            libdsa::structures::utilities::CompactTree<type>::_create(const type &datum)
+            {
+                if (_size == MAX_NODES)
+                {
+                    throw std::runtime_error("CompactTree - Node limit reached.");
+                }
+
+                if (_size == capacity())
+                {
+                    // Grow the block list first so the push_back cannot throw and strand the new block.
+                    if (_blocks.size() == _blocks.capacity())
+                    {
+                        _blocks.reserve(2 * _blocks.size() + 1);
+                    }
+
+                    _blocks.push_back(std::allocator<Node>().allocate(BLOCK_SIZE));
+                }
+
+                const NodeIndex index = static_cast<NodeIndex>(_size);
+                new (_slot(index)) Node(datum);
+                ++_size;
+
+                return index;
+            }
+
+            template <typename type>
+            void libdsa::structures::utilities::CompactTree<type>::_destroyNodes()
+            {
+                if constexpr (!std::is_trivially_destructible_v<type>)
+                {
+                    for (size_t index = 0; index < _size; ++index)
+                    {
+                        _slot(static_cast<NodeIndex>(index))->~Node();
+                    }
+                }
+
+                _size = 0;
+            }
+
+            template <typename type>
+            libdsa::structures::utilities::NodeIndex
+            libdsa::structures::utilities::CompactTree<type>::addRoot(const type &datum)
+            {
+                if (_size != 0)
+                {
+                    throw std::runtime_error("CompactTree - Tree already has a root.");
+                }
+
+                return _create(datum);
+            }
+
+            template <typename type>
+            libdsa::structures::utilities::NodeIndex
+            libdsa::structures::utilities::CompactTree<type>::addChild(NodeIndex parent, const type &datum)
+            {
+                _checkIndex(parent);
+
+                const NodeIndex child = _create(datum);
+                Node *parentNode = _slot(parent);
+
+                if (parentNode->_lastChild == NULL_INDEX)
+                {
+                    parentNode->_firstChild = child;
+                }
+                else
+                {
+                    _slot(parentNode->_lastChild)->_nextSibling = child;
+                }
+
+                parentNode->_lastChild = child;
+                return child;
+            }
+
+            template <typename type>
+            libdsa::structures::utilities::NodeIndex libdsa::structures::utilities::CompactTree<type>::root() const
+            {
+                return _size == 0 ? NULL_INDEX : 0;
+            }
+
+            template <typename type>
+            libdsa::structures::utilities::NodeIndex
+            libdsa::structures::utilities::CompactTree<type>::firstChild(NodeIndex node) const
+            {
+                _checkIndex(node);
+                return _slot(node)->_firstChild;
+            }
+
+            template <typename type>
+            libdsa::structures::utilities::NodeIndex
+            libdsa::structures::utilities::CompactTree<type>::nextSibling(NodeIndex node) const
+            {
+                _checkIndex(node);
+                return _slot(node)->_nextSibling;
+            }
+
+            template <typename type>
+            size_t libdsa::structures::utilities::CompactTree<type>::childCount(NodeIndex node) const
+            {
+                size_t count = 0;
+
+                for (NodeIndex child = firstChild(node); child != NULL_INDEX; child = _slot(child)->_nextSibling)
+                {
+                    ++count;
+                }
+
+                return count;
+            }
+
+            template <typename type>
+            type &libdsa::structures::utilities::CompactTree<type>::datum(NodeIndex node)
+            {
+                _checkIndex(node);
+                return _slot(node)->_datum;
+            }
+
+            template <typename type>
+            const type &libdsa::structures::utilities::CompactTree<type>::datum(NodeIndex node) const
+            {
+                _checkIndex(node);
+                return _slot(node)->_datum;
+            }
+
+            template <typename type>
+            const typename libdsa::structures::utilities::CompactTree<type>::Node &
+            libdsa::structures::utilities::CompactTree<type>::node(NodeIndex index) const
+            {
+                return *_slot(index);
+            }
+
+            template <typename type>
+            template <typename Function>
+            void libdsa::structures::utilities::CompactTree<type>::preOrder(Function function) const
+            {
+                if (_size == 0)
+                {
+                    return;
+                }
+
+                // Holds the next sibling to resume at after each subtree, so the stack is only as deep as the tree.
+                std::vector<NodeIndex> resume;
+                NodeIndex current = 0;
+
+                while (true)
+                {
+                    const Node *entry = _slot(current);
+                    function(entry->_datum);
+
+                    if (entry->_firstChild != NULL_INDEX)
+                    {
+                        if (entry->_nextSibling != NULL_INDEX)
+                        {
+                            resume.push_back(entry->_nextSibling);
+                        }
+
+                        current = entry->_firstChild;
+                    }
+                    else if (entry->_nextSibling != NULL_INDEX)
+                    {
+                        current = entry->_nextSibling;
+                    }
+                    else if (!resume.empty())
+                    {
+                        current = resume.back();
+                        resume.pop_back();
+                    }
+                    else
+                    {
+                        return;
+                    }
+                }
+            }
+
+            template <typename type>
+            void libdsa::structures::utilities::CompactTree<type>::reset()
+            {
+                _destroyNodes();
+            }
+
+            template <typename type>
+            void libdsa::structures::utilities::CompactTree<type>::release()
+            {
+                _destroyNodes();
+
+                for (Node *block : _blocks)
+                {
+                    std::allocator<Node>().deallocate(block, BLOCK_SIZE);
+                }
+
+                _blocks.clear();
+            }
+
+            template <typename type>
+            size_t libdsa::structures::utilities::CompactTree<type>::size() const
+            {
+                return _size;
+            }
+
+            template <typename type>
+            bool libdsa::structures::utilities::CompactTree<type>::empty() const
+            {
+                return _size == 0;
+            }
+
+            template <typename type>
+            size_t libdsa::structures::utilities::CompactTree<type>::capacity() const
+            {
+                return _blocks.size() * BLOCK_SIZE;
+            }
+        } // utilities
+    } // structures
+} // libdsa
+
+#endif // COMPACTTREE_H_
+
+/// @}
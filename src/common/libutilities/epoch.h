@@ -0,0 +1,371 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file epoch
+/// @{
+
+#ifndef EPOCH_H_
+#define EPOCH_H_
+
+/// @details A reader pins the current global epoch before touching shared nodes and unpins when done.  A writer that
+/// unlinks a node retires it instead of freeing it.  The node is stamped with the epoch in force at that moment.  The
+/// global epoch only advances once every pinned reader has seen the current value.  So once it has moved two past a
+/// node's stamp, no reader can still hold that node and it is freed.
+///
+/// Each reader thread owns one slot, padded to a cache line, and pinning is a plain store into it.  Readers never
+/// perform a read-modify-write and never write to a line another reader writes to.
+
+// From C++ STL
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// From libutilities
+#include <alignedallocator.h>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace utilities
+        {
+            class EpochManager
+            {
+                private:
+
+                    /// @brief Per thread announcement of the epoch it is reading in, or 0 when it is not reading.
+                    struct alignas(CACHE_LINE_SIZE) Slot
+                    {
+                        std::atomic<uint64_t> _epoch{0};
+                        std::atomic<bool> _claimed{false};
+                    };
+
+                    /// @brief Slot storage shared with the threads that hold a slot, so whichever of the manager and
+                    ///        a thread goes away last can still release the slot safely.
+                    struct SlotTable
+                    {
+                        explicit SlotTable(size_t capacity) : _slots(capacity), _highWater(0)
+                        {
+                            // Intentionally empty constructor.
+                        }
+
+                        std::vector<Slot, AlignedAllocator<Slot>> _slots;
+
+                        /// @brief One past the highest slot ever claimed, bounding the scan over slots.
+                        std::atomic<size_t> _highWater;
+                    };
+
+                    /// @brief A thread's slot in one manager along with how deeply it is pinned there.
+                    struct Registration
+                    {
+                        uint64_t _managerId;
+                        std::shared_ptr<SlotTable> _table;
+                        size_t _index;
+                        size_t _depth;
+                    };
+
+                    /// @brief Releases the slots of a thread when it exits.
+                    struct ThreadRegistrations
+                    {
+                        std::vector<Registration> _entries;
+
+                        ~ThreadRegistrations()
+                        {
+                            for (Registration &entry : _entries)
+                            {
+                                entry._table->_slots[entry._index]._claimed.store(false, std::memory_order_release);
+                            }
+                        }
+                    };
+
+                    struct Retired
+                    {
+                        void *_pointer;
+                        void (*_deleter)(void *);
+                        uint64_t _epoch;
+                    };
+
+                public:
+
+                    /// @brief Retired nodes accumulated before a writer tries to advance the epoch and free some.
+                    static constexpr size_t COLLECT_THRESHOLD = 64;
+
+                    /// @brief Keeps the calling thread pinned for as long as it is alive.
+                    class Guard
+                    {
+                        public:
+                            Guard(Guard &&other) noexcept : _manager(other._manager)
+                            {
+                                other._manager = nullptr;
+                            }
+
+                            Guard(const Guard &) = delete;
+                            Guard &operator=(const Guard &) = delete;
+                            Guard &operator=(Guard &&) = delete;
+
+                            ~Guard()
+                            {
+                                if (_manager != nullptr)
+                                {
+                                    _manager->_unpin();
+                                }
+                            }
+
+                        private:
+                            friend class EpochManager;
+
+                            explicit Guard(EpochManager *manager) : _manager(manager)
+                            {
+                                // Intentionally empty constructor.
+                            }
+
+                            EpochManager *_manager;
+                    }; // Guard
+
+                    /// @brief Constructor.
+                    ///
+                    /// @param maxThreads Number of distinct threads that may pin at the same time.
+                    explicit EpochManager(size_t maxThreads = 256);
+
+                    EpochManager(const EpochManager &) = delete;
+                    EpochManager &operator=(const EpochManager &) = delete;
+
+                    /// @brief Destructor.  Frees everything still retired; no thread may be pinned.
+                    ~EpochManager();
+
+                    /// @brief Pins the calling thread.  Pins nest, and the thread stays pinned until the outermost
+                    ///        guard is destroyed.
+                    Guard pin();
+
+                    /// @brief Hands @p pointer over to be deleted once no pinned reader can reach it.  The caller must
+                    ///        already have unlinked it from the shared structure.
+                    template <typename T>
+                    void retire(T *pointer);
+
+                    /// @brief Tries to advance the epoch and frees every retired node that is old enough.
+                    void collect();
+
+                    /// @brief Number of retired nodes not yet freed.
+                    size_t pending() const;
+
+                    /// @brief The current global epoch.
+                    uint64_t epoch() const;
+
+                private:
+
+                    /// @brief Finds or claims the calling thread's slot in this manager.
+                    Registration &_registration();
+
+                    void _unpin();
+
+                    /// @brief Advances past @p current if every reader has caught up, then frees the retired nodes
+                    ///        that are two or more epochs old.  Requires @c _mutex.
+                    void _free(uint64_t current);
+
+                    /// @brief Distinguishes managers in the thread local registrations even if an address is reused.
+                    static uint64_t _nextId();
+
+                    static ThreadRegistrations &_threadRegistrations();
+
+                    const uint64_t _id;
+
+                    std::shared_ptr<SlotTable> _table;
+
+                    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> _epoch;
+
+                    mutable std::mutex _mutex;
+
+                    std::vector<Retired> _retired;
+
+                    /// @brief Size of @c _retired at which the next retire collects.  It grows while readers hold the
+                    ///        epoch back so that retiring stays amortized constant time.
+                    size_t _collectAt;
+            }; // EpochManager
+
+            inline libdsa::structures::utilities::EpochManager::EpochManager(size_t maxThreads)
+                : _id(_nextId()), _table(std::make_shared<SlotTable>(maxThreads)), _epoch(1),
+                  _collectAt(COLLECT_THRESHOLD)
+            {
+                // Intentionally empty constructor.
+            }
+
+            inline libdsa::structures::utilities::EpochManager::~EpochManager()
+            {
+                for (Retired &retired : _retired)
+                {
+                    retired._deleter(retired._pointer);
+                }
+            }
+
+            inline uint64_t libdsa::structures::utilities::EpochManager::_nextId()
+            {
+                static std::atomic<uint64_t> next{0};
+                return next.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            inline libdsa::structures::utilities::EpochManager::ThreadRegistrations &
+            libdsa::structures::utilities::EpochManager::_threadRegistrations()
+            {
+                static thread_local ThreadRegistrations registrations;
+                return registrations;
+            }
+
+            inline libdsa::structures::utilities::EpochManager::Registration &
+            libdsa::structures::utilities::EpochManager::_registration()
+            {
+                std::vector<Registration> &entries = _threadRegistrations()._entries;
+
+                for (Registration &entry : entries)
+                {
+                    if (entry._managerId == _id)
+                    {
+                        return entry;
+                    }
+                }
+
+                // Registrations of managers that no longer exist hold the only reference to their table.
+                for (size_t i = 0; i < entries.size();)
+                {
+                    if (entries[i]._table.use_count() == 1)
+                    {
+                        entries[i] = std::move(entries.back());
+                        entries.pop_back();
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+
+                for (size_t i = 0; i < _table->_slots.size(); ++i)
+                {
+                    bool expected = false;
+
+                    if (!_table->_slots[i]._claimed.load(std::memory_order_relaxed) &&
+                        _table->_slots[i]._claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                    {
+                        size_t highWater = _table->_highWater.load(std::memory_order_relaxed);
+
+                        while (highWater < i + 1 &&
+                               !_table->_highWater.compare_exchange_weak(highWater, i + 1, std::memory_order_acq_rel))
+                        {
+                            // Retry with the refreshed value.
+                        }
+
+                        entries.push_back(Registration{_id, _table, i, 0});
+                        return entries.back();
+                    }
+                }
+
+                throw std::runtime_error("EpochManager - Too many threads pinned at once.");
+            }
+
+            inline libdsa::structures::utilities::EpochManager::Guard libdsa::structures::utilities::EpochManager::pin()
+            {
+                Registration &registration = _registration();
+
+                if (registration._depth++ == 0)
+                {
+                    // The announcement must be visible before any shared pointer is read, and a stale epoch only
+                    // makes reclamation more conservative.
+                    Slot &slot = _table->_slots[registration._index];
+                    slot._epoch.store(_epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                }
+
+                return Guard(this);
+            }
+
+            inline void libdsa::structures::utilities::EpochManager::_unpin()
+            {
+                Registration &registration = _registration();
+
+                if (--registration._depth == 0)
+                {
+                    _table->_slots[registration._index]._epoch.store(0, std::memory_order_release);
+                }
+            }
+
+            template <typename T>
+            void libdsa::structures::utilities::EpochManager::retire(T *pointer)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+
+                _retired.push_back(Retired{pointer, [](void *retired) { delete static_cast<T *>(retired); },
+                                           _epoch.load(std::memory_order_acquire)});
+
+                if (_retired.size() >= _collectAt)
+                {
+                    _free(_epoch.load(std::memory_order_acquire));
+                    _collectAt = std::max(COLLECT_THRESHOLD, 2 * _retired.size());
+                }
+            }
+
+            inline void libdsa::structures::utilities::EpochManager::collect()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _free(_epoch.load(std::memory_order_acquire));
+            }
+
+            inline void libdsa::structures::utilities::EpochManager::_free(uint64_t current)
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                // The epoch may only advance once every pinned reader has caught up with it.
+                bool advance = true;
+                const size_t highWater = _table->_highWater.load(std::memory_order_acquire);
+
+                for (size_t i = 0; i < highWater; ++i)
+                {
+                    const uint64_t observed = _table->_slots[i]._epoch.load(std::memory_order_acquire);
+
+                    if (observed != 0 && observed != current)
+                    {
+                        advance = false;
+                        break;
+                    }
+                }
+
+                if (advance)
+                {
+                    _epoch.store(++current, std::memory_order_release);
+                }
+
+                size_t kept = 0;
+
+                for (size_t i = 0; i < _retired.size(); ++i)
+                {
+                    if (_retired[i]._epoch + 2 <= current)
+                    {
+                        _retired[i]._deleter(_retired[i]._pointer);
+                    }
+                    else
+                    {
+                        _retired[kept++] = _retired[i];
+                    }
+                }
+
+                _retired.resize(kept);
+            }
+
+            inline size_t libdsa::structures::utilities::EpochManager::pending() const
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _retired.size();
+            }
+
+            inline uint64_t libdsa::structures::utilities::EpochManager::epoch() const
+            {
+                return _epoch.load(std::memory_order_acquire);
+            }
+        } // utilities
+    } // structures
+} // libdsa
+
+#endif // EPOCH_H_
+/// @}
@@ -0,0 +1,201 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file latencyhistogram
+/// @{
+
+#ifndef LATENCY_HISTOGRAM_H_
+#define LATENCY_HISTOGRAM_H_
+
+/// @details Records values, typically latencies in nanoseconds, into a fixed set of log-linear buckets in the manner
+/// of an HDR histogram, so a percentile can be read without keeping every sample.  Values below @c SUB_BUCKETS are
+/// counted exactly.  Above that, every power of two is split into @c SUB_BUCKETS / 2 equal buckets, which keeps the
+/// width of a bucket under 1% of the values it holds, whatever their magnitude.
+///
+/// Recording is a few shifts and an increment with no allocation, so one histogram per thread can be filled on a hot
+/// path and the histograms merged afterwards.  It is not synchronised.
+
+// From C++ STL
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace utilities
+        {
+            class LatencyHistogram
+            {
+                public:
+
+                    /// @brief Bits of precision kept for every value.
+                    static constexpr unsigned SUB_BUCKET_BITS = 8;
+
+                    /// @brief Values below this are counted exactly.
+                    static constexpr uint64_t SUB_BUCKETS = uint64_t(1) << SUB_BUCKET_BITS;
+
+                    /// @brief Buckets needed to cover every 64-bit value.
+                    static constexpr size_t BUCKET_COUNT =
+                        (64 - SUB_BUCKET_BITS + 1) * (SUB_BUCKETS / 2) + SUB_BUCKETS / 2;
+
+                    LatencyHistogram();
+
+                    /// @brief Counts one occurrence of @p value.
+                    void record(uint64_t value);
+
+                    /// @brief Adds every value counted by @p other.
+                    void merge(const LatencyHistogram &other);
+
+                    /// @brief Forgets every value.
+                    void reset();
+
+                    uint64_t count() const;
+
+                    /// @brief Gets the smallest value recorded, or 0 if there is none.
+                    uint64_t min() const;
+
+                    /// @brief Gets the largest value recorded, or 0 if there is none.
+                    uint64_t max() const;
+
+                    /// @brief Gets the exact mean of the values recorded, or 0 if there is none.
+                    double mean() const;
+
+                    /// @brief Gets the value at or below which @p percent of the values lie, from 0 to 100.  It is
+                    ///        the highest value of the bucket holding that rank, so it may overstate the exact value
+                    ///        by less than 1% but never understates it, and it is never above @c max().
+                    uint64_t percentile(double percent) const;
+
+                    /// @brief Gets the bucket @p value falls in.
+                    static size_t bucketFor(uint64_t value);
+
+                    /// @brief Gets the largest value that falls in @p bucket.
+                    static uint64_t highestIn(size_t bucket);
+
+                private:
+                    std::vector<uint64_t> _counts;
+                    uint64_t _count;
+                    uint64_t _min;
+                    uint64_t _max;
+
+                    /// @brief Sum of every value, kept in floating point since it may exceed 64 bits.
+                    double _sum;
+            }; // LatencyHistogram
+
+            inline libdsa::structures::utilities::LatencyHistogram::LatencyHistogram()
+                : _counts(BUCKET_COUNT, 0), _count(0), _min(std::numeric_limits<uint64_t>::max()), _max(0), _sum(0)
+            {
+                // Intentionally empty constructor.
+            }
+
+            inline void libdsa::structures::utilities::LatencyHistogram::record(uint64_t value)
+            {
+                ++_counts[bucketFor(value)];
+                ++_count;
+                _min = std::min(_min, value);
+                _max = std::max(_max, value);
+                _sum += static_cast<double>(value);
+            }
+
+            inline void libdsa::structures::utilities::LatencyHistogram::merge(const LatencyHistogram &other)
+            {
+                for (size_t i = 0; i < BUCKET_COUNT; ++i)
+                {
+                    _counts[i] += other._counts[i];
+                }
+
+                _count += other._count;
+                _min = std::min(_min, other._min);
+                _max = std::max(_max, other._max);
+                _sum += other._sum;
+            }
+
+            inline void libdsa::structures::utilities::LatencyHistogram::reset()
+            {
+                std::fill(_counts.begin(), _counts.end(), 0);
+                _count = 0;
+                _min = std::numeric_limits<uint64_t>::max();
+                _max = 0;
+                _sum = 0;
+            }
+
+            inline uint64_t libdsa::structures::utilities::LatencyHistogram::count() const
+            {
+                return _count;
+            }
+
+            inline uint64_t libdsa::structures::utilities::LatencyHistogram::min() const
+            {
+                return _count == 0 ? 0 : _min;
+            }
+
+            inline uint64_t libdsa::structures::utilities::LatencyHistogram::max() const
+            {
+                return _max;
+            }
+
+            inline double libdsa::structures::utilities::LatencyHistogram::mean() const
+            {
+                return _count == 0 ? 0 : _sum / static_cast<double>(_count);
+            }
+
+            inline uint64_t libdsa::structures::utilities::LatencyHistogram::percentile(double percent) const
+            {
+                if (_count == 0)
+                {
+                    return 0;
+                }
+
+                if (percent <= 0)
+                {
+                    return _min;
+                }
+
+                // The rank of the value asked for, counting from 1.
+                const double wanted = std::min(percent, 100.0) / 100.0 * static_cast<double>(_count);
+                const uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(wanted + 0.999999), 1);
+                uint64_t seen = 0;
+
+                for (size_t i = 0; i < BUCKET_COUNT; ++i)
+                {
+                    seen += _counts[i];
+
+                    if (seen >= rank)
+                    {
+                        return std::min(highestIn(i), _max);
+                    }
+                }
+
+                return _max;
+            }
+
+            inline size_t libdsa::structures::utilities::LatencyHistogram::bucketFor(uint64_t value)
+            {
+                if (value < SUB_BUCKETS)
+                {
+                    return static_cast<size_t>(value);
+                }
+
+                // Keep the leading one and the SUB_BUCKET_BITS - 1 bits after it; every shift adds a row.
+                const unsigned shift = 63 - static_cast<unsigned>(__builtin_clzll(value)) - (SUB_BUCKET_BITS - 1);
+                return static_cast<size_t>(shift * (SUB_BUCKETS / 2) + (value >> shift));
+            }
+
+            inline uint64_t libdsa::structures::utilities::LatencyHistogram::highestIn(size_t bucket)
+            {
+                if (bucket < SUB_BUCKETS)
+                {
+                    return bucket;
+                }
+
+                const unsigned shift = static_cast<unsigned>(bucket / (SUB_BUCKETS / 2)) - 1;
+                const uint64_t lowest = (bucket - shift * (SUB_BUCKETS / 2)) << shift;
+                return lowest + ((uint64_t(1) << shift) - 1);
+            }
+        } // utilities
+    } // structures
+} // libdsa
+
+#endif // LATENCY_HISTOGRAM_H_
+/// @}
@@ -41,6 +41,23 @@ namespace libdsa
                     // Intentionally empty constructor
                 }
             }; // TreeNode
+
+
+            template <typename type>
+            struct BinaryTreeNode
+            {
+                BinaryTreeNode *_left;
+                BinaryTreeNode *_right;
+                BinaryTreeNode *_parent;
+                int _height;
+                type _datum;
+
+                BinaryTreeNode(type datum)
+                    : _left(nullptr), _right(nullptr), _parent(nullptr), _height(1), _datum(datum)
+                {
+                    // Intentionally empty constructor
+                }
+            }; // BinaryTreeNode
         }
 
     } // structures
@@ -6,10 +6,20 @@
 #ifndef TREE_H_
 #define TREE_H_
 
+/// @details The @c BinaryTree is an ordered set kept balanced as an AVL tree: the heights of the two subtrees of every
+/// node differ by at most one, so insert, find and erase are O(log n) in the worst case.  Nodes keep a pointer to
+/// their parent so that in-order iteration and rebalancing after a change can walk back up without a stack.
+
 // From C++ STL
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <random>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 // From libutilities
@@ -21,12 +31,88 @@ namespace libdsa
     {
         namespace tree
         {
-            template <typename Type>
+            template <typename Type, typename Compare = std::less<Type>>
             class BinaryTree
             {
+                using Node = libdsa::structures::utilities::BinaryTreeNode<Type>;
 
                 public:
 
+                    /// @brief Bidirectional iterator visiting the elements in ascending order.
+                    class Iterator
+                    {
+                        public:
+                            using iterator_category = std::bidirectional_iterator_tag;
+                            using value_type = Type;
+                            using difference_type = std::ptrdiff_t;
+                            using pointer = const Type *;
+                            using reference = const Type &;
+
+                            Iterator() : _node(nullptr), _tree(nullptr)
+                            {
+                                // Intentionally empty constructor
+                            }
+
+                            reference operator*() const
+                            {
+                                return _node->_datum;
+                            }
+
+                            pointer operator->() const
+                            {
+                                return &_node->_datum;
+                            }
+
+                            Iterator &operator++()
+                            {
+                                _node = BinaryTree::_successor(_node);
+                                return *this;
+                            }
+
+                            Iterator operator++(int)
+                            {
+                                Iterator previous = *this;
+                                ++(*this);
+                                return previous;
+                            }
+
+                            Iterator &operator--()
+                            {
+                                // Stepping back from end() lands on the largest element.
+                                _node = _node == nullptr ? BinaryTree::_maximum(_tree->_head)
+                                                         : BinaryTree::_predecessor(_node);
+                                return *this;
+                            }
+
+                            Iterator operator--(int)
+                            {
+                                Iterator previous = *this;
+                                --(*this);
+                                return previous;
+                            }
+
+                            bool operator==(const Iterator &other) const
+                            {
+                                return _node == other._node;
+                            }
+
+                            bool operator!=(const Iterator &other) const
+                            {
+                                return _node != other._node;
+                            }
+
+                        private:
+                            friend class BinaryTree;
+
+                            Iterator(Node *node, const BinaryTree *tree) : _node(node), _tree(tree)
+                            {
+                                // Intentionally empty constructor
+                            }
+
+                            Node *_node;
+                            const BinaryTree *_tree;
+                    }; // Iterator
+
                     /// @brief Constructor for an empty Binary Tree.
                     BinaryTree();
 
@@ -47,11 +133,71 @@ namespace libdsa
                     template <typename Subtype>
                     BinaryTree(std::vector<Subtype> &container);
 
+                    /// @brief Copy constructor.  Duplicates the structure of @p other node for node.
+                    BinaryTree(const BinaryTree &other);
+
+                    /// @brief Move constructor.  Leaves @p other empty.
+                    BinaryTree(BinaryTree &&other) noexcept;
+
+                    BinaryTree &operator=(BinaryTree other) noexcept;
+
+                    /// @brief Destructor.  Frees every node.
+                    ~BinaryTree();
+
+                    /// @brief Adds an element if an equal element is not already present.
+                    ///
+                    /// @param datum The element to add.
+                    ///
+                    /// @return True if the element was added, false if it was already present.
+                    bool Insert(const Type &datum);
+
+                    /// @brief Removes an element.
+                    ///
+                    /// @param datum The element to remove.
+                    ///
+                    /// @return True if the element was found and removed.
+                    bool Erase(const Type &datum);
+
+                    /// @brief Looks up an element.
+                    ///
+                    /// @param datum The element to look for.
+                    ///
+                    /// @return An iterator to the element, or @c end() if it is not present.
+                    Iterator Find(const Type &datum) const;
+
+                    /// @brief Checks whether an element is present.
+                    bool Contains(const Type &datum) const;
+
+                    /// @brief Finds the first element that is not less than @p datum.
+                    ///
+                    /// @return An iterator to the element, or @c end() if every element is less.
+                    Iterator LowerBound(const Type &datum) const;
+
+                    /// @brief Finds the first element that is greater than @p datum.
+                    ///
+                    /// @return An iterator to the element, or @c end() if no element is greater.
+                    Iterator UpperBound(const Type &datum) const;
+
+                    /// @brief Removes every element.
+                    void Clear();
+
+                    /// @brief Checks whether the tree holds no elements.
+                    bool Empty() const;
+
+                    /// @brief Getter to get the height of the tree.  An empty tree has height 0.
+                    int Height() const;
+
                     /// @brief Getter to get the number of nodes within the tree.
                     ///
                     /// @return The number of nodes within the Binary Tree.
                     size_t Size();
-                
+
+                    /// @brief Iterator to the smallest element.
+                    Iterator begin() const;
+
+                    /// @brief Iterator past the largest element.
+                    Iterator end() const;
+
                 private:
 
                     /// @brief Checks that the type of the tree and the data instance are the same.
@@ -62,61 +208,116 @@ namespace libdsa
                     template <typename Subtype>
                     void _checkTypeCompatability(Subtype);
 
+                    static int _heightOf(const Node *node);
+
+                    static void _updateHeight(Node *node);
+
+                    static Node *_minimum(Node *node);
+
+                    static Node *_maximum(Node *node);
+
+                    static Node *_successor(Node *node);
+
+                    static Node *_predecessor(Node *node);
+
+                    /// @brief Makes @p replacement take the place of @p node under @p node's parent.
+                    void _replaceChild(Node *node, Node *replacement);
+
+                    Node *_rotateLeft(Node *node);
+
+                    Node *_rotateRight(Node *node);
+
+                    /// @brief Restores the height invariant from @p node up to the root.
+                    void _rebalance(Node *node);
+
+                    /// @brief Recursively frees a subtree.
+                    static void _destroy(Node *node);
+
+                    /// @brief Recursively copies a subtree.  If an element copy throws, the partial copy is freed.
+                    static Node *_copy(const Node *node, Node *parent);
+
                     /// @brief Top most node in the Binary Tree.
-                    libdsa::structures::utilities::TreeNode<Type> *_head;
+                    Node *_head;
 
                     /// @brief Number of nodes within the Binary Tree.
                     size_t _size;
+
+                    Compare _compare;
             }; // BinaryTree
 
-            template <typename Type>
-            libdsa::structures::tree::BinaryTree<Type>::BinaryTree() : _size(0)
+            template <typename Type, typename Compare>
+            libdsa::structures::tree::BinaryTree<Type, Compare>::BinaryTree() : _head(nullptr), _size(0)
             {
                 // Intentionally empty constructor
             }
 
-            template <typename Type>
+            template <typename Type, typename Compare>
             template <typename Subtype, std::size_t SIZE>
-            libdsa::structures::tree::BinaryTree<Type>::BinaryTree(std::array<Subtype, SIZE> &container) : _size(0)
+            libdsa::structures::tree::BinaryTree<Type, Compare>::BinaryTree(std::array<Subtype, SIZE> &container)
+                : _head(nullptr), _size(0)
             {
                 // Get the type of elements and verify they're the same as the type of the Binary Tree
                 using array_element_type = typename std::remove_reference<decltype(*std::begin(container))>::type;
-                array_element_type temp;
+                array_element_type temp{};
                 _checkTypeCompatability(temp);
 
                 for (size_t i = 0; i < container.size(); ++i)
                 {
-                    if (i == 0)
-                    {
-                        this->_head = new libdsa::structures::utilities::TreeNode<Type>(container[i]);
-                    }
-                    else
-                    {
-                        // Add a child in a random side
-                    }
+                    this->Insert(container[i]);
                 }
             }
 
-            template <typename Type>
+            template <typename Type, typename Compare>
             template <typename Subtype>
-            libdsa::structures::tree::BinaryTree<Type>::BinaryTree(std::vector<Subtype> &container) : _size(0)
+            libdsa::structures::tree::BinaryTree<Type, Compare>::BinaryTree(std::vector<Subtype> &container)
+                : _head(nullptr), _size(0)
             {
                 using vector_element_type = typename std::remove_reference<decltype(*std::begin(container))>::type;
-                vector_element_type temp;
+                vector_element_type temp{};
                 _checkTypeCompatability(temp);
 
                 for (size_t i = 0; i < container.size(); ++i)
                 {
-                    if (i == 0)
-                    {
-                        this->_head = new libdsa::structures::utilities::TreeNode<Type>(container[i]);
-                    }
+                    this->Insert(container[i]);
                 }
             }
 
-            template <typename Type>
+            template <typename Type, typename Compare>
+            libdsa::structures::tree::BinaryTree<Type, Compare>::BinaryTree(const BinaryTree &other)
+                : _head(nullptr), _size(0), _compare(other._compare)
+            {
+                // _copy frees whatever it built if an element copy throws, so nothing is left to clean up here.
+                _head = _copy(other._head, nullptr);
+                _size = other._size;
+            }
+
+            template <typename Type, typename Compare>
+            libdsa::structures::tree::BinaryTree<Type, Compare>::BinaryTree(BinaryTree &&other) noexcept
+                : _head(other._head), _size(other._size), _compare(std::move(other._compare))
+            {
+                other._head = nullptr;
+                other._size = 0;
+            }
+
+            template <typename Type, typename Compare>
+            libdsa::structures::tree::BinaryTree<Type, Compare> &
+            libdsa::structures::tree::BinaryTree<Type, Compare>::operator=(BinaryTree other) noexcept
+            {
+                std::swap(_head, other._head);
+                std::swap(_size, other._size);
+                std::swap(_compare, other._compare);
+                return *this;
+            }
+
+            template <typename Type, typename Compare>
+            libdsa::structures::tree::BinaryTree<Type, Compare>::~BinaryTree()
+            {
+                _destroy(_head);
+            }
+
+            template <typename Type, typename Compare>
             template <typename Subtype>
-            void libdsa::structures::tree::BinaryTree<Type>::_checkTypeCompatability(Subtype datum)
+            void libdsa::structures::tree::BinaryTree<Type, Compare>::_checkTypeCompatability(Subtype)
             {
                 if constexpr (!std::is_same_v<Type, Subtype>)
                 {
@@ -124,14 +325,420 @@ namespace libdsa
                 }
             }
 
-            template <typename Type>
-            size_t libdsa::structures::tree::BinaryTree<Type>::Size()
+            template <typename Type, typename Compare>
+            int libdsa::structures::tree::BinaryTree<Type, Compare>::_heightOf(const Node *node)
+            {
+                return node == nullptr ? 0 : node->_height;
+            }
+
+            template <typename Type, typename Compare>
+            void libdsa::structures::tree::BinaryTree<Type, Compare>::_updateHeight(Node *node)
+            {
+                node->_height = 1 + std::max(_heightOf(node->_left), _heightOf(node->_right));
+            }
+
+            template <typename Type, typename Compare>
+            typename libdsa::structures::tree::BinaryTree<Type, Compare>::Node *
+            libdsa::structures::tree::BinaryTree<Type, Compare>::_minimum(Node *node)
+            {
+                while (node != nullptr && node->_left != nullptr)
+                {
+                    node = node->_left;
+                }
+
+                return node;
+            }
+
+            template <typename Type, typename Compare>
+            typename libdsa::structures::tree::BinaryTree<Type, Compare>::Node *
+            libdsa::structures::tree::BinaryTree<Type, Compare>::_maximum(Node *node)
+            {
+                while (node != nullptr && node->_right != nullptr)
+                {
+                    node = node->_right;
+                }
+
+                return node;
+            }
+
+            template <typename Type, typename Compare>
+            typename libdsa::structures::tree::BinaryTree<Type, Compare>::Node *
+            libdsa::structures::tree::BinaryTree<Type, Compare>::_successor(Node *node)
+            {
+                if (node->_right != nullptr)
+                {
+                    return _minimum(node->_right);
+                }
+
+                // Climb until we arrive from a left subtree.
+                Node *parent = node->_parent;
+
+                while (parent != nullptr && node == parent->_right)
+                {
+                    node = parent;
+                    parent = parent->_parent;
+                }
+
+                return parent;
+            }
+
+            template <typename Type, typename Compare>
+            typename libdsa::structures::tree::BinaryTree<Type, Compare>::Node *
+            libdsa::structures::tree::BinaryTree<Type, Compare>::_predecessor(Node *node)
+            {
+                if (node->_left != nullptr)
+                {
+                    return _maximum(node->_left);
+                }
+
+                Node *parent = node->_parent;
+
+                while (parent != nullptr && node == parent->_left)
+                {
+                    node = parent;
+                    parent = parent->_parent;
+                }
+
+                return parent;
+            }
+
+            template <typename Type, typename Compare>
+            void libdsa::structures::tree::BinaryTree<Type, Compare>::_replaceChild(Node *node, Node *replacement)
+            {
+                if (node->_parent == nullptr)
+                {
+                    _head = replacement;
+                }
+                else if (node->_parent->_left == node)
+                {
+                    node->_parent->_left = replacement;
+                }
+                else
+                {
+                    node->_parent->_right = replacement;
+                }
+
+                if (replacement != nullptr)
+                {
+                    replacement->_parent = node->_parent;
+                }
+            }
+
+            template <typename Type, typename Compare>
+            typename libdsa::structures::tree::BinaryTree<Type, Compare>::Node *
+            libdsa::structures::tree::BinaryTree<Type, Compare>::_rotateLeft(Node *node)
+            {
+                Node *pivot = node->_right;
+
+                node->_right = pivot->_left;
+                if (pivot->_left != nullptr)
+                {
+                    pivot->_left->_parent = node;
+                }
+
+                _replaceChild(node, pivot);
+                pivot->_left = node;
+                node->_parent = pivot;
+
+                _updateHeight(node);
+                _updateHeight(pivot);
+                return pivot;
+            }
+
+            template <typename Type, typename Compare>
+            typename libdsa::structures::tree::BinaryTree<Type, Compare>::Node *
+            libdsa::structures::tree::BinaryTree<Type, Compare>::_rotateRight(Node *node)
+            {
+                Node *pivot = node->_left;
+
+                node->_left = pivot->_right;
+                if (pivot->_right != nullptr)
+                {
+                    pivot->_right->_parent = node;
+                }
+
+                _replaceChild(node, pivot);
+                pivot->_right = node;
+                node->_parent = pivot;
+
+                _updateHeight(node);
+                _updateHeight(pivot);
+                return pivot;
+            }
+
+            template <typename Type, typename Compare>
+            void libdsa::structures::tree::BinaryTree<Type, Compare>::_rebalance(Node *node)
+            {
+                while (node != nullptr)
+                {
+                    _updateHeight(node);
+                    const int balance = _heightOf(node->_left) - _heightOf(node->_right);
+
+                    if (balance > 1)
+                    {
+                        // Left-right case: straighten the left child first.
+                        if (_heightOf(node->_left->_left) < _heightOf(node->_left->_right))
+                        {
+                            _rotateLeft(node->_left);
+                        }
+
+                        node = _rotateRight(node);
+                    }
+                    else if (balance < -1)
+                    {
+                        // Right-left case: straighten the right child first.
+                        if (_heightOf(node->_right->_right) < _heightOf(node->_right->_left))
+                        {
+                            _rotateRight(node->_right);
+                        }
+
+                        node = _rotateLeft(node);
+                    }
+
+                    node = node->_parent;
+                }
+            }
+
+            template <typename Type, typename Compare>
+            bool libdsa::structures::tree::BinaryTree<Type, Compare>::Insert(const Type &datum)
+            {
+                Node *parent = nullptr;
+                Node *current = _head;
+
+                while (current != nullptr)
+                {
+                    parent = current;
+
+                    if (_compare(datum, current->_datum))
+                    {
+                        current = current->_left;
+                    }
+                    else if (_compare(current->_datum, datum))
+                    {
+                        current = current->_right;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
+
+                Node *node = new Node(datum);
+                node->_parent = parent;
+
+                if (parent == nullptr)
+                {
+                    _head = node;
+                }
+                else if (_compare(datum, parent->_datum))
+                {
+                    parent->_left = node;
+                }
+                else
+                {
+                    parent->_right = node;
+                }
+
+                ++_size;
+                _rebalance(parent);
+                return true;
+            }
+
+            template <typename Type, typename Compare>
+            bool libdsa::structures::tree::BinaryTree<Type, Compare>::Erase(const Type &datum)
+            {
+                Node *node = Find(datum)._node;
+
+                if (node == nullptr)
+                {
+                    return false;
+                }
+
+                // A node with two children trades places with its successor, which has no left child.
+                if (node->_left != nullptr && node->_right != nullptr)
+                {
+                    Node *successor = _minimum(node->_right);
+                    node->_datum = std::move(successor->_datum);
+                    node = successor;
+                }
+
+                Node *child = node->_left != nullptr ? node->_left : node->_right;
+                Node *parent = node->_parent;
+
+                _replaceChild(node, child);
+                delete node;
+
+                --_size;
+                _rebalance(parent);
+                return true;
+            }
+
+            template <typename Type, typename Compare>
+            typename libdsa::structures::tree::BinaryTree<Type, Compare>::Iterator
+            libdsa::structures::tree::BinaryTree<Type, Compare>::Find(const Type &datum) const
+            {
+                Iterator candidate = LowerBound(datum);
+
+                if (candidate._node != nullptr && !_compare(datum, candidate._node->_datum))
+                {
+                    return candidate;
+                }
+
+                return end();
+            }
+
+            template <typename Type, typename Compare>
+            bool libdsa::structures::tree::BinaryTree<Type, Compare>::Contains(const Type &datum) const
+            {
+                return Find(datum) != end();
+            }
+
+            template <typename Type, typename Compare>
+            typename libdsa::structures::tree::BinaryTree<Type, Compare>::Iterator
+            libdsa::structures::tree::BinaryTree<Type, Compare>::LowerBound(const Type &datum) const
+            {
+                Node *current = _head;
+                Node *result = nullptr;
+
+                while (current != nullptr)
+                {
+                    if (_compare(current->_datum, datum))
+                    {
+                        current = current->_right;
+                    }
+                    else
+                    {
+                        result = current;
+                        current = current->_left;
+                    }
+                }
+
+                return Iterator(result, this);
+            }
+
+            template <typename Type, typename Compare>
+            typename libdsa::structures::tree::BinaryTree<Type, Compare>::Iterator
+            libdsa::structures::tree::BinaryTree<Type, Compare>::UpperBound(const Type &datum) const
+            {
+                Node *current = _head;
+                Node *result = nullptr;
+
+                while (current != nullptr)
+                {
+                    if (_compare(datum, current->_datum))
+                    {
+                        result = current;
+                        current = current->_left;
+                    }
+                    else
+                    {
+                        current = current->_right;
+                    }
+                }
+
+                return Iterator(result, this);
+            }
+
+            template <typename Type, typename Compare>
+            void libdsa::structures::tree::BinaryTree<Type, Compare>::_destroy(Node *node)
+            {
+                // Iterative post-order so degenerate inputs cannot overflow the stack.
+                while (node != nullptr)
+                {
+                    if (node->_left != nullptr)
+                    {
+                        node = node->_left;
+                    }
+                    else if (node->_right != nullptr)
+                    {
+                        node = node->_right;
+                    }
+                    else
+                    {
+                        Node *parent = node->_parent;
+
+                        if (parent != nullptr)
+                        {
+                            (parent->_left == node ? parent->_left : parent->_right) = nullptr;
+                        }
+
+                        delete node;
+                        node = parent;
+                    }
+                }
+            }
+
+            template <typename Type, typename Compare>
+            typename libdsa::structures::tree::BinaryTree<Type, Compare>::Node *
+            libdsa::structures::tree::BinaryTree<Type, Compare>::_copy(const Node *node, Node *parent)
+            {
+                if (node == nullptr)
+                {
+                    return nullptr;
+                }
+
+                // Recursion depth is bounded by the AVL height.
+                Node *copy = new Node(node->_datum);
+                copy->_height = node->_height;
+
+                try
+                {
+                    copy->_left = _copy(node->_left, copy);
+                    copy->_right = _copy(node->_right, copy);
+                }
+                catch (...)
+                {
+                    // The copy is not linked to its parent yet, so _destroy stops at it.
+                    _destroy(copy);
+                    throw;
+                }
+
+                copy->_parent = parent;
+                return copy;
+            }
+
+            template <typename Type, typename Compare>
+            void libdsa::structures::tree::BinaryTree<Type, Compare>::Clear()
+            {
+                _destroy(_head);
+                _head = nullptr;
+                _size = 0;
+            }
+
+            template <typename Type, typename Compare>
+            bool libdsa::structures::tree::BinaryTree<Type, Compare>::Empty() const
+            {
+                return _size == 0;
+            }
+
+            template <typename Type, typename Compare>
+            int libdsa::structures::tree::BinaryTree<Type, Compare>::Height() const
+            {
+                return _heightOf(_head);
+            }
+
+            template <typename Type, typename Compare>
+            size_t libdsa::structures::tree::BinaryTree<Type, Compare>::Size()
             {
                 return this->_size;
             }
+
+            template <typename Type, typename Compare>
+            typename libdsa::structures::tree::BinaryTree<Type, Compare>::Iterator
+            libdsa::structures::tree::BinaryTree<Type, Compare>::begin() const
+            {
+                return Iterator(_minimum(_head), this);
+            }
+
+            template <typename Type, typename Compare>
+            typename libdsa::structures::tree::BinaryTree<Type, Compare>::Iterator
+            libdsa::structures::tree::BinaryTree<Type, Compare>::end() const
+            {
+                return Iterator(nullptr, this);
+            }
         } // tree
     } // structures
 } // libdsa
 
 #endif // TREE_H_
-/// @}
\ No newline at end of file
+/// @}
@@ -0,0 +1,689 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file concurrentmap
+/// @{
+
+#ifndef CONCURRENTMAP_H_
+#define CONCURRENTMAP_H_
+
+/// @details The @c ConcurrentMap is an AVL balanced ordered map for many readers and few writers.  Published nodes are
+/// never modified.  A writer copies the nodes on the path it changes, rebalances the copies and publishes the new
+/// root with a single release store.  Every reader that loads a root therefore sees one complete version of the tree,
+/// and it walks that version with plain loads while holding neither a lock nor a shared counter.
+///
+/// Writers are serialized by a mutex.  The nodes a writer replaced are handed to an @c EpochManager and are only
+/// freed after every reader that might still be walking the old version has unpinned.  A writer that throws, say
+/// from copying a key or value, frees the copies it made and leaves the published version untouched.
+
+// From C++ STL
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// From libutilities
+#include <epoch.h>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace tree
+        {
+            template <typename Key, typename Value, typename Compare = std::less<Key>>
+            class ConcurrentMap
+            {
+                private:
+
+                    struct Node
+                    {
+                        Key _key;
+                        Value _value;
+                        Node *_left;
+                        Node *_right;
+                        int _height;
+
+                        /// @brief Write operation that created the node.  Nodes of the running operation are not yet
+                        ///        visible to readers and may be changed in place.
+                        uint64_t _version;
+                    };
+
+                    /// @brief Undoes a write operation that throws before publishing: frees the nodes it created and
+                    ///        forgets the nodes it would have replaced, which are still part of the live tree.
+                    class WriteGuard
+                    {
+                        public:
+
+                            explicit WriteGuard(ConcurrentMap &map);
+
+                            WriteGuard(const WriteGuard &) = delete;
+                            WriteGuard &operator=(const WriteGuard &) = delete;
+
+                            ~WriteGuard();
+
+                            /// @brief Keeps the operation's nodes once it has been published.
+                            void dismiss();
+
+                        private:
+
+                            ConcurrentMap &_map;
+
+                            bool _dismissed;
+                    };
+
+                public:
+
+                    /// @brief Constructor for an empty map.
+                    ConcurrentMap();
+
+                    ConcurrentMap(const ConcurrentMap &) = delete;
+                    ConcurrentMap &operator=(const ConcurrentMap &) = delete;
+
+                    /// @brief Destructor.  No other thread may be using the map.
+                    ~ConcurrentMap();
+
+                    /// @brief Adds an element if its key is not already present.
+                    ///
+                    /// @return True if the element was added, false if the key was already present.
+                    bool Insert(const Key &key, const Value &value);
+
+                    /// @brief Adds an element or replaces the value of an existing key.
+                    ///
+                    /// @return True if the key was new.
+                    bool InsertOrAssign(const Key &key, const Value &value);
+
+                    /// @brief Removes an element.
+                    ///
+                    /// @return True if the key was found and removed.
+                    bool Erase(const Key &key);
+
+                    /// @brief Looks up a key without blocking.
+                    ///
+                    /// @param key The key to look for.
+                    /// @param value Receives a copy of the value when the key is present.
+                    ///
+                    /// @return True if the key was found.
+                    bool Find(const Key &key, Value &value) const;
+
+                    /// @brief Checks whether a key is present without blocking.
+                    bool Contains(const Key &key) const;
+
+                    /// @brief Calls @p function with every element in [@p low, @p high) in ascending order.  Every
+                    ///        element comes from the same version of the map, however many writes run meanwhile.
+                    ///
+                    /// @tparam Function Callable as function(const Key &, const Value &).
+                    ///
+                    /// @return The number of elements visited.
+                    template <typename Function>
+                    size_t RangeScan(const Key &low, const Key &high, Function function) const;
+
+                    /// @brief Calls @p function with every element of one version of the map in ascending order.
+                    template <typename Function>
+                    void ForEach(Function function) const;
+
+                    /// @brief Getter to get the number of elements.  It may be stale by the time it is used.
+                    size_t Size() const;
+
+                    /// @brief Checks whether the map holds no elements.
+                    bool Empty() const;
+
+                    /// @brief Getter to get the height of the current version.  An empty map has height 0.
+                    int Height() const;
+
+                private:
+
+                    static int _heightOf(const Node *node);
+
+                    static void _updateHeight(Node *node);
+
+                    Node *_create(const Key &key, const Value &value);
+
+                    /// @brief Returns a node of the running operation holding the contents of @p node, copying it and
+                    ///        recording the original for retirement if it is already published.
+                    Node *_own(Node *node);
+
+                    Node *_rotateLeft(Node *node);
+
+                    Node *_rotateRight(Node *node);
+
+                    /// @brief Restores the height invariant at an owned node and returns the subtree's new root.
+                    Node *_balance(Node *node);
+
+                    Node *_insert(Node *node, const Key &key, const Value &value, bool assign, bool &inserted);
+
+                    Node *_erase(Node *node, const Key &key, bool &erased);
+
+                    /// @brief Unlinks the smallest node of a subtree, returning the subtree's new root.
+                    Node *_eraseMinimum(Node *node, Node *&minimum);
+
+                    /// @brief Publishes @p root and retires every node the running operation replaced.
+                    void _publish(Node *root);
+
+                    template <typename Function>
+                    static size_t _scan(const Node *node, const Key &low, const Key &high, Function &function,
+                                        const Compare &compare);
+
+                    template <typename Function>
+                    static void _visit(const Node *node, Function &function);
+
+                    static void _destroy(Node *node);
+
+                    mutable libdsa::structures::utilities::EpochManager _epochs;
+
+                    std::atomic<Node *> _root;
+
+                    std::atomic<size_t> _size;
+
+                    /// @brief Serializes writers.  Readers never take it.
+                    std::mutex _writer;
+
+                    /// @brief Identifies the running write operation.  Only touched under @c _writer.
+                    uint64_t _version;
+
+                    /// @brief Published nodes replaced by the running write operation.
+                    std::vector<Node *> _replaced;
+
+                    /// @brief Nodes the running write operation allocated and has not published yet.
+                    std::vector<Node *> _created;
+
+                    Compare _compare;
+            }; // ConcurrentMap
+
+            template <typename Key, typename Value, typename Compare>
+            libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::ConcurrentMap()
+                : _root(nullptr), _size(0), _version(0)
+            {
+                // Intentionally empty constructor
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::~ConcurrentMap()
+            {
+                _destroy(_root.load(std::memory_order_relaxed));
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::WriteGuard::WriteGuard(ConcurrentMap &map)
+                : _map(map), _dismissed(false)
+            {
+                // Intentionally empty constructor
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::WriteGuard::~WriteGuard()
+            {
+                if (!_dismissed)
+                {
+                    for (Node *node : _map._created)
+                    {
+                        delete node;
+                    }
+                }
+
+                _map._created.clear();
+                _map._replaced.clear();
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            void libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::WriteGuard::dismiss()
+            {
+                _dismissed = true;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            int libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::_heightOf(const Node *node)
+            {
+                return node == nullptr ? 0 : node->_height;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            void libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::_updateHeight(Node *node)
+            {
+                node->_height = 1 + std::max(_heightOf(node->_left), _heightOf(node->_right));
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Node *
+            libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::_create(const Key &key, const Value &value)
+            {
+                // Recorded before allocating, so a failed push_back cannot leak the node.
+                _created.push_back(nullptr);
+                _created.back() = new Node{key, value, nullptr, nullptr, 1, _version};
+                return _created.back();
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Node *
+            libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::_own(Node *node)
+            {
+                if (node->_version == _version)
+                {
+                    return node;
+                }
+
+                _created.push_back(nullptr);
+                Node *copy = new Node(*node);
+                _created.back() = copy;
+                copy->_version = _version;
+                _replaced.push_back(node);
+                return copy;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Node *
+            libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::_rotateLeft(Node *node)
+            {
+                Node *pivot = _own(node->_right);
+
+                node->_right = pivot->_left;
+                pivot->_left = node;
+
+                _updateHeight(node);
+                _updateHeight(pivot);
+                return pivot;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Node *
+            libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::_rotateRight(Node *node)
+            {
+                Node *pivot = _own(node->_left);
+
+                node->_left = pivot->_right;
+                pivot->_right = node;
+
+                _updateHeight(node);
+                _updateHeight(pivot);
+                return pivot;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Node *
+            libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::_balance(Node *node)
+            {
+                _updateHeight(node);
+                const int balance = _heightOf(node->_left) - _heightOf(node->_right);
+
+                if (balance > 1)
+                {
+                    if (_heightOf(node->_left->_left) < _heightOf(node->_left->_right))
+                    {
+                        node->_left = _rotateLeft(_own(node->_left));
+                    }
+
+                    return _rotateRight(node);
+                }
+
+                if (balance < -1)
+                {
+                    if (_heightOf(node->_right->_right) < _heightOf(node->_right->_left))
+                    {
+                        node->_right = _rotateRight(_own(node->_right));
+                    }
+
+                    return _rotateLeft(node);
+                }
+
+                return node;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Node *
+            libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::_insert(Node *node, const Key &key,
+                                                                                  const Value &value, bool assign,
+                                                                                  bool &inserted)
+            {
+                if (node == nullptr)
+                {
+                    inserted = true;
+                    return _create(key, value);
+                }
+
+                if (_compare(key, node->_key))
+                {
+                    Node *left = _insert(node->_left, key, value, assign, inserted);
+
+                    if (left == node->_left)
+                    {
+                        return node;
+                    }
+
+                    Node *copy = _own(node);
+                    copy->_left = left;
+                    return _balance(copy);
+                }
+
+                if (_compare(node->_key, key))
+                {
+                    Node *right = _insert(node->_right, key, value, assign, inserted);
+
+                    if (right == node->_right)
+                    {
+                        return node;
+                    }
+
+                    Node *copy = _own(node);
+                    copy->_right = right;
+                    return _balance(copy);
+                }
+
+                if (!assign)
+                {
+                    return node;
+                }
+
+                Node *copy = _own(node);
+                copy->_value = value;
+                return copy;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Node *
+            libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::_eraseMinimum(Node *node, Node *&minimum)
+            {
+                if (node->_left == nullptr)
+                {
+                    minimum = node;
+                    return node->_right;
+                }
+
+                Node *copy = _own(node);
+                copy->_left = _eraseMinimum(copy->_left, minimum);
+                return _balance(copy);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Node *
+            libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::_erase(Node *node, const Key &key, bool &erased)
+            {
+                if (node == nullptr)
+                {
+                    return nullptr;
+                }
+
+                if (_compare(key, node->_key))
+                {
+                    Node *left = _erase(node->_left, key, erased);
+
+                    if (!erased)
+                    {
+                        return node;
+                    }
+
+                    Node *copy = _own(node);
+                    copy->_left = left;
+                    return _balance(copy);
+                }
+
+                if (_compare(node->_key, key))
+                {
+                    Node *right = _erase(node->_right, key, erased);
+
+                    if (!erased)
+                    {
+                        return node;
+                    }
+
+                    Node *copy = _own(node);
+                    copy->_right = right;
+                    return _balance(copy);
+                }
+
+                erased = true;
+                _replaced.push_back(node);
+
+                if (node->_left == nullptr)
+                {
+                    return node->_right;
+                }
+
+                if (node->_right == nullptr)
+                {
+                    return node->_left;
+                }
+
+                // Replace the node with its in-order successor, which takes over both subtrees.
+                Node *minimum = nullptr;
+                Node *right = _eraseMinimum(node->_right, minimum);
+
+                Node *successor = _own(minimum);
+                successor->_left = node->_left;
+                successor->_right = right;
+                return _balance(successor);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            void libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::_publish(Node *root)
+            {
+                _root.store(root, std::memory_order_release);
+
+                // The new nodes are live from here on, whatever happens while retiring the old ones.
+                _created.clear();
+
+                for (Node *node : _replaced)
+                {
+                    _epochs.retire(node);
+                }
+
+                _replaced.clear();
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            bool libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Insert(const Key &key, const Value &value)
+            {
+                std::lock_guard<std::mutex> lock(_writer);
+                WriteGuard guard(*this);
+                ++_version;
+
+                bool inserted = false;
+                Node *root = _root.load(std::memory_order_relaxed);
+                Node *updated = _insert(root, key, value, false, inserted);
+
+                if (updated != root)
+                {
+                    _publish(updated);
+                    guard.dismiss();
+                    _size.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                return inserted;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            bool libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::InsertOrAssign(const Key &key,
+                                                                                              const Value &value)
+            {
+                std::lock_guard<std::mutex> lock(_writer);
+                WriteGuard guard(*this);
+                ++_version;
+
+                bool inserted = false;
+                _publish(_insert(_root.load(std::memory_order_relaxed), key, value, true, inserted));
+                guard.dismiss();
+
+                if (inserted)
+                {
+                    _size.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                return inserted;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            bool libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Erase(const Key &key)
+            {
+                std::lock_guard<std::mutex> lock(_writer);
+                WriteGuard guard(*this);
+                ++_version;
+
+                bool erased = false;
+                Node *updated = _erase(_root.load(std::memory_order_relaxed), key, erased);
+
+                if (erased)
+                {
+                    _publish(updated);
+                    guard.dismiss();
+                    _size.fetch_sub(1, std::memory_order_relaxed);
+                }
+
+                return erased;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            bool libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Find(const Key &key, Value &value) const
+            {
+                auto guard = _epochs.pin();
+                const Node *node = _root.load(std::memory_order_acquire);
+
+                while (node != nullptr)
+                {
+                    if (_compare(key, node->_key))
+                    {
+                        node = node->_left;
+                    }
+                    else if (_compare(node->_key, key))
+                    {
+                        node = node->_right;
+                    }
+                    else
+                    {
+                        value = node->_value;
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            bool libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Contains(const Key &key) const
+            {
+                auto guard = _epochs.pin();
+                const Node *node = _root.load(std::memory_order_acquire);
+
+                while (node != nullptr)
+                {
+                    if (_compare(key, node->_key))
+                    {
+                        node = node->_left;
+                    }
+                    else if (_compare(node->_key, key))
+                    {
+                        node = node->_right;
+                    }
+                    else
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            template <typename Function>
+            size_t libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::_scan(const Node *node, const Key &low,
+                                                                                       const Key &high,
+                                                                                       Function &function,
+                                                                                       const Compare &compare)
+            {
+                if (node == nullptr)
+                {
+                    return 0;
+                }
+
+                size_t visited = 0;
+                const bool aboveLow = !compare(node->_key, low);
+                const bool belowHigh = compare(node->_key, high);
+
+                if (aboveLow)
+                {
+                    visited += _scan(node->_left, low, high, function, compare);
+                }
+
+                if (aboveLow && belowHigh)
+                {
+                    function(node->_key, node->_value);
+                    ++visited;
+                }
+
+                if (belowHigh)
+                {
+                    visited += _scan(node->_right, low, high, function, compare);
+                }
+
+                return visited;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            template <typename Function>
+            size_t libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::RangeScan(const Key &low, const Key &high,
+                                                                                           Function function) const
+            {
+                auto guard = _epochs.pin();
+                return _scan(_root.load(std::memory_order_acquire), low, high, function, _compare);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            template <typename Function>
+            void libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::_visit(const Node *node, Function &function)
+            {
+                if (node == nullptr)
+                {
+                    return;
+                }
+
+                _visit(node->_left, function);
+                function(node->_key, node->_value);
+                _visit(node->_right, function);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            template <typename Function>
+            void libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::ForEach(Function function) const
+            {
+                auto guard = _epochs.pin();
+                _visit(_root.load(std::memory_order_acquire), function);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            size_t libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Size() const
+            {
+                return _size.load(std::memory_order_relaxed);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            bool libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Empty() const
+            {
+                return Size() == 0;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            int libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::Height() const
+            {
+                auto guard = _epochs.pin();
+                return _heightOf(_root.load(std::memory_order_acquire));
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            void libdsa::structures::tree::ConcurrentMap<Key, Value, Compare>::_destroy(Node *node)
+            {
+                if (node == nullptr)
+                {
+                    return;
+                }
+
+                _destroy(node->_left);
+                _destroy(node->_right);
+                delete node;
+            }
+        } // tree
+    } // structures
+} // libdsa
+
+#endif // CONCURRENTMAP_H_
+/// @}
@@ -0,0 +1,286 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file eytzingertree
+/// @{
+
+#ifndef EYTZINGERTREE_H_
+#define EYTZINGERTREE_H_
+
+/// @details The @c EytzingerTree is an immutable search tree stored in one contiguous array in breadth first
+/// (Eytzinger) order: the root is at index 1 and the children of index k are at 2k and 2k + 1.  A search only ever
+/// moves to a computed index, so the loop has no unpredictable branch, and the descendants a few levels below the
+/// current node are adjacent in memory, so one prefetch per step brings them in long before they are needed.
+///
+/// @c FindMany runs a group of searches in lockstep, one level at a time, so the cache misses of independent
+/// searches overlap instead of being paid one after another.
+
+// From C++ STL
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// From libutilities
+#include <alignedallocator.h>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace tree
+        {
+            template <typename Type, typename Compare = std::less<Type>>
+            class EytzingerTree
+            {
+                public:
+
+                    /// @brief Number of searches interleaved by @c FindMany.
+                    static constexpr size_t BATCH_SIZE = 8;
+
+                    /// @brief Constructor for an empty tree.
+                    EytzingerTree();
+
+                    /// @brief Constructor from an std::array container.  The elements need not be sorted.
+                    ///
+                    /// @tparam Subtype The data type of the array.
+                    /// @tparam SIZE The size of the array
+                    ///
+                    /// @param container The container we want to build from defined by the template parameters.
+                    template <typename Subtype, std::size_t SIZE>
+                    EytzingerTree(std::array<Subtype, SIZE> &container);
+
+                    /// @brief Constructor from an std::vector container.  The elements need not be sorted.
+                    ///
+                    /// @tparam Subtype The internal data type of the vector.
+                    ///
+                    /// @param container The container we want to build from defined by the template parameters.
+                    template <typename Subtype>
+                    EytzingerTree(std::vector<Subtype> &container);
+
+                    /// @brief Finds the smallest element that is not less than @p key.
+                    ///
+                    /// @return A pointer to the element, or @c nullptr if every element is less than @p key.
+                    const Type *LowerBound(const Type &key) const;
+
+                    /// @brief Checks whether an element equal to @p key is present.
+                    bool Contains(const Type &key) const;
+
+                    /// @brief Runs @c LowerBound for many keys, interleaving groups of searches to hide memory latency.
+                    ///
+                    /// @param keys Pointer to the first key.
+                    /// @param count Number of keys.
+                    /// @param results Receives one @c LowerBound result per key.
+                    void FindMany(const Type *keys, size_t count, const Type **results) const;
+
+                    /// @brief Runs @c LowerBound for every key of a vector.
+                    ///
+                    /// @return One @c LowerBound result per key.
+                    std::vector<const Type *> FindMany(const std::vector<Type> &keys) const;
+
+                    /// @brief Getter to get the number of elements within the tree.
+                    size_t Size() const;
+
+                private:
+
+                    /// @brief Checks that the type of the tree and the data instance are the same.
+                    template <typename Subtype>
+                    void _checkTypeCompatability(Subtype);
+
+                    /// @brief Sorts @p sorted and lays it out in breadth first order.
+                    void _build(std::vector<Type> sorted);
+
+                    /// @brief Copies the sorted elements into the subtree rooted at @p index in in-order sequence.
+                    void _fill(const std::vector<Type> &sorted, size_t &next, size_t index);
+
+                    /// @brief Maps the final position of a search that ran off the bottom of the tree to its answer.
+                    size_t _resolve(size_t index) const;
+
+                    /// @brief Hints the cache to load the descendants of @p index a few levels down.
+                    void _prefetch(size_t index) const;
+
+                    /// @brief Multiplier from a node to its leftmost descendant whose whole generation fits in one cache line.
+                    static constexpr size_t PREFETCH_STRIDE = std::max<size_t>(
+                        1, libdsa::structures::utilities::CACHE_LINE_SIZE / sizeof(Type));
+
+                    /// @brief Elements in breadth first order, 1-indexed.  Slot 0 is unused.
+                    std::vector<Type, libdsa::structures::utilities::AlignedAllocator<Type>> _nodes;
+
+                    /// @brief Number of elements.
+                    size_t _size;
+
+                    Compare _compare;
+            }; // EytzingerTree
+
+            template <typename Type, typename Compare>
+            libdsa::structures::tree::EytzingerTree<Type, Compare>::EytzingerTree() : _nodes(1), _size(0)
+            {
+                // Intentionally empty constructor
+            }
+
+            template <typename Type, typename Compare>
+            template <typename Subtype, std::size_t SIZE>
+            libdsa::structures::tree::EytzingerTree<Type, Compare>::EytzingerTree(std::array<Subtype, SIZE> &container)
+                : _size(0)
+            {
+                using array_element_type = typename std::remove_reference<decltype(*std::begin(container))>::type;
+                array_element_type temp{};
+                _checkTypeCompatability(temp);
+
+                _build(std::vector<Type>(container.begin(), container.end()));
+            }
+
+            template <typename Type, typename Compare>
+            template <typename Subtype>
+            libdsa::structures::tree::EytzingerTree<Type, Compare>::EytzingerTree(std::vector<Subtype> &container)
+                : _size(0)
+            {
+                using vector_element_type = typename std::remove_reference<decltype(*std::begin(container))>::type;
+                vector_element_type temp{};
+                _checkTypeCompatability(temp);
+
+                _build(std::vector<Type>(container.begin(), container.end()));
+            }
+
+            template <typename Type, typename Compare>
+            template <typename Subtype>
+            void libdsa::structures::tree::EytzingerTree<Type, Compare>::_checkTypeCompatability(Subtype)
+            {
+                if constexpr (!std::is_same_v<Type, Subtype>)
+                {
+                    throw std::runtime_error("EytzingerTree - Invalid type passed into tree.");
+                }
+            }
+
+            template <typename Type, typename Compare>
+            void libdsa::structures::tree::EytzingerTree<Type, Compare>::_build(std::vector<Type> sorted)
+            {
+                std::sort(sorted.begin(), sorted.end(), _compare);
+
+                _size = sorted.size();
+                _nodes.assign(_size + 1, Type{});
+
+                size_t next = 0;
+                _fill(sorted, next, 1);
+            }
+
+            template <typename Type, typename Compare>
+            void libdsa::structures::tree::EytzingerTree<Type, Compare>::_fill(const std::vector<Type> &sorted,
+                                                                             size_t &next, size_t index)
+            {
+                // An in-order walk of the implicit tree visits the slots in sorted order.  The recursion is only as
+                // deep as the tree, so it is bounded by log2 of the size.
+                if (index > _size)
+                {
+                    return;
+                }
+
+                _fill(sorted, next, 2 * index);
+                _nodes[index] = sorted[next++];
+                _fill(sorted, next, 2 * index + 1);
+            }
+
+            template <typename Type, typename Compare>
+            size_t libdsa::structures::tree::EytzingerTree<Type, Compare>::_resolve(size_t index) const
+            {
+                // The path went right every time the node was less than the key and left otherwise.  The answer is
+                // the last node where it went left: strip the trailing right turns (ones) plus that left turn.
+                return index >> (__builtin_ctzll(~static_cast<unsigned long long>(index)) + 1);
+            }
+
+            template <typename Type, typename Compare>
+            void libdsa::structures::tree::EytzingerTree<Type, Compare>::_prefetch(size_t index) const
+            {
+                // The address is only a hint, so compute it without forming an out of range pointer.
+                const uintptr_t base = reinterpret_cast<uintptr_t>(_nodes.data());
+                __builtin_prefetch(reinterpret_cast<const void *>(base + index * PREFETCH_STRIDE * sizeof(Type)));
+            }
+
+            template <typename Type, typename Compare>
+            const Type *libdsa::structures::tree::EytzingerTree<Type, Compare>::LowerBound(const Type &key) const
+            {
+                size_t index = 1;
+
+                while (index <= _size)
+                {
+                    _prefetch(index);
+                    index = 2 * index + static_cast<size_t>(_compare(_nodes[index], key));
+                }
+
+                index = _resolve(index);
+                return index == 0 ? nullptr : &_nodes[index];
+            }
+
+            template <typename Type, typename Compare>
+            bool libdsa::structures::tree::EytzingerTree<Type, Compare>::Contains(const Type &key) const
+            {
+                const Type *candidate = LowerBound(key);
+                return candidate != nullptr && !_compare(key, *candidate);
+            }
+
+            template <typename Type, typename Compare>
+            void libdsa::structures::tree::EytzingerTree<Type, Compare>::FindMany(const Type *keys, size_t count,
+                                                                                const Type **results) const
+            {
+                size_t indices[BATCH_SIZE];
+
+                for (size_t start = 0; start < count; start += BATCH_SIZE)
+                {
+                    const size_t batch = std::min(BATCH_SIZE, count - start);
+
+                    for (size_t lane = 0; lane < batch; ++lane)
+                    {
+                        indices[lane] = 1;
+                    }
+
+                    // Every search has the same depth give or take one level, so advance them all together.
+                    bool active = _size > 0;
+
+                    while (active)
+                    {
+                        active = false;
+
+                        for (size_t lane = 0; lane < batch; ++lane)
+                        {
+                            const size_t index = indices[lane];
+
+                            if (index <= _size)
+                            {
+                                _prefetch(index);
+                                indices[lane] = 2 * index + static_cast<size_t>(_compare(_nodes[index], keys[start + lane]));
+                                active = true;
+                            }
+                        }
+                    }
+
+                    for (size_t lane = 0; lane < batch; ++lane)
+                    {
+                        const size_t index = _resolve(indices[lane]);
+                        results[start + lane] = index == 0 ? nullptr : &_nodes[index];
+                    }
+                }
+            }
+
+            template <typename Type, typename Compare>
+            std::vector<const Type *> libdsa::structures::tree::EytzingerTree<Type, Compare>::FindMany(
+                const std::vector<Type> &keys) const
+            {
+                std::vector<const Type *> results(keys.size());
+                FindMany(keys.data(), keys.size(), results.data());
+                return results;
+            }
+
+            template <typename Type, typename Compare>
+            size_t libdsa::structures::tree::EytzingerTree<Type, Compare>::Size() const
+            {
+                return _size;
+            }
+        } // tree
+    } // structures
+} // libdsa
+
+#endif // EYTZINGERTREE_H_
+/// @}
@@ -0,0 +1,416 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file persistentmap
+/// @{
+
+#ifndef PERSISTENTMAP_H_
+#define PERSISTENTMAP_H_
+
+/// @details The @c PersistentMap is an immutable AVL balanced ordered map.  An update never changes a node.  It
+/// builds new copies of the O(log n) nodes on the path to the key and returns a new version whose other subtrees are
+/// shared with the old one.  Copying a map is therefore an O(1) snapshot, and a version holds only the nodes it does
+/// not share with others.
+///
+/// Nodes are reference counted with atomic counters, so versions that share nodes may be read, copied and destroyed
+/// from different threads.  A single @c PersistentMap object is an ordinary value and must not be assigned while
+/// another thread reads it.
+
+// From C++ STL
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace tree
+        {
+            template <typename Key, typename Value, typename Compare = std::less<Key>>
+            class PersistentMap
+            {
+                private:
+
+                    struct Node;
+
+                    /// @brief Owning reference to a shared node.  The node is freed with its last reference.
+                    class NodeReference
+                    {
+                        public:
+                            NodeReference() : _node(nullptr)
+                            {
+                                // Intentionally empty constructor
+                            }
+
+                            /// @brief Adopts a freshly allocated node, whose count starts at one.
+                            explicit NodeReference(Node *node) : _node(node)
+                            {
+                                // Intentionally empty constructor
+                            }
+
+                            NodeReference(const NodeReference &other) : _node(other._node)
+                            {
+                                if (_node != nullptr)
+                                {
+                                    _node->_references.fetch_add(1, std::memory_order_relaxed);
+                                }
+                            }
+
+                            NodeReference(NodeReference &&other) noexcept : _node(other._node)
+                            {
+                                other._node = nullptr;
+                            }
+
+                            NodeReference &operator=(NodeReference other) noexcept
+                            {
+                                std::swap(_node, other._node);
+                                return *this;
+                            }
+
+                            ~NodeReference()
+                            {
+                                // The last owner must observe every write made through the other owners.
+                                if (_node != nullptr && _node->_references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                                {
+                                    delete _node;
+                                }
+                            }
+
+                            const Node *operator->() const
+                            {
+                                return _node;
+                            }
+
+                            const Node *get() const
+                            {
+                                return _node;
+                            }
+
+                            explicit operator bool() const
+                            {
+                                return _node != nullptr;
+                            }
+
+                        private:
+                            Node *_node;
+                    }; // NodeReference
+
+                    struct Node
+                    {
+                        std::atomic<size_t> _references;
+                        Key _key;
+                        Value _value;
+                        NodeReference _left;
+                        NodeReference _right;
+                        int _height;
+
+                        Node(const Key &key, const Value &value, NodeReference left, NodeReference right)
+                            : _references(1), _key(key), _value(value), _left(std::move(left)), _right(std::move(right)),
+                              _height(1 + std::max(_heightOf(_left), _heightOf(_right)))
+                        {
+                            // Intentionally empty constructor
+                        }
+                    };
+
+                public:
+
+                    /// @brief Constructor for an empty map.
+                    PersistentMap();
+
+                    /// @brief Returns a version in which @p key maps to @p value, whether or not it was present.
+                    [[nodiscard]] PersistentMap Set(const Key &key, const Value &value) const;
+
+                    /// @brief Returns a version without @p key.  If the key is absent the result shares everything.
+                    [[nodiscard]] PersistentMap Erase(const Key &key) const;
+
+                    /// @brief Looks up a key.
+                    ///
+                    /// @return A pointer to the value that stays valid as long as this version, or @c nullptr.
+                    const Value *Find(const Key &key) const;
+
+                    /// @brief Checks whether a key is present.
+                    bool Contains(const Key &key) const;
+
+                    /// @brief Calls @p function with every element in ascending key order.
+                    ///
+                    /// @tparam Function Callable as function(const Key &, const Value &).
+                    template <typename Function>
+                    void ForEach(Function function) const;
+
+                    /// @brief Checks whether the map holds no elements.
+                    bool Empty() const;
+
+                    /// @brief Getter to get the height of the tree.  An empty map has height 0.
+                    int Height() const;
+
+                    /// @brief Getter to get the number of elements within the map.
+                    size_t Size() const;
+
+                private:
+
+                    PersistentMap(NodeReference root, size_t size, const Compare &compare);
+
+                    static int _heightOf(const NodeReference &node);
+
+                    static NodeReference _make(const Key &key, const Value &value, NodeReference left, NodeReference right);
+
+                    /// @brief Builds a node over @p left and @p right, rotating if their heights differ by two.
+                    static NodeReference _balance(const Key &key, const Value &value, NodeReference left,
+                                                  NodeReference right);
+
+                    NodeReference _set(const NodeReference &node, const Key &key, const Value &value, bool &inserted) const;
+
+                    NodeReference _erase(const NodeReference &node, const Key &key, bool &erased) const;
+
+                    static NodeReference _eraseMinimum(const NodeReference &node);
+
+                    template <typename Function>
+                    static void _visit(const Node *node, Function &function);
+
+                    NodeReference _root;
+
+                    size_t _size;
+
+                    Compare _compare;
+            }; // PersistentMap
+
+            template <typename Key, typename Value, typename Compare>
+            libdsa::structures::tree::PersistentMap<Key, Value, Compare>::PersistentMap() : _size(0)
+            {
+                // Intentionally empty constructor
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            libdsa::structures::tree::PersistentMap<Key, Value, Compare>::PersistentMap(NodeReference root, size_t size,
+                                                                                     const Compare &compare)
+                : _root(std::move(root)), _size(size), _compare(compare)
+            {
+                // Intentionally empty constructor
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            int libdsa::structures::tree::PersistentMap<Key, Value, Compare>::_heightOf(const NodeReference &node)
+            {
+                return node ? node->_height : 0;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::PersistentMap<Key, Value, Compare>::NodeReference
+            libdsa::structures::tree::PersistentMap<Key, Value, Compare>::_make(const Key &key, const Value &value,
+                                                                              NodeReference left, NodeReference right)
+            {
+                return NodeReference(new Node(key, value, std::move(left), std::move(right)));
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::PersistentMap<Key, Value, Compare>::NodeReference
+            libdsa::structures::tree::PersistentMap<Key, Value, Compare>::_balance(const Key &key, const Value &value,
+                                                                                 NodeReference left, NodeReference right)
+            {
+                // Rotations build new nodes around the shared grandchildren instead of relinking existing nodes.
+                if (_heightOf(left) > _heightOf(right) + 1)
+                {
+                    if (_heightOf(left->_left) >= _heightOf(left->_right))
+                    {
+                        return _make(left->_key, left->_value, left->_left,
+                                     _make(key, value, left->_right, std::move(right)));
+                    }
+
+                    const Node *middle = left->_right.get();
+
+                    return _make(middle->_key, middle->_value, _make(left->_key, left->_value, left->_left, middle->_left),
+                                 _make(key, value, middle->_right, std::move(right)));
+                }
+
+                if (_heightOf(right) > _heightOf(left) + 1)
+                {
+                    if (_heightOf(right->_right) >= _heightOf(right->_left))
+                    {
+                        return _make(right->_key, right->_value, _make(key, value, std::move(left), right->_left),
+                                     right->_right);
+                    }
+
+                    const Node *middle = right->_left.get();
+
+                    return _make(middle->_key, middle->_value, _make(key, value, std::move(left), middle->_left),
+                                 _make(right->_key, right->_value, middle->_right, right->_right));
+                }
+
+                return _make(key, value, std::move(left), std::move(right));
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::PersistentMap<Key, Value, Compare>::NodeReference
+            libdsa::structures::tree::PersistentMap<Key, Value, Compare>::_set(const NodeReference &node, const Key &key,
+                                                                             const Value &value, bool &inserted) const
+            {
+                if (!node)
+                {
+                    inserted = true;
+                    return _make(key, value, NodeReference(), NodeReference());
+                }
+
+                if (_compare(key, node->_key))
+                {
+                    return _balance(node->_key, node->_value, _set(node->_left, key, value, inserted), node->_right);
+                }
+
+                if (_compare(node->_key, key))
+                {
+                    return _balance(node->_key, node->_value, node->_left, _set(node->_right, key, value, inserted));
+                }
+
+                return _make(key, value, node->_left, node->_right);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::PersistentMap<Key, Value, Compare>::NodeReference
+            libdsa::structures::tree::PersistentMap<Key, Value, Compare>::_eraseMinimum(const NodeReference &node)
+            {
+                if (!node->_left)
+                {
+                    return node->_right;
+                }
+
+                return _balance(node->_key, node->_value, _eraseMinimum(node->_left), node->_right);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::PersistentMap<Key, Value, Compare>::NodeReference
+            libdsa::structures::tree::PersistentMap<Key, Value, Compare>::_erase(const NodeReference &node, const Key &key,
+                                                                               bool &erased) const
+            {
+                if (!node)
+                {
+                    return node;
+                }
+
+                if (_compare(key, node->_key))
+                {
+                    NodeReference left = _erase(node->_left, key, erased);
+                    return erased ? _balance(node->_key, node->_value, std::move(left), node->_right) : node;
+                }
+
+                if (_compare(node->_key, key))
+                {
+                    NodeReference right = _erase(node->_right, key, erased);
+                    return erased ? _balance(node->_key, node->_value, node->_left, std::move(right)) : node;
+                }
+
+                erased = true;
+
+                if (!node->_left)
+                {
+                    return node->_right;
+                }
+
+                if (!node->_right)
+                {
+                    return node->_left;
+                }
+
+                // The in-order successor takes the removed node's place.
+                const Node *successor = node->_right.get();
+
+                while (successor->_left)
+                {
+                    successor = successor->_left.get();
+                }
+
+                return _balance(successor->_key, successor->_value, node->_left, _eraseMinimum(node->_right));
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            libdsa::structures::tree::PersistentMap<Key, Value, Compare>
+            libdsa::structures::tree::PersistentMap<Key, Value, Compare>::Set(const Key &key, const Value &value) const
+            {
+                bool inserted = false;
+                NodeReference root = _set(_root, key, value, inserted);
+                return PersistentMap(std::move(root), inserted ? _size + 1 : _size, _compare);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            libdsa::structures::tree::PersistentMap<Key, Value, Compare>
+            libdsa::structures::tree::PersistentMap<Key, Value, Compare>::Erase(const Key &key) const
+            {
+                bool erased = false;
+                NodeReference root = _erase(_root, key, erased);
+                return PersistentMap(std::move(root), erased ? _size - 1 : _size, _compare);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            const Value *libdsa::structures::tree::PersistentMap<Key, Value, Compare>::Find(const Key &key) const
+            {
+                const Node *node = _root.get();
+
+                while (node != nullptr)
+                {
+                    if (_compare(key, node->_key))
+                    {
+                        node = node->_left.get();
+                    }
+                    else if (_compare(node->_key, key))
+                    {
+                        node = node->_right.get();
+                    }
+                    else
+                    {
+                        return &node->_value;
+                    }
+                }
+
+                return nullptr;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            bool libdsa::structures::tree::PersistentMap<Key, Value, Compare>::Contains(const Key &key) const
+            {
+                return Find(key) != nullptr;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            template <typename Function>
+            void libdsa::structures::tree::PersistentMap<Key, Value, Compare>::_visit(const Node *node, Function &function)
+            {
+                if (node == nullptr)
+                {
+                    return;
+                }
+
+                _visit(node->_left.get(), function);
+                function(node->_key, node->_value);
+                _visit(node->_right.get(), function);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            template <typename Function>
+            void libdsa::structures::tree::PersistentMap<Key, Value, Compare>::ForEach(Function function) const
+            {
+                _visit(_root.get(), function);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            bool libdsa::structures::tree::PersistentMap<Key, Value, Compare>::Empty() const
+            {
+                return _size == 0;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            int libdsa::structures::tree::PersistentMap<Key, Value, Compare>::Height() const
+            {
+                return _heightOf(_root);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            size_t libdsa::structures::tree::PersistentMap<Key, Value, Compare>::Size() const
+            {
+                return _size;
+            }
+        } // tree
+    } // structures
+} // libdsa
+
+#endif // PERSISTENTMAP_H_
+/// @}
@@ -0,0 +1,120 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file bitops
+/// @brief Word level bit manipulation primitives shared by the word-packed bit array structures.
+/// @{
+
+#ifndef BITOPS_H_
+#define BITOPS_H_
+
+// From C++ STL
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace bits
+        {
+            /// @brief Number of bits held by one storage word.
+            constexpr std::size_t WORD_BITS = 64;
+
+            /// @brief Number of words required to hold @p bitCount bits.
+            inline constexpr std::size_t wordsFor(std::size_t bitCount)
+            {
+                return (bitCount + WORD_BITS - 1) / WORD_BITS;
+            }
+
+            /// @brief Number of set bits within @p word.  Compiles down to a single @c POPCNT instruction when
+            ///        the consumer's target supports it, for instance with @c -march=native or @c -mpopcnt.
+            inline unsigned popcount(uint64_t word)
+            {
+                return static_cast<unsigned>(__builtin_popcountll(word));
+            }
+
+            /// @brief Index of the lowest set bit of @p word.
+            /// @note @p word must not be zero.
+            inline unsigned countTrailingZeros(uint64_t word)
+            {
+                return static_cast<unsigned>(__builtin_ctzll(word));
+            }
+
+            /// @brief Index of the highest set bit of @p word.
+            /// @note @p word must not be zero.
+            inline unsigned highestSetBit(uint64_t word)
+            {
+                return 63U - static_cast<unsigned>(__builtin_clzll(word));
+            }
+
+            /// @brief Mask with the lowest @p count bits set.  Valid for @p count in [0, 64].
+            inline constexpr uint64_t lowMask(std::size_t count)
+            {
+                return count >= WORD_BITS ? ~uint64_t(0) : ((uint64_t(1) << count) - 1);
+            }
+
+            /// @brief Position of the @p rank-th (zero based) set bit within @p word.
+            /// @note @p rank must be less than @c popcount(word).
+            inline unsigned selectInWord(uint64_t word, unsigned rank)
+            {
+#if defined(__BMI2__)
+                return countTrailingZeros(_pdep_u64(uint64_t(1) << rank, word));
+#else
+                // Skip whole bytes first so the per-bit loop below runs at most eight times.
+                unsigned base = 0;
+                unsigned inByte = popcount(word & 0xFF);
+
+                while (rank >= inByte)
+                {
+                    rank -= inByte;
+                    word >>= 8;
+                    base += 8;
+                    inByte = popcount(word & 0xFF);
+                }
+
+                for (unsigned i = 0; i < rank; ++i)
+                {
+                    word &= word - 1;
+                }
+
+                return base + countTrailingZeros(word);
+#endif
+            }
+
+            /// @brief Logical operations the compressed and mapped bit arrays apply between two operands.
+            enum class Operation : uint8_t
+            {
+                AND,
+                OR,
+                XOR,
+                DIFFERENCE,
+            };
+
+            /// @brief Applies @p operation to a pair of words.
+            inline uint64_t applyWord(Operation operation, uint64_t left, uint64_t right)
+            {
+                switch (operation)
+                {
+                    case Operation::AND:
+                        return left & right;
+                    case Operation::OR:
+                        return left | right;
+                    case Operation::XOR:
+                        return left ^ right;
+                    case Operation::DIFFERENCE:
+                        return left & ~right;
+                }
+
+                return 0;
+            }
+        } // bits
+    } // structures
+} // libdsa
+
+#endif // BITOPS_H_
+
+/// @}
@@ -0,0 +1,449 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file bitvector
+/// @brief Contains declaration and definition of a word-packed bit array.
+/// @{
+
+#ifndef BITVECTOR_H_
+#define BITVECTOR_H_
+
+/// @details Unlike @c std::vector<bool>, the @c BitVector exposes its underlying 64-bit words so that whole-array
+/// operations (counting, logical operations, rank/select indexing) run a word at a time instead of a bit at a time.
+/// Storage is cache line aligned and any bits past @c size() in the final word are always kept clear.
+
+// From C++ STL
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+// From libutilities
+#include <alignedallocator.h>
+
+// From libbitarray
+#include <bitops.h>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        class BitVector
+        {
+        public:
+            /// @brief Underlying word storage.
+            using WordStorage = std::vector<uint64_t, libdsa::structures::utilities::AlignedAllocator<uint64_t>>;
+
+            /// @brief Constructor for an empty bit array.
+            BitVector();
+
+            /// @brief Constructor
+            /// @param size Number of bits held by the array.
+            /// @param value Initial value of every bit.
+            explicit BitVector(size_t size, bool value = false);
+
+            /// @brief Constructor that packs an existing @c std::vector<bool>.
+            /// @param source The bits to copy.
+            explicit BitVector(const std::vector<bool> &source);
+
+            /// @brief Gets the number of bits held by the array.
+            /// @return The number of bits.
+            size_t size() const;
+
+            /// @brief Gets the number of 64-bit words backing the array.
+            /// @return The number of words.
+            size_t wordCount() const;
+
+            /// @brief Read-only access to the underlying words.
+            const uint64_t *words() const;
+
+            /// @brief Mutable access to the underlying words.
+            /// @note Callers must keep bits past @c size() in the final word clear.
+            uint64_t *words();
+
+            /// @brief Reads a single bit.
+            /// @param index Position of the bit.
+            /// @return Whether the bit is set.
+            bool test(size_t index) const;
+
+            /// @brief Sets a single bit to one.
+            /// @param index Position of the bit.
+            void set(size_t index);
+
+            /// @brief Sets a single bit to zero.
+            /// @param index Position of the bit.
+            void reset(size_t index);
+
+            /// @brief Sets a single bit to the given value.
+            /// @param index Position of the bit.
+            /// @param value The new value of the bit.
+            void assign(size_t index, bool value);
+
+            /// @brief Inverts a single bit.
+            /// @param index Position of the bit.
+            void flip(size_t index);
+
+            /// @brief Counts every set bit using a hardware population count per word.
+            /// @return The number of set bits.
+            size_t count() const;
+
+            /// @brief Finds the lowest set bit.
+            /// @return The position of the lowest set bit, or @c size() if no bit is set.
+            size_t findFirst() const;
+
+            /// @brief Finds the lowest set bit strictly after @p position.
+            /// @param position The position to search after.  Any position at or past @c size() finds nothing.
+            /// @return The position of the next set bit, or @c size() if there is none.
+            size_t findNext(size_t position) const;
+
+            /// @brief Calls @p function with the position of every set bit in ascending order.  Zero words are
+            ///        skipped whole, so the cost scales with the number of set bits rather than @c size().
+            /// @tparam Function Callable taking a @c size_t position.
+            template <typename Function>
+            void forEachSetBit(Function function) const;
+
+            /// @brief Forward iterator over the positions of the set bits.
+            class SetBitIterator
+            {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = size_t;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const size_t *;
+                using reference = size_t;
+
+                SetBitIterator(const BitVector *bitVector, size_t position);
+
+                size_t operator*() const;
+
+                SetBitIterator &operator++();
+
+                SetBitIterator operator++(int);
+
+                bool operator==(const SetBitIterator &other) const;
+
+                bool operator!=(const SetBitIterator &other) const;
+
+            private:
+                const BitVector *_bitVector;
+                size_t _position;
+            }; // SetBitIterator
+
+            /// @brief Range over the positions of the set bits, usable in a range based for loop.
+            struct SetBitRange
+            {
+                SetBitIterator first;
+                SetBitIterator last;
+
+                SetBitIterator begin() const
+                {
+                    return first;
+                }
+
+                SetBitIterator end() const
+                {
+                    return last;
+                }
+            }; // SetBitRange
+
+            /// @brief Gets a range over the positions of the set bits.
+            SetBitRange setBits() const;
+
+            /// @brief Changes the number of bits held by the array.  New bits are cleared.
+            /// @param size The new number of bits.
+            void resize(size_t size);
+
+            /// @brief Unpacks the array into a @c std::vector<bool>.
+            /// @return A vector containing the same bits.
+            std::vector<bool> toVector() const;
+
+            /// @brief Word-wise logical AND with another bit array of the same size.
+            BitVector &operator&=(const BitVector &other);
+
+            /// @brief Word-wise logical OR with another bit array of the same size.
+            BitVector &operator|=(const BitVector &other);
+
+            /// @brief Word-wise logical XOR with another bit array of the same size.
+            BitVector &operator^=(const BitVector &other);
+
+            bool operator==(const BitVector &other) const;
+
+            bool operator!=(const BitVector &other) const;
+
+        private:
+            /// @brief Throws if @p other does not hold the same number of bits.
+            void _checkSize(const BitVector &other) const;
+
+            /// @brief Clears any bits past @c _size in the final word.
+            void _clearTail();
+
+            /// @brief Packed bits, least significant bit first.
+            WordStorage _words;
+
+            /// @brief Number of bits held by the array.
+            size_t _size;
+        }; // BitVector
+
+        inline libdsa::structures::BitVector::BitVector() : _size(0)
+        {
+            // Intentionally empty constructor.
+        }
+
+        inline libdsa::structures::BitVector::BitVector(size_t size, bool value)
+            : _words(bits::wordsFor(size), value ? ~uint64_t(0) : uint64_t(0)), _size(size)
+        {
+            _clearTail();
+        }
+
+        inline libdsa::structures::BitVector::BitVector(const std::vector<bool> &source)
+            : _words(bits::wordsFor(source.size()), 0), _size(source.size())
+        {
+            for (size_t i = 0; i < source.size(); ++i)
+            {
+                if (source[i])
+                {
+                    set(i);
+                }
+            }
+        }
+
+        inline size_t libdsa::structures::BitVector::size() const
+        {
+            return _size;
+        }
+
+        inline size_t libdsa::structures::BitVector::wordCount() const
+        {
+            return _words.size();
+        }
+
+        inline const uint64_t *libdsa::structures::BitVector::words() const
+        {
+            return _words.data();
+        }
+
+        inline uint64_t *libdsa::structures::BitVector::words()
+        {
+            return _words.data();
+        }
+
+        inline bool libdsa::structures::BitVector::test(size_t index) const
+        {
+            return (_words[index / bits::WORD_BITS] >> (index % bits::WORD_BITS)) & 1U;
+        }
+
+        inline void libdsa::structures::BitVector::set(size_t index)
+        {
+            _words[index / bits::WORD_BITS] |= uint64_t(1) << (index % bits::WORD_BITS);
+        }
+
+        inline void libdsa::structures::BitVector::reset(size_t index)
+        {
+            _words[index / bits::WORD_BITS] &= ~(uint64_t(1) << (index % bits::WORD_BITS));
+        }
+
+        inline void libdsa::structures::BitVector::assign(size_t index, bool value)
+        {
+            if (value)
+            {
+                set(index);
+            }
+            else
+            {
+                reset(index);
+            }
+        }
+
+        inline void libdsa::structures::BitVector::flip(size_t index)
+        {
+            _words[index / bits::WORD_BITS] ^= uint64_t(1) << (index % bits::WORD_BITS);
+        }
+
+        inline size_t libdsa::structures::BitVector::count() const
+        {
+            size_t total = 0;
+
+            for (uint64_t word : _words)
+            {
+                total += bits::popcount(word);
+            }
+
+            return total;
+        }
+
+        inline size_t libdsa::structures::BitVector::findFirst() const
+        {
+            for (size_t word = 0; word < _words.size(); ++word)
+            {
+                if (_words[word] != 0)
+                {
+                    return word * bits::WORD_BITS + bits::countTrailingZeros(_words[word]);
+                }
+            }
+
+            return _size;
+        }
+
+        inline size_t libdsa::structures::BitVector::findNext(size_t position) const
+        {
+            // Checked before stepping past it, so a position of SIZE_MAX cannot wrap around to 0.
+            if (position >= _size || ++position == _size)
+            {
+                return _size;
+            }
+
+            size_t word = position / bits::WORD_BITS;
+
+            // Discard the bits before the starting position in the first word.
+            uint64_t remaining = _words[word] & ~bits::lowMask(position % bits::WORD_BITS);
+
+            while (remaining == 0)
+            {
+                if (++word == _words.size())
+                {
+                    return _size;
+                }
+
+                remaining = _words[word];
+            }
+
+            return word * bits::WORD_BITS + bits::countTrailingZeros(remaining);
+        }
+
+        template <typename Function>
+        void libdsa::structures::BitVector::forEachSetBit(Function function) const
+        {
+            for (size_t word = 0; word < _words.size(); ++word)
+            {
+                // Clear the lowest set bit on every step so each iteration yields exactly one position.
+                for (uint64_t remaining = _words[word]; remaining != 0; remaining &= remaining - 1)
+                {
+                    function(word * bits::WORD_BITS + bits::countTrailingZeros(remaining));
+                }
+            }
+        }
+
+        inline libdsa::structures::BitVector::SetBitIterator::SetBitIterator(const BitVector *bitVector, size_t position)
+            : _bitVector(bitVector), _position(position)
+        {
+            // Intentionally empty constructor.
+        }
+
+        inline size_t libdsa::structures::BitVector::SetBitIterator::operator*() const
+        {
+            return _position;
+        }
+
+        inline libdsa::structures::BitVector::SetBitIterator &libdsa::structures::BitVector::SetBitIterator::operator++()
+        {
+            _position = _bitVector->findNext(_position);
+            return *this;
+        }
+
+        inline libdsa::structures::BitVector::SetBitIterator libdsa::structures::BitVector::SetBitIterator::operator++(int)
+        {
+            SetBitIterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        inline bool libdsa::structures::BitVector::SetBitIterator::operator==(const SetBitIterator &other) const
+        {
+            return _bitVector == other._bitVector && _position == other._position;
+        }
+
+        inline bool libdsa::structures::BitVector::SetBitIterator::operator!=(const SetBitIterator &other) const
+        {
+            return !(*this == other);
+        }
+
+        inline libdsa::structures::BitVector::SetBitRange libdsa::structures::BitVector::setBits() const
+        {
+            return {SetBitIterator(this, findFirst()), SetBitIterator(this, _size)};
+        }
+
+        inline void libdsa::structures::BitVector::resize(size_t size)
+        {
+            _words.resize(bits::wordsFor(size), 0);
+            _size = size;
+            _clearTail();
+        }
+
+        inline std::vector<bool> libdsa::structures::BitVector::toVector() const
+        {
+            std::vector<bool> result(_size);
+
+            for (size_t i = 0; i < _size; ++i)
+            {
+                result[i] = test(i);
+            }
+
+            return result;
+        }
+
+        inline libdsa::structures::BitVector &libdsa::structures::BitVector::operator&=(const BitVector &other)
+        {
+            _checkSize(other);
+
+            for (size_t i = 0; i < _words.size(); ++i)
+            {
+                _words[i] &= other._words[i];
+            }
+
+            return *this;
+        }
+
+        inline libdsa::structures::BitVector &libdsa::structures::BitVector::operator|=(const BitVector &other)
+        {
+            _checkSize(other);
+
+            for (size_t i = 0; i < _words.size(); ++i)
+            {
+                _words[i] |= other._words[i];
+            }
+
+            return *this;
+        }
+
+        inline libdsa::structures::BitVector &libdsa::structures::BitVector::operator^=(const BitVector &other)
+        {
+            _checkSize(other);
+
+            for (size_t i = 0; i < _words.size(); ++i)
+            {
+                _words[i] ^= other._words[i];
+            }
+
+            return *this;
+        }
+
+        inline bool libdsa::structures::BitVector::operator==(const BitVector &other) const
+        {
+            return _size == other._size && _words == other._words;
+        }
+
+        inline bool libdsa::structures::BitVector::operator!=(const BitVector &other) const
+        {
+            return !(*this == other);
+        }
+
+        inline void libdsa::structures::BitVector::_checkSize(const BitVector &other) const
+        {
+            if (_size != other._size)
+            {
+                throw std::runtime_error("BitVector - Bit arrays must be the same size.");
+            }
+        }
+
+        inline void libdsa::structures::BitVector::_clearTail()
+        {
+            if (_size % bits::WORD_BITS != 0)
+            {
+                _words.back() &= bits::lowMask(_size % bits::WORD_BITS);
+            }
+        }
+    } // structures
+} // libdsa
+
+#endif // BITVECTOR_H_
+
+/// @}
@@ -0,0 +1,515 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file bloomfilter
+/// @brief Contains declaration and definition of a blocked Bloom filter and a counting Bloom filter.
+/// @{
+
+#ifndef BLOOMFILTER_H_
+#define BLOOMFILTER_H_
+
+/// @details Both filters are blocked: the first hash of a key picks one 64-byte block and every probe for that key
+/// lands inside it, so a lookup touches a single cache line no matter how many hash functions are used.  Probe
+/// positions within the block come from double hashing, position_i = (g1 + i * g2) mod blockSize with an odd g2, which
+/// visits distinct positions for every i below the block size.
+///
+/// The counting variant swaps each bit for a 4-bit saturating counter (128 counters per block) so keys can be removed.
+/// A counter that reaches 15 sticks there, trading a little precision for never producing false negatives.
+
+// From C++ STL
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+// From libutilities
+#include <alignedallocator.h>
+
+// From libbitarray
+#include <bitops.h>
+#include <bitvector.h>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace bloom
+        {
+            /// @brief Number of 64-bit words in one cache line sized block.
+            constexpr size_t BLOCK_WORDS = libdsa::structures::utilities::CACHE_LINE_SIZE / sizeof(uint64_t);
+
+            /// @brief Number of keys hashed ahead of probing during a batch operation.
+            constexpr size_t BATCH_SIZE = 16;
+
+            /// @brief Upper bound on the number of probes per key.
+            constexpr unsigned MAX_HASHES = 16;
+
+            /// @brief Size of a filter in blocks and the number of probes per key.
+            struct Geometry
+            {
+                size_t blockCount;
+                unsigned hashCount;
+            };
+
+            /// @brief Block and probe parameters derived from one key.
+            struct Probe
+            {
+                size_t block;
+                uint32_t first;
+                uint32_t step;
+            };
+
+            /// @brief SplitMix64 finalizer.  Spreads weak hashes such as the identity @c std::hash of integers.
+            inline uint64_t mix(uint64_t value)
+            {
+                value ^= value >> 30;
+                value *= 0xBF58476D1CE4E5B9ULL;
+                value ^= value >> 27;
+                value *= 0x94D049BB133111EBULL;
+                value ^= value >> 31;
+                return value;
+            }
+
+            /// @brief Derives the block and double hashing parameters for a hashed key.
+            inline Probe makeProbe(uint64_t hash, size_t blockCount)
+            {
+                const uint64_t h1 = mix(hash);
+                const uint64_t h2 = mix(h1 ^ 0x9E3779B97F4A7C15ULL);
+
+                // Multiply-shift maps the upper half of h1 onto [0, blockCount) without a division.
+                const size_t block = static_cast<size_t>(((h1 >> 32) * blockCount) >> 32);
+                return {block, static_cast<uint32_t>(h1), static_cast<uint32_t>(h2) | 1U};
+            }
+
+            /// @brief Computes the optimal number of bits for @p items keys at false positive rate @p rate.
+            inline size_t optimalBits(size_t items, double rate)
+            {
+                if (items == 0 || rate <= 0.0 || rate >= 1.0)
+                {
+                    throw std::invalid_argument("BloomFilter - Expected items must be positive and rate in (0, 1).");
+                }
+
+                const double ln2 = std::log(2.0);
+                return static_cast<size_t>(std::ceil(-static_cast<double>(items) * std::log(rate) / (ln2 * ln2)));
+            }
+
+            /// @brief Computes the optimal number of hash functions for the given bits per key.
+            inline unsigned optimalHashes(size_t bitCount, size_t items)
+            {
+                const double hashes = std::round(static_cast<double>(bitCount) / items * std::log(2.0));
+                return static_cast<unsigned>(std::min<double>(MAX_HASHES, std::max(1.0, hashes)));
+            }
+        } // bloom
+
+        /// @brief Blocked Bloom filter backed by a @c BitVector.
+        ///
+        /// @tparam Key The type of key being stored.
+        /// @tparam Hash Hash functor for @c Key.
+        template <typename Key, typename Hash = std::hash<Key>>
+        class BloomFilter
+        {
+        public:
+            /// @brief Number of bits in one block.
+            static constexpr uint32_t BLOCK_BITS = bloom::BLOCK_WORDS * bits::WORD_BITS;
+
+            /// @brief Constructor sized for an expected number of keys and false positive rate.
+            /// @param expectedItems Number of keys the filter is expected to hold.
+            /// @param falsePositiveRate Target probability of a false positive, in (0, 1).
+            BloomFilter(size_t expectedItems, double falsePositiveRate);
+
+            /// @brief Builds a filter with explicit geometry.  A named function rather than a constructor, since
+            ///        a constructor taking two integers is ambiguous with the one above for integer arguments.
+            /// @param blockCount Number of 512-bit blocks.
+            /// @param hashCount Number of probes per key.
+            static BloomFilter fromBlocks(size_t blockCount, unsigned hashCount);
+
+            /// @brief Adds a key to the filter.
+            /// @param key The key to add.
+            void insert(const Key &key);
+
+            /// @brief Adds several keys, hashing a batch ahead and prefetching their blocks before writing.
+            /// @param keys Pointer to the first key.
+            /// @param count Number of keys.
+            void insert(const Key *keys, size_t count);
+
+            /// @brief Adds every key of a vector.
+            void insert(const std::vector<Key> &keys);
+
+            /// @brief Checks whether a key may have been added.
+            /// @param key The key to look for.
+            /// @return False if the key was definitely never added, true if it probably was.
+            bool contains(const Key &key) const;
+
+            /// @brief Checks several keys, hashing a batch ahead and prefetching their blocks before reading.
+            /// @param keys Pointer to the first key.
+            /// @param count Number of keys.
+            /// @param results Receives one answer per key.
+            void contains(const Key *keys, size_t count, bool *results) const;
+
+            /// @brief Checks every key of a vector.
+            /// @return One answer per key.
+            std::vector<bool> contains(const std::vector<Key> &keys) const;
+
+            /// @brief Merges another filter with the same geometry into this one with a word-wise OR.
+            /// @param other The filter to merge.
+            void unionWith(const BloomFilter &other);
+
+            /// @brief Removes every key.
+            void clear();
+
+            /// @brief Gets the number of bits in the filter.
+            size_t bitCount() const;
+
+            /// @brief Gets the number of probes per key.
+            unsigned hashCount() const;
+
+            /// @brief Estimates the current false positive rate from the fraction of bits set.
+            double estimatedFalsePositiveRate() const;
+
+        private:
+            explicit BloomFilter(bloom::Geometry geometry);
+
+            /// @brief Sets the probe bits of one key.
+            void _insert(const bloom::Probe &probe);
+
+            /// @brief Tests the probe bits of one key.
+            bool _contains(const bloom::Probe &probe) const;
+
+            /// @brief The filter bits, grouped into cache line blocks.
+            BitVector _bits;
+
+            /// @brief Number of blocks in @c _bits.
+            size_t _blockCount;
+
+            /// @brief Number of probes per key.
+            unsigned _hashCount;
+
+            Hash _hash;
+        }; // BloomFilter
+
+        /// @brief Blocked Bloom filter of 4-bit counters that supports removing keys.
+        ///
+        /// @tparam Key The type of key being stored.
+        /// @tparam Hash Hash functor for @c Key.
+        template <typename Key, typename Hash = std::hash<Key>>
+        class CountingBloomFilter
+        {
+        public:
+            /// @brief Number of counters in one block.
+            static constexpr uint32_t BLOCK_COUNTERS = bloom::BLOCK_WORDS * 16;
+
+            /// @brief Value at which a counter stops changing.
+            static constexpr uint64_t COUNTER_MAX = 15;
+
+            /// @brief Constructor sized for an expected number of keys and false positive rate.
+            /// @param expectedItems Number of keys the filter is expected to hold.
+            /// @param falsePositiveRate Target probability of a false positive, in (0, 1).
+            CountingBloomFilter(size_t expectedItems, double falsePositiveRate);
+
+            /// @brief Adds a key to the filter.
+            /// @param key The key to add.
+            void insert(const Key &key);
+
+            /// @brief Removes a key previously added.
+            /// @param key The key to remove.
+            /// @return False if the key was definitely not present, in which case nothing is changed.
+            bool remove(const Key &key);
+
+            /// @brief Checks whether a key may be present.
+            /// @param key The key to look for.
+            /// @return False if the key is definitely absent, true if it probably is present.
+            bool contains(const Key &key) const;
+
+            /// @brief Gets the number of counters in the filter.
+            size_t counterCount() const;
+
+            /// @brief Gets the number of probes per key.
+            unsigned hashCount() const;
+
+        private:
+            /// @brief Reads the counter at @p index.
+            uint64_t _counter(size_t index) const;
+
+            /// @brief Index of the counter hit by the @p i-th probe.
+            size_t _slot(const bloom::Probe &probe, unsigned i) const;
+
+            /// @brief Counters packed sixteen to a word.
+            std::vector<uint64_t, libdsa::structures::utilities::AlignedAllocator<uint64_t>> _counters;
+
+            /// @brief Number of blocks in @c _counters.
+            size_t _blockCount;
+
+            /// @brief Number of probes per key.
+            unsigned _hashCount;
+
+            Hash _hash;
+        }; // CountingBloomFilter
+
+        template <typename Key, typename Hash>
+        libdsa::structures::BloomFilter<Key, Hash>::BloomFilter(size_t expectedItems, double falsePositiveRate)
+            : BloomFilter(bloom::Geometry{
+                  (bloom::optimalBits(expectedItems, falsePositiveRate) + BLOCK_BITS - 1) / BLOCK_BITS,
+                  bloom::optimalHashes(bloom::optimalBits(expectedItems, falsePositiveRate), expectedItems)})
+        {
+            // Intentionally empty constructor.
+        }
+
+        template <typename Key, typename Hash>
+        libdsa::structures::BloomFilter<Key, Hash>
+        libdsa::structures::BloomFilter<Key, Hash>::fromBlocks(size_t blockCount, unsigned hashCount)
+        {
+            return BloomFilter(bloom::Geometry{blockCount, hashCount});
+        }
+
+        template <typename Key, typename Hash>
+        libdsa::structures::BloomFilter<Key, Hash>::BloomFilter(bloom::Geometry geometry)
+            : _bits(std::max<size_t>(geometry.blockCount, 1) * BLOCK_BITS),
+              _blockCount(std::max<size_t>(geometry.blockCount, 1)), _hashCount(geometry.hashCount)
+        {
+            if (_hashCount == 0 || _hashCount > bloom::MAX_HASHES)
+            {
+                throw std::invalid_argument("BloomFilter - Hash count must be between 1 and 16.");
+            }
+        }
+
+        template <typename Key, typename Hash>
+        void libdsa::structures::BloomFilter<Key, Hash>::_insert(const bloom::Probe &probe)
+        {
+            uint64_t *block = _bits.words() + probe.block * bloom::BLOCK_WORDS;
+
+            for (unsigned i = 0; i < _hashCount; ++i)
+            {
+                const uint32_t bit = (probe.first + i * probe.step) % BLOCK_BITS;
+                block[bit / bits::WORD_BITS] |= uint64_t(1) << (bit % bits::WORD_BITS);
+            }
+        }
+
+        template <typename Key, typename Hash>
+        bool libdsa::structures::BloomFilter<Key, Hash>::_contains(const bloom::Probe &probe) const
+        {
+            const uint64_t *block = _bits.words() + probe.block * bloom::BLOCK_WORDS;
+
+            // Build the expected mask for the whole block first so the checks do not branch per probe.
+            uint64_t mask[bloom::BLOCK_WORDS] = {};
+
+            for (unsigned i = 0; i < _hashCount; ++i)
+            {
+                const uint32_t bit = (probe.first + i * probe.step) % BLOCK_BITS;
+                mask[bit / bits::WORD_BITS] |= uint64_t(1) << (bit % bits::WORD_BITS);
+            }
+
+            uint64_t missing = 0;
+
+            for (size_t w = 0; w < bloom::BLOCK_WORDS; ++w)
+            {
+                missing |= mask[w] & ~block[w];
+            }
+
+            return missing == 0;
+        }
+
+        template <typename Key, typename Hash>
+        void libdsa::structures::BloomFilter<Key, Hash>::insert(const Key &key)
+        {
+            _insert(bloom::makeProbe(_hash(key), _blockCount));
+        }
+
+        template <typename Key, typename Hash>
+        void libdsa::structures::BloomFilter<Key, Hash>::insert(const Key *keys, size_t count)
+        {
+            bloom::Probe probes[bloom::BATCH_SIZE];
+
+            for (size_t start = 0; start < count; start += bloom::BATCH_SIZE)
+            {
+                const size_t batch = std::min(bloom::BATCH_SIZE, count - start);
+
+                for (size_t i = 0; i < batch; ++i)
+                {
+                    probes[i] = bloom::makeProbe(_hash(keys[start + i]), _blockCount);
+                    __builtin_prefetch(_bits.words() + probes[i].block * bloom::BLOCK_WORDS, 1);
+                }
+
+                for (size_t i = 0; i < batch; ++i)
+                {
+                    _insert(probes[i]);
+                }
+            }
+        }
+
+        template <typename Key, typename Hash>
+        void libdsa::structures::BloomFilter<Key, Hash>::insert(const std::vector<Key> &keys)
+        {
+            insert(keys.data(), keys.size());
+        }
+
+        template <typename Key, typename Hash>
+        bool libdsa::structures::BloomFilter<Key, Hash>::contains(const Key &key) const
+        {
+            return _contains(bloom::makeProbe(_hash(key), _blockCount));
+        }
+
+        template <typename Key, typename Hash>
+        void libdsa::structures::BloomFilter<Key, Hash>::contains(const Key *keys, size_t count, bool *results) const
+        {
+            bloom::Probe probes[bloom::BATCH_SIZE];
+
+            for (size_t start = 0; start < count; start += bloom::BATCH_SIZE)
+            {
+                const size_t batch = std::min(bloom::BATCH_SIZE, count - start);
+
+                for (size_t i = 0; i < batch; ++i)
+                {
+                    probes[i] = bloom::makeProbe(_hash(keys[start + i]), _blockCount);
+                    __builtin_prefetch(_bits.words() + probes[i].block * bloom::BLOCK_WORDS, 0);
+                }
+
+                for (size_t i = 0; i < batch; ++i)
+                {
+                    results[start + i] = _contains(probes[i]);
+                }
+            }
+        }
+
+        template <typename Key, typename Hash>
+        std::vector<bool> libdsa::structures::BloomFilter<Key, Hash>::contains(const std::vector<Key> &keys) const
+        {
+            std::unique_ptr<bool[]> answers(new bool[keys.size()]);
+            contains(keys.data(), keys.size(), answers.get());
+
+            return std::vector<bool>(answers.get(), answers.get() + keys.size());
+        }
+
+        template <typename Key, typename Hash>
+        void libdsa::structures::BloomFilter<Key, Hash>::unionWith(const BloomFilter &other)
+        {
+            if (_blockCount != other._blockCount || _hashCount != other._hashCount)
+            {
+                throw std::runtime_error("BloomFilter - Filters must share the same geometry to be merged.");
+            }
+
+            _bits |= other._bits;
+        }
+
+        template <typename Key, typename Hash>
+        void libdsa::structures::BloomFilter<Key, Hash>::clear()
+        {
+            _bits = BitVector(_bits.size());
+        }
+
+        template <typename Key, typename Hash>
+        size_t libdsa::structures::BloomFilter<Key, Hash>::bitCount() const
+        {
+            return _bits.size();
+        }
+
+        template <typename Key, typename Hash>
+        unsigned libdsa::structures::BloomFilter<Key, Hash>::hashCount() const
+        {
+            return _hashCount;
+        }
+
+        template <typename Key, typename Hash>
+        double libdsa::structures::BloomFilter<Key, Hash>::estimatedFalsePositiveRate() const
+        {
+            const double fill = static_cast<double>(_bits.count()) / static_cast<double>(_bits.size());
+            return std::pow(fill, static_cast<double>(_hashCount));
+        }
+
+        template <typename Key, typename Hash>
+        libdsa::structures::CountingBloomFilter<Key, Hash>::CountingBloomFilter(size_t expectedItems,
+                                                                                double falsePositiveRate)
+        {
+            const size_t slots = bloom::optimalBits(expectedItems, falsePositiveRate);
+
+            _blockCount = std::max<size_t>(1, (slots + BLOCK_COUNTERS - 1) / BLOCK_COUNTERS);
+            _hashCount = bloom::optimalHashes(slots, expectedItems);
+            _counters.assign(_blockCount * bloom::BLOCK_WORDS, 0);
+        }
+
+        template <typename Key, typename Hash>
+        uint64_t libdsa::structures::CountingBloomFilter<Key, Hash>::_counter(size_t index) const
+        {
+            return (_counters[index / 16] >> ((index % 16) * 4)) & 0xF;
+        }
+
+        template <typename Key, typename Hash>
+        size_t libdsa::structures::CountingBloomFilter<Key, Hash>::_slot(const bloom::Probe &probe, unsigned i) const
+        {
+            return probe.block * BLOCK_COUNTERS + (probe.first + i * probe.step) % BLOCK_COUNTERS;
+        }
+
+        template <typename Key, typename Hash>
+        void libdsa::structures::CountingBloomFilter<Key, Hash>::insert(const Key &key)
+        {
+            const bloom::Probe probe = bloom::makeProbe(_hash(key), _blockCount);
+
+            for (unsigned i = 0; i < _hashCount; ++i)
+            {
+                const size_t slot = _slot(probe, i);
+
+                if (_counter(slot) < COUNTER_MAX)
+                {
+                    _counters[slot / 16] += uint64_t(1) << ((slot % 16) * 4);
+                }
+            }
+        }
+
+        template <typename Key, typename Hash>
+        bool libdsa::structures::CountingBloomFilter<Key, Hash>::remove(const Key &key)
+        {
+            if (!contains(key))
+            {
+                return false;
+            }
+
+            const bloom::Probe probe = bloom::makeProbe(_hash(key), _blockCount);
+
+            for (unsigned i = 0; i < _hashCount; ++i)
+            {
+                const size_t slot = _slot(probe, i);
+
+                // Saturated counters have lost track of their true value and must stay put.
+                if (_counter(slot) < COUNTER_MAX)
+                {
+                    _counters[slot / 16] -= uint64_t(1) << ((slot % 16) * 4);
+                }
+            }
+
+            return true;
+        }
+
+        template <typename Key, typename Hash>
+        bool libdsa::structures::CountingBloomFilter<Key, Hash>::contains(const Key &key) const
+        {
+            const bloom::Probe probe = bloom::makeProbe(_hash(key), _blockCount);
+
+            for (unsigned i = 0; i < _hashCount; ++i)
+            {
+                if (_counter(_slot(probe, i)) == 0)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        template <typename Key, typename Hash>
+        size_t libdsa::structures::CountingBloomFilter<Key, Hash>::counterCount() const
+        {
+            return _blockCount * BLOCK_COUNTERS;
+        }
+
+        template <typename Key, typename Hash>
+        unsigned libdsa::structures::CountingBloomFilter<Key, Hash>::hashCount() const
+        {
+            return _hashCount;
+        }
+    } // structures
+} // libdsa
+
+#endif // BLOOMFILTER_H_
+
+/// @}
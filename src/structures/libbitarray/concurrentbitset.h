@@ -0,0 +1,236 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file concurrentbitset
+/// @brief Contains declaration and definition of a fixed size bit set whose operations are atomic.
+/// @{
+
+#ifndef CONCURRENTBITSET_H_
+#define CONCURRENTBITSET_H_
+
+/// @details Every word is a @c std::atomic<uint64_t>, so individual bits and whole words can be changed from many
+/// threads at once without a lock.  @c claimFirstFree() turns the set into a lock-free slot allocator: each thread
+/// starts scanning from its own hint, which begins on a different cache line per thread and then follows the last
+/// slot that thread claimed, so concurrent claimers rarely fight over the same word.  Hints belong to the set, one
+/// cache line each for up to @c HINT_SLOTS threads; beyond that, threads share a hint.
+
+// From C++ STL
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+// From libutilities
+#include <alignedallocator.h>
+
+// From libbitarray
+#include <bitops.h>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        class ConcurrentBitSet
+        {
+        public:
+            /// @brief Number of per-thread scan hints each set keeps.
+            static constexpr size_t HINT_SLOTS = 64;
+
+            /// @brief Constructor.  Every bit starts cleared.
+            /// @param size Number of bits held by the set.
+            explicit ConcurrentBitSet(size_t size);
+
+            ConcurrentBitSet(const ConcurrentBitSet &) = delete;
+            ConcurrentBitSet &operator=(const ConcurrentBitSet &) = delete;
+
+            /// @brief Gets the number of bits held by the set.
+            size_t size() const;
+
+            /// @brief Gets the number of 64-bit words backing the set.
+            size_t wordCount() const;
+
+            /// @brief Reads a single bit.
+            /// @param index Position of the bit.
+            bool test(size_t index) const;
+
+            /// @brief Atomically sets a bit.
+            /// @param index Position of the bit.
+            /// @return The previous value of the bit.  False means this call was the one to set it.
+            bool testAndSet(size_t index);
+
+            /// @brief Atomically clears a bit.
+            /// @param index Position of the bit.
+            /// @return The previous value of the bit.
+            bool clear(size_t index);
+
+            /// @brief Atomically ORs a mask into a whole word.
+            /// @param wordIndex Index of the word.
+            /// @param mask Bits to set.
+            /// @return The previous value of the word.
+            uint64_t fetchOrWord(size_t wordIndex, uint64_t mask);
+
+            /// @brief Atomically ANDs a mask into a whole word.
+            /// @param wordIndex Index of the word.
+            /// @param mask Bits to keep.
+            /// @return The previous value of the word.
+            uint64_t fetchAndWord(size_t wordIndex, uint64_t mask);
+
+            /// @brief Reads a whole word.
+            /// @param wordIndex Index of the word.
+            uint64_t loadWord(size_t wordIndex) const;
+
+            /// @brief Finds a cleared bit and sets it with a compare-and-swap, starting from the calling thread's
+            ///        hint and wrapping around once.
+            /// @return The position of the claimed bit, or @c size() if every bit is set.
+            size_t claimFirstFree();
+
+            /// @brief Counts the set bits.  The result is only exact while no other thread is writing.
+            size_t count() const;
+
+        private:
+            /// @brief One thread's scan hint, alone on its cache line.
+            struct alignas(libdsa::structures::utilities::CACHE_LINE_SIZE) Hint
+            {
+                std::atomic<size_t> _word;
+            };
+
+            /// @brief Word the calling thread should start scanning from.
+            std::atomic<size_t> &_hint();
+
+            /// @brief Mask of the valid bits within @p wordIndex.
+            uint64_t _validMask(size_t wordIndex) const;
+
+            /// @brief The atomic words, cache line aligned.
+            std::vector<std::atomic<uint64_t>, libdsa::structures::utilities::AlignedAllocator<std::atomic<uint64_t>>>
+                _words;
+
+            /// @brief Number of bits held by the set.
+            size_t _size;
+
+            /// @brief Scan hints, indexed by thread number modulo @c HINT_SLOTS.
+            std::vector<Hint, libdsa::structures::utilities::AlignedAllocator<Hint>> _hints;
+        }; // ConcurrentBitSet
+
+        inline libdsa::structures::ConcurrentBitSet::ConcurrentBitSet(size_t size)
+            : _words(bits::wordsFor(size)), _size(size), _hints(HINT_SLOTS)
+        {
+            for (std::atomic<uint64_t> &word : _words)
+            {
+                word.store(0, std::memory_order_relaxed);
+            }
+
+            // Spread threads a cache line apart so they do not all start on word zero.
+            for (size_t slot = 0; slot < _hints.size(); ++slot)
+            {
+                _hints[slot]._word.store(slot * (libdsa::structures::utilities::CACHE_LINE_SIZE / sizeof(uint64_t)),
+                                         std::memory_order_relaxed);
+            }
+        }
+
+        inline size_t libdsa::structures::ConcurrentBitSet::size() const
+        {
+            return _size;
+        }
+
+        inline size_t libdsa::structures::ConcurrentBitSet::wordCount() const
+        {
+            return _words.size();
+        }
+
+        inline bool libdsa::structures::ConcurrentBitSet::test(size_t index) const
+        {
+            return (_words[index / bits::WORD_BITS].load(std::memory_order_acquire) >> (index % bits::WORD_BITS)) & 1U;
+        }
+
+        inline bool libdsa::structures::ConcurrentBitSet::testAndSet(size_t index)
+        {
+            const uint64_t mask = uint64_t(1) << (index % bits::WORD_BITS);
+            return (_words[index / bits::WORD_BITS].fetch_or(mask, std::memory_order_acq_rel) & mask) != 0;
+        }
+
+        inline bool libdsa::structures::ConcurrentBitSet::clear(size_t index)
+        {
+            const uint64_t mask = uint64_t(1) << (index % bits::WORD_BITS);
+            return (_words[index / bits::WORD_BITS].fetch_and(~mask, std::memory_order_acq_rel) & mask) != 0;
+        }
+
+        inline uint64_t libdsa::structures::ConcurrentBitSet::fetchOrWord(size_t wordIndex, uint64_t mask)
+        {
+            return _words[wordIndex].fetch_or(mask & _validMask(wordIndex), std::memory_order_acq_rel);
+        }
+
+        inline uint64_t libdsa::structures::ConcurrentBitSet::fetchAndWord(size_t wordIndex, uint64_t mask)
+        {
+            return _words[wordIndex].fetch_and(mask, std::memory_order_acq_rel);
+        }
+
+        inline uint64_t libdsa::structures::ConcurrentBitSet::loadWord(size_t wordIndex) const
+        {
+            return _words[wordIndex].load(std::memory_order_acquire);
+        }
+
+        inline std::atomic<size_t> &libdsa::structures::ConcurrentBitSet::_hint()
+        {
+            static std::atomic<size_t> nextThread{0};
+            thread_local const size_t thread = nextThread.fetch_add(1, std::memory_order_relaxed);
+            return _hints[thread % HINT_SLOTS]._word;
+        }
+
+        inline uint64_t libdsa::structures::ConcurrentBitSet::_validMask(size_t wordIndex) const
+        {
+            if (wordIndex + 1 == _words.size() && _size % bits::WORD_BITS != 0)
+            {
+                return bits::lowMask(_size % bits::WORD_BITS);
+            }
+
+            return ~uint64_t(0);
+        }
+
+        inline size_t libdsa::structures::ConcurrentBitSet::claimFirstFree()
+        {
+            if (_words.empty())
+            {
+                return _size;
+            }
+
+            std::atomic<size_t> &hint = _hint();
+            const size_t start = hint.load(std::memory_order_relaxed) % _words.size();
+
+            for (size_t step = 0; step < _words.size(); ++step)
+            {
+                const size_t wordIndex = (start + step) % _words.size();
+                const uint64_t valid = _validMask(wordIndex);
+                uint64_t current = _words[wordIndex].load(std::memory_order_relaxed);
+
+                while ((~current & valid) != 0)
+                {
+                    const uint64_t bit = uint64_t(1) << bits::countTrailingZeros(~current & valid);
+
+                    // On failure current is reloaded, so the loop retries against the latest word.
+                    if (_words[wordIndex].compare_exchange_weak(current, current | bit, std::memory_order_acq_rel,
+                                                                 std::memory_order_relaxed))
+                    {
+                        hint.store(wordIndex, std::memory_order_relaxed);
+                        return wordIndex * bits::WORD_BITS + bits::countTrailingZeros(bit);
+                    }
+                }
+            }
+
+            return _size;
+        }
+
+        inline size_t libdsa::structures::ConcurrentBitSet::count() const
+        {
+            size_t total = 0;
+
+            for (const std::atomic<uint64_t> &word : _words)
+            {
+                total += bits::popcount(word.load(std::memory_order_relaxed));
+            }
+
+            return total;
+        }
+    } // structures
+} // libdsa
+
+#endif // CONCURRENTBITSET_H_
+
+/// @}
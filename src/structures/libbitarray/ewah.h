@@ -0,0 +1,697 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file ewah
+/// @brief Contains declaration and definition of the EWAH word-aligned run-length compressed bit array format.
+/// @{
+
+#ifndef EWAH_H_
+#define EWAH_H_
+
+/// @details An Enhanced Word-Aligned Hybrid (EWAH) stream is a sequence of marker words, each followed by the literal
+/// words it announces.  A marker describes a run of "clean" words (all zeros or all ones) followed by a number of
+/// "dirty" literal words copied verbatim:
+///     - bit 0:       value of every bit in the clean run
+///     - bits 1-32:   number of clean words in the run
+///     - bits 33-63:  number of literal words that follow the marker
+/// Mostly empty or mostly full bit arrays collapse into a handful of markers.  Logical operations read both streams
+/// one run or literal block at a time, so a clean run is either written straight to the output or used to copy the
+/// other operand's literals, and the inputs are never inflated.
+///
+/// The serialized form is a 24-byte header (magic, version, bit count, stream length) followed by the stream words,
+/// all in host byte order.
+
+// From C++ STL
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+// From libbitarray
+#include <bitops.h>
+#include <bitvector.h>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace ewah
+        {
+            /// @brief Identifies a serialized stream: the ASCII characters "EWAH".
+            constexpr uint32_t MAGIC = 0x48415745U;
+
+            /// @brief Current serialization version.
+            constexpr uint32_t VERSION = 1;
+
+            /// @brief Largest clean run a single marker can describe.
+            constexpr uint64_t MAX_RUN_LENGTH = (uint64_t(1) << 32) - 1;
+
+            /// @brief Largest number of literal words a single marker can announce.
+            constexpr uint64_t MAX_LITERAL_COUNT = (uint64_t(1) << 31) - 1;
+
+            /// @brief Logical operations supported between two compressed streams.
+            using Operation = bits::Operation;
+
+            inline bool runBit(uint64_t marker)
+            {
+                return marker & 1U;
+            }
+
+            inline uint64_t runLength(uint64_t marker)
+            {
+                return (marker >> 1) & MAX_RUN_LENGTH;
+            }
+
+            inline uint64_t literalCount(uint64_t marker)
+            {
+                return marker >> 33;
+            }
+
+            inline uint64_t makeMarker(bool bit, uint64_t run, uint64_t literals)
+            {
+                return uint64_t(bit) | (run << 1) | (literals << 33);
+            }
+        } // ewah
+
+        class EwahBitmap;
+
+        /// @brief Builds an EWAH stream from uncompressed words supplied one at a time.
+        class EwahEncoder
+        {
+        public:
+            EwahEncoder();
+
+            /// @brief Appends one uncompressed word.
+            void addWord(uint64_t word);
+
+            /// @brief Appends @p count words whose bits all equal @p bit.
+            void addRun(bool bit, uint64_t count);
+
+            /// @brief Appends @p count words verbatim.  Clean words among them are still folded into runs.
+            void addWords(const uint64_t *words, uint64_t count);
+
+            /// @brief Gets the number of uncompressed words appended so far.
+            uint64_t wordCount() const;
+
+            /// @brief Completes the stream.
+            /// @param bitCount Number of meaningful bits.  Must fit within the appended words.
+            /// @return The compressed bitmap.  The encoder is left empty.
+            EwahBitmap finish(size_t bitCount);
+
+        private:
+            /// @brief Appends a literal word to the current marker.
+            void _addLiteral(uint64_t word);
+
+            /// @brief Starts a new marker at the end of the stream.
+            void _newMarker();
+
+            std::vector<uint64_t> _buffer;
+
+            /// @brief Index of the marker currently being extended.
+            size_t _marker;
+
+            uint64_t _wordCount;
+        }; // EwahEncoder
+
+        /// @brief Reads an EWAH stream back as uncompressed words, one run or literal block at a time.
+        class EwahDecoder
+        {
+        public:
+            /// @param stream The compressed stream.  Must outlive the decoder.
+            /// @param streamLength Number of words in @p stream.
+            EwahDecoder(const uint64_t *stream, size_t streamLength);
+
+            /// @brief Whether every word has been consumed.
+            bool done() const;
+
+            /// @brief Whether the decoder is positioned inside a clean run.
+            bool inRun() const;
+
+            /// @brief Bit value of the current clean run.
+            bool runBit() const;
+
+            /// @brief Words left in the current clean run.
+            uint64_t runRemaining() const;
+
+            /// @brief Literal words left after the current run, before the next marker.
+            uint64_t literalsRemaining() const;
+
+            /// @brief Pointer to the next literal word.
+            const uint64_t *literals() const;
+
+            /// @brief Consumes @p count words of the current run, or of the current literal block once the run is
+            ///        exhausted.  Must not cross into the next marker.
+            void advance(uint64_t count);
+
+            /// @brief Reads the next uncompressed word.
+            /// @param word Receives the word.
+            /// @return False once the stream is exhausted.
+            bool next(uint64_t &word);
+
+        private:
+            /// @brief Loads markers until one with remaining words is found or the stream ends.
+            void _loadMarker();
+
+            const uint64_t *_stream;
+            size_t _streamLength;
+            size_t _position;
+            bool _runBit;
+            uint64_t _runRemaining;
+            uint64_t _literalsRemaining;
+        }; // EwahDecoder
+
+        /// @brief A bit array held in EWAH compressed form.
+        class EwahBitmap
+        {
+        public:
+            /// @brief Constructor for an empty bitmap.
+            EwahBitmap();
+
+            /// @brief Compresses an uncompressed bit array.
+            static EwahBitmap encode(const BitVector &bitVector);
+
+            /// @brief Inflates the bitmap into an uncompressed bit array.
+            BitVector decode() const;
+
+            /// @brief Gets the number of bits held by the bitmap.
+            size_t size() const;
+
+            /// @brief Counts the set bits without inflating the bitmap.
+            size_t count() const;
+
+            /// @brief Gets the compressed stream.
+            const std::vector<uint64_t> &stream() const;
+
+            /// @brief Gets the size of the compressed stream in bytes.
+            size_t sizeInBytes() const;
+
+            /// @brief Gets a decoder positioned at the start of the stream.
+            EwahDecoder decoder() const;
+
+            /// @brief Writes the header and stream.
+            void serialize(std::ostream &output) const;
+
+            /// @brief Reads a bitmap written by @c serialize().
+            static EwahBitmap deserialize(std::istream &input);
+
+            /// @brief Logical AND between both compressed bitmaps.
+            EwahBitmap AND(const EwahBitmap &other) const;
+
+            /// @brief Logical difference between the two compressed bitmaps.
+            /// @note Operation: difference = this AND (NOT other)
+            EwahBitmap difference(const EwahBitmap &other) const;
+
+            /// @brief Logical OR between both compressed bitmaps.
+            EwahBitmap OR(const EwahBitmap &other) const;
+
+            /// @brief Logical XOR between both compressed bitmaps.
+            EwahBitmap XOR(const EwahBitmap &other) const;
+
+            bool operator==(const EwahBitmap &other) const;
+
+        private:
+            friend class EwahEncoder;
+
+            EwahBitmap(std::vector<uint64_t> &&stream, size_t size);
+
+            /// @brief Walks both streams together, combining runs and literal blocks.
+            EwahBitmap _combine(const EwahBitmap &other, ewah::Operation operation) const;
+
+            std::vector<uint64_t> _stream;
+            size_t _size;
+        }; // EwahBitmap
+
+        inline libdsa::structures::EwahEncoder::EwahEncoder() : _buffer(1, 0), _marker(0), _wordCount(0)
+        {
+            // Intentionally empty constructor.
+        }
+
+        inline void libdsa::structures::EwahEncoder::_newMarker()
+        {
+            _marker = _buffer.size();
+            _buffer.push_back(0);
+        }
+
+        inline void libdsa::structures::EwahEncoder::addRun(bool bit, uint64_t count)
+        {
+            _wordCount += count;
+
+            while (count > 0)
+            {
+                const uint64_t marker = _buffer[_marker];
+
+                // A run can only extend the current marker if nothing has been written after it yet.
+                const bool extendable = ewah::literalCount(marker) == 0 &&
+                                        (ewah::runLength(marker) == 0 || ewah::runBit(marker) == bit) &&
+                                        ewah::runLength(marker) < ewah::MAX_RUN_LENGTH;
+
+                if (!extendable)
+                {
+                    _newMarker();
+                    continue;
+                }
+
+                const uint64_t added = std::min(count, ewah::MAX_RUN_LENGTH - ewah::runLength(marker));
+                _buffer[_marker] = ewah::makeMarker(bit, ewah::runLength(marker) + added, 0);
+                count -= added;
+            }
+        }
+
+        inline void libdsa::structures::EwahEncoder::_addLiteral(uint64_t word)
+        {
+            if (ewah::literalCount(_buffer[_marker]) == ewah::MAX_LITERAL_COUNT)
+            {
+                _newMarker();
+            }
+
+            const uint64_t marker = _buffer[_marker];
+            _buffer[_marker] = ewah::makeMarker(ewah::runBit(marker), ewah::runLength(marker),
+                                                ewah::literalCount(marker) + 1);
+            _buffer.push_back(word);
+            ++_wordCount;
+        }
+
+        inline void libdsa::structures::EwahEncoder::addWord(uint64_t word)
+        {
+            if (word == 0 || word == ~uint64_t(0))
+            {
+                addRun(word != 0, 1);
+            }
+            else
+            {
+                _addLiteral(word);
+            }
+        }
+
+        inline void libdsa::structures::EwahEncoder::addWords(const uint64_t *words, uint64_t count)
+        {
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                addWord(words[i]);
+            }
+        }
+
+        inline uint64_t libdsa::structures::EwahEncoder::wordCount() const
+        {
+            return _wordCount;
+        }
+
+        inline libdsa::structures::EwahBitmap libdsa::structures::EwahEncoder::finish(size_t bitCount)
+        {
+            if (bits::wordsFor(bitCount) != _wordCount)
+            {
+                throw std::runtime_error("EwahEncoder - Bit count does not match the number of words written.");
+            }
+
+            EwahBitmap result(std::move(_buffer), bitCount);
+
+            _buffer.assign(1, 0);
+            _marker = 0;
+            _wordCount = 0;
+
+            return result;
+        }
+
+        inline libdsa::structures::EwahDecoder::EwahDecoder(const uint64_t *stream, size_t streamLength)
+            : _stream(stream), _streamLength(streamLength), _position(0), _runBit(false), _runRemaining(0),
+              _literalsRemaining(0)
+        {
+            _loadMarker();
+        }
+
+        inline void libdsa::structures::EwahDecoder::_loadMarker()
+        {
+            while (_runRemaining == 0 && _literalsRemaining == 0 && _position < _streamLength)
+            {
+                const uint64_t marker = _stream[_position++];
+                _runBit = ewah::runBit(marker);
+                _runRemaining = ewah::runLength(marker);
+                _literalsRemaining = ewah::literalCount(marker);
+
+                if (_position + _literalsRemaining > _streamLength)
+                {
+                    throw std::runtime_error("EwahDecoder - Marker announces more literals than the stream holds.");
+                }
+            }
+        }
+
+        inline bool libdsa::structures::EwahDecoder::done() const
+        {
+            return _runRemaining == 0 && _literalsRemaining == 0;
+        }
+
+        inline bool libdsa::structures::EwahDecoder::inRun() const
+        {
+            return _runRemaining > 0;
+        }
+
+        inline bool libdsa::structures::EwahDecoder::runBit() const
+        {
+            return _runBit;
+        }
+
+        inline uint64_t libdsa::structures::EwahDecoder::runRemaining() const
+        {
+            return _runRemaining;
+        }
+
+        inline uint64_t libdsa::structures::EwahDecoder::literalsRemaining() const
+        {
+            return _literalsRemaining;
+        }
+
+        inline const uint64_t *libdsa::structures::EwahDecoder::literals() const
+        {
+            return _stream + _position;
+        }
+
+        inline void libdsa::structures::EwahDecoder::advance(uint64_t count)
+        {
+            if (_runRemaining > 0)
+            {
+                _runRemaining -= count;
+            }
+            else
+            {
+                _literalsRemaining -= count;
+                _position += count;
+            }
+
+            _loadMarker();
+        }
+
+        inline bool libdsa::structures::EwahDecoder::next(uint64_t &word)
+        {
+            if (done())
+            {
+                return false;
+            }
+
+            word = inRun() ? (_runBit ? ~uint64_t(0) : uint64_t(0)) : *literals();
+            advance(1);
+            return true;
+        }
+
+        inline libdsa::structures::EwahBitmap::EwahBitmap() : _stream(1, 0), _size(0)
+        {
+            // Intentionally empty constructor.
+        }
+
+        inline libdsa::structures::EwahBitmap::EwahBitmap(std::vector<uint64_t> &&stream, size_t size)
+            : _stream(std::move(stream)), _size(size)
+        {
+            // Intentionally empty constructor.
+        }
+
+        inline libdsa::structures::EwahBitmap libdsa::structures::EwahBitmap::encode(const BitVector &bitVector)
+        {
+            EwahEncoder encoder;
+            encoder.addWords(bitVector.words(), bitVector.wordCount());
+            return encoder.finish(bitVector.size());
+        }
+
+        inline libdsa::structures::BitVector libdsa::structures::EwahBitmap::decode() const
+        {
+            BitVector result(_size);
+            uint64_t *words = result.words();
+            EwahDecoder reader = decoder();
+            size_t index = 0;
+
+            while (!reader.done())
+            {
+                if (reader.inRun())
+                {
+                    const uint64_t count = reader.runRemaining();
+                    std::fill(words + index, words + index + count, reader.runBit() ? ~uint64_t(0) : uint64_t(0));
+                    index += count;
+                    reader.advance(count);
+                }
+                else
+                {
+                    const uint64_t count = reader.literalsRemaining();
+                    std::copy(reader.literals(), reader.literals() + count, words + index);
+                    index += count;
+                    reader.advance(count);
+                }
+            }
+
+            return result;
+        }
+
+        inline size_t libdsa::structures::EwahBitmap::size() const
+        {
+            return _size;
+        }
+
+        inline size_t libdsa::structures::EwahBitmap::count() const
+        {
+            EwahDecoder reader = decoder();
+            size_t total = 0;
+
+            while (!reader.done())
+            {
+                if (reader.inRun())
+                {
+                    total += reader.runBit() ? reader.runRemaining() * bits::WORD_BITS : 0;
+                    reader.advance(reader.runRemaining());
+                }
+                else
+                {
+                    for (uint64_t i = 0; i < reader.literalsRemaining(); ++i)
+                    {
+                        total += bits::popcount(reader.literals()[i]);
+                    }
+
+                    reader.advance(reader.literalsRemaining());
+                }
+            }
+
+            return total;
+        }
+
+        inline const std::vector<uint64_t> &libdsa::structures::EwahBitmap::stream() const
+        {
+            return _stream;
+        }
+
+        inline size_t libdsa::structures::EwahBitmap::sizeInBytes() const
+        {
+            return _stream.size() * sizeof(uint64_t);
+        }
+
+        inline libdsa::structures::EwahDecoder libdsa::structures::EwahBitmap::decoder() const
+        {
+            return EwahDecoder(_stream.data(), _stream.size());
+        }
+
+        inline void libdsa::structures::EwahBitmap::serialize(std::ostream &output) const
+        {
+            const uint32_t header[2] = {ewah::MAGIC, ewah::VERSION};
+            const uint64_t bitCount = _size;
+            const uint64_t streamLength = _stream.size();
+
+            output.write(reinterpret_cast<const char *>(header), sizeof(header));
+            output.write(reinterpret_cast<const char *>(&bitCount), sizeof(bitCount));
+            output.write(reinterpret_cast<const char *>(&streamLength), sizeof(streamLength));
+            output.write(reinterpret_cast<const char *>(_stream.data()),
+                         static_cast<std::streamsize>(_stream.size() * sizeof(uint64_t)));
+
+            if (!output)
+            {
+                throw std::runtime_error("EwahBitmap - Unable to write the compressed stream.");
+            }
+        }
+
+        inline libdsa::structures::EwahBitmap libdsa::structures::EwahBitmap::deserialize(std::istream &input)
+        {
+            uint32_t header[2] = {0, 0};
+            uint64_t bitCount = 0;
+            uint64_t streamLength = 0;
+
+            input.read(reinterpret_cast<char *>(header), sizeof(header));
+            input.read(reinterpret_cast<char *>(&bitCount), sizeof(bitCount));
+            input.read(reinterpret_cast<char *>(&streamLength), sizeof(streamLength));
+
+            if (!input || header[0] != ewah::MAGIC || header[1] != ewah::VERSION)
+            {
+                throw std::runtime_error("EwahBitmap - Input is not a compressed bitmap stream.");
+            }
+
+            // Any larger and the word count would wrap around.
+            if (bitCount > SIZE_MAX - (bits::WORD_BITS - 1))
+            {
+                throw std::runtime_error("EwahBitmap - Compressed bitmap stream has an impossible bit count.");
+            }
+
+            // The length comes from the input, so it is checked against what the input holds before anything is
+            // allocated for it.  A stream that cannot tell is read in chunks that only grow as the words arrive.
+            const std::istream::pos_type start = input.tellg();
+
+            if (start != std::istream::pos_type(-1))
+            {
+                input.seekg(0, std::ios::end);
+                const std::istream::pos_type end = input.tellg();
+                input.seekg(start);
+
+                if (!input || streamLength > static_cast<uint64_t>(end - start) / sizeof(uint64_t))
+                {
+                    throw std::runtime_error("EwahBitmap - Compressed bitmap stream is truncated.");
+                }
+            }
+
+            constexpr uint64_t CHUNK_WORDS = uint64_t(1) << 16;
+            std::vector<uint64_t> stream;
+
+            while (stream.size() < streamLength)
+            {
+                const size_t offset = stream.size();
+                const size_t count = static_cast<size_t>(std::min(CHUNK_WORDS, streamLength - offset));
+
+                stream.resize(offset + count);
+                input.read(reinterpret_cast<char *>(stream.data() + offset),
+                           static_cast<std::streamsize>(count * sizeof(uint64_t)));
+
+                if (!input)
+                {
+                    throw std::runtime_error("EwahBitmap - Compressed bitmap stream is truncated.");
+                }
+            }
+
+            // Make sure the markers describe exactly the advertised number of words, counting without overflow,
+            // and that the last word sets no bit past the end.
+            const uint64_t expected = bits::wordsFor(static_cast<size_t>(bitCount));
+            EwahDecoder reader(stream.data(), stream.size());
+            uint64_t words = 0;
+            uint64_t last = 0;
+
+            while (!reader.done())
+            {
+                const uint64_t count = reader.inRun() ? reader.runRemaining() : reader.literalsRemaining();
+
+                if (count > expected - words)
+                {
+                    throw std::runtime_error("EwahBitmap - Compressed bitmap stream does not match its bit count.");
+                }
+
+                last = reader.inRun() ? (reader.runBit() ? ~uint64_t(0) : uint64_t(0)) : reader.literals()[count - 1];
+                words += count;
+                reader.advance(count);
+            }
+
+            if (words != expected)
+            {
+                throw std::runtime_error("EwahBitmap - Compressed bitmap stream does not match its bit count.");
+            }
+
+            if (bitCount % bits::WORD_BITS != 0 && (last & ~bits::lowMask(bitCount % bits::WORD_BITS)) != 0)
+            {
+                throw std::runtime_error("EwahBitmap - Compressed bitmap stream sets bits past its bit count.");
+            }
+
+            return EwahBitmap(std::move(stream), bitCount);
+        }
+
+        inline libdsa::structures::EwahBitmap libdsa::structures::EwahBitmap::_combine(const EwahBitmap &other,
+                                                                                       ewah::Operation operation) const
+        {
+            if (_size != other._size)
+            {
+                throw std::runtime_error("EwahBitmap - Bitmaps must be the same size.");
+            }
+
+            EwahEncoder encoder;
+            EwahDecoder left = decoder();
+            EwahDecoder right = other.decoder();
+
+            while (!left.done() && !right.done())
+            {
+                if (left.inRun() && right.inRun())
+                {
+                    const uint64_t count = std::min(left.runRemaining(), right.runRemaining());
+                    const uint64_t word = bits::applyWord(operation, left.runBit() ? ~uint64_t(0) : 0,
+                                                          right.runBit() ? ~uint64_t(0) : 0);
+                    encoder.addRun(word != 0, count);
+                    left.advance(count);
+                    right.advance(count);
+                }
+                else if (left.inRun() || right.inRun())
+                {
+                    // One side is a clean run and the other a literal block.  The clean word either decides the
+                    // result outright or reduces the operation to copying, possibly negated, the literals.
+                    EwahDecoder &run = left.inRun() ? left : right;
+                    EwahDecoder &block = left.inRun() ? right : left;
+
+                    const uint64_t count = std::min(run.runRemaining(), block.literalsRemaining());
+                    const uint64_t clean = run.runBit() ? ~uint64_t(0) : 0;
+                    const uint64_t onZero = left.inRun() ? bits::applyWord(operation, clean, 0)
+                                                         : bits::applyWord(operation, 0, clean);
+                    const uint64_t onOnes = left.inRun() ? bits::applyWord(operation, clean, ~uint64_t(0))
+                                                         : bits::applyWord(operation, ~uint64_t(0), clean);
+
+                    if (onZero == onOnes)
+                    {
+                        encoder.addRun(onZero != 0, count);
+                    }
+                    else if (onZero == 0)
+                    {
+                        encoder.addWords(block.literals(), count);
+                    }
+                    else
+                    {
+                        for (uint64_t i = 0; i < count; ++i)
+                        {
+                            encoder.addWord(~block.literals()[i]);
+                        }
+                    }
+
+                    run.advance(count);
+                    block.advance(count);
+                }
+                else
+                {
+                    const uint64_t count = std::min(left.literalsRemaining(), right.literalsRemaining());
+
+                    for (uint64_t i = 0; i < count; ++i)
+                    {
+                        encoder.addWord(bits::applyWord(operation, left.literals()[i], right.literals()[i]));
+                    }
+
+                    left.advance(count);
+                    right.advance(count);
+                }
+            }
+
+            return encoder.finish(_size);
+        }
+
+        inline libdsa::structures::EwahBitmap libdsa::structures::EwahBitmap::AND(const EwahBitmap &other) const
+        {
+            return _combine(other, ewah::Operation::AND);
+        }
+
+        inline libdsa::structures::EwahBitmap libdsa::structures::EwahBitmap::difference(const EwahBitmap &other) const
+        {
+            return _combine(other, ewah::Operation::DIFFERENCE);
+        }
+
+        inline libdsa::structures::EwahBitmap libdsa::structures::EwahBitmap::OR(const EwahBitmap &other) const
+        {
+            return _combine(other, ewah::Operation::OR);
+        }
+
+        inline libdsa::structures::EwahBitmap libdsa::structures::EwahBitmap::XOR(const EwahBitmap &other) const
+        {
+            return _combine(other, ewah::Operation::XOR);
+        }
+
+        inline bool libdsa::structures::EwahBitmap::operator==(const EwahBitmap &other) const
+        {
+            return _size == other._size && _stream == other._stream;
+        }
+    } // structures
+} // libdsa
+
+#endif // EWAH_H_
+
+/// @}
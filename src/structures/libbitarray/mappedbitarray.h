@@ -0,0 +1,474 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file mappedbitarray
+/// @brief Contains declaration and definition of a file backed bit array mapped into memory with @c mmap.
+/// @{
+
+#ifndef MAPPEDBITARRAY_H_
+#define MAPPEDBITARRAY_H_
+
+/// @details The file holds a 64-byte header followed by the packed 64-bit words, least significant bit first, in the
+/// host byte order.  Opening a file only maps it; pages are read from disk the first time they are touched, so a
+/// multi-gigabyte bit array is usable immediately.  The header keeps the words cache line aligned within the page
+/// aligned mapping.
+///
+/// The @c parallelApply functions run a binary operation over two arrays by splitting the words into contiguous
+/// ranges, one per pool thread, so each thread streams through its own part of both inputs and the output.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// From C++ STL
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// From libparallel
+#include <threadpool.h>
+
+// From libbitarray
+#include <bitops.h>
+#include <bitvector.h>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace mapped
+        {
+            /// @brief Identifies a bit array file: the ASCII characters "LDSABITS".
+            constexpr uint64_t MAGIC = 0x535449424153444CULL;
+
+            /// @brief Current file format version.
+            constexpr uint32_t VERSION = 1;
+
+            /// @brief Layout of the start of a bit array file.
+            struct Header
+            {
+                uint64_t magic;
+                uint32_t version;
+                uint32_t reserved;
+                uint64_t bitCount;
+                uint64_t wordCount;
+                uint8_t padding[32];
+            };
+
+            static_assert(sizeof(Header) == 64, "MappedBitArray - Header must fill exactly one cache line.");
+
+            /// @brief Logical operations supported by @c parallelApply.
+            using Operation = bits::Operation;
+
+            /// @brief Number of words handed to a thread at a time.  Ranges are split on word boundaries, so two
+            ///        threads never write the same word.
+            constexpr size_t WORD_GRAIN = 4096 / sizeof(uint64_t);
+
+            /// @brief Applies @p operation word by word over [begin, end).
+            inline void applyRange(Operation operation, const uint64_t *left, const uint64_t *right, uint64_t *output,
+                                   size_t begin, size_t end)
+            {
+                switch (operation)
+                {
+                    case Operation::AND:
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            output[i] = left[i] & right[i];
+                        }
+                        break;
+                    case Operation::OR:
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            output[i] = left[i] | right[i];
+                        }
+                        break;
+                    case Operation::XOR:
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            output[i] = left[i] ^ right[i];
+                        }
+                        break;
+                    case Operation::DIFFERENCE:
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            output[i] = left[i] & ~right[i];
+                        }
+                        break;
+                }
+            }
+
+            /// @brief Applies @p operation to @p wordCount words of two inputs across the pool's threads.
+            /// @note @p output may alias either input.
+            inline void parallelApply(Operation operation, const uint64_t *left, const uint64_t *right,
+                                      uint64_t *output, size_t wordCount, libdsa::common::ThreadPool &pool)
+            {
+                pool.parallelFor(0, wordCount, WORD_GRAIN, [=](size_t begin, size_t end)
+                {
+                    applyRange(operation, left, right, output, begin, end);
+                });
+            }
+        } // mapped
+
+        class MappedBitArray
+        {
+        public:
+            /// @brief Creates a new bit array file, replacing any existing file, with every bit cleared.
+            /// @param path Location of the file.
+            /// @param size Number of bits held by the array.
+            /// @return The writable mapping of the new file.
+            static MappedBitArray create(const std::string &path, size_t size);
+
+            /// @brief Creates a new bit array file holding a copy of @p bitVector.
+            /// @param path Location of the file.
+            /// @param bitVector The bits to store.
+            /// @return The writable mapping of the new file.
+            static MappedBitArray create(const std::string &path, const BitVector &bitVector);
+
+            /// @brief Maps an existing bit array file.
+            /// @param path Location of the file.
+            /// @param writable Whether the mapping may be modified.  Changes are written back to the file.
+            /// @return The mapping of the file.
+            static MappedBitArray open(const std::string &path, bool writable = false);
+
+            MappedBitArray(MappedBitArray &&other) noexcept;
+            MappedBitArray &operator=(MappedBitArray &&other) noexcept;
+
+            MappedBitArray(const MappedBitArray &) = delete;
+            MappedBitArray &operator=(const MappedBitArray &) = delete;
+
+            /// @brief Destructor.  Unmaps the file; dirty pages are written back by the kernel.
+            ~MappedBitArray();
+
+            /// @brief Gets the number of bits held by the array.
+            size_t size() const;
+
+            /// @brief Gets the number of 64-bit words backing the array.
+            size_t wordCount() const;
+
+            /// @brief Read-only access to the mapped words.
+            const uint64_t *words() const;
+
+            /// @brief Mutable access to the mapped words.
+            /// @note Throws if the array was opened read-only.
+            uint64_t *words();
+
+            /// @brief Whether the mapping may be modified.
+            bool writable() const;
+
+            /// @brief Reads a single bit.
+            /// @param index Position of the bit.
+            bool test(size_t index) const;
+
+            /// @brief Sets a single bit to one.
+            /// @param index Position of the bit.
+            void set(size_t index);
+
+            /// @brief Sets a single bit to zero.
+            /// @param index Position of the bit.
+            void reset(size_t index);
+
+            /// @brief Counts every set bit.
+            size_t count() const;
+
+            /// @brief Counts every set bit, splitting the words across the pool's threads.
+            size_t count(libdsa::common::ThreadPool &pool) const;
+
+            /// @brief Tells the kernel the words will be read front to back so it can read ahead aggressively.
+            void adviseSequential() const;
+
+            /// @brief Blocks until every modified page has been written to the file.
+            void sync();
+
+            /// @brief Stores @p operation between @p left and @p right into this array, using every pool thread.
+            /// @param operation The logical operation to apply.
+            /// @param left First operand.
+            /// @param right Second operand.
+            /// @param pool Threads used to process the words.
+            /// @note All three arrays must hold the same number of bits.  This array may be one of the operands.
+            void assign(mapped::Operation operation, const MappedBitArray &left, const MappedBitArray &right,
+                        libdsa::common::ThreadPool &pool);
+
+        private:
+            /// @brief Constructor used by the factories once a file has been mapped.
+            MappedBitArray(int fileDescriptor, void *mapping, size_t mappingBytes, bool writable);
+
+            /// @brief Releases the mapping and file descriptor.
+            void _release();
+
+            /// @brief Throws a @c std::runtime_error that includes the current @c errno description.
+            [[noreturn]] static void _throwError(const std::string &message);
+
+            int _fileDescriptor;
+            void *_mapping;
+            size_t _mappingBytes;
+            bool _writable;
+        }; // MappedBitArray
+
+        inline libdsa::structures::MappedBitArray::MappedBitArray(int fileDescriptor, void *mapping,
+                                                                  size_t mappingBytes, bool writable)
+            : _fileDescriptor(fileDescriptor), _mapping(mapping), _mappingBytes(mappingBytes), _writable(writable)
+        {
+            // Intentionally empty constructor.
+        }
+
+        inline void libdsa::structures::MappedBitArray::_throwError(const std::string &message)
+        {
+            throw std::runtime_error("MappedBitArray - " + message + ": " + std::strerror(errno));
+        }
+
+        inline libdsa::structures::MappedBitArray libdsa::structures::MappedBitArray::create(const std::string &path,
+                                                                                             size_t size)
+        {
+            const size_t wordCount = bits::wordsFor(size);
+            const size_t bytes = sizeof(mapped::Header) + wordCount * sizeof(uint64_t);
+
+            const int fileDescriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+            if (fileDescriptor < 0)
+            {
+                _throwError("Unable to create " + path);
+            }
+
+            // A freshly extended file reads back as zeros, so the words need no explicit clearing.
+            if (::ftruncate(fileDescriptor, static_cast<off_t>(bytes)) != 0)
+            {
+                ::close(fileDescriptor);
+                _throwError("Unable to size " + path);
+            }
+
+            void *mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+
+            if (mapping == MAP_FAILED)
+            {
+                ::close(fileDescriptor);
+                _throwError("Unable to map " + path);
+            }
+
+            mapped::Header *header = static_cast<mapped::Header *>(mapping);
+            header->magic = mapped::MAGIC;
+            header->version = mapped::VERSION;
+            header->reserved = 0;
+            header->bitCount = size;
+            header->wordCount = wordCount;
+
+            return MappedBitArray(fileDescriptor, mapping, bytes, true);
+        }
+
+        inline libdsa::structures::MappedBitArray libdsa::structures::MappedBitArray::create(const std::string &path,
+                                                                                             const BitVector &bitVector)
+        {
+            MappedBitArray result = create(path, bitVector.size());
+            std::memcpy(result.words(), bitVector.words(), bitVector.wordCount() * sizeof(uint64_t));
+            return result;
+        }
+
+        inline libdsa::structures::MappedBitArray libdsa::structures::MappedBitArray::open(const std::string &path,
+                                                                                           bool writable)
+        {
+            const int fileDescriptor = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+
+            if (fileDescriptor < 0)
+            {
+                _throwError("Unable to open " + path);
+            }
+
+            struct stat status;
+
+            if (::fstat(fileDescriptor, &status) != 0)
+            {
+                ::close(fileDescriptor);
+                _throwError("Unable to stat " + path);
+            }
+
+            const size_t bytes = static_cast<size_t>(status.st_size);
+
+            if (bytes < sizeof(mapped::Header))
+            {
+                ::close(fileDescriptor);
+                throw std::runtime_error("MappedBitArray - " + path + " is too small to be a bit array file.");
+            }
+
+            void *mapping = ::mmap(nullptr, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED,
+                                   fileDescriptor, 0);
+
+            if (mapping == MAP_FAILED)
+            {
+                ::close(fileDescriptor);
+                _throwError("Unable to map " + path);
+            }
+
+            MappedBitArray result(fileDescriptor, mapping, bytes, writable);
+            const mapped::Header *header = static_cast<const mapped::Header *>(mapping);
+
+            // Rounding a bit count this close to the top of the range up to whole words would wrap around.
+            if (header->magic != mapped::MAGIC || header->version != mapped::VERSION ||
+                header->bitCount > SIZE_MAX - (bits::WORD_BITS - 1) ||
+                header->wordCount != bits::wordsFor(header->bitCount) ||
+                bytes < sizeof(mapped::Header) + header->wordCount * sizeof(uint64_t))
+            {
+                throw std::runtime_error("MappedBitArray - " + path + " is not a valid bit array file.");
+            }
+
+            return result;
+        }
+
+        inline libdsa::structures::MappedBitArray::MappedBitArray(MappedBitArray &&other) noexcept
+            : _fileDescriptor(other._fileDescriptor), _mapping(other._mapping), _mappingBytes(other._mappingBytes),
+              _writable(other._writable)
+        {
+            other._fileDescriptor = -1;
+            other._mapping = nullptr;
+            other._mappingBytes = 0;
+        }
+
+        inline libdsa::structures::MappedBitArray &libdsa::structures::MappedBitArray::operator=(
+            MappedBitArray &&other) noexcept
+        {
+            if (this != &other)
+            {
+                _release();
+
+                _fileDescriptor = other._fileDescriptor;
+                _mapping = other._mapping;
+                _mappingBytes = other._mappingBytes;
+                _writable = other._writable;
+
+                other._fileDescriptor = -1;
+                other._mapping = nullptr;
+                other._mappingBytes = 0;
+            }
+
+            return *this;
+        }
+
+        inline libdsa::structures::MappedBitArray::~MappedBitArray()
+        {
+            _release();
+        }
+
+        inline void libdsa::structures::MappedBitArray::_release()
+        {
+            if (_mapping != nullptr)
+            {
+                ::munmap(_mapping, _mappingBytes);
+                _mapping = nullptr;
+            }
+
+            if (_fileDescriptor >= 0)
+            {
+                ::close(_fileDescriptor);
+                _fileDescriptor = -1;
+            }
+        }
+
+        inline size_t libdsa::structures::MappedBitArray::size() const
+        {
+            return static_cast<const mapped::Header *>(_mapping)->bitCount;
+        }
+
+        inline size_t libdsa::structures::MappedBitArray::wordCount() const
+        {
+            return static_cast<const mapped::Header *>(_mapping)->wordCount;
+        }
+
+        inline const uint64_t *libdsa::structures::MappedBitArray::words() const
+        {
+            return reinterpret_cast<const uint64_t *>(static_cast<const char *>(_mapping) + sizeof(mapped::Header));
+        }
+
+        inline uint64_t *libdsa::structures::MappedBitArray::words()
+        {
+            if (!_writable)
+            {
+                throw std::runtime_error("MappedBitArray - Cannot modify a bit array opened read-only.");
+            }
+
+            return reinterpret_cast<uint64_t *>(static_cast<char *>(_mapping) + sizeof(mapped::Header));
+        }
+
+        inline bool libdsa::structures::MappedBitArray::writable() const
+        {
+            return _writable;
+        }
+
+        inline bool libdsa::structures::MappedBitArray::test(size_t index) const
+        {
+            return (words()[index / bits::WORD_BITS] >> (index % bits::WORD_BITS)) & 1U;
+        }
+
+        inline void libdsa::structures::MappedBitArray::set(size_t index)
+        {
+            words()[index / bits::WORD_BITS] |= uint64_t(1) << (index % bits::WORD_BITS);
+        }
+
+        inline void libdsa::structures::MappedBitArray::reset(size_t index)
+        {
+            words()[index / bits::WORD_BITS] &= ~(uint64_t(1) << (index % bits::WORD_BITS));
+        }
+
+        inline size_t libdsa::structures::MappedBitArray::count() const
+        {
+            const uint64_t *data = words();
+            size_t total = 0;
+
+            for (size_t i = 0; i < wordCount(); ++i)
+            {
+                total += bits::popcount(data[i]);
+            }
+
+            return total;
+        }
+
+        inline size_t libdsa::structures::MappedBitArray::count(libdsa::common::ThreadPool &pool) const
+        {
+            const uint64_t *data = words();
+            std::atomic<size_t> total{0};
+
+            pool.parallelFor(0, wordCount(), mapped::WORD_GRAIN, [data, &total](size_t begin, size_t end)
+            {
+                size_t local = 0;
+
+                for (size_t i = begin; i < end; ++i)
+                {
+                    local += bits::popcount(data[i]);
+                }
+
+                total.fetch_add(local, std::memory_order_relaxed);
+            });
+
+            return total.load();
+        }
+
+        inline void libdsa::structures::MappedBitArray::adviseSequential() const
+        {
+            ::madvise(_mapping, _mappingBytes, MADV_SEQUENTIAL);
+        }
+
+        inline void libdsa::structures::MappedBitArray::sync()
+        {
+            if (_writable && ::msync(_mapping, _mappingBytes, MS_SYNC) != 0)
+            {
+                _throwError("Unable to sync mapping");
+            }
+        }
+
+        inline void libdsa::structures::MappedBitArray::assign(mapped::Operation operation, const MappedBitArray &left,
+                                                               const MappedBitArray &right,
+                                                               libdsa::common::ThreadPool &pool)
+        {
+            if (left.size() != right.size() || left.size() != size())
+            {
+                throw std::runtime_error("MappedBitArray - Bit arrays must be the same size.");
+            }
+
+            mapped::parallelApply(operation, left.words(), right.words(), words(), wordCount(), pool);
+        }
+    } // structures
+} // libdsa
+
+#endif // MAPPEDBITARRAY_H_
+
+/// @}
@@ -0,0 +1,246 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file rankselect
+/// @brief Contains declaration and definition of a succinct rank/select index over a @c BitVector.
+/// @{
+
+#ifndef RANKSELECT_H_
+#define RANKSELECT_H_
+
+/// @details The index stores an absolute count of set bits before every superblock of 4096 bits and a 16-bit count
+/// relative to its superblock before every block of 512 bits, which adds roughly 4.7% on top of the bits themselves.
+/// A rank query reads one superblock count, one block count and popcounts at most eight words.  Select additionally
+/// keeps the superblock holding every 8192nd set bit, so it only has to binary search between two samples before
+/// finishing with the same block and word scan.
+
+// From C++ STL
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// From libbitarray
+#include <bitops.h>
+#include <bitvector.h>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        class RankSelect
+        {
+        public:
+            /// @brief Number of bits covered by one superblock count.
+            static constexpr size_t SUPERBLOCK_BITS = 4096;
+
+            /// @brief Number of bits covered by one block count.
+            static constexpr size_t BLOCK_BITS = 512;
+
+            /// @brief Distance in set bits between two select samples.
+            static constexpr size_t SELECT_SAMPLE_RATE = 8192;
+
+            /// @brief Constructor.  Builds the index in a single pass over the words.
+            /// @param bitVector The bit array to index.  It must outlive the index and must not be modified
+            ///                  while the index is in use.
+            explicit RankSelect(const BitVector &bitVector);
+
+            /// @brief Counts the set bits strictly before @p position.
+            /// @param position A position in [0, size()].
+            /// @return The number of set bits in [0, position).
+            size_t rank1(size_t position) const;
+
+            /// @brief Counts the cleared bits strictly before @p position.
+            /// @param position A position in [0, size()].
+            /// @return The number of cleared bits in [0, position).
+            size_t rank0(size_t position) const;
+
+            /// @brief Finds the position of the @p rank-th set bit.
+            /// @param rank Zero based rank of the set bit.  Must be less than @c count().
+            /// @return The position of the set bit.
+            size_t select1(size_t rank) const;
+
+            /// @brief Gets the total number of set bits in constant time.
+            /// @return The number of set bits.
+            size_t count() const;
+
+            /// @brief Gets the number of bits covered by the index.
+            /// @return The number of bits.
+            size_t size() const;
+
+            /// @brief Gets the memory used by the index on top of the bit array.
+            /// @return The size of the index in bytes.
+            size_t indexBytes() const;
+
+        private:
+            static constexpr size_t WORDS_PER_BLOCK = BLOCK_BITS / bits::WORD_BITS;
+            static constexpr size_t BLOCKS_PER_SUPERBLOCK = SUPERBLOCK_BITS / BLOCK_BITS;
+
+            /// @brief The indexed bit array.
+            const BitVector &_bitVector;
+
+            /// @brief Number of set bits before each superblock, plus a trailing total.
+            std::vector<uint64_t> _superblocks;
+
+            /// @brief Number of set bits before each block, relative to the start of its superblock.
+            std::vector<uint16_t> _blocks;
+
+            /// @brief Superblock containing every @c SELECT_SAMPLE_RATE th set bit.
+            std::vector<uint32_t> _selectSamples;
+
+            /// @brief Total number of set bits.
+            size_t _ones;
+        }; // RankSelect
+
+        inline libdsa::structures::RankSelect::RankSelect(const BitVector &bitVector)
+            : _bitVector(bitVector), _ones(0)
+        {
+            const uint64_t *words = _bitVector.words();
+            const size_t wordCount = _bitVector.wordCount();
+            const size_t blockCount = (wordCount + WORDS_PER_BLOCK - 1) / WORDS_PER_BLOCK;
+
+            _superblocks.reserve(blockCount / BLOCKS_PER_SUPERBLOCK + 2);
+            _blocks.reserve(blockCount);
+
+            size_t superblockBase = 0;
+
+            for (size_t block = 0; block < blockCount; ++block)
+            {
+                if (block % BLOCKS_PER_SUPERBLOCK == 0)
+                {
+                    superblockBase = _ones;
+                    _superblocks.push_back(superblockBase);
+                }
+
+                _blocks.push_back(static_cast<uint16_t>(_ones - superblockBase));
+
+                const size_t end = std::min(wordCount, (block + 1) * WORDS_PER_BLOCK);
+
+                for (size_t word = block * WORDS_PER_BLOCK; word < end; ++word)
+                {
+                    const unsigned ones = bits::popcount(words[word]);
+
+                    // Record the superblock whenever a sample boundary falls inside this word.
+                    while (_selectSamples.size() * SELECT_SAMPLE_RATE < _ones + ones)
+                    {
+                        _selectSamples.push_back(static_cast<uint32_t>(_superblocks.size() - 1));
+                    }
+
+                    _ones += ones;
+                }
+            }
+
+            _superblocks.push_back(_ones);
+        }
+
+        inline size_t libdsa::structures::RankSelect::rank1(size_t position) const
+        {
+            if (position > _bitVector.size())
+            {
+                throw std::out_of_range("RankSelect - Rank position is past the end of the bit array.");
+            }
+
+            if (position == _bitVector.size())
+            {
+                return _ones;
+            }
+
+            const uint64_t *words = _bitVector.words();
+            const size_t wordIndex = position / bits::WORD_BITS;
+            const size_t block = wordIndex / WORDS_PER_BLOCK;
+
+            size_t result = _superblocks[position / SUPERBLOCK_BITS] + _blocks[block];
+
+            for (size_t word = block * WORDS_PER_BLOCK; word < wordIndex; ++word)
+            {
+                result += bits::popcount(words[word]);
+            }
+
+            return result + bits::popcount(words[wordIndex] & bits::lowMask(position % bits::WORD_BITS));
+        }
+
+        inline size_t libdsa::structures::RankSelect::rank0(size_t position) const
+        {
+            return position - rank1(position);
+        }
+
+        inline size_t libdsa::structures::RankSelect::select1(size_t rank) const
+        {
+            if (rank >= _ones)
+            {
+                throw std::out_of_range("RankSelect - Select rank exceeds the number of set bits.");
+            }
+
+            // Binary search for the last superblock starting with no more than rank set bits, bounded by the
+            // samples on either side of the requested rank.
+            const size_t sample = rank / SELECT_SAMPLE_RATE;
+            size_t low = _selectSamples[sample];
+            size_t high = sample + 1 < _selectSamples.size() ? _selectSamples[sample + 1] + 1
+                                                              : _superblocks.size() - 1;
+
+            while (high - low > 1)
+            {
+                const size_t middle = low + (high - low) / 2;
+
+                if (_superblocks[middle] <= rank)
+                {
+                    low = middle;
+                }
+                else
+                {
+                    high = middle;
+                }
+            }
+
+            size_t remaining = rank - _superblocks[low];
+
+            // Walk the blocks of the superblock.
+            size_t block = low * BLOCKS_PER_SUPERBLOCK;
+            const size_t lastBlock = std::min(_blocks.size(), block + BLOCKS_PER_SUPERBLOCK);
+
+            while (block + 1 < lastBlock && _blocks[block + 1] <= remaining)
+            {
+                ++block;
+            }
+
+            remaining -= _blocks[block];
+
+            // Walk the words of the block.
+            const uint64_t *words = _bitVector.words();
+            size_t word = block * WORDS_PER_BLOCK;
+
+            for (;; ++word)
+            {
+                const unsigned ones = bits::popcount(words[word]);
+
+                if (remaining < ones)
+                {
+                    break;
+                }
+
+                remaining -= ones;
+            }
+
+            return word * bits::WORD_BITS + bits::selectInWord(words[word], static_cast<unsigned>(remaining));
+        }
+
+        inline size_t libdsa::structures::RankSelect::count() const
+        {
+            return _ones;
+        }
+
+        inline size_t libdsa::structures::RankSelect::size() const
+        {
+            return _bitVector.size();
+        }
+
+        inline size_t libdsa::structures::RankSelect::indexBytes() const
+        {
+            return _superblocks.size() * sizeof(uint64_t) + _blocks.size() * sizeof(uint16_t) +
+                   _selectSamples.size() * sizeof(uint32_t);
+        }
+    } // structures
+} // libdsa
+
+#endif // RANKSELECT_H_
+
+/// @}
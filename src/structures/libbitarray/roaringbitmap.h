@@ -0,0 +1,1091 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file roaringbitmap
+/// @brief Contains declaration and definition of a compressed Roaring-style bitmap over 32-bit keys.
+/// @{
+
+#ifndef ROARINGBITMAP_H_
+#define ROARINGBITMAP_H_
+
+/// @details The 32-bit key space is split into 65536 chunks addressed by the upper 16 bits of a key.  Only chunks
+/// holding at least one key get a container, and each container picks the cheapest of three layouts for the lower
+/// 16 bits:
+///     - Array:  a sorted list of values, used while the chunk holds at most 4096 keys.
+///     - Bitmap: 1024 words covering the whole chunk, used for denser chunks.
+///     - Run:    a sorted list of [start, start + length] intervals, chosen by @c runOptimize() or produced by
+///               operations between two run containers when that is the smallest layout.
+/// Logical operations walk both key lists in step and combine matching containers directly, so a set is never
+/// expanded into a dense bit array.
+
+// From C++ STL
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// From libbitarray
+#include <bitops.h>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace roaring
+        {
+            /// @brief Maximum number of values held by an array container before it becomes a bitmap.
+            constexpr uint32_t ARRAY_MAX_SIZE = 4096;
+
+            /// @brief Number of words in a bitmap container.
+            constexpr uint32_t BITMAP_WORDS = 65536 / 64;
+
+            enum class ContainerType : uint8_t
+            {
+                ARRAY,
+                BITMAP,
+                RUN,
+            };
+
+            /// @brief The logical operation being applied between two containers.
+            using Operation = bits::Operation;
+
+            /// @brief A closed interval [start, start + length] of values.
+            struct Run
+            {
+                uint16_t start;
+                uint16_t length;
+            };
+
+            /// @brief Storage for the lower 16 bits of every key within one chunk.  Only the vector matching
+            ///        @c type holds data.
+            struct Container
+            {
+                ContainerType type = ContainerType::ARRAY;
+                uint32_t cardinality = 0;
+                std::vector<uint16_t> array;
+                std::vector<uint64_t> bitmap;
+                std::vector<Run> runs;
+
+                /// @brief Size in bytes of the payload for the current layout.
+                size_t sizeInBytes() const
+                {
+                    switch (type)
+                    {
+                        case ContainerType::ARRAY:
+                            return array.size() * sizeof(uint16_t);
+                        case ContainerType::BITMAP:
+                            return BITMAP_WORDS * sizeof(uint64_t);
+                        case ContainerType::RUN:
+                            return runs.size() * sizeof(Run);
+                    }
+
+                    return 0;
+                }
+            }; // Container
+
+            /// @brief Sets every bit in the half-open range [start, end) of a bitmap container's words.
+            inline void setRange(std::vector<uint64_t> &words, uint32_t start, uint32_t end)
+            {
+                if (start >= end)
+                {
+                    return;
+                }
+
+                const uint32_t firstWord = start / 64;
+                const uint32_t lastWord = (end - 1) / 64;
+                const uint64_t firstMask = ~uint64_t(0) << (start % 64);
+                const uint64_t lastMask = bits::lowMask(((end - 1) % 64) + 1);
+
+                if (firstWord == lastWord)
+                {
+                    words[firstWord] |= firstMask & lastMask;
+                    return;
+                }
+
+                words[firstWord] |= firstMask;
+
+                for (uint32_t word = firstWord + 1; word < lastWord; ++word)
+                {
+                    words[word] = ~uint64_t(0);
+                }
+
+                words[lastWord] |= lastMask;
+            }
+
+            /// @brief Number of runs of consecutive set bits within a bitmap container.
+            inline uint32_t countRuns(const std::vector<uint64_t> &words)
+            {
+                uint32_t runs = 0;
+
+                for (uint32_t i = 0; i < BITMAP_WORDS; ++i)
+                {
+                    const uint64_t word = words[i];
+                    const uint64_t next = i + 1 < BITMAP_WORDS ? words[i + 1] : 0;
+
+                    // A run ends wherever a set bit is followed by a cleared bit.
+                    runs += bits::popcount(word & ~((word >> 1) | (next << 63)));
+                }
+
+                return runs;
+            }
+
+            /// @brief Materializes any container as a bitmap container's word array.
+            inline std::vector<uint64_t> toBitmapWords(const Container &container)
+            {
+                if (container.type == ContainerType::BITMAP)
+                {
+                    return container.bitmap;
+                }
+
+                std::vector<uint64_t> words(BITMAP_WORDS, 0);
+
+                if (container.type == ContainerType::ARRAY)
+                {
+                    for (uint16_t value : container.array)
+                    {
+                        words[value / 64] |= uint64_t(1) << (value % 64);
+                    }
+                }
+                else
+                {
+                    for (const Run &run : container.runs)
+                    {
+                        setRange(words, run.start, uint32_t(run.start) + run.length + 1);
+                    }
+                }
+
+                return words;
+            }
+
+            /// @brief Builds a container from bitmap words, picking an array layout when it is small enough.
+            inline Container fromBitmapWords(std::vector<uint64_t> &&words)
+            {
+                Container result;
+
+                for (uint64_t word : words)
+                {
+                    result.cardinality += bits::popcount(word);
+                }
+
+                if (result.cardinality > ARRAY_MAX_SIZE)
+                {
+                    result.type = ContainerType::BITMAP;
+                    result.bitmap = std::move(words);
+                    return result;
+                }
+
+                result.type = ContainerType::ARRAY;
+                result.array.reserve(result.cardinality);
+
+                for (uint32_t i = 0; i < BITMAP_WORDS; ++i)
+                {
+                    for (uint64_t word = words[i]; word != 0; word &= word - 1)
+                    {
+                        result.array.push_back(static_cast<uint16_t>(i * 64 + bits::countTrailingZeros(word)));
+                    }
+                }
+
+                return result;
+            }
+
+            /// @brief Builds a container from a sorted array of values, promoting it to a bitmap if too large.
+            inline Container fromArray(std::vector<uint16_t> &&values)
+            {
+                Container result;
+                result.cardinality = static_cast<uint32_t>(values.size());
+
+                if (result.cardinality > ARRAY_MAX_SIZE)
+                {
+                    result.type = ContainerType::BITMAP;
+                    result.bitmap.assign(BITMAP_WORDS, 0);
+
+                    for (uint16_t value : values)
+                    {
+                        result.bitmap[value / 64] |= uint64_t(1) << (value % 64);
+                    }
+                }
+                else
+                {
+                    result.type = ContainerType::ARRAY;
+                    result.array = std::move(values);
+                }
+
+                return result;
+            }
+
+            /// @brief Builds a container from half-open intervals, keeping whichever layout is smallest.
+            inline Container fromIntervals(const std::vector<std::pair<uint32_t, uint32_t>> &intervals)
+            {
+                Container result;
+
+                for (const auto &interval : intervals)
+                {
+                    result.cardinality += interval.second - interval.first;
+                }
+
+                const size_t runBytes = intervals.size() * sizeof(Run);
+                const size_t arrayBytes = result.cardinality * sizeof(uint16_t);
+
+                if (runBytes <= arrayBytes && runBytes <= BITMAP_WORDS * sizeof(uint64_t))
+                {
+                    result.type = ContainerType::RUN;
+                    result.runs.reserve(intervals.size());
+
+                    for (const auto &interval : intervals)
+                    {
+                        result.runs.push_back({static_cast<uint16_t>(interval.first),
+                                               static_cast<uint16_t>(interval.second - interval.first - 1)});
+                    }
+                }
+                else if (result.cardinality <= ARRAY_MAX_SIZE)
+                {
+                    result.type = ContainerType::ARRAY;
+                    result.array.reserve(result.cardinality);
+
+                    for (const auto &interval : intervals)
+                    {
+                        for (uint32_t value = interval.first; value < interval.second; ++value)
+                        {
+                            result.array.push_back(static_cast<uint16_t>(value));
+                        }
+                    }
+                }
+                else
+                {
+                    result.type = ContainerType::BITMAP;
+                    result.bitmap.assign(BITMAP_WORDS, 0);
+
+                    for (const auto &interval : intervals)
+                    {
+                        setRange(result.bitmap, interval.first, interval.second);
+                    }
+                }
+
+                return result;
+            }
+
+            /// @brief Applies @p operation to two membership flags.
+            inline bool apply(Operation operation, bool left, bool right)
+            {
+                switch (operation)
+                {
+                    case Operation::AND:
+                        return left && right;
+                    case Operation::OR:
+                        return left || right;
+                    case Operation::XOR:
+                        return left != right;
+                    case Operation::DIFFERENCE:
+                        return left && !right;
+                }
+
+                return false;
+            }
+
+            /// @brief Combines two array containers with a single merge pass.
+            inline Container arrayArray(const Container &left, const Container &right, Operation operation)
+            {
+                std::vector<uint16_t> result;
+                result.reserve(operation == Operation::AND ? std::min(left.array.size(), right.array.size())
+                                                           : left.array.size() + right.array.size());
+                size_t i = 0;
+                size_t j = 0;
+
+                while (i < left.array.size() && j < right.array.size())
+                {
+                    if (left.array[i] < right.array[j])
+                    {
+                        if (apply(operation, true, false))
+                        {
+                            result.push_back(left.array[i]);
+                        }
+                        ++i;
+                    }
+                    else if (right.array[j] < left.array[i])
+                    {
+                        if (apply(operation, false, true))
+                        {
+                            result.push_back(right.array[j]);
+                        }
+                        ++j;
+                    }
+                    else
+                    {
+                        if (apply(operation, true, true))
+                        {
+                            result.push_back(left.array[i]);
+                        }
+                        ++i;
+                        ++j;
+                    }
+                }
+
+                if (apply(operation, true, false))
+                {
+                    result.insert(result.end(), left.array.begin() + i, left.array.end());
+                }
+
+                if (apply(operation, false, true))
+                {
+                    result.insert(result.end(), right.array.begin() + j, right.array.end());
+                }
+
+                return fromArray(std::move(result));
+            }
+
+            /// @brief Combines two containers word by word as bitmaps.
+            inline Container bitmapBitmap(const std::vector<uint64_t> &left, const std::vector<uint64_t> &right,
+                                          Operation operation)
+            {
+                std::vector<uint64_t> result(BITMAP_WORDS);
+
+                for (uint32_t i = 0; i < BITMAP_WORDS; ++i)
+                {
+                    result[i] = bits::applyWord(operation, left[i], right[i]);
+                }
+
+                return fromBitmapWords(std::move(result));
+            }
+
+            /// @brief Combines an array container with a bitmap container.
+            /// @param arrayOnLeft Whether the array container is the left operand.
+            inline Container arrayBitmap(const Container &array, const Container &bitmap, Operation operation,
+                                         bool arrayOnLeft)
+            {
+                const auto inBitmap = [&bitmap](uint16_t value)
+                {
+                    return (bitmap.bitmap[value / 64] >> (value % 64)) & 1U;
+                };
+
+                // Operations whose result is a subset of the array can simply filter it.
+                if (operation == Operation::AND || (operation == Operation::DIFFERENCE && arrayOnLeft))
+                {
+                    std::vector<uint16_t> result;
+
+                    for (uint16_t value : array.array)
+                    {
+                        if (inBitmap(value) == (operation == Operation::AND))
+                        {
+                            result.push_back(value);
+                        }
+                    }
+
+                    return fromArray(std::move(result));
+                }
+
+                std::vector<uint64_t> result = bitmap.bitmap;
+
+                for (uint16_t value : array.array)
+                {
+                    const uint64_t mask = uint64_t(1) << (value % 64);
+
+                    switch (operation)
+                    {
+                        case Operation::OR:
+                            result[value / 64] |= mask;
+                            break;
+                        case Operation::XOR:
+                            result[value / 64] ^= mask;
+                            break;
+                        default:
+                            // Bitmap minus array.
+                            result[value / 64] &= ~mask;
+                            break;
+                    }
+                }
+
+                return fromBitmapWords(std::move(result));
+            }
+
+            /// @brief Combines two run containers by sweeping over the union of their interval boundaries.
+            inline Container runRun(const Container &left, const Container &right, Operation operation)
+            {
+                std::vector<uint32_t> boundaries;
+                boundaries.reserve(2 * (left.runs.size() + right.runs.size()));
+
+                for (const Container *container : {&left, &right})
+                {
+                    for (const Run &run : container->runs)
+                    {
+                        boundaries.push_back(run.start);
+                        boundaries.push_back(uint32_t(run.start) + run.length + 1);
+                    }
+                }
+
+                std::sort(boundaries.begin(), boundaries.end());
+                boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+
+                std::vector<std::pair<uint32_t, uint32_t>> intervals;
+                size_t i = 0;
+                size_t j = 0;
+
+                for (size_t k = 0; k + 1 < boundaries.size(); ++k)
+                {
+                    const uint32_t position = boundaries[k];
+
+                    while (i < left.runs.size() && uint32_t(left.runs[i].start) + left.runs[i].length < position)
+                    {
+                        ++i;
+                    }
+
+                    while (j < right.runs.size() && uint32_t(right.runs[j].start) + right.runs[j].length < position)
+                    {
+                        ++j;
+                    }
+
+                    const bool inLeft = i < left.runs.size() && left.runs[i].start <= position;
+                    const bool inRight = j < right.runs.size() && right.runs[j].start <= position;
+
+                    if (!apply(operation, inLeft, inRight))
+                    {
+                        continue;
+                    }
+
+                    if (!intervals.empty() && intervals.back().second == position)
+                    {
+                        intervals.back().second = boundaries[k + 1];
+                    }
+                    else
+                    {
+                        intervals.emplace_back(position, boundaries[k + 1]);
+                    }
+                }
+
+                return fromIntervals(intervals);
+            }
+
+            /// @brief Filters an array container against a run container.
+            /// @param keep Whether to keep values inside the runs (intersection) or outside them (difference).
+            inline Container arrayRunFilter(const Container &array, const Container &run, bool keep)
+            {
+                std::vector<uint16_t> result;
+                size_t r = 0;
+
+                for (uint16_t value : array.array)
+                {
+                    while (r < run.runs.size() && uint32_t(run.runs[r].start) + run.runs[r].length < value)
+                    {
+                        ++r;
+                    }
+
+                    const bool inside = r < run.runs.size() && run.runs[r].start <= value;
+
+                    if (inside == keep)
+                    {
+                        result.push_back(value);
+                    }
+                }
+
+                return fromArray(std::move(result));
+            }
+
+            /// @brief Dispatches a logical operation to the specialized routine for the two container layouts.
+            inline Container combine(const Container &left, const Container &right, Operation operation)
+            {
+                const ContainerType l = left.type;
+                const ContainerType r = right.type;
+
+                if (l == ContainerType::ARRAY && r == ContainerType::ARRAY)
+                {
+                    return arrayArray(left, right, operation);
+                }
+
+                if (l == ContainerType::RUN && r == ContainerType::RUN)
+                {
+                    return runRun(left, right, operation);
+                }
+
+                if (l == ContainerType::ARRAY && r == ContainerType::BITMAP)
+                {
+                    return arrayBitmap(left, right, operation, true);
+                }
+
+                if (l == ContainerType::BITMAP && r == ContainerType::ARRAY)
+                {
+                    return arrayBitmap(right, left, operation, false);
+                }
+
+                if (l == ContainerType::ARRAY && r == ContainerType::RUN &&
+                    (operation == Operation::AND || operation == Operation::DIFFERENCE))
+                {
+                    return arrayRunFilter(left, right, operation == Operation::AND);
+                }
+
+                if (l == ContainerType::RUN && r == ContainerType::ARRAY && operation == Operation::AND)
+                {
+                    return arrayRunFilter(right, left, true);
+                }
+
+                // Remaining mixes involving a run container are evaluated on this chunk's bitmap words.
+                return bitmapBitmap(toBitmapWords(left), toBitmapWords(right), operation);
+            }
+        } // roaring
+
+        class RoaringBitmap
+        {
+        public:
+            /// @brief Constructor for an empty bitmap.
+            RoaringBitmap() = default;
+
+            /// @brief Constructor from a list of keys in any order.  Duplicates are ignored.
+            /// @param values The keys to add.
+            explicit RoaringBitmap(const std::vector<uint32_t> &values);
+
+            /// @brief Adds a key.
+            /// @param value The key to add.
+            void add(uint32_t value);
+
+            /// @brief Removes a key if present.
+            /// @param value The key to remove.
+            void remove(uint32_t value);
+
+            /// @brief Checks whether a key is present.
+            /// @param value The key to look for.
+            /// @return Whether the key is present.
+            bool contains(uint32_t value) const;
+
+            /// @brief Gets the number of keys held by the bitmap.
+            /// @return The number of keys.
+            uint64_t cardinality() const;
+
+            /// @brief Checks whether the bitmap holds no keys.
+            bool empty() const;
+
+            /// @brief Converts every container to the run layout wherever that is the smallest layout.
+            void runOptimize();
+
+            /// @brief Gets the approximate memory footprint of the containers.
+            /// @return The size in bytes.
+            size_t sizeInBytes() const;
+
+            /// @brief Calls @p function once for every key in ascending order.
+            template <typename Function>
+            void forEach(Function function) const;
+
+            /// @brief Gets every key in ascending order.
+            /// @return A vector containing every key.
+            std::vector<uint32_t> toVector() const;
+
+            /// @brief Gets the layout of the container holding the chunk of @p value.  Used for diagnostics.
+            /// @param value Any key within the chunk.
+            /// @param type Filled with the container layout when the chunk exists.
+            /// @return Whether the chunk holds any keys.
+            bool containerType(uint32_t value, roaring::ContainerType &type) const;
+
+            /// @brief Logical AND between both bitmaps.
+            /// @return A bitmap containing the intersection of the two bitmaps.
+            RoaringBitmap AND(const RoaringBitmap &other) const;
+
+            /// @brief Logical difference between the two bitmaps.
+            /// @note Operation: difference = this AND (NOT other)
+            /// @return A bitmap containing the keys of this bitmap absent from @p other.
+            RoaringBitmap difference(const RoaringBitmap &other) const;
+
+            /// @brief Logical OR between both bitmaps.
+            /// @return A bitmap containing the union of the two bitmaps.
+            RoaringBitmap OR(const RoaringBitmap &other) const;
+
+            /// @brief Logical XOR between both bitmaps.
+            /// @return A bitmap containing the keys present in exactly one of the two bitmaps.
+            RoaringBitmap XOR(const RoaringBitmap &other) const;
+
+            bool operator==(const RoaringBitmap &other) const;
+
+        private:
+            /// @brief Walks both key lists and combines matching containers.
+            RoaringBitmap _combine(const RoaringBitmap &other, roaring::Operation operation) const;
+
+            /// @brief Finds the index of the container for @p key, or where it would be inserted.
+            size_t _lowerBound(uint16_t key) const;
+
+            /// @brief Sorted upper 16 bits of every populated chunk.
+            std::vector<uint16_t> _keys;
+
+            /// @brief Containers matching @c _keys one to one.
+            std::vector<roaring::Container> _containers;
+        }; // RoaringBitmap
+
+        inline libdsa::structures::RoaringBitmap::RoaringBitmap(const std::vector<uint32_t> &values)
+        {
+            std::vector<uint32_t> sorted(values);
+            std::sort(sorted.begin(), sorted.end());
+            sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+            // Build each chunk in one go rather than inserting key by key.
+            size_t begin = 0;
+
+            while (begin < sorted.size())
+            {
+                const uint16_t key = static_cast<uint16_t>(sorted[begin] >> 16);
+                size_t end = begin;
+                std::vector<uint16_t> low;
+
+                while (end < sorted.size() && (sorted[end] >> 16) == key)
+                {
+                    low.push_back(static_cast<uint16_t>(sorted[end] & 0xFFFF));
+                    ++end;
+                }
+
+                _keys.push_back(key);
+                _containers.push_back(roaring::fromArray(std::move(low)));
+                begin = end;
+            }
+        }
+
+        inline size_t libdsa::structures::RoaringBitmap::_lowerBound(uint16_t key) const
+        {
+            return static_cast<size_t>(std::lower_bound(_keys.begin(), _keys.end(), key) - _keys.begin());
+        }
+
+        inline void libdsa::structures::RoaringBitmap::add(uint32_t value)
+        {
+            const uint16_t key = static_cast<uint16_t>(value >> 16);
+            const uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+            const size_t index = _lowerBound(key);
+
+            if (index == _keys.size() || _keys[index] != key)
+            {
+                _keys.insert(_keys.begin() + index, key);
+                _containers.insert(_containers.begin() + index, roaring::fromArray({low}));
+                return;
+            }
+
+            roaring::Container &container = _containers[index];
+
+            switch (container.type)
+            {
+                case roaring::ContainerType::ARRAY:
+                {
+                    auto position = std::lower_bound(container.array.begin(), container.array.end(), low);
+
+                    if (position != container.array.end() && *position == low)
+                    {
+                        return;
+                    }
+
+                    container.array.insert(position, low);
+
+                    if (container.array.size() > roaring::ARRAY_MAX_SIZE)
+                    {
+                        container = roaring::fromArray(std::move(container.array));
+                    }
+                    else
+                    {
+                        ++container.cardinality;
+                    }
+                    break;
+                }
+                case roaring::ContainerType::BITMAP:
+                {
+                    uint64_t &word = container.bitmap[low / 64];
+                    const uint64_t mask = uint64_t(1) << (low % 64);
+
+                    if ((word & mask) == 0)
+                    {
+                        word |= mask;
+                        ++container.cardinality;
+                    }
+                    break;
+                }
+                case roaring::ContainerType::RUN:
+                {
+                    // First run starting after the value; the one before it is the only run that can contain it.
+                    auto next = std::upper_bound(container.runs.begin(), container.runs.end(), low,
+                                                 [](uint16_t v, const roaring::Run &run) { return v < run.start; });
+
+                    if (next != container.runs.begin())
+                    {
+                        const roaring::Run &previous = *(next - 1);
+                        if (uint32_t(previous.start) + previous.length >= low)
+                        {
+                            return;
+                        }
+                    }
+
+                    const bool extendsPrevious = next != container.runs.begin() &&
+                                                 uint32_t((next - 1)->start) + (next - 1)->length + 1 == low;
+                    const bool extendsNext = next != container.runs.end() && uint32_t(low) + 1 == next->start;
+
+                    if (extendsPrevious && extendsNext)
+                    {
+                        (next - 1)->length = static_cast<uint16_t>((next - 1)->length + next->length + 2);
+                        container.runs.erase(next);
+                    }
+                    else if (extendsPrevious)
+                    {
+                        ++(next - 1)->length;
+                    }
+                    else if (extendsNext)
+                    {
+                        --next->start;
+                        ++next->length;
+                    }
+                    else
+                    {
+                        container.runs.insert(next, {low, 0});
+                    }
+
+                    ++container.cardinality;
+                    break;
+                }
+            }
+        }
+
+        inline void libdsa::structures::RoaringBitmap::remove(uint32_t value)
+        {
+            const uint16_t key = static_cast<uint16_t>(value >> 16);
+            const uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+            const size_t index = _lowerBound(key);
+
+            if (index == _keys.size() || _keys[index] != key)
+            {
+                return;
+            }
+
+            roaring::Container &container = _containers[index];
+
+            switch (container.type)
+            {
+                case roaring::ContainerType::ARRAY:
+                {
+                    auto position = std::lower_bound(container.array.begin(), container.array.end(), low);
+
+                    if (position == container.array.end() || *position != low)
+                    {
+                        return;
+                    }
+
+                    container.array.erase(position);
+                    --container.cardinality;
+                    break;
+                }
+                case roaring::ContainerType::BITMAP:
+                {
+                    uint64_t &word = container.bitmap[low / 64];
+                    const uint64_t mask = uint64_t(1) << (low % 64);
+
+                    if ((word & mask) == 0)
+                    {
+                        return;
+                    }
+
+                    word &= ~mask;
+                    --container.cardinality;
+
+                    // Back to an array once it fits in one, mirroring the promotion in add().
+                    if (container.cardinality <= roaring::ARRAY_MAX_SIZE)
+                    {
+                        container = roaring::fromBitmapWords(std::move(container.bitmap));
+                    }
+                    break;
+                }
+                case roaring::ContainerType::RUN:
+                {
+                    auto next = std::upper_bound(container.runs.begin(), container.runs.end(), low,
+                                                 [](uint16_t v, const roaring::Run &run) { return v < run.start; });
+
+                    if (next == container.runs.begin() || uint32_t((next - 1)->start) + (next - 1)->length < low)
+                    {
+                        return;
+                    }
+
+                    roaring::Run &run = *(next - 1);
+                    const uint16_t last = static_cast<uint16_t>(run.start + run.length);
+
+                    if (run.length == 0)
+                    {
+                        container.runs.erase(next - 1);
+                    }
+                    else if (low == run.start)
+                    {
+                        ++run.start;
+                        --run.length;
+                    }
+                    else if (low == last)
+                    {
+                        --run.length;
+                    }
+                    else
+                    {
+                        // Splitting around the value leaves [start, low) and (low, last].
+                        run.length = static_cast<uint16_t>(low - run.start - 1);
+                        container.runs.insert(next, {static_cast<uint16_t>(low + 1),
+                                                     static_cast<uint16_t>(last - low - 1)});
+                    }
+
+                    --container.cardinality;
+
+                    // Splits add runs while the values drop, so the run layout may no longer be the smallest.
+                    const size_t runBytes = container.runs.size() * sizeof(roaring::Run);
+
+                    if (runBytes > container.cardinality * sizeof(uint16_t) ||
+                        runBytes > roaring::BITMAP_WORDS * sizeof(uint64_t))
+                    {
+                        std::vector<std::pair<uint32_t, uint32_t>> intervals;
+                        intervals.reserve(container.runs.size());
+
+                        for (const roaring::Run &kept : container.runs)
+                        {
+                            intervals.emplace_back(kept.start, uint32_t(kept.start) + kept.length + 1);
+                        }
+
+                        container = roaring::fromIntervals(intervals);
+                    }
+                    break;
+                }
+            }
+
+            if (container.cardinality == 0)
+            {
+                _keys.erase(_keys.begin() + index);
+                _containers.erase(_containers.begin() + index);
+            }
+        }
+
+        inline bool libdsa::structures::RoaringBitmap::contains(uint32_t value) const
+        {
+            const uint16_t key = static_cast<uint16_t>(value >> 16);
+            const uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+            const size_t index = _lowerBound(key);
+
+            if (index == _keys.size() || _keys[index] != key)
+            {
+                return false;
+            }
+
+            const roaring::Container &container = _containers[index];
+
+            switch (container.type)
+            {
+                case roaring::ContainerType::ARRAY:
+                    return std::binary_search(container.array.begin(), container.array.end(), low);
+                case roaring::ContainerType::BITMAP:
+                    return (container.bitmap[low / 64] >> (low % 64)) & 1U;
+                case roaring::ContainerType::RUN:
+                {
+                    auto next = std::upper_bound(container.runs.begin(), container.runs.end(), low,
+                                                 [](uint16_t v, const roaring::Run &run) { return v < run.start; });
+
+                    return next != container.runs.begin() &&
+                           uint32_t((next - 1)->start) + (next - 1)->length >= low;
+                }
+            }
+
+            return false;
+        }
+
+        inline uint64_t libdsa::structures::RoaringBitmap::cardinality() const
+        {
+            uint64_t total = 0;
+
+            for (const roaring::Container &container : _containers)
+            {
+                total += container.cardinality;
+            }
+
+            return total;
+        }
+
+        inline bool libdsa::structures::RoaringBitmap::empty() const
+        {
+            return _containers.empty();
+        }
+
+        inline void libdsa::structures::RoaringBitmap::runOptimize()
+        {
+            for (roaring::Container &container : _containers)
+            {
+                if (container.type == roaring::ContainerType::RUN)
+                {
+                    continue;
+                }
+
+                std::vector<uint64_t> words = roaring::toBitmapWords(container);
+
+                // Counting runs is cheap compared to building them, so skip containers that would not shrink.
+                if (roaring::countRuns(words) * sizeof(roaring::Run) >= container.sizeInBytes())
+                {
+                    continue;
+                }
+
+                std::vector<std::pair<uint32_t, uint32_t>> intervals;
+                uint32_t position = 0;
+
+                while (position < 65536)
+                {
+                    // Skip cleared bits, then measure the run of set bits.
+                    while (position < 65536 && ((words[position / 64] >> (position % 64)) & 1U) == 0)
+                    {
+                        const uint64_t remaining = words[position / 64] >> (position % 64);
+                        position += remaining == 0 ? 64 - (position % 64) : bits::countTrailingZeros(remaining);
+                    }
+
+                    const uint32_t start = position;
+
+                    while (position < 65536 && ((words[position / 64] >> (position % 64)) & 1U) == 1)
+                    {
+                        const uint64_t remaining = ~words[position / 64] >> (position % 64);
+                        position += remaining == 0 ? 64 - (position % 64) : bits::countTrailingZeros(remaining);
+                    }
+
+                    if (position > start)
+                    {
+                        intervals.emplace_back(start, position);
+                    }
+                }
+
+                container = roaring::fromIntervals(intervals);
+            }
+        }
+
+        inline size_t libdsa::structures::RoaringBitmap::sizeInBytes() const
+        {
+            size_t total = _keys.size() * sizeof(uint16_t);
+
+            for (const roaring::Container &container : _containers)
+            {
+                total += sizeof(roaring::Container) + container.sizeInBytes();
+            }
+
+            return total;
+        }
+
+        template <typename Function>
+        void libdsa::structures::RoaringBitmap::forEach(Function function) const
+        {
+            for (size_t i = 0; i < _keys.size(); ++i)
+            {
+                const uint32_t high = uint32_t(_keys[i]) << 16;
+                const roaring::Container &container = _containers[i];
+
+                switch (container.type)
+                {
+                    case roaring::ContainerType::ARRAY:
+                        for (uint16_t value : container.array)
+                        {
+                            function(high | value);
+                        }
+                        break;
+                    case roaring::ContainerType::BITMAP:
+                        for (uint32_t w = 0; w < roaring::BITMAP_WORDS; ++w)
+                        {
+                            for (uint64_t word = container.bitmap[w]; word != 0; word &= word - 1)
+                            {
+                                function(high | (w * 64 + bits::countTrailingZeros(word)));
+                            }
+                        }
+                        break;
+                    case roaring::ContainerType::RUN:
+                        for (const roaring::Run &run : container.runs)
+                        {
+                            for (uint32_t value = run.start; value <= uint32_t(run.start) + run.length; ++value)
+                            {
+                                function(high | value);
+                            }
+                        }
+                        break;
+                }
+            }
+        }
+
+        inline std::vector<uint32_t> libdsa::structures::RoaringBitmap::toVector() const
+        {
+            std::vector<uint32_t> result;
+            result.reserve(cardinality());
+
+            forEach([&result](uint32_t value) { result.push_back(value); });
+
+            return result;
+        }
+
+        inline bool libdsa::structures::RoaringBitmap::containerType(uint32_t value, roaring::ContainerType &type) const
+        {
+            const uint16_t key = static_cast<uint16_t>(value >> 16);
+            const size_t index = _lowerBound(key);
+
+            if (index == _keys.size() || _keys[index] != key)
+            {
+                return false;
+            }
+
+            type = _containers[index].type;
+            return true;
+        }
+
+        inline libdsa::structures::RoaringBitmap libdsa::structures::RoaringBitmap::_combine(
+            const RoaringBitmap &other, roaring::Operation operation) const
+        {
+            RoaringBitmap result;
+            size_t i = 0;
+            size_t j = 0;
+
+            const bool keepLeftOnly = roaring::apply(operation, true, false);
+            const bool keepRightOnly = roaring::apply(operation, false, true);
+
+            while (i < _keys.size() || j < other._keys.size())
+            {
+                if (j == other._keys.size() || (i < _keys.size() && _keys[i] < other._keys[j]))
+                {
+                    if (keepLeftOnly)
+                    {
+                        result._keys.push_back(_keys[i]);
+                        result._containers.push_back(_containers[i]);
+                    }
+                    ++i;
+                }
+                else if (i == _keys.size() || other._keys[j] < _keys[i])
+                {
+                    if (keepRightOnly)
+                    {
+                        result._keys.push_back(other._keys[j]);
+                        result._containers.push_back(other._containers[j]);
+                    }
+                    ++j;
+                }
+                else
+                {
+                    roaring::Container container = roaring::combine(_containers[i], other._containers[j], operation);
+
+                    if (container.cardinality != 0)
+                    {
+                        result._keys.push_back(_keys[i]);
+                        result._containers.push_back(std::move(container));
+                    }
+                    ++i;
+                    ++j;
+                }
+            }
+
+            return result;
+        }
+
+        inline libdsa::structures::RoaringBitmap libdsa::structures::RoaringBitmap::AND(const RoaringBitmap &other) const
+        {
+            return _combine(other, roaring::Operation::AND);
+        }
+
+        inline libdsa::structures::RoaringBitmap libdsa::structures::RoaringBitmap::difference(
+            const RoaringBitmap &other) const
+        {
+            return _combine(other, roaring::Operation::DIFFERENCE);
+        }
+
+        inline libdsa::structures::RoaringBitmap libdsa::structures::RoaringBitmap::OR(const RoaringBitmap &other) const
+        {
+            return _combine(other, roaring::Operation::OR);
+        }
+
+        inline libdsa::structures::RoaringBitmap libdsa::structures::RoaringBitmap::XOR(const RoaringBitmap &other) const
+        {
+            return _combine(other, roaring::Operation::XOR);
+        }
+
+        inline bool libdsa::structures::RoaringBitmap::operator==(const RoaringBitmap &other) const
+        {
+            return _keys == other._keys && toVector() == other.toVector();
+        }
+    } // structures
+} // libdsa
+
+#endif // ROARINGBITMAP_H_
+
+/// @}
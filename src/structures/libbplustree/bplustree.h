@@ -0,0 +1,930 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file bplustree
+/// @{
+
+#ifndef BPLUSTREE_H_
+#define BPLUSTREE_H_
+
+/// @details The @c BPlusTree is an ordered map whose nodes are sized to a few cache lines.  Each node keeps its keys
+/// in one contiguous array, apart from the values or child pointers, so a lookup only touches the key lines of the
+/// nodes on its path.  Inside a node the position of a key is found by counting the keys that compare below it,
+/// which has no data dependent branch and vectorizes for arithmetic keys.
+///
+/// Every element lives in a leaf and the leaves are chained in key order, so a range scan is one descent followed by
+/// a walk over contiguous arrays.  A tree built with @c BulkLoad is packed level by level from sorted input without
+/// any splitting.
+
+// From C++ STL
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// From libutilities
+#include <alignedallocator.h>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace tree
+        {
+            namespace bplustree
+            {
+                constexpr size_t alignUp(size_t bytes, size_t alignment)
+                {
+                    return (bytes + alignment - 1) / alignment * alignment;
+                }
+
+                /// @brief Bytes a leaf holding @p capacity elements takes, from its @p header bytes to the link to the
+                ///        next leaf.
+                template <typename Key, typename Value>
+                constexpr size_t leafBytes(size_t header, size_t capacity)
+                {
+                    const size_t keys = alignUp(header, alignof(Key)) + capacity * sizeof(Key);
+                    const size_t values = alignUp(keys, alignof(Value)) + capacity * sizeof(Value);
+                    return alignUp(values, alignof(void *)) + sizeof(void *);
+                }
+
+                /// @brief Bytes an inner node holding @p capacity keys takes, from its @p header bytes to its last
+                ///        child.
+                template <typename Key>
+                constexpr size_t innerBytes(size_t header, size_t capacity)
+                {
+                    const size_t keys = alignUp(header, alignof(Key)) + capacity * sizeof(Key);
+                    return alignUp(keys, alignof(void *)) + (capacity + 1) * sizeof(void *);
+                }
+
+                /// @brief Gets the most elements, but at least 4, a leaf of @p nodeBytes holds.
+                template <typename Key, typename Value>
+                constexpr size_t leafCapacity(size_t nodeBytes, size_t header)
+                {
+                    size_t capacity = nodeBytes / (sizeof(Key) + sizeof(Value));
+
+                    while (capacity > 4 && leafBytes<Key, Value>(header, capacity) > nodeBytes)
+                    {
+                        --capacity;
+                    }
+
+                    return std::max<size_t>(4, capacity);
+                }
+
+                /// @brief Gets the most keys, but at least 4, an inner node of @p nodeBytes holds.
+                template <typename Key>
+                constexpr size_t innerCapacity(size_t nodeBytes, size_t header)
+                {
+                    size_t capacity = nodeBytes / (sizeof(Key) + sizeof(void *));
+
+                    while (capacity > 4 && innerBytes<Key>(header, capacity) > nodeBytes)
+                    {
+                        --capacity;
+                    }
+
+                    return std::max<size_t>(4, capacity);
+                }
+            } // bplustree
+
+            template <typename Key, typename Value, typename Compare = std::less<Key>>
+            class BPlusTree
+            {
+                private:
+
+                    struct Node
+                    {
+                        bool _leaf;
+                        size_t _count;
+                    };
+
+                public:
+
+                    /// @brief Target size of a node in bytes.
+                    static constexpr size_t NODE_BYTES = 4 * libdsa::structures::utilities::CACHE_LINE_SIZE;
+
+                    /// @brief Maximum number of elements in a leaf.  The node header and the link to the next leaf
+                    ///        come out of @c NODE_BYTES as well.
+                    static constexpr size_t LEAF_CAPACITY =
+                        bplustree::leafCapacity<Key, Value>(NODE_BYTES, sizeof(Node));
+
+                    /// @brief Maximum number of separator keys in an inner node.  It has one more child than keys.
+                    static constexpr size_t INNER_CAPACITY = bplustree::innerCapacity<Key>(NODE_BYTES, sizeof(Node));
+
+                private:
+
+                    struct alignas(libdsa::structures::utilities::CACHE_LINE_SIZE) LeafNode : Node
+                    {
+                        Key _keys[LEAF_CAPACITY];
+                        Value _values[LEAF_CAPACITY];
+                        LeafNode *_next;
+
+                        LeafNode() : Node{true, 0}, _next(nullptr)
+                        {
+                            // Intentionally empty constructor
+                        }
+                    };
+
+                    struct alignas(libdsa::structures::utilities::CACHE_LINE_SIZE) InnerNode : Node
+                    {
+                        Key _keys[INNER_CAPACITY];
+                        Node *_children[INNER_CAPACITY + 1];
+
+                        InnerNode() : Node{false, 0}
+                        {
+                            // Intentionally empty constructor
+                        }
+                    };
+
+                    static_assert(LEAF_CAPACITY == 4 || sizeof(LeafNode) == NODE_BYTES, "A leaf must fill its lines.");
+                    static_assert(INNER_CAPACITY == 4 || sizeof(InnerNode) == NODE_BYTES,
+                                  "An inner node must fill its lines.");
+
+                    /// @brief Describes the right half produced when a node splits.
+                    struct Split
+                    {
+                        Key _separator;
+                        Node *_right;
+                    };
+
+                public:
+
+                    /// @brief Forward iterator visiting the elements in ascending key order.  Values can be changed
+                    ///        through an @c Iterator but not through a @c ConstIterator.
+                    template <bool Constant>
+                    class BasicIterator
+                    {
+                        public:
+                            using iterator_category = std::forward_iterator_tag;
+                            using difference_type = std::ptrdiff_t;
+                            using value_reference = typename std::conditional<Constant, const Value &, Value &>::type;
+
+                            BasicIterator() : _leaf(nullptr), _index(0)
+                            {
+                                // Intentionally empty constructor
+                            }
+
+                            /// @brief Converts an @c Iterator to a @c ConstIterator.
+                            template <bool Other, typename = typename std::enable_if<Constant && !Other>::type>
+                            BasicIterator(const BasicIterator<Other> &other) : _leaf(other._leaf), _index(other._index)
+                            {
+                                // Intentionally empty constructor
+                            }
+
+                            const Key &GetKey() const
+                            {
+                                return _leaf->_keys[_index];
+                            }
+
+                            value_reference GetValue() const
+                            {
+                                return _leaf->_values[_index];
+                            }
+
+                            BasicIterator &operator++()
+                            {
+                                if (++_index == _leaf->_count)
+                                {
+                                    _leaf = _leaf->_next;
+                                    _index = 0;
+                                }
+
+                                return *this;
+                            }
+
+                            BasicIterator operator++(int)
+                            {
+                                BasicIterator previous = *this;
+                                ++(*this);
+                                return previous;
+                            }
+
+                            bool operator==(const BasicIterator &other) const
+                            {
+                                return _leaf == other._leaf && _index == other._index;
+                            }
+
+                            bool operator!=(const BasicIterator &other) const
+                            {
+                                return !(*this == other);
+                            }
+
+                        private:
+                            friend class BPlusTree;
+
+                            template <bool>
+                            friend class BasicIterator;
+
+                            BasicIterator(LeafNode *leaf, size_t index) : _leaf(leaf), _index(index)
+                            {
+                                // Intentionally empty constructor
+                            }
+
+                            LeafNode *_leaf;
+                            size_t _index;
+                    }; // BasicIterator
+
+                    using Iterator = BasicIterator<false>;
+                    using ConstIterator = BasicIterator<true>;
+
+                    /// @brief Constructor for an empty tree.
+                    BPlusTree();
+
+                    /// @brief Constructor that bulk loads from key/value pairs sorted by strictly ascending key.
+                    ///
+                    /// @param sorted The elements to load.
+                    BPlusTree(const std::vector<std::pair<Key, Value>> &sorted);
+
+                    /// @brief Copy constructor.  Rebuilds the elements of @p other as a packed tree.
+                    BPlusTree(const BPlusTree &other);
+
+                    /// @brief Move constructor.  Leaves @p other empty.
+                    BPlusTree(BPlusTree &&other) noexcept;
+
+                    BPlusTree &operator=(BPlusTree other) noexcept;
+
+                    /// @brief Destructor.  Frees every node.
+                    ~BPlusTree();
+
+                    /// @brief Adds an element if its key is not already present.
+                    ///
+                    /// @return True if the element was added, false if the key was already present.
+                    bool Insert(const Key &key, const Value &value);
+
+                    /// @brief Replaces the contents with key/value pairs sorted by strictly ascending key.
+                    ///
+                    /// @param sorted The elements to load.
+                    void BulkLoad(const std::vector<std::pair<Key, Value>> &sorted);
+
+                    /// @brief Looks up a key.
+                    ///
+                    /// @return An iterator to the element, or @c end() if the key is not present.
+                    Iterator Find(const Key &key);
+                    ConstIterator Find(const Key &key) const;
+
+                    /// @brief Checks whether a key is present.
+                    bool Contains(const Key &key) const;
+
+                    /// @brief Finds the first element whose key is not less than @p key.
+                    ///
+                    /// @return An iterator to the element, or @c end() if every key is less.
+                    Iterator LowerBound(const Key &key);
+                    ConstIterator LowerBound(const Key &key) const;
+
+                    /// @brief Calls @p function with the key and value of every element in [@p low, @p high).
+                    ///
+                    /// @tparam Function Callable as function(const Key &, Value &), or as function(const Key &,
+                    ///         const Value &) on a const tree.
+                    ///
+                    /// @return The number of elements visited.
+                    template <typename Function>
+                    size_t RangeScan(const Key &low, const Key &high, Function function);
+
+                    template <typename Function>
+                    size_t RangeScan(const Key &low, const Key &high, Function function) const;
+
+                    /// @brief Removes every element.
+                    void Clear();
+
+                    /// @brief Checks whether the tree holds no elements.
+                    bool Empty() const;
+
+                    /// @brief Getter to get the number of levels.  An empty tree has height 0.
+                    size_t Height() const;
+
+                    /// @brief Getter to get the number of elements within the tree.
+                    size_t Size() const;
+
+                    /// @brief Iterator to the element with the smallest key.
+                    Iterator begin();
+                    ConstIterator begin() const;
+
+                    /// @brief Iterator past the element with the largest key.
+                    Iterator end();
+                    ConstIterator end() const;
+
+                private:
+
+                    /// @brief Number of keys in @p keys that are less than @p key.
+                    size_t _lowerIndex(const Key *keys, size_t count, const Key &key) const;
+
+                    /// @brief Number of keys in @p keys that are not greater than @p key.
+                    size_t _upperIndex(const Key *keys, size_t count, const Key &key) const;
+
+                    /// @brief Descends to the leaf whose range covers @p key.
+                    LeafNode *_findLeaf(const Key &key) const;
+
+                    /// @brief Shared by both @c Find overloads.
+                    Iterator _find(const Key &key) const;
+
+                    /// @brief Shared by both @c LowerBound overloads.
+                    Iterator _lowerBound(const Key &key) const;
+
+                    /// @brief Shared by both @c RangeScan overloads; @p function may change the values it is given.
+                    template <typename Function>
+                    size_t _rangeScan(const Key &low, const Key &high, Function function) const;
+
+                    /// @brief Inserts below @p node, reporting a split of @p node through @p split.
+                    bool _insert(Node *node, const Key &key, const Value &value, Split &split);
+
+                    bool _insertIntoLeaf(LeafNode *leaf, const Key &key, const Value &value, Split &split);
+
+                    /// @brief Adds the right half of a split child at @p slot, splitting @p inner if it is full.
+                    void _insertIntoInner(InnerNode *inner, size_t slot, const Split &child, Split &split);
+
+                    /// @brief Recursively frees a subtree.
+                    static void _destroy(Node *node);
+
+                    Node *_root;
+
+                    /// @brief Leftmost leaf, where iteration starts.
+                    LeafNode *_first;
+
+                    size_t _height;
+
+                    size_t _size;
+
+                    Compare _compare;
+            }; // BPlusTree
+
+            template <typename Key, typename Value, typename Compare>
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::BPlusTree()
+                : _root(nullptr), _first(nullptr), _height(0), _size(0)
+            {
+                // Intentionally empty constructor
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::BPlusTree(
+                const std::vector<std::pair<Key, Value>> &sorted)
+                : _root(nullptr), _first(nullptr), _height(0), _size(0)
+            {
+                BulkLoad(sorted);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::BPlusTree(const BPlusTree &other)
+                : _root(nullptr), _first(nullptr), _height(0), _size(0), _compare(other._compare)
+            {
+                std::vector<std::pair<Key, Value>> elements;
+                elements.reserve(other._size);
+
+                for (ConstIterator it = other.begin(); it != other.end(); ++it)
+                {
+                    elements.emplace_back(it.GetKey(), it.GetValue());
+                }
+
+                BulkLoad(elements);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::BPlusTree(BPlusTree &&other) noexcept
+                : _root(other._root), _first(other._first), _height(other._height), _size(other._size),
+                  _compare(std::move(other._compare))
+            {
+                other._root = nullptr;
+                other._first = nullptr;
+                other._height = 0;
+                other._size = 0;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare> &
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::operator=(BPlusTree other) noexcept
+            {
+                std::swap(_root, other._root);
+                std::swap(_first, other._first);
+                std::swap(_height, other._height);
+                std::swap(_size, other._size);
+                std::swap(_compare, other._compare);
+                return *this;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::~BPlusTree()
+            {
+                _destroy(_root);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            size_t libdsa::structures::tree::BPlusTree<Key, Value, Compare>::_lowerIndex(const Key *keys, size_t count,
+                                                                                         const Key &key) const
+            {
+                // Counting instead of searching keeps the loop free of early exits so it can be vectorized.
+                size_t index = 0;
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    index += static_cast<size_t>(_compare(keys[i], key));
+                }
+
+                return index;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            size_t libdsa::structures::tree::BPlusTree<Key, Value, Compare>::_upperIndex(const Key *keys, size_t count,
+                                                                                         const Key &key) const
+            {
+                size_t index = 0;
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    index += static_cast<size_t>(!_compare(key, keys[i]));
+                }
+
+                return index;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::BPlusTree<Key, Value, Compare>::LeafNode *
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::_findLeaf(const Key &key) const
+            {
+                Node *node = _root;
+
+                // Child i holds the keys in [separator i - 1, separator i).
+                while (node != nullptr && !node->_leaf)
+                {
+                    InnerNode *inner = static_cast<InnerNode *>(node);
+                    node = inner->_children[_upperIndex(inner->_keys, inner->_count, key)];
+                }
+
+                return static_cast<LeafNode *>(node);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            bool libdsa::structures::tree::BPlusTree<Key, Value, Compare>::Insert(const Key &key, const Value &value)
+            {
+                if (_root == nullptr)
+                {
+                    LeafNode *leaf = new LeafNode();
+                    leaf->_keys[0] = key;
+                    leaf->_values[0] = value;
+                    leaf->_count = 1;
+
+                    _root = leaf;
+                    _first = leaf;
+                    _height = 1;
+                    _size = 1;
+                    return true;
+                }
+
+                Split split{Key{}, nullptr};
+
+                if (!_insert(_root, key, value, split))
+                {
+                    return false;
+                }
+
+                ++_size;
+
+                // A split of the root grows the tree by one level.
+                if (split._right != nullptr)
+                {
+                    InnerNode *root = new InnerNode();
+                    root->_keys[0] = split._separator;
+                    root->_children[0] = _root;
+                    root->_children[1] = split._right;
+                    root->_count = 1;
+
+                    _root = root;
+                    ++_height;
+                }
+
+                return true;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            bool libdsa::structures::tree::BPlusTree<Key, Value, Compare>::_insert(Node *node, const Key &key,
+                                                                                   const Value &value, Split &split)
+            {
+                if (node->_leaf)
+                {
+                    return _insertIntoLeaf(static_cast<LeafNode *>(node), key, value, split);
+                }
+
+                InnerNode *inner = static_cast<InnerNode *>(node);
+                const size_t slot = _upperIndex(inner->_keys, inner->_count, key);
+
+                Split child{Key{}, nullptr};
+
+                if (!_insert(inner->_children[slot], key, value, child))
+                {
+                    return false;
+                }
+
+                if (child._right != nullptr)
+                {
+                    _insertIntoInner(inner, slot, child, split);
+                }
+
+                return true;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            bool libdsa::structures::tree::BPlusTree<Key, Value, Compare>::_insertIntoLeaf(LeafNode *leaf, const Key &key,
+                                                                                           const Value &value, Split &split)
+            {
+                const size_t position = _lowerIndex(leaf->_keys, leaf->_count, key);
+
+                if (position < leaf->_count && !_compare(key, leaf->_keys[position]))
+                {
+                    return false;
+                }
+
+                if (leaf->_count < LEAF_CAPACITY)
+                {
+                    std::move_backward(leaf->_keys + position, leaf->_keys + leaf->_count, leaf->_keys + leaf->_count + 1);
+                    std::move_backward(leaf->_values + position, leaf->_values + leaf->_count,
+                                       leaf->_values + leaf->_count + 1);
+
+                    leaf->_keys[position] = key;
+                    leaf->_values[position] = value;
+                    ++leaf->_count;
+                    return true;
+                }
+
+                // Merge the new element into a scratch copy of the full leaf, then deal the halves back out.
+                Key keys[LEAF_CAPACITY + 1];
+                Value values[LEAF_CAPACITY + 1];
+
+                std::move(leaf->_keys, leaf->_keys + position, keys);
+                std::move(leaf->_values, leaf->_values + position, values);
+                keys[position] = key;
+                values[position] = value;
+                std::move(leaf->_keys + position, leaf->_keys + LEAF_CAPACITY, keys + position + 1);
+                std::move(leaf->_values + position, leaf->_values + LEAF_CAPACITY, values + position + 1);
+
+                const size_t leftCount = (LEAF_CAPACITY + 1) / 2;
+                const size_t rightCount = LEAF_CAPACITY + 1 - leftCount;
+
+                LeafNode *right = new LeafNode();
+
+                std::move(keys, keys + leftCount, leaf->_keys);
+                std::move(values, values + leftCount, leaf->_values);
+                std::move(keys + leftCount, keys + LEAF_CAPACITY + 1, right->_keys);
+                std::move(values + leftCount, values + LEAF_CAPACITY + 1, right->_values);
+
+                leaf->_count = leftCount;
+                right->_count = rightCount;
+
+                right->_next = leaf->_next;
+                leaf->_next = right;
+
+                split._separator = right->_keys[0];
+                split._right = right;
+                return true;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            void libdsa::structures::tree::BPlusTree<Key, Value, Compare>::_insertIntoInner(InnerNode *inner, size_t slot,
+                                                                                            const Split &child, Split &split)
+            {
+                if (inner->_count < INNER_CAPACITY)
+                {
+                    std::move_backward(inner->_keys + slot, inner->_keys + inner->_count, inner->_keys + inner->_count + 1);
+                    std::move_backward(inner->_children + slot + 1, inner->_children + inner->_count + 1,
+                                       inner->_children + inner->_count + 2);
+
+                    inner->_keys[slot] = child._separator;
+                    inner->_children[slot + 1] = child._right;
+                    ++inner->_count;
+                    return;
+                }
+
+                Key keys[INNER_CAPACITY + 1];
+                Node *children[INNER_CAPACITY + 2];
+
+                std::move(inner->_keys, inner->_keys + slot, keys);
+                keys[slot] = child._separator;
+                std::move(inner->_keys + slot, inner->_keys + INNER_CAPACITY, keys + slot + 1);
+
+                std::copy(inner->_children, inner->_children + slot + 1, children);
+                children[slot + 1] = child._right;
+                std::copy(inner->_children + slot + 1, inner->_children + INNER_CAPACITY + 1, children + slot + 2);
+
+                // The middle key moves up to the parent and belongs to neither half.
+                const size_t middle = (INNER_CAPACITY + 1) / 2;
+
+                InnerNode *right = new InnerNode();
+
+                std::move(keys, keys + middle, inner->_keys);
+                std::copy(children, children + middle + 1, inner->_children);
+                inner->_count = middle;
+
+                std::move(keys + middle + 1, keys + INNER_CAPACITY + 1, right->_keys);
+                std::copy(children + middle + 1, children + INNER_CAPACITY + 2, right->_children);
+                right->_count = INNER_CAPACITY - middle;
+
+                split._separator = keys[middle];
+                split._right = right;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            void libdsa::structures::tree::BPlusTree<Key, Value, Compare>::BulkLoad(
+                const std::vector<std::pair<Key, Value>> &sorted)
+            {
+                for (size_t i = 1; i < sorted.size(); ++i)
+                {
+                    if (!_compare(sorted[i - 1].first, sorted[i].first))
+                    {
+                        throw std::invalid_argument("BPlusTree - Bulk load input must be sorted with unique keys.");
+                    }
+                }
+
+                Clear();
+
+                if (sorted.empty())
+                {
+                    return;
+                }
+
+                // Spread the elements evenly over the fewest leaves that hold them.
+                const size_t leafCount = (sorted.size() + LEAF_CAPACITY - 1) / LEAF_CAPACITY;
+
+                std::vector<Node *> level;
+                std::vector<Key> lowest;
+                level.reserve(leafCount);
+                lowest.reserve(leafCount);
+
+                LeafNode *previous = nullptr;
+                size_t offset = 0;
+
+                for (size_t i = 0; i < leafCount; ++i)
+                {
+                    LeafNode *leaf = new LeafNode();
+                    leaf->_count = sorted.size() / leafCount + (i < sorted.size() % leafCount ? 1 : 0);
+
+                    for (size_t j = 0; j < leaf->_count; ++j)
+                    {
+                        leaf->_keys[j] = sorted[offset + j].first;
+                        leaf->_values[j] = sorted[offset + j].second;
+                    }
+
+                    offset += leaf->_count;
+
+                    if (previous == nullptr)
+                    {
+                        _first = leaf;
+                    }
+                    else
+                    {
+                        previous->_next = leaf;
+                    }
+
+                    previous = leaf;
+                    level.push_back(leaf);
+                    lowest.push_back(leaf->_keys[0]);
+                }
+
+                _height = 1;
+
+                // Build each inner level over the one below.  The separator in front of a child is the smallest key
+                // in that child's subtree.
+                while (level.size() > 1)
+                {
+                    const size_t parentCount = (level.size() + INNER_CAPACITY) / (INNER_CAPACITY + 1);
+
+                    std::vector<Node *> parents;
+                    std::vector<Key> parentLowest;
+                    parents.reserve(parentCount);
+                    parentLowest.reserve(parentCount);
+
+                    offset = 0;
+
+                    for (size_t i = 0; i < parentCount; ++i)
+                    {
+                        const size_t childCount = level.size() / parentCount + (i < level.size() % parentCount ? 1 : 0);
+
+                        InnerNode *inner = new InnerNode();
+                        inner->_count = childCount - 1;
+                        inner->_children[0] = level[offset];
+
+                        for (size_t j = 1; j < childCount; ++j)
+                        {
+                            inner->_keys[j - 1] = lowest[offset + j];
+                            inner->_children[j] = level[offset + j];
+                        }
+
+                        parents.push_back(inner);
+                        parentLowest.push_back(lowest[offset]);
+                        offset += childCount;
+                    }
+
+                    level.swap(parents);
+                    lowest.swap(parentLowest);
+                    ++_height;
+                }
+
+                _root = level[0];
+                _size = sorted.size();
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::BPlusTree<Key, Value, Compare>::Iterator
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::Find(const Key &key)
+            {
+                return _find(key);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::BPlusTree<Key, Value, Compare>::ConstIterator
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::Find(const Key &key) const
+            {
+                return _find(key);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::BPlusTree<Key, Value, Compare>::Iterator
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::_find(const Key &key) const
+            {
+                Iterator candidate = _lowerBound(key);
+
+                if (candidate != Iterator() && !_compare(key, candidate.GetKey()))
+                {
+                    return candidate;
+                }
+
+                return Iterator();
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            bool libdsa::structures::tree::BPlusTree<Key, Value, Compare>::Contains(const Key &key) const
+            {
+                return Find(key) != end();
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::BPlusTree<Key, Value, Compare>::Iterator
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::LowerBound(const Key &key)
+            {
+                return _lowerBound(key);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::BPlusTree<Key, Value, Compare>::ConstIterator
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::LowerBound(const Key &key) const
+            {
+                return _lowerBound(key);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::BPlusTree<Key, Value, Compare>::Iterator
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::_lowerBound(const Key &key) const
+            {
+                LeafNode *leaf = _findLeaf(key);
+
+                if (leaf == nullptr)
+                {
+                    return Iterator();
+                }
+
+                const size_t index = _lowerIndex(leaf->_keys, leaf->_count, key);
+
+                // Every key of this leaf is smaller, so the answer starts the next leaf.  Leaves are never empty.
+                if (index == leaf->_count)
+                {
+                    return Iterator(leaf->_next, 0);
+                }
+
+                return Iterator(leaf, index);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            template <typename Function>
+            size_t libdsa::structures::tree::BPlusTree<Key, Value, Compare>::RangeScan(const Key &low, const Key &high,
+                                                                                       Function function)
+            {
+                return _rangeScan(low, high, function);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            template <typename Function>
+            size_t libdsa::structures::tree::BPlusTree<Key, Value, Compare>::RangeScan(const Key &low, const Key &high,
+                                                                                       Function function) const
+            {
+                return _rangeScan(low, high, [&function](const Key &key, const Value &value) { function(key, value); });
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            template <typename Function>
+            size_t libdsa::structures::tree::BPlusTree<Key, Value, Compare>::_rangeScan(const Key &low, const Key &high,
+                                                                                        Function function) const
+            {
+                Iterator start = _lowerBound(low);
+
+                LeafNode *leaf = start._leaf;
+                size_t index = start._index;
+                size_t visited = 0;
+
+                while (leaf != nullptr)
+                {
+                    if (leaf->_next != nullptr)
+                    {
+                        __builtin_prefetch(leaf->_next);
+                    }
+
+                    for (; index < leaf->_count; ++index)
+                    {
+                        if (!_compare(leaf->_keys[index], high))
+                        {
+                            return visited;
+                        }
+
+                        function(leaf->_keys[index], leaf->_values[index]);
+                        ++visited;
+                    }
+
+                    leaf = leaf->_next;
+                    index = 0;
+                }
+
+                return visited;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            void libdsa::structures::tree::BPlusTree<Key, Value, Compare>::_destroy(Node *node)
+            {
+                if (node == nullptr)
+                {
+                    return;
+                }
+
+                if (node->_leaf)
+                {
+                    delete static_cast<LeafNode *>(node);
+                    return;
+                }
+
+                InnerNode *inner = static_cast<InnerNode *>(node);
+
+                for (size_t i = 0; i <= inner->_count; ++i)
+                {
+                    _destroy(inner->_children[i]);
+                }
+
+                delete inner;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            void libdsa::structures::tree::BPlusTree<Key, Value, Compare>::Clear()
+            {
+                _destroy(_root);
+                _root = nullptr;
+                _first = nullptr;
+                _height = 0;
+                _size = 0;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            bool libdsa::structures::tree::BPlusTree<Key, Value, Compare>::Empty() const
+            {
+                return _size == 0;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            size_t libdsa::structures::tree::BPlusTree<Key, Value, Compare>::Height() const
+            {
+                return _height;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            size_t libdsa::structures::tree::BPlusTree<Key, Value, Compare>::Size() const
+            {
+                return _size;
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::BPlusTree<Key, Value, Compare>::Iterator
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::begin()
+            {
+                return Iterator(_first, 0);
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::BPlusTree<Key, Value, Compare>::ConstIterator
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::begin() const
+            {
+                return ConstIterator(Iterator(_first, 0));
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::BPlusTree<Key, Value, Compare>::Iterator
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::end()
+            {
+                return Iterator();
+            }
+
+            template <typename Key, typename Value, typename Compare>
+            typename libdsa::structures::tree::BPlusTree<Key, Value, Compare>::ConstIterator
+            libdsa::structures::tree::BPlusTree<Key, Value, Compare>::end() const
+            {
+                return ConstIterator();
+            }
+        } // tree
+    } // structures
+} // libdsa
+
+#endif // BPLUSTREE_H_
+/// @}
@@ -0,0 +1,885 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file flattree
+/// @brief Contains declaration and definition of flat, file backed trees that are searched in place with @c mmap.
+/// @{
+
+#ifndef FLATTREE_H_
+#define FLATTREE_H_
+
+/// @details A flat tree file holds a 64-byte header followed by one array of fixed-size nodes in the host byte order.
+/// Nodes refer to each other by index into that array rather than by pointer, so the file means the same wherever it
+/// is mapped.  Opening a file only maps it and checks the header.  Pages are read from disk the first time a search
+/// touches them, so a tree of any size is usable immediately and nothing is ever deserialized.
+///
+/// Both layouts store nodes in pre-order, so the first child of a node is the next node in the file:
+///   - @c FlatBinaryTree writes the elements of a @c BinaryTree as a perfectly balanced search tree.  Each node keeps
+///     the indices of its two children.
+///   - @c FlatTree writes an n-ary @c TreeNode tree.  Each node keeps the index of its next sibling and the index
+///     just past its subtree, so a pre-order walk is a linear scan.
+///
+/// The element type must be trivially copyable, since it is stored as raw bytes.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// From C++ STL
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// From libutilities
+#include <compacttree.h>
+#include <node.h>
+
+// From libbinarytree
+#include <binarytree.h>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace flat
+        {
+            using utilities::NodeIndex;
+            using utilities::NULL_INDEX;
+
+            /// @brief Identifies a flat tree file: the ASCII characters "LDSATREE".
+            constexpr uint64_t MAGIC = 0x454552544153444CULL;
+
+            /// @brief Current file format version.
+            constexpr uint32_t VERSION = 1;
+
+            /// @brief Which node layout follows the header.
+            enum class Kind : uint32_t
+            {
+                BINARY = 1,
+                NARY = 2
+            };
+
+            /// @brief Layout of the start of a flat tree file.
+            struct Header
+            {
+                uint64_t magic;
+                uint32_t version;
+                uint32_t kind;
+                uint64_t nodeCount;
+                uint32_t nodeSize;
+                uint32_t datumSize;
+                uint32_t height;
+                uint8_t padding[28];
+            };
+
+            static_assert(sizeof(Header) == 64, "FlatTree - Header must fill exactly one cache line.");
+
+            template <typename Type>
+            struct BinaryNode
+            {
+                Type datum;
+                NodeIndex left;
+                NodeIndex right;
+            };
+
+            template <typename Type>
+            struct NaryNode
+            {
+                Type datum;
+                NodeIndex nextSibling;
+
+                /// @brief Index just past the last node of this subtree.
+                NodeIndex subtreeEnd;
+            };
+
+            /// @brief Owns a file descriptor and its shared mapping.
+            class Mapping
+            {
+            public:
+                /// @brief Creates a temporary file of @p bytes next to @p path and maps it for writing.  @p path
+                ///        itself is only replaced by @c commit(), so readers of an older file never see a partial
+                ///        one, and the temporary file is removed if the mapping is dropped before that.
+                static Mapping create(const std::string &path, size_t bytes);
+
+                /// @brief Maps an existing file read-only and checks that its header describes nodes of
+                ///        @p nodeSize bytes holding data of @p datumSize bytes in the @p kind layout.
+                static Mapping open(const std::string &path, Kind kind, uint32_t nodeSize, uint32_t datumSize);
+
+                Mapping(Mapping &&other) noexcept;
+                Mapping &operator=(Mapping &&other) noexcept;
+
+                Mapping(const Mapping &) = delete;
+                Mapping &operator=(const Mapping &) = delete;
+
+                ~Mapping();
+
+                const Header *header() const;
+
+                Header *header();
+
+                /// @brief The node array that follows the header.
+                const void *nodes() const;
+
+                void *nodes();
+
+                /// @brief Flushes a mapping from @c create() to disk, renames it over its final path and flushes
+                ///        the directory so the rename survives a crash.
+                void commit();
+
+            private:
+                Mapping(int fileDescriptor, void *mapping, size_t mappingBytes);
+
+                void _release();
+
+                /// @brief Throws a @c std::runtime_error describing @p message and the system error @p error.
+                [[noreturn]] static void _throwError(const std::string &message, int error);
+
+                int _fileDescriptor;
+                void *_mapping;
+                size_t _mappingBytes;
+
+                /// @brief The file being written and the path it replaces on @c commit(), or empty once committed.
+                std::string _temporaryPath;
+                std::string _path;
+            }; // Mapping
+
+            inline libdsa::structures::flat::Mapping::Mapping(int fileDescriptor, void *mapping, size_t mappingBytes)
+                : _fileDescriptor(fileDescriptor), _mapping(mapping), _mappingBytes(mappingBytes)
+            {
+                // Intentionally empty constructor.
+            }
+
+            inline void libdsa::structures::flat::Mapping::_throwError(const std::string &message, int error)
+            {
+                throw std::runtime_error("FlatTree - " + message + ": " + std::strerror(error));
+            }
+
+            inline libdsa::structures::flat::Mapping libdsa::structures::flat::Mapping::create(const std::string &path,
+                                                                                              size_t bytes)
+            {
+                std::string temporaryPath = path + ".XXXXXX";
+                const int fileDescriptor = ::mkstemp(&temporaryPath[0]);
+
+                if (fileDescriptor < 0)
+                {
+                    _throwError("Unable to create a temporary file for " + path, errno);
+                }
+
+                // Any failure below leaves nothing behind.
+                Mapping result(fileDescriptor, nullptr, 0);
+                result._temporaryPath = std::move(temporaryPath);
+                result._path = path;
+
+                if (::fchmod(fileDescriptor, 0644) != 0 || ::ftruncate(fileDescriptor, static_cast<off_t>(bytes)) != 0)
+                {
+                    _throwError("Unable to size " + path, errno);
+                }
+
+                void *mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+
+                if (mapping == MAP_FAILED)
+                {
+                    _throwError("Unable to map " + path, errno);
+                }
+
+                result._mapping = mapping;
+                result._mappingBytes = bytes;
+
+                return result;
+            }
+
+            inline void libdsa::structures::flat::Mapping::commit()
+            {
+                if (::msync(_mapping, _mappingBytes, MS_SYNC) != 0)
+                {
+                    _throwError("Unable to flush " + _path, errno);
+                }
+
+                if (::rename(_temporaryPath.c_str(), _path.c_str()) != 0)
+                {
+                    _throwError("Unable to replace " + _path, errno);
+                }
+
+                _temporaryPath.clear();
+
+                // The rename itself is only durable once the directory holding the file has been flushed too.
+                const size_t slash = _path.find_last_of('/');
+                std::string directory = ".";
+
+                if (slash != std::string::npos)
+                {
+                    directory = slash == 0 ? "/" : _path.substr(0, slash);
+                }
+
+                const int directoryDescriptor = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+
+                if (directoryDescriptor < 0)
+                {
+                    _throwError("Unable to open the directory of " + _path, errno);
+                }
+
+                if (::fsync(directoryDescriptor) != 0)
+                {
+                    const int error = errno;
+                    ::close(directoryDescriptor);
+                    _throwError("Unable to flush the directory of " + _path, error);
+                }
+
+                ::close(directoryDescriptor);
+            }
+
+            inline libdsa::structures::flat::Mapping libdsa::structures::flat::Mapping::open(const std::string &path,
+                                                                                            Kind kind,
+                                                                                            uint32_t nodeSize,
+                                                                                            uint32_t datumSize)
+            {
+                const int fileDescriptor = ::open(path.c_str(), O_RDONLY);
+
+                if (fileDescriptor < 0)
+                {
+                    _throwError("Unable to open " + path, errno);
+                }
+
+                struct stat status;
+
+                if (::fstat(fileDescriptor, &status) != 0)
+                {
+                    const int error = errno;
+                    ::close(fileDescriptor);
+                    _throwError("Unable to stat " + path, error);
+                }
+
+                const size_t bytes = static_cast<size_t>(status.st_size);
+
+                if (bytes < sizeof(Header))
+                {
+                    ::close(fileDescriptor);
+                    throw std::runtime_error("FlatTree - " + path + " is too small to be a flat tree file.");
+                }
+
+                void *mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+
+                if (mapping == MAP_FAILED)
+                {
+                    const int error = errno;
+                    ::close(fileDescriptor);
+                    _throwError("Unable to map " + path, error);
+                }
+
+                Mapping result(fileDescriptor, mapping, bytes);
+                const Header *header = result.header();
+
+                if (header->magic != MAGIC || header->version != VERSION ||
+                    header->kind != static_cast<uint32_t>(kind) || header->nodeSize != nodeSize ||
+                    header->datumSize != datumSize || header->nodeCount >= NULL_INDEX ||
+                    header->height > header->nodeCount || bytes < sizeof(Header) + header->nodeCount * nodeSize)
+                {
+                    throw std::runtime_error("FlatTree - " + path + " is not a valid flat tree file of this type.");
+                }
+
+                return result;
+            }
+
+            inline libdsa::structures::flat::Mapping::Mapping(Mapping &&other) noexcept
+                : _fileDescriptor(other._fileDescriptor), _mapping(other._mapping), _mappingBytes(other._mappingBytes),
+                  _temporaryPath(std::move(other._temporaryPath)), _path(std::move(other._path))
+            {
+                other._fileDescriptor = -1;
+                other._mapping = nullptr;
+                other._mappingBytes = 0;
+                other._temporaryPath.clear();
+            }
+
+            inline libdsa::structures::flat::Mapping &libdsa::structures::flat::Mapping::operator=(
+                Mapping &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    _release();
+
+                    _fileDescriptor = other._fileDescriptor;
+                    _mapping = other._mapping;
+                    _mappingBytes = other._mappingBytes;
+                    _temporaryPath = std::move(other._temporaryPath);
+                    _path = std::move(other._path);
+
+                    other._fileDescriptor = -1;
+                    other._mapping = nullptr;
+                    other._mappingBytes = 0;
+                    other._temporaryPath.clear();
+                }
+
+                return *this;
+            }
+
+            inline libdsa::structures::flat::Mapping::~Mapping()
+            {
+                _release();
+            }
+
+            inline void libdsa::structures::flat::Mapping::_release()
+            {
+                if (_mapping != nullptr)
+                {
+                    ::munmap(_mapping, _mappingBytes);
+                    _mapping = nullptr;
+                }
+
+                if (_fileDescriptor >= 0)
+                {
+                    ::close(_fileDescriptor);
+                    _fileDescriptor = -1;
+                }
+
+                // Never committed: the file it replaces stays as it was.
+                if (!_temporaryPath.empty())
+                {
+                    ::unlink(_temporaryPath.c_str());
+                    _temporaryPath.clear();
+                }
+            }
+
+            inline const libdsa::structures::flat::Header *libdsa::structures::flat::Mapping::header() const
+            {
+                return static_cast<const Header *>(_mapping);
+            }
+
+            inline libdsa::structures::flat::Header *libdsa::structures::flat::Mapping::header()
+            {
+                return static_cast<Header *>(_mapping);
+            }
+
+            inline const void *libdsa::structures::flat::Mapping::nodes() const
+            {
+                return static_cast<const char *>(_mapping) + sizeof(Header);
+            }
+
+            inline void *libdsa::structures::flat::Mapping::nodes()
+            {
+                return static_cast<char *>(_mapping) + sizeof(Header);
+            }
+
+            /// @brief Fills in a new header for @p nodeCount nodes of @p Node.
+            template <typename Node, typename Type>
+            void writeHeader(Mapping &mapping, Kind kind, size_t nodeCount, uint32_t height)
+            {
+                Header *header = mapping.header();
+                header->magic = MAGIC;
+                header->version = VERSION;
+                header->kind = static_cast<uint32_t>(kind);
+                header->nodeCount = nodeCount;
+                header->nodeSize = sizeof(Node);
+                header->datumSize = sizeof(Type);
+                header->height = height;
+            }
+        } // flat
+
+        /// @brief Read-only balanced search tree searched directly in a mapped file.
+        template <typename Type, typename Compare = std::less<Type>>
+        class FlatBinaryTree
+        {
+            static_assert(std::is_trivially_copyable_v<Type>, "FlatBinaryTree - Type must be trivially copyable.");
+
+        public:
+            using Node = flat::BinaryNode<Type>;
+
+            /// @brief Writes the elements of @p tree to @p path.
+            static void write(const std::string &path, const tree::BinaryTree<Type, Compare> &tree);
+
+            /// @brief Writes @p sorted to @p path.
+            ///
+            /// @throw std::invalid_argument if @p sorted is not strictly increasing.
+            static void write(const std::string &path, const std::vector<Type> &sorted);
+
+            /// @brief Maps a file written by @c write.
+            static FlatBinaryTree open(const std::string &path);
+
+            size_t size() const;
+
+            bool empty() const;
+
+            /// @brief Getter to get the height of the tree.  An empty tree has height 0.
+            size_t height() const;
+
+            /// @brief Index of the root, or @c NULL_INDEX if the tree is empty.
+            flat::NodeIndex root() const;
+
+            flat::NodeIndex left(flat::NodeIndex node) const;
+
+            flat::NodeIndex right(flat::NodeIndex node) const;
+
+            const Type &datum(flat::NodeIndex node) const;
+
+            /// @brief Looks up an element.
+            ///
+            /// @return A pointer into the mapping, or nullptr if the element is not present.
+            const Type *find(const Type &datum) const;
+
+            bool contains(const Type &datum) const;
+
+            /// @brief Finds the first element that is not less than @p datum.
+            ///
+            /// @return A pointer into the mapping, or nullptr if every element is less.
+            const Type *lowerBound(const Type &datum) const;
+
+            /// @brief Calls @p function on every element in ascending order.
+            template <typename Function>
+            void forEach(Function function) const;
+
+            /// @brief Checks every child index in O(n).  Files from an untrusted source should pass this before they
+            ///        are searched.
+            bool verify() const;
+
+        private:
+            explicit FlatBinaryTree(flat::Mapping mapping);
+
+            /// @brief Writes the middle of @p sorted [@p begin, @p end) at @p next and its halves after it.
+            static flat::NodeIndex _place(Node *nodes, const std::vector<Type> &sorted, size_t begin, size_t end,
+                                          flat::NodeIndex &next);
+
+            const Node *_nodes() const;
+
+            flat::Mapping _mapping;
+            Compare _compare;
+        }; // FlatBinaryTree
+
+        /// @brief Read-only n-ary tree navigated directly in a mapped file.
+        template <typename Type>
+        class FlatTree
+        {
+            static_assert(std::is_trivially_copyable_v<Type>, "FlatTree - Type must be trivially copyable.");
+
+        public:
+            using Node = flat::NaryNode<Type>;
+
+            /// @brief Writes the tree hanging off @p root to @p path, keeping the order of every node's children.
+            static void write(const std::string &path, const utilities::TreeNode<Type> *root);
+
+            /// @brief Maps a file written by @c write.
+            static FlatTree open(const std::string &path);
+
+            size_t size() const;
+
+            bool empty() const;
+
+            /// @brief Index of the root, or @c NULL_INDEX if the tree is empty.
+            flat::NodeIndex root() const;
+
+            flat::NodeIndex firstChild(flat::NodeIndex node) const;
+
+            flat::NodeIndex nextSibling(flat::NodeIndex node) const;
+
+            size_t childCount(flat::NodeIndex node) const;
+
+            /// @brief Number of nodes in the subtree rooted at @p node, itself included.
+            size_t subtreeSize(flat::NodeIndex node) const;
+
+            const Type &datum(flat::NodeIndex node) const;
+
+            /// @brief Calls @p function on every datum in pre-order, which is file order.
+            template <typename Function>
+            void preOrder(Function function) const;
+
+            /// @brief Checks every sibling and subtree index in O(n).  Files from an untrusted source should pass
+            ///        this before they are navigated.
+            bool verify() const;
+
+        private:
+            explicit FlatTree(flat::Mapping mapping);
+
+            const Node *_nodes() const;
+
+            flat::Mapping _mapping;
+        }; // FlatTree
+
+        template <typename Type, typename Compare>
+        libdsa::structures::FlatBinaryTree<Type, Compare>::FlatBinaryTree(flat::Mapping mapping)
+            : _mapping(std::move(mapping)), _compare()
+        {
+            // Intentionally empty constructor.
+        }
+
+        template <typename Type, typename Compare>
+        void libdsa::structures::FlatBinaryTree<Type, Compare>::write(const std::string &path,
+                                                                      const tree::BinaryTree<Type, Compare> &tree)
+        {
+            write(path, std::vector<Type>(tree.begin(), tree.end()));
+        }
+
+        template <typename Type, typename Compare>
+        void libdsa::structures::FlatBinaryTree<Type, Compare>::write(const std::string &path,
+                                                                      const std::vector<Type> &sorted)
+        {
+            Compare compare;
+
+            for (size_t i = 1; i < sorted.size(); ++i)
+            {
+                if (!compare(sorted[i - 1], sorted[i]))
+                {
+                    throw std::invalid_argument("FlatBinaryTree - Elements must be strictly increasing.");
+                }
+            }
+
+            if (sorted.size() >= flat::NULL_INDEX)
+            {
+                throw std::runtime_error("FlatBinaryTree - Too many elements for 32-bit node indices.");
+            }
+
+            flat::Mapping mapping = flat::Mapping::create(path, sizeof(flat::Header) + sorted.size() * sizeof(Node));
+
+            // Splitting at the middle makes every level full except the last.
+            uint32_t height = 0;
+
+            while ((size_t(1) << height) <= sorted.size())
+            {
+                ++height;
+            }
+
+            flat::writeHeader<Node, Type>(mapping, flat::Kind::BINARY, sorted.size(), height);
+
+            flat::NodeIndex next = 0;
+            _place(static_cast<Node *>(mapping.nodes()), sorted, 0, sorted.size(), next);
+            mapping.commit();
+        }
+
+        template <typename Type, typename Compare>
+        flat::NodeIndex libdsa::structures::FlatBinaryTree<Type, Compare>::_place(Node *nodes,
+                                                                                  const std::vector<Type> &sorted,
+                                                                                  size_t begin, size_t end,
+                                                                                  flat::NodeIndex &next)
+        {
+            if (begin == end)
+            {
+                return flat::NULL_INDEX;
+            }
+
+            const size_t middle = begin + (end - begin) / 2;
+            const flat::NodeIndex index = next++;
+            Node *node = new (nodes + index) Node{sorted[middle], flat::NULL_INDEX, flat::NULL_INDEX};
+
+            node->left = _place(nodes, sorted, begin, middle, next);
+            node->right = _place(nodes, sorted, middle + 1, end, next);
+
+            return index;
+        }
+
+        template <typename Type, typename Compare>
+        libdsa::structures::FlatBinaryTree<Type, Compare>
+        libdsa::structures::FlatBinaryTree<Type, Compare>::open(const std::string &path)
+        {
+            return FlatBinaryTree(flat::Mapping::open(path, flat::Kind::BINARY, sizeof(Node), sizeof(Type)));
+        }
+
+        template <typename Type, typename Compare>
+        const typename libdsa::structures::FlatBinaryTree<Type, Compare>::Node *
+        libdsa::structures::FlatBinaryTree<Type, Compare>::_nodes() const
+        {
+            return static_cast<const Node *>(_mapping.nodes());
+        }
+
+        template <typename Type, typename Compare>
+        size_t libdsa::structures::FlatBinaryTree<Type, Compare>::size() const
+        {
+            return _mapping.header()->nodeCount;
+        }
+
+        template <typename Type, typename Compare>
+        bool libdsa::structures::FlatBinaryTree<Type, Compare>::empty() const
+        {
+            return size() == 0;
+        }
+
+        template <typename Type, typename Compare>
+        size_t libdsa::structures::FlatBinaryTree<Type, Compare>::height() const
+        {
+            return _mapping.header()->height;
+        }
+
+        template <typename Type, typename Compare>
+        flat::NodeIndex libdsa::structures::FlatBinaryTree<Type, Compare>::root() const
+        {
+            return empty() ? flat::NULL_INDEX : 0;
+        }
+
+        template <typename Type, typename Compare>
+        flat::NodeIndex libdsa::structures::FlatBinaryTree<Type, Compare>::left(flat::NodeIndex node) const
+        {
+            return _nodes()[node].left;
+        }
+
+        template <typename Type, typename Compare>
+        flat::NodeIndex libdsa::structures::FlatBinaryTree<Type, Compare>::right(flat::NodeIndex node) const
+        {
+            return _nodes()[node].right;
+        }
+
+        template <typename Type, typename Compare>
+        const Type &libdsa::structures::FlatBinaryTree<Type, Compare>::datum(flat::NodeIndex node) const
+        {
+            return _nodes()[node].datum;
+        }
+
+        template <typename Type, typename Compare>
+        const Type *libdsa::structures::FlatBinaryTree<Type, Compare>::lowerBound(const Type &datum) const
+        {
+            const Node *nodes = _nodes();
+            const Type *best = nullptr;
+
+            for (flat::NodeIndex index = root(); index != flat::NULL_INDEX;)
+            {
+                if (_compare(nodes[index].datum, datum))
+                {
+                    index = nodes[index].right;
+                }
+                else
+                {
+                    best = &nodes[index].datum;
+                    index = nodes[index].left;
+                }
+            }
+
+            return best;
+        }
+
+        template <typename Type, typename Compare>
+        const Type *libdsa::structures::FlatBinaryTree<Type, Compare>::find(const Type &datum) const
+        {
+            const Type *candidate = lowerBound(datum);
+            return candidate != nullptr && !_compare(datum, *candidate) ? candidate : nullptr;
+        }
+
+        template <typename Type, typename Compare>
+        bool libdsa::structures::FlatBinaryTree<Type, Compare>::contains(const Type &datum) const
+        {
+            return find(datum) != nullptr;
+        }
+
+        template <typename Type, typename Compare>
+        template <typename Function>
+        void libdsa::structures::FlatBinaryTree<Type, Compare>::forEach(Function function) const
+        {
+            const Node *nodes = _nodes();
+            std::vector<flat::NodeIndex> stack;
+            stack.reserve(height());
+
+            for (flat::NodeIndex index = root(); index != flat::NULL_INDEX || !stack.empty();)
+            {
+                if (index != flat::NULL_INDEX)
+                {
+                    stack.push_back(index);
+                    index = nodes[index].left;
+                    continue;
+                }
+
+                index = stack.back();
+                stack.pop_back();
+                function(nodes[index].datum);
+                index = nodes[index].right;
+            }
+        }
+
+        template <typename Type, typename Compare>
+        bool libdsa::structures::FlatBinaryTree<Type, Compare>::verify() const
+        {
+            const Node *nodes = _nodes();
+            const size_t count = size();
+
+            // In pre-order every child comes after its parent and the left child comes first, which also rules out
+            // cycles.
+            for (size_t index = 0; index < count; ++index)
+            {
+                const flat::NodeIndex left = nodes[index].left;
+                const flat::NodeIndex right = nodes[index].right;
+
+                if ((left != flat::NULL_INDEX && (left != index + 1 || left >= count)) ||
+                    (right != flat::NULL_INDEX && (right <= index || right >= count)))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        template <typename Type>
+        libdsa::structures::FlatTree<Type>::FlatTree(flat::Mapping mapping) : _mapping(std::move(mapping))
+        {
+            // Intentionally empty constructor.
+        }
+
+        template <typename Type>
+        void libdsa::structures::FlatTree<Type>::write(const std::string &path, const utilities::TreeNode<Type> *root)
+        {
+            // Pre-order walk recording each node's parent, so subtree extents can be filled in afterwards.
+            std::vector<const utilities::TreeNode<Type> *> order;
+            std::vector<flat::NodeIndex> parents;
+            std::vector<std::pair<const utilities::TreeNode<Type> *, flat::NodeIndex>> stack;
+
+            if (root != nullptr)
+            {
+                stack.emplace_back(root, flat::NULL_INDEX);
+            }
+
+            while (!stack.empty())
+            {
+                auto [node, parent] = stack.back();
+                stack.pop_back();
+
+                if (order.size() >= flat::NULL_INDEX - 1)
+                {
+                    throw std::runtime_error("FlatTree - Too many nodes for 32-bit node indices.");
+                }
+
+                const flat::NodeIndex index = static_cast<flat::NodeIndex>(order.size());
+                order.push_back(node);
+                parents.push_back(parent);
+
+                for (auto child = node->children.rbegin(); child != node->children.rend(); ++child)
+                {
+                    stack.emplace_back(*child, index);
+                }
+            }
+
+            flat::Mapping mapping = flat::Mapping::create(path, sizeof(flat::Header) + order.size() * sizeof(Node));
+            flat::writeHeader<Node, Type>(mapping, flat::Kind::NARY, order.size(), 0);
+            Node *nodes = static_cast<Node *>(mapping.nodes());
+
+            // Children follow their parent, so walking backwards finishes every subtree before its root.
+            std::vector<flat::NodeIndex> sizes(order.size(), 1);
+
+            for (size_t index = order.size(); index-- > 1;)
+            {
+                sizes[parents[index]] += sizes[index];
+            }
+
+            for (size_t index = 0; index < order.size(); ++index)
+            {
+                const flat::NodeIndex end = static_cast<flat::NodeIndex>(index + sizes[index]);
+                const bool hasNext = index != 0 && end < nodes[parents[index]].subtreeEnd;
+
+                new (nodes + index) Node{order[index]->_datum, hasNext ? end : flat::NULL_INDEX, end};
+            }
+
+            mapping.commit();
+        }
+
+        template <typename Type>
+        libdsa::structures::FlatTree<Type> libdsa::structures::FlatTree<Type>::open(const std::string &path)
+        {
+            return FlatTree(flat::Mapping::open(path, flat::Kind::NARY, sizeof(Node), sizeof(Type)));
+        }
+
+        template <typename Type>
+        const typename libdsa::structures::FlatTree<Type>::Node *libdsa::structures::FlatTree<Type>::_nodes() const
+        {
+            return static_cast<const Node *>(_mapping.nodes());
+        }
+
+        template <typename Type>
+        size_t libdsa::structures::FlatTree<Type>::size() const
+        {
+            return _mapping.header()->nodeCount;
+        }
+
+        template <typename Type>
+        bool libdsa::structures::FlatTree<Type>::empty() const
+        {
+            return size() == 0;
+        }
+
+        template <typename Type>
+        flat::NodeIndex libdsa::structures::FlatTree<Type>::root() const
+        {
+            return empty() ? flat::NULL_INDEX : 0;
+        }
+
+        template <typename Type>
+        flat::NodeIndex libdsa::structures::FlatTree<Type>::firstChild(flat::NodeIndex node) const
+        {
+            return _nodes()[node].subtreeEnd > node + 1 ? node + 1 : flat::NULL_INDEX;
+        }
+
+        template <typename Type>
+        flat::NodeIndex libdsa::structures::FlatTree<Type>::nextSibling(flat::NodeIndex node) const
+        {
+            return _nodes()[node].nextSibling;
+        }
+
+        template <typename Type>
+        size_t libdsa::structures::FlatTree<Type>::childCount(flat::NodeIndex node) const
+        {
+            size_t count = 0;
+
+            for (flat::NodeIndex child = firstChild(node); child != flat::NULL_INDEX; child = nextSibling(child))
+            {
+                ++count;
+            }
+
+            return count;
+        }
+
+        template <typename Type>
+        size_t libdsa::structures::FlatTree<Type>::subtreeSize(flat::NodeIndex node) const
+        {
+            return _nodes()[node].subtreeEnd - node;
+        }
+
+        template <typename Type>
+        const Type &libdsa::structures::FlatTree<Type>::datum(flat::NodeIndex node) const
+        {
+            return _nodes()[node].datum;
+        }
+
+        template <typename Type>
+        template <typename Function>
+        void libdsa::structures::FlatTree<Type>::preOrder(Function function) const
+        {
+            const Node *nodes = _nodes();
+
+            for (size_t index = 0; index < size(); ++index)
+            {
+                function(nodes[index].datum);
+            }
+        }
+
+        template <typename Type>
+        bool libdsa::structures::FlatTree<Type>::verify() const
+        {
+            const Node *nodes = _nodes();
+            const size_t count = size();
+
+            if (count != 0 && (nodes[0].subtreeEnd != count || nodes[0].nextSibling != flat::NULL_INDEX))
+            {
+                return false;
+            }
+
+            // Each subtree must end inside the file, and a next sibling must start where the subtree ends.
+            for (size_t index = 0; index < count; ++index)
+            {
+                const flat::NodeIndex end = nodes[index].subtreeEnd;
+                const flat::NodeIndex next = nodes[index].nextSibling;
+
+                if (end <= index || end > count || (next != flat::NULL_INDEX && (next != end || next >= count)))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    } // structures
+} // libdsa
+
+#endif // FLATTREE_H_
+
+/// @}
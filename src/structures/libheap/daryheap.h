@@ -0,0 +1,450 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file daryheap
+/// @{
+
+#ifndef DARYHEAP_H_
+#define DARYHEAP_H_
+
+/// @details The @c DaryHeap is an implicit heap in which every node has @c D children, so it is log base D deep
+/// instead of log base 2.  Sifting down compares all children of a node, and those children are adjacent.  The array
+/// starts @c D - 1 slots in from its cache aligned base, which puts every group of siblings at a multiple of @c D.
+/// With @c D = 4 and 16 byte entries, each group fills exactly one cache line.
+///
+/// Every element gets a handle when it is pushed.  A table maps handles to heap positions, so an element can be
+/// re-prioritized or removed without searching for it.  A handle becomes invalid once its element leaves the heap and
+/// may then be reused.
+
+// From C++ STL
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// From libutilities
+#include <alignedallocator.h>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        /// @brief Declaration and implementation of the @c DaryHeap class.
+        ///
+        /// @tparam T Type of the stored elements.  It must be default constructible.
+        /// @tparam D Number of children per node.
+        /// @tparam Compare Ordering of the elements.  The default @c std::less keeps the smallest element on top.
+        template <typename T, size_t D = 4, typename Compare = std::less<T>>
+        class DaryHeap
+        {
+            static_assert(D >= 2, "DaryHeap - A node needs at least two children.");
+
+        public:
+            /// @brief Opaque identifier of an element while it is in the heap.
+            using Handle = size_t;
+
+            /// @brief Constructor for an empty heap.
+            DaryHeap();
+
+            /// @brief Constructor that builds a heap from every element of @p container in linear time.
+            /// @param container The elements to add.  Their handles are 0 through size - 1 in container order.
+            DaryHeap(const std::vector<T> &container);
+
+            /// @brief Adds an element.
+            /// @param value The element to add.
+            /// @return The handle of the new element.
+            Handle push(const T &value);
+
+            /// @brief Adds every element of [@p first, @p last).  A batch at least as large as the heap is added by
+            ///        rebuilding the whole heap in linear time rather than sifting each element up.
+            /// @return The handles of the new elements in input order.
+            template <typename Iterator>
+            std::vector<Handle> pushRange(Iterator first, Iterator last);
+
+            /// @brief Gets the element that orders first.
+            /// @return The top element.
+            const T &top() const;
+
+            /// @brief Gets the handle of the element that orders first.
+            Handle topHandle() const;
+
+            /// @brief Removes the element that orders first.
+            /// @return The removed element.
+            T pop();
+
+            /// @brief Moves an element toward the top by giving it a value that orders no later than its current one.
+            /// @param handle The element to change.
+            /// @param value The new value.
+            void decreaseKey(Handle handle, const T &value);
+
+            /// @brief Removes an arbitrary element.
+            /// @param handle The element to remove.
+            /// @return The removed element.
+            T erase(Handle handle);
+
+            /// @brief Checks whether @p handle refers to an element still in the heap.
+            bool contains(Handle handle) const;
+
+            /// @brief Gets the current value of an element.
+            const T &get(Handle handle) const;
+
+            /// @brief Checks if the heap is empty.
+            bool empty() const;
+
+            /// @brief Gets the number of elements.
+            size_t size() const;
+
+            /// @brief Removes every element and invalidates every handle.
+            void clear();
+
+        private:
+            struct Entry
+            {
+                T _value;
+                Handle _handle;
+            };
+
+            /// @brief Number of unused slots before the root, so sibling groups line up with the allocation.
+            static constexpr size_t OFFSET = D - 1;
+
+            /// @brief Position recorded for a handle whose element is not in the heap.
+            static constexpr size_t NOT_IN_HEAP = std::numeric_limits<size_t>::max();
+
+            Entry &_entry(size_t position);
+
+            const Entry &_entry(size_t position) const;
+
+            /// @brief Stores @p entry at @p position and records where its handle now lives.
+            void _place(size_t position, Entry &&entry);
+
+            void _siftUp(size_t position);
+
+            void _siftDown(size_t position);
+
+            /// @brief Restores the heap order over every element.
+            void _heapify();
+
+            Handle _allocateHandle();
+
+            /// @brief Validates @p handle, throwing if it does not refer to an element in the heap.
+            size_t _positionOf(Handle handle) const;
+
+            /// @brief Elements in heap order, preceded by @c OFFSET unused slots.
+            std::vector<Entry, libdsa::structures::utilities::AlignedAllocator<Entry>> _entries;
+
+            /// @brief Heap position of each handle, or @c NOT_IN_HEAP.
+            std::vector<size_t> _positions;
+
+            /// @brief Handles available for reuse.
+            std::vector<Handle> _freeHandles;
+
+            Compare _compare;
+        }; // DaryHeap
+
+        template <typename T, size_t D, typename Compare>
+        libdsa::structures::DaryHeap<T, D, Compare>::DaryHeap() : _entries(OFFSET)
+        {
+            // Intentionally empty constructor.
+        }
+
+        template <typename T, size_t D, typename Compare>
+        libdsa::structures::DaryHeap<T, D, Compare>::DaryHeap(const std::vector<T> &container) : _entries(OFFSET)
+        {
+            pushRange(container.begin(), container.end());
+        }
+
+        template <typename T, size_t D, typename Compare>
+        typename libdsa::structures::DaryHeap<T, D, Compare>::Entry &
+        libdsa::structures::DaryHeap<T, D, Compare>::_entry(size_t position)
+        {
+            return _entries[position + OFFSET];
+        }
+
+        template <typename T, size_t D, typename Compare>
+        const typename libdsa::structures::DaryHeap<T, D, Compare>::Entry &
+        libdsa::structures::DaryHeap<T, D, Compare>::_entry(size_t position) const
+        {
+            return _entries[position + OFFSET];
+        }
+
+        template <typename T, size_t D, typename Compare>
+        void libdsa::structures::DaryHeap<T, D, Compare>::_place(size_t position, Entry &&entry)
+        {
+            _positions[entry._handle] = position;
+            _entry(position) = std::move(entry);
+        }
+
+        template <typename T, size_t D, typename Compare>
+        void libdsa::structures::DaryHeap<T, D, Compare>::_siftUp(size_t position)
+        {
+            // Shift parents down into the hole instead of swapping, and drop the element in once at the end.
+            Entry moving = std::move(_entry(position));
+
+            while (position > 0)
+            {
+                const size_t parent = (position - 1) / D;
+
+                if (!_compare(moving._value, _entry(parent)._value))
+                {
+                    break;
+                }
+
+                _place(position, std::move(_entry(parent)));
+                position = parent;
+            }
+
+            _place(position, std::move(moving));
+        }
+
+        template <typename T, size_t D, typename Compare>
+        void libdsa::structures::DaryHeap<T, D, Compare>::_siftDown(size_t position)
+        {
+            const size_t count = size();
+            Entry moving = std::move(_entry(position));
+
+            while (true)
+            {
+                const size_t first = D * position + 1;
+
+                if (first >= count)
+                {
+                    break;
+                }
+
+                const size_t last = std::min(first + D, count);
+                size_t best = first;
+
+                for (size_t child = first + 1; child < last; ++child)
+                {
+                    if (_compare(_entry(child)._value, _entry(best)._value))
+                    {
+                        best = child;
+                    }
+                }
+
+                if (!_compare(_entry(best)._value, moving._value))
+                {
+                    break;
+                }
+
+                _place(position, std::move(_entry(best)));
+                position = best;
+            }
+
+            _place(position, std::move(moving));
+        }
+
+        template <typename T, size_t D, typename Compare>
+        void libdsa::structures::DaryHeap<T, D, Compare>::_heapify()
+        {
+            const size_t count = size();
+
+            if (count < 2)
+            {
+                return;
+            }
+
+            // Sifting down every parent from the last one up is linear overall, since most nodes sit near the leaves.
+            for (size_t position = (count - 2) / D + 1; position-- > 0;)
+            {
+                _siftDown(position);
+            }
+        }
+
+        template <typename T, size_t D, typename Compare>
+        typename libdsa::structures::DaryHeap<T, D, Compare>::Handle
+        libdsa::structures::DaryHeap<T, D, Compare>::_allocateHandle()
+        {
+            if (!_freeHandles.empty())
+            {
+                Handle handle = _freeHandles.back();
+                _freeHandles.pop_back();
+                return handle;
+            }
+
+            _positions.push_back(NOT_IN_HEAP);
+            return _positions.size() - 1;
+        }
+
+        template <typename T, size_t D, typename Compare>
+        size_t libdsa::structures::DaryHeap<T, D, Compare>::_positionOf(Handle handle) const
+        {
+            if (handle >= _positions.size() || _positions[handle] == NOT_IN_HEAP)
+            {
+                throw std::out_of_range("DaryHeap - Handle does not refer to an element in the heap.");
+            }
+
+            return _positions[handle];
+        }
+
+        template <typename T, size_t D, typename Compare>
+        typename libdsa::structures::DaryHeap<T, D, Compare>::Handle
+        libdsa::structures::DaryHeap<T, D, Compare>::push(const T &value)
+        {
+            const Handle handle = _allocateHandle();
+            const size_t position = size();
+
+            _positions[handle] = position;
+            _entries.push_back(Entry{value, handle});
+            _siftUp(position);
+
+            return handle;
+        }
+
+        template <typename T, size_t D, typename Compare>
+        template <typename Iterator>
+        std::vector<typename libdsa::structures::DaryHeap<T, D, Compare>::Handle>
+        libdsa::structures::DaryHeap<T, D, Compare>::pushRange(Iterator first, Iterator last)
+        {
+            const size_t previous = size();
+            std::vector<Handle> handles;
+
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                            typename std::iterator_traits<Iterator>::iterator_category>)
+            {
+                const size_t added = static_cast<size_t>(std::distance(first, last));
+                handles.reserve(added);
+                _entries.reserve(_entries.size() + added);
+            }
+
+            for (; first != last; ++first)
+            {
+                const Handle handle = _allocateHandle();
+                _positions[handle] = size();
+                _entries.push_back(Entry{*first, handle});
+                handles.push_back(handle);
+            }
+
+            if (handles.size() >= previous)
+            {
+                _heapify();
+            }
+            else
+            {
+                for (size_t position = previous; position < size(); ++position)
+                {
+                    _siftUp(position);
+                }
+            }
+
+            return handles;
+        }
+
+        template <typename T, size_t D, typename Compare>
+        const T &libdsa::structures::DaryHeap<T, D, Compare>::top() const
+        {
+            if (empty())
+            {
+                throw std::out_of_range("DaryHeap - Heap is empty.");
+            }
+
+            return _entry(0)._value;
+        }
+
+        template <typename T, size_t D, typename Compare>
+        typename libdsa::structures::DaryHeap<T, D, Compare>::Handle
+        libdsa::structures::DaryHeap<T, D, Compare>::topHandle() const
+        {
+            if (empty())
+            {
+                throw std::out_of_range("DaryHeap - Heap is empty.");
+            }
+
+            return _entry(0)._handle;
+        }
+
+        template <typename T, size_t D, typename Compare>
+        T libdsa::structures::DaryHeap<T, D, Compare>::pop()
+        {
+            return erase(topHandle());
+        }
+
+        template <typename T, size_t D, typename Compare>
+        void libdsa::structures::DaryHeap<T, D, Compare>::decreaseKey(Handle handle, const T &value)
+        {
+            const size_t position = _positionOf(handle);
+
+            if (_compare(_entry(position)._value, value))
+            {
+                throw std::invalid_argument("DaryHeap - New key orders after the current key.");
+            }
+
+            _entry(position)._value = value;
+            _siftUp(position);
+        }
+
+        template <typename T, size_t D, typename Compare>
+        T libdsa::structures::DaryHeap<T, D, Compare>::erase(Handle handle)
+        {
+            const size_t position = _positionOf(handle);
+            const size_t last = size() - 1;
+
+            T value = std::move(_entry(position)._value);
+
+            _positions[handle] = NOT_IN_HEAP;
+            _freeHandles.push_back(handle);
+
+            if (position != last)
+            {
+                // Fill the hole with the last element, which may belong either above or below it.
+                _place(position, std::move(_entry(last)));
+                _entries.pop_back();
+
+                if (position > 0 && _compare(_entry(position)._value, _entry((position - 1) / D)._value))
+                {
+                    _siftUp(position);
+                }
+                else
+                {
+                    _siftDown(position);
+                }
+            }
+            else
+            {
+                _entries.pop_back();
+            }
+
+            return value;
+        }
+
+        template <typename T, size_t D, typename Compare>
+        bool libdsa::structures::DaryHeap<T, D, Compare>::contains(Handle handle) const
+        {
+            return handle < _positions.size() && _positions[handle] != NOT_IN_HEAP;
+        }
+
+        template <typename T, size_t D, typename Compare>
+        const T &libdsa::structures::DaryHeap<T, D, Compare>::get(Handle handle) const
+        {
+            return _entry(_positionOf(handle))._value;
+        }
+
+        template <typename T, size_t D, typename Compare>
+        bool libdsa::structures::DaryHeap<T, D, Compare>::empty() const
+        {
+            return _entries.size() == OFFSET;
+        }
+
+        template <typename T, size_t D, typename Compare>
+        size_t libdsa::structures::DaryHeap<T, D, Compare>::size() const
+        {
+            return _entries.size() - OFFSET;
+        }
+
+        template <typename T, size_t D, typename Compare>
+        void libdsa::structures::DaryHeap<T, D, Compare>::clear()
+        {
+            _entries.resize(OFFSET);
+            _positions.clear();
+            _freeHandles.clear();
+        }
+    } // structures
+} // libdsa
+
+#endif // DARYHEAP_H_
+
+/// @}
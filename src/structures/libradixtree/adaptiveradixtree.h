@@ -0,0 +1,1229 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file adaptiveradixtree
+/// @{
+
+#ifndef ADAPTIVERADIXTREE_H_
+#define ADAPTIVERADIXTREE_H_
+
+/// @details The @c AdaptiveRadixTree maps byte string keys to values by branching on one key byte per level.  Inner
+/// nodes come in four sizes and a node is replaced by the next larger or smaller one as its child count changes:
+///   - Node4 and Node16 keep sorted key bytes next to their child pointers; Node16 is searched with one SIMD compare.
+///   - Node48 maps every byte to one of 48 child slots through a 256 entry index.
+///   - Node256 holds a child pointer for every byte.
+///
+/// Chains of single child nodes are collapsed into a prefix stored in the node below them (path compression).  Up to
+/// @c MAX_PREFIX bytes are stored; longer prefixes are skipped during lookups and verified against the full key that
+/// every leaf keeps.  A leaf sits directly under the first node where its key differs from every other key, and inner
+/// nodes are only created when a second key needs to branch off (lazy expansion).
+///
+/// A key that ends exactly where an inner node branches is kept in that node's terminal slot, so no key needs to be
+/// terminated and one key may be a prefix of another.  Keys are visited in lexicographic byte order, and
+/// @c EncodeKey turns unsigned integers into keys that sort numerically.
+
+// From C++ STL
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace tree
+        {
+            template <typename Value>
+            class AdaptiveRadixTree
+            {
+                public:
+
+                    /// @brief Number of compressed path bytes stored in an inner node.
+                    static constexpr size_t MAX_PREFIX = 8;
+
+                private:
+
+                    enum class NodeType : uint8_t
+                    {
+                        LEAF,
+                        NODE4,
+                        NODE16,
+                        NODE48,
+                        NODE256
+                    };
+
+                    struct Node
+                    {
+                        NodeType _type;
+                    };
+
+                    struct Leaf : Node
+                    {
+                        std::string _key;
+                        Value _value;
+
+                        Leaf(const std::string &key, const Value &value) : Node{NodeType::LEAF}, _key(key), _value(value)
+                        {
+                            // Intentionally empty constructor
+                        }
+                    };
+
+                    struct Inner : Node
+                    {
+                        uint16_t _count;
+                        uint32_t _prefixLength;
+                        uint8_t _prefix[MAX_PREFIX];
+
+                        /// @brief Leaf whose key ends where this node branches.
+                        Leaf *_terminal;
+
+                        Inner(NodeType type) : Node{type}, _count(0), _prefixLength(0), _prefix{}, _terminal(nullptr)
+                        {
+                            // Intentionally empty constructor
+                        }
+                    };
+
+                    struct Node4 : Inner
+                    {
+                        uint8_t _keys[4];
+                        Node *_children[4];
+
+                        Node4() : Inner(NodeType::NODE4), _keys{}, _children{}
+                        {
+                            // Intentionally empty constructor
+                        }
+                    };
+
+                    struct Node16 : Inner
+                    {
+                        uint8_t _keys[16];
+                        Node *_children[16];
+
+                        Node16() : Inner(NodeType::NODE16), _keys{}, _children{}
+                        {
+                            // Intentionally empty constructor
+                        }
+                    };
+
+                    struct Node48 : Inner
+                    {
+                        /// @brief Child slot plus one for every byte, or 0 when the byte has no child.
+                        uint8_t _index[256];
+                        Node *_children[48];
+
+                        Node48() : Inner(NodeType::NODE48), _index{}, _children{}
+                        {
+                            // Intentionally empty constructor
+                        }
+                    };
+
+                    struct Node256 : Inner
+                    {
+                        Node *_children[256];
+
+                        Node256() : Inner(NodeType::NODE256), _children{}
+                        {
+                            // Intentionally empty constructor
+                        }
+                    };
+
+                public:
+
+                    /// @brief Constructor for an empty tree.
+                    AdaptiveRadixTree();
+
+                    AdaptiveRadixTree(const AdaptiveRadixTree &) = delete;
+                    AdaptiveRadixTree &operator=(const AdaptiveRadixTree &) = delete;
+
+                    /// @brief Move constructor.  Leaves @p other empty.
+                    AdaptiveRadixTree(AdaptiveRadixTree &&other) noexcept;
+
+                    /// @brief Destructor.  Frees every node.
+                    ~AdaptiveRadixTree();
+
+                    /// @brief Turns an unsigned integer into a big endian key, so integer keys sort numerically.
+                    template <typename Integer>
+                    static std::string EncodeKey(Integer value);
+
+                    /// @brief Adds an element if its key is not already present.
+                    ///
+                    /// @return True if the element was added, false if the key was already present.
+                    bool Insert(const std::string &key, const Value &value);
+
+                    /// @brief Removes an element.
+                    ///
+                    /// @return True if the key was found and removed.
+                    bool Erase(const std::string &key);
+
+                    /// @brief Looks up a key.
+                    ///
+                    /// @return A pointer to the value, or @c nullptr if the key is not present.
+                    Value *Find(const std::string &key) const;
+
+                    /// @brief Checks whether a key is present.
+                    bool Contains(const std::string &key) const;
+
+                    /// @brief Finds the value of the longest stored key that is a prefix of @p key.
+                    ///
+                    /// @return A pointer to the value, or @c nullptr if no stored key is a prefix of @p key.
+                    Value *LongestPrefixMatch(const std::string &key) const;
+
+                    /// @brief Calls @p function with every element whose key starts with @p prefix, in key order.
+                    ///
+                    /// @tparam Function Callable as function(const std::string &, Value &).
+                    ///
+                    /// @return The number of elements visited.
+                    template <typename Function>
+                    size_t PrefixScan(const std::string &prefix, Function function) const;
+
+                    /// @brief Calls @p function with every element in key order.
+                    template <typename Function>
+                    void ForEach(Function function) const;
+
+                    /// @brief Removes every element.
+                    void Clear();
+
+                    /// @brief Checks whether the tree holds no elements.
+                    bool Empty() const;
+
+                    /// @brief Getter to get the number of elements within the tree.
+                    size_t Size() const;
+
+                private:
+
+                    static Leaf *_asLeaf(Node *node);
+
+                    /// @brief Finds the slot holding the child for @p byte, or @c nullptr.
+                    static Node **_findChild(Inner *inner, uint8_t byte);
+
+                    /// @brief Adds a child under @p byte, replacing @p reference with a larger node if it is full.
+                    static void _addChild(Node *&reference, uint8_t byte, Node *child);
+
+                    static void _removeChild(Inner *inner, uint8_t byte);
+
+                    /// @brief Replaces @p reference with a smaller node, or collapses it into its only entry, once it
+                    ///        holds few enough entries.  @p depth is where the prefix of @p reference starts.
+                    static void _shrink(Node *&reference, size_t depth);
+
+                    /// @brief Copies the prefix, terminal and count of @p source into @p destination.
+                    static void _copyHeader(Inner *destination, const Inner *source);
+
+                    /// @brief The leaf with the smallest key below @p node.
+                    static Leaf *_minimumLeaf(Node *node);
+
+                    /// @brief Number of stored prefix bytes of @p inner that match @p key from @p depth.
+                    static size_t _checkPrefix(const Inner *inner, const std::string &key, size_t depth);
+
+                    /// @brief Position of the first byte where the full prefix of @p inner differs from @p key.
+                    static size_t _prefixMismatch(Inner *inner, const std::string &key, size_t depth);
+
+                    static bool _startsWith(const std::string &key, const std::string &prefix);
+
+                    bool _insert(Node *&reference, const std::string &key, const Value &value, size_t depth);
+
+                    bool _erase(Node *&reference, const std::string &key, size_t depth);
+
+                    template <typename Function>
+                    static size_t _visit(Node *node, Function &function);
+
+                    static void _destroy(Node *node);
+
+                    Node *_root;
+
+                    size_t _size;
+            }; // AdaptiveRadixTree
+
+            template <typename Value>
+            libdsa::structures::tree::AdaptiveRadixTree<Value>::AdaptiveRadixTree() : _root(nullptr), _size(0)
+            {
+                // Intentionally empty constructor
+            }
+
+            template <typename Value>
+            libdsa::structures::tree::AdaptiveRadixTree<Value>::AdaptiveRadixTree(AdaptiveRadixTree &&other) noexcept
+                : _root(other._root), _size(other._size)
+            {
+                other._root = nullptr;
+                other._size = 0;
+            }
+
+            template <typename Value>
+            libdsa::structures::tree::AdaptiveRadixTree<Value>::~AdaptiveRadixTree()
+            {
+                _destroy(_root);
+            }
+
+            template <typename Value>
+            template <typename Integer>
+            std::string libdsa::structures::tree::AdaptiveRadixTree<Value>::EncodeKey(Integer value)
+            {
+                static_assert(std::is_unsigned_v<Integer>, "AdaptiveRadixTree - Integer keys must be unsigned.");
+
+                std::string key(sizeof(Integer), '\0');
+
+                for (size_t i = 0; i < sizeof(Integer); ++i)
+                {
+                    key[i] = static_cast<char>(static_cast<uint8_t>(value >> (8 * (sizeof(Integer) - 1 - i))));
+                }
+
+                return key;
+            }
+
+            template <typename Value>
+            typename libdsa::structures::tree::AdaptiveRadixTree<Value>::Leaf *
+            libdsa::structures::tree::AdaptiveRadixTree<Value>::_asLeaf(Node *node)
+            {
+                return node != nullptr && node->_type == NodeType::LEAF ? static_cast<Leaf *>(node) : nullptr;
+            }
+
+            template <typename Value>
+            typename libdsa::structures::tree::AdaptiveRadixTree<Value>::Node **
+            libdsa::structures::tree::AdaptiveRadixTree<Value>::_findChild(Inner *inner, uint8_t byte)
+            {
+                switch (inner->_type)
+                {
+                    case NodeType::NODE4:
+                    {
+                        Node4 *node = static_cast<Node4 *>(inner);
+
+                        for (size_t i = 0; i < node->_count; ++i)
+                        {
+                            if (node->_keys[i] == byte)
+                            {
+                                return &node->_children[i];
+                            }
+                        }
+
+                        return nullptr;
+                    }
+                    case NodeType::NODE16:
+                    {
+                        Node16 *node = static_cast<Node16 *>(inner);
+#if defined(__SSE2__)
+                        // Compare the byte against all sixteen keys at once and keep the lanes that are in use.
+                        const __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(byte)),
+                                                               _mm_loadu_si128(reinterpret_cast<const __m128i *>(node->_keys)));
+                        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(matches)) & ((1u << node->_count) - 1);
+
+                        return mask != 0 ? &node->_children[__builtin_ctz(mask)] : nullptr;
+#else
+                        for (size_t i = 0; i < node->_count; ++i)
+                        {
+                            if (node->_keys[i] == byte)
+                            {
+                                return &node->_children[i];
+                            }
+                        }
+
+                        return nullptr;
+#endif
+                    }
+                    case NodeType::NODE48:
+                    {
+                        Node48 *node = static_cast<Node48 *>(inner);
+                        return node->_index[byte] != 0 ? &node->_children[node->_index[byte] - 1] : nullptr;
+                    }
+                    case NodeType::NODE256:
+                    {
+                        Node256 *node = static_cast<Node256 *>(inner);
+                        return node->_children[byte] != nullptr ? &node->_children[byte] : nullptr;
+                    }
+                    default:
+                        return nullptr;
+                }
+            }
+
+            template <typename Value>
+            void libdsa::structures::tree::AdaptiveRadixTree<Value>::_copyHeader(Inner *destination, const Inner *source)
+            {
+                destination->_count = source->_count;
+                destination->_prefixLength = source->_prefixLength;
+                destination->_terminal = source->_terminal;
+                std::memcpy(destination->_prefix, source->_prefix, MAX_PREFIX);
+            }
+
+            template <typename Value>
+            void libdsa::structures::tree::AdaptiveRadixTree<Value>::_addChild(Node *&reference, uint8_t byte, Node *child)
+            {
+                switch (reference->_type)
+                {
+                    case NodeType::NODE4:
+                    {
+                        Node4 *node = static_cast<Node4 *>(reference);
+
+                        if (node->_count < 4)
+                        {
+                            size_t position = 0;
+
+                            while (position < node->_count && node->_keys[position] < byte)
+                            {
+                                ++position;
+                            }
+
+                            std::memmove(node->_keys + position + 1, node->_keys + position, node->_count - position);
+                            std::memmove(node->_children + position + 1, node->_children + position,
+                                         (node->_count - position) * sizeof(Node *));
+
+                            node->_keys[position] = byte;
+                            node->_children[position] = child;
+                            ++node->_count;
+                            return;
+                        }
+
+                        Node16 *grown = new Node16();
+                        _copyHeader(grown, node);
+                        std::memcpy(grown->_keys, node->_keys, 4);
+                        std::memcpy(grown->_children, node->_children, 4 * sizeof(Node *));
+
+                        reference = grown;
+                        delete node;
+                        break;
+                    }
+                    case NodeType::NODE16:
+                    {
+                        Node16 *node = static_cast<Node16 *>(reference);
+
+                        if (node->_count < 16)
+                        {
+                            size_t position = 0;
+
+                            while (position < node->_count && node->_keys[position] < byte)
+                            {
+                                ++position;
+                            }
+
+                            std::memmove(node->_keys + position + 1, node->_keys + position, node->_count - position);
+                            std::memmove(node->_children + position + 1, node->_children + position,
+                                         (node->_count - position) * sizeof(Node *));
+
+                            node->_keys[position] = byte;
+                            node->_children[position] = child;
+                            ++node->_count;
+                            return;
+                        }
+
+                        Node48 *grown = new Node48();
+                        _copyHeader(grown, node);
+
+                        for (size_t i = 0; i < 16; ++i)
+                        {
+                            grown->_index[node->_keys[i]] = static_cast<uint8_t>(i + 1);
+                            grown->_children[i] = node->_children[i];
+                        }
+
+                        reference = grown;
+                        delete node;
+                        break;
+                    }
+                    case NodeType::NODE48:
+                    {
+                        Node48 *node = static_cast<Node48 *>(reference);
+
+                        if (node->_count < 48)
+                        {
+                            size_t slot = 0;
+
+                            while (node->_children[slot] != nullptr)
+                            {
+                                ++slot;
+                            }
+
+                            node->_children[slot] = child;
+                            node->_index[byte] = static_cast<uint8_t>(slot + 1);
+                            ++node->_count;
+                            return;
+                        }
+
+                        Node256 *grown = new Node256();
+                        _copyHeader(grown, node);
+
+                        for (size_t b = 0; b < 256; ++b)
+                        {
+                            if (node->_index[b] != 0)
+                            {
+                                grown->_children[b] = node->_children[node->_index[b] - 1];
+                            }
+                        }
+
+                        reference = grown;
+                        delete node;
+                        break;
+                    }
+                    case NodeType::NODE256:
+                    {
+                        Node256 *node = static_cast<Node256 *>(reference);
+                        node->_children[byte] = child;
+                        ++node->_count;
+                        return;
+                    }
+                    default:
+                        return;
+                }
+
+                // The node was full and has just been replaced by a larger one with room for the child.
+                _addChild(reference, byte, child);
+            }
+
+            template <typename Value>
+            void libdsa::structures::tree::AdaptiveRadixTree<Value>::_removeChild(Inner *inner, uint8_t byte)
+            {
+                switch (inner->_type)
+                {
+                    case NodeType::NODE4:
+                    case NodeType::NODE16:
+                    {
+                        uint8_t *keys = inner->_type == NodeType::NODE4 ? static_cast<Node4 *>(inner)->_keys
+                                                                        : static_cast<Node16 *>(inner)->_keys;
+                        Node **children = inner->_type == NodeType::NODE4 ? static_cast<Node4 *>(inner)->_children
+                                                                          : static_cast<Node16 *>(inner)->_children;
+
+                        size_t position = 0;
+
+                        while (keys[position] != byte)
+                        {
+                            ++position;
+                        }
+
+                        std::memmove(keys + position, keys + position + 1, inner->_count - position - 1);
+                        std::memmove(children + position, children + position + 1,
+                                     (inner->_count - position - 1) * sizeof(Node *));
+                        break;
+                    }
+                    case NodeType::NODE48:
+                    {
+                        Node48 *node = static_cast<Node48 *>(inner);
+                        node->_children[node->_index[byte] - 1] = nullptr;
+                        node->_index[byte] = 0;
+                        break;
+                    }
+                    case NodeType::NODE256:
+                    {
+                        static_cast<Node256 *>(inner)->_children[byte] = nullptr;
+                        break;
+                    }
+                    default:
+                        return;
+                }
+
+                --inner->_count;
+            }
+
+            template <typename Value>
+            void libdsa::structures::tree::AdaptiveRadixTree<Value>::_shrink(Node *&reference, size_t depth)
+            {
+                Inner *inner = static_cast<Inner *>(reference);
+
+                switch (inner->_type)
+                {
+                    case NodeType::NODE4:
+                    {
+                        Node4 *node = static_cast<Node4 *>(inner);
+
+                        if (node->_count == 0)
+                        {
+                            // Only the terminal is left, and a leaf keeps its whole key so it can stand in directly.
+                            reference = node->_terminal;
+                            delete node;
+                        }
+                        else if (node->_count == 1 && node->_terminal == nullptr)
+                        {
+                            Node *child = node->_children[0];
+
+                            if (child->_type != NodeType::LEAF)
+                            {
+                                // Fold this node's prefix and branch byte into the child's prefix.
+                                Inner *below = static_cast<Inner *>(child);
+                                below->_prefixLength += node->_prefixLength + 1;
+
+                                Leaf *leaf = _minimumLeaf(below);
+                                std::memcpy(below->_prefix, leaf->_key.data() + depth,
+                                            std::min<size_t>(below->_prefixLength, MAX_PREFIX));
+                            }
+
+                            reference = child;
+                            delete node;
+                        }
+
+                        return;
+                    }
+                    case NodeType::NODE16:
+                    {
+                        Node16 *node = static_cast<Node16 *>(inner);
+
+                        if (node->_count > 3)
+                        {
+                            return;
+                        }
+
+                        Node4 *shrunk = new Node4();
+                        _copyHeader(shrunk, node);
+                        std::memcpy(shrunk->_keys, node->_keys, node->_count);
+                        std::memcpy(shrunk->_children, node->_children, node->_count * sizeof(Node *));
+
+                        reference = shrunk;
+                        delete node;
+                        return;
+                    }
+                    case NodeType::NODE48:
+                    {
+                        Node48 *node = static_cast<Node48 *>(inner);
+
+                        if (node->_count > 12)
+                        {
+                            return;
+                        }
+
+                        Node16 *shrunk = new Node16();
+                        _copyHeader(shrunk, node);
+
+                        size_t position = 0;
+
+                        for (size_t b = 0; b < 256; ++b)
+                        {
+                            if (node->_index[b] != 0)
+                            {
+                                shrunk->_keys[position] = static_cast<uint8_t>(b);
+                                shrunk->_children[position++] = node->_children[node->_index[b] - 1];
+                            }
+                        }
+
+                        reference = shrunk;
+                        delete node;
+                        return;
+                    }
+                    case NodeType::NODE256:
+                    {
+                        Node256 *node = static_cast<Node256 *>(inner);
+
+                        if (node->_count > 37)
+                        {
+                            return;
+                        }
+
+                        Node48 *shrunk = new Node48();
+                        _copyHeader(shrunk, node);
+
+                        size_t slot = 0;
+
+                        for (size_t b = 0; b < 256; ++b)
+                        {
+                            if (node->_children[b] != nullptr)
+                            {
+                                shrunk->_index[b] = static_cast<uint8_t>(slot + 1);
+                                shrunk->_children[slot++] = node->_children[b];
+                            }
+                        }
+
+                        reference = shrunk;
+                        delete node;
+                        return;
+                    }
+                    default:
+                        return;
+                }
+            }
+
+            template <typename Value>
+            typename libdsa::structures::tree::AdaptiveRadixTree<Value>::Leaf *
+            libdsa::structures::tree::AdaptiveRadixTree<Value>::_minimumLeaf(Node *node)
+            {
+                while (node != nullptr && node->_type != NodeType::LEAF)
+                {
+                    Inner *inner = static_cast<Inner *>(node);
+
+                    if (inner->_terminal != nullptr)
+                    {
+                        return inner->_terminal;
+                    }
+
+                    switch (inner->_type)
+                    {
+                        case NodeType::NODE4:
+                            node = static_cast<Node4 *>(inner)->_children[0];
+                            break;
+                        case NodeType::NODE16:
+                            node = static_cast<Node16 *>(inner)->_children[0];
+                            break;
+                        case NodeType::NODE48:
+                        {
+                            Node48 *wide = static_cast<Node48 *>(inner);
+                            size_t b = 0;
+
+                            while (wide->_index[b] == 0)
+                            {
+                                ++b;
+                            }
+
+                            node = wide->_children[wide->_index[b] - 1];
+                            break;
+                        }
+                        default:
+                        {
+                            Node256 *wide = static_cast<Node256 *>(inner);
+                            size_t b = 0;
+
+                            while (wide->_children[b] == nullptr)
+                            {
+                                ++b;
+                            }
+
+                            node = wide->_children[b];
+                            break;
+                        }
+                    }
+                }
+
+                return static_cast<Leaf *>(node);
+            }
+
+            template <typename Value>
+            size_t libdsa::structures::tree::AdaptiveRadixTree<Value>::_checkPrefix(const Inner *inner,
+                                                                                    const std::string &key, size_t depth)
+            {
+                const size_t stored = std::min<size_t>(inner->_prefixLength, MAX_PREFIX);
+                size_t matched = 0;
+
+                while (matched < stored && depth + matched < key.size() &&
+                       inner->_prefix[matched] == static_cast<uint8_t>(key[depth + matched]))
+                {
+                    ++matched;
+                }
+
+                return matched;
+            }
+
+            template <typename Value>
+            size_t libdsa::structures::tree::AdaptiveRadixTree<Value>::_prefixMismatch(Inner *inner,
+                                                                                       const std::string &key,
+                                                                                       size_t depth)
+            {
+                const size_t matched = _checkPrefix(inner, key, depth);
+
+                if (matched < std::min<size_t>(inner->_prefixLength, MAX_PREFIX) || inner->_prefixLength <= MAX_PREFIX)
+                {
+                    return matched;
+                }
+
+                // The rest of the prefix is not stored, but every leaf below shares it.
+                const Leaf *leaf = _minimumLeaf(inner);
+                size_t position = matched;
+
+                while (position < inner->_prefixLength && depth + position < key.size() &&
+                       leaf->_key[depth + position] == key[depth + position])
+                {
+                    ++position;
+                }
+
+                return position;
+            }
+
+            template <typename Value>
+            bool libdsa::structures::tree::AdaptiveRadixTree<Value>::_startsWith(const std::string &key,
+                                                                                 const std::string &prefix)
+            {
+                return key.size() >= prefix.size() && key.compare(0, prefix.size(), prefix) == 0;
+            }
+
+            template <typename Value>
+            bool libdsa::structures::tree::AdaptiveRadixTree<Value>::Insert(const std::string &key, const Value &value)
+            {
+                if (_insert(_root, key, value, 0))
+                {
+                    ++_size;
+                    return true;
+                }
+
+                return false;
+            }
+
+            template <typename Value>
+            bool libdsa::structures::tree::AdaptiveRadixTree<Value>::_insert(Node *&reference, const std::string &key,
+                                                                              const Value &value, size_t depth)
+            {
+                if (reference == nullptr)
+                {
+                    reference = new Leaf(key, value);
+                    return true;
+                }
+
+                if (Leaf *existing = _asLeaf(reference))
+                {
+                    if (existing->_key == key)
+                    {
+                        return false;
+                    }
+
+                    // Lazy expansion: only now does the path need a node, starting with the bytes both keys share.
+                    size_t common = 0;
+                    const size_t limit = std::min(existing->_key.size(), key.size());
+
+                    while (depth + common < limit && existing->_key[depth + common] == key[depth + common])
+                    {
+                        ++common;
+                    }
+
+                    Node4 *branch = new Node4();
+                    branch->_prefixLength = static_cast<uint32_t>(common);
+                    std::memcpy(branch->_prefix, key.data() + depth, std::min(common, MAX_PREFIX));
+
+                    Node *node = branch;
+                    const size_t branchDepth = depth + common;
+
+                    for (Leaf *leaf : {existing, new Leaf(key, value)})
+                    {
+                        if (leaf->_key.size() == branchDepth)
+                        {
+                            branch->_terminal = leaf;
+                        }
+                        else
+                        {
+                            _addChild(node, static_cast<uint8_t>(leaf->_key[branchDepth]), leaf);
+                        }
+                    }
+
+                    reference = node;
+                    return true;
+                }
+
+                Inner *inner = static_cast<Inner *>(reference);
+
+                if (inner->_prefixLength > 0)
+                {
+                    const size_t mismatch = _prefixMismatch(inner, key, depth);
+
+                    if (mismatch < inner->_prefixLength)
+                    {
+                        // The key leaves the compressed path part way, so split the path at that byte.
+                        Node4 *branch = new Node4();
+                        branch->_prefixLength = static_cast<uint32_t>(mismatch);
+                        std::memcpy(branch->_prefix, key.data() + depth, std::min(mismatch, MAX_PREFIX));
+
+                        uint8_t byte = 0;
+                        const size_t remaining = inner->_prefixLength - mismatch - 1;
+
+                        if (inner->_prefixLength <= MAX_PREFIX)
+                        {
+                            byte = inner->_prefix[mismatch];
+                            std::memmove(inner->_prefix, inner->_prefix + mismatch + 1, remaining);
+                        }
+                        else
+                        {
+                            const Leaf *leaf = _minimumLeaf(inner);
+                            byte = static_cast<uint8_t>(leaf->_key[depth + mismatch]);
+                            std::memcpy(inner->_prefix, leaf->_key.data() + depth + mismatch + 1,
+                                        std::min(remaining, MAX_PREFIX));
+                        }
+
+                        inner->_prefixLength = static_cast<uint32_t>(remaining);
+
+                        Node *node = branch;
+                        _addChild(node, byte, inner);
+
+                        Leaf *leaf = new Leaf(key, value);
+
+                        if (depth + mismatch == key.size())
+                        {
+                            branch->_terminal = leaf;
+                        }
+                        else
+                        {
+                            _addChild(node, static_cast<uint8_t>(key[depth + mismatch]), leaf);
+                        }
+
+                        reference = node;
+                        return true;
+                    }
+
+                    depth += inner->_prefixLength;
+                }
+
+                if (depth == key.size())
+                {
+                    if (inner->_terminal != nullptr)
+                    {
+                        return false;
+                    }
+
+                    inner->_terminal = new Leaf(key, value);
+                    return true;
+                }
+
+                const uint8_t byte = static_cast<uint8_t>(key[depth]);
+                Node **child = _findChild(inner, byte);
+
+                if (child != nullptr)
+                {
+                    return _insert(*child, key, value, depth + 1);
+                }
+
+                _addChild(reference, byte, new Leaf(key, value));
+                return true;
+            }
+
+            template <typename Value>
+            bool libdsa::structures::tree::AdaptiveRadixTree<Value>::Erase(const std::string &key)
+            {
+                if (_erase(_root, key, 0))
+                {
+                    --_size;
+                    return true;
+                }
+
+                return false;
+            }
+
+            template <typename Value>
+            bool libdsa::structures::tree::AdaptiveRadixTree<Value>::_erase(Node *&reference, const std::string &key,
+                                                                             size_t depth)
+            {
+                if (reference == nullptr)
+                {
+                    return false;
+                }
+
+                if (Leaf *leaf = _asLeaf(reference))
+                {
+                    if (leaf->_key != key)
+                    {
+                        return false;
+                    }
+
+                    delete leaf;
+                    reference = nullptr;
+                    return true;
+                }
+
+                Inner *inner = static_cast<Inner *>(reference);
+                const size_t start = depth;
+
+                if (_checkPrefix(inner, key, depth) != std::min<size_t>(inner->_prefixLength, MAX_PREFIX))
+                {
+                    return false;
+                }
+
+                depth += inner->_prefixLength;
+
+                if (depth > key.size())
+                {
+                    return false;
+                }
+
+                if (depth == key.size())
+                {
+                    if (inner->_terminal == nullptr || inner->_terminal->_key != key)
+                    {
+                        return false;
+                    }
+
+                    delete inner->_terminal;
+                    inner->_terminal = nullptr;
+                    _shrink(reference, start);
+                    return true;
+                }
+
+                const uint8_t byte = static_cast<uint8_t>(key[depth]);
+                Node **child = _findChild(inner, byte);
+
+                if (child == nullptr)
+                {
+                    return false;
+                }
+
+                if (Leaf *leaf = _asLeaf(*child))
+                {
+                    if (leaf->_key != key)
+                    {
+                        return false;
+                    }
+
+                    delete leaf;
+                    _removeChild(inner, byte);
+                    _shrink(reference, start);
+                    return true;
+                }
+
+                return _erase(*child, key, depth + 1);
+            }
+
+            template <typename Value>
+            Value *libdsa::structures::tree::AdaptiveRadixTree<Value>::Find(const std::string &key) const
+            {
+                Node *node = _root;
+                size_t depth = 0;
+
+                while (node != nullptr)
+                {
+                    if (Leaf *leaf = _asLeaf(node))
+                    {
+                        return leaf->_key == key ? &leaf->_value : nullptr;
+                    }
+
+                    Inner *inner = static_cast<Inner *>(node);
+
+                    // Only the stored bytes are checked here; the leaf comparison covers any that were skipped.
+                    if (_checkPrefix(inner, key, depth) != std::min<size_t>(inner->_prefixLength, MAX_PREFIX))
+                    {
+                        return nullptr;
+                    }
+
+                    depth += inner->_prefixLength;
+
+                    if (depth >= key.size())
+                    {
+                        Leaf *terminal = depth == key.size() ? inner->_terminal : nullptr;
+                        return terminal != nullptr && terminal->_key == key ? &terminal->_value : nullptr;
+                    }
+
+                    Node **child = _findChild(inner, static_cast<uint8_t>(key[depth]));
+                    node = child != nullptr ? *child : nullptr;
+                    ++depth;
+                }
+
+                return nullptr;
+            }
+
+            template <typename Value>
+            bool libdsa::structures::tree::AdaptiveRadixTree<Value>::Contains(const std::string &key) const
+            {
+                return Find(key) != nullptr;
+            }
+
+            template <typename Value>
+            Value *libdsa::structures::tree::AdaptiveRadixTree<Value>::LongestPrefixMatch(const std::string &key) const
+            {
+                Leaf *best = nullptr;
+                Node *node = _root;
+                size_t depth = 0;
+
+                // Candidates are only accepted after comparing their full key, so skipped prefix bytes are harmless.
+                while (node != nullptr)
+                {
+                    if (Leaf *leaf = _asLeaf(node))
+                    {
+                        if (_startsWith(key, leaf->_key))
+                        {
+                            best = leaf;
+                        }
+
+                        break;
+                    }
+
+                    Inner *inner = static_cast<Inner *>(node);
+                    depth += inner->_prefixLength;
+
+                    if (depth > key.size())
+                    {
+                        break;
+                    }
+
+                    if (inner->_terminal != nullptr && _startsWith(key, inner->_terminal->_key))
+                    {
+                        best = inner->_terminal;
+                    }
+
+                    if (depth == key.size())
+                    {
+                        break;
+                    }
+
+                    Node **child = _findChild(inner, static_cast<uint8_t>(key[depth]));
+                    node = child != nullptr ? *child : nullptr;
+                    ++depth;
+                }
+
+                return best != nullptr ? &best->_value : nullptr;
+            }
+
+            template <typename Value>
+            template <typename Function>
+            size_t libdsa::structures::tree::AdaptiveRadixTree<Value>::_visit(Node *node, Function &function)
+            {
+                if (Leaf *leaf = _asLeaf(node))
+                {
+                    function(static_cast<const std::string &>(leaf->_key), leaf->_value);
+                    return 1;
+                }
+
+                Inner *inner = static_cast<Inner *>(node);
+                size_t visited = 0;
+
+                // A terminal key is a prefix of every key below it, so it sorts first.
+                if (inner->_terminal != nullptr)
+                {
+                    visited += _visit(inner->_terminal, function);
+                }
+
+                switch (inner->_type)
+                {
+                    case NodeType::NODE4:
+                        for (size_t i = 0; i < inner->_count; ++i)
+                        {
+                            visited += _visit(static_cast<Node4 *>(inner)->_children[i], function);
+                        }
+                        break;
+                    case NodeType::NODE16:
+                        for (size_t i = 0; i < inner->_count; ++i)
+                        {
+                            visited += _visit(static_cast<Node16 *>(inner)->_children[i], function);
+                        }
+                        break;
+                    case NodeType::NODE48:
+                    {
+                        Node48 *wide = static_cast<Node48 *>(inner);
+
+                        for (size_t b = 0; b < 256; ++b)
+                        {
+                            if (wide->_index[b] != 0)
+                            {
+                                visited += _visit(wide->_children[wide->_index[b] - 1], function);
+                            }
+                        }
+                        break;
+                    }
+                    default:
+                    {
+                        Node256 *wide = static_cast<Node256 *>(inner);
+
+                        for (size_t b = 0; b < 256; ++b)
+                        {
+                            if (wide->_children[b] != nullptr)
+                            {
+                                visited += _visit(wide->_children[b], function);
+                            }
+                        }
+                        break;
+                    }
+                }
+
+                return visited;
+            }
+
+            template <typename Value>
+            template <typename Function>
+            size_t libdsa::structures::tree::AdaptiveRadixTree<Value>::PrefixScan(const std::string &prefix,
+                                                                                  Function function) const
+            {
+                Node *node = _root;
+                size_t depth = 0;
+
+                while (node != nullptr)
+                {
+                    if (Leaf *leaf = _asLeaf(node))
+                    {
+                        return _startsWith(leaf->_key, prefix) ? _visit(leaf, function) : 0;
+                    }
+
+                    Inner *inner = static_cast<Inner *>(node);
+
+                    // Once the prefix ends inside this node's path, either every key below matches or none does,
+                    // and any one leaf tells which.
+                    if (depth + inner->_prefixLength >= prefix.size())
+                    {
+                        return _startsWith(_minimumLeaf(inner)->_key, prefix) ? _visit(inner, function) : 0;
+                    }
+
+                    depth += inner->_prefixLength;
+
+                    Node **child = _findChild(inner, static_cast<uint8_t>(prefix[depth]));
+                    node = child != nullptr ? *child : nullptr;
+                    ++depth;
+                }
+
+                return 0;
+            }
+
+            template <typename Value>
+            template <typename Function>
+            void libdsa::structures::tree::AdaptiveRadixTree<Value>::ForEach(Function function) const
+            {
+                if (_root != nullptr)
+                {
+                    _visit(_root, function);
+                }
+            }
+
+            template <typename Value>
+            void libdsa::structures::tree::AdaptiveRadixTree<Value>::_destroy(Node *node)
+            {
+                if (node == nullptr)
+                {
+                    return;
+                }
+
+                if (Leaf *leaf = _asLeaf(node))
+                {
+                    delete leaf;
+                    return;
+                }
+
+                Inner *inner = static_cast<Inner *>(node);
+                _destroy(inner->_terminal);
+
+                switch (inner->_type)
+                {
+                    case NodeType::NODE4:
+                        for (size_t i = 0; i < inner->_count; ++i)
+                        {
+                            _destroy(static_cast<Node4 *>(inner)->_children[i]);
+                        }
+
+                        delete static_cast<Node4 *>(inner);
+                        break;
+                    case NodeType::NODE16:
+                        for (size_t i = 0; i < inner->_count; ++i)
+                        {
+                            _destroy(static_cast<Node16 *>(inner)->_children[i]);
+                        }
+
+                        delete static_cast<Node16 *>(inner);
+                        break;
+                    case NodeType::NODE48:
+                        for (Node *child : static_cast<Node48 *>(inner)->_children)
+                        {
+                            _destroy(child);
+                        }
+
+                        delete static_cast<Node48 *>(inner);
+                        break;
+                    default:
+                        for (Node *child : static_cast<Node256 *>(inner)->_children)
+                        {
+                            _destroy(child);
+                        }
+
+                        delete static_cast<Node256 *>(inner);
+                        break;
+                }
+            }
+
+            template <typename Value>
+            void libdsa::structures::tree::AdaptiveRadixTree<Value>::Clear()
+            {
+                _destroy(_root);
+                _root = nullptr;
+                _size = 0;
+            }
+
+            template <typename Value>
+            bool libdsa::structures::tree::AdaptiveRadixTree<Value>::Empty() const
+            {
+                return _size == 0;
+            }
+
+            template <typename Value>
+            size_t libdsa::structures::tree::AdaptiveRadixTree<Value>::Size() const
+            {
+                return _size;
+            }
+        } // tree
+    } // structures
+} // libdsa
+
+#endif // ADAPTIVERADIXTREE_H_
+/// @}
@@ -0,0 +1,243 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file fenwicktree
+/// @{
+
+#ifndef FENWICKTREE_H_
+#define FENWICKTREE_H_
+
+/// @details The @c FenwickTree (binary indexed tree) keeps prefix sums of an array that changes one element at a time.
+/// Slot i of its 1-indexed array holds the sum of the lowbit(i) elements ending at i, so both a prefix sum and a point
+/// update touch O(log n) slots of one flat array.
+
+// From C++ STL
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace tree
+        {
+            template <typename Type>
+            class FenwickTree
+            {
+                public:
+
+                    /// @brief Constructor for @p size elements that are all zero.
+                    FenwickTree(size_t size = 0);
+
+                    /// @brief Constructor from an std::array container in O(n).
+                    ///
+                    /// @tparam Subtype The data type of the array.
+                    /// @tparam SIZE The size of the array
+                    ///
+                    /// @param container The container we want to build from defined by the template parameters.
+                    template <typename Subtype, std::size_t SIZE>
+                    FenwickTree(std::array<Subtype, SIZE> &container);
+
+                    /// @brief Constructor from an std::vector container in O(n).
+                    ///
+                    /// @tparam Subtype The internal data type of the vector.
+                    ///
+                    /// @param container The container we want to build from defined by the template parameters.
+                    template <typename Subtype>
+                    FenwickTree(std::vector<Subtype> &container);
+
+                    /// @brief Adds @p delta to the element at @p index.
+                    void Add(size_t index, const Type &delta);
+
+                    /// @brief Replaces the element at @p index.
+                    void Set(size_t index, const Type &value);
+
+                    /// @brief Gets the element at @p index.
+                    Type Get(size_t index) const;
+
+                    /// @brief Sum of the elements in [0, @p end).
+                    Type PrefixSum(size_t end) const;
+
+                    /// @brief Sum of the elements in [@p begin, @p end).
+                    Type RangeSum(size_t begin, size_t end) const;
+
+                    /// @brief Finds the smallest @c end whose prefix sum [0, end] reaches @p target, assuming no element
+                    ///        is negative.
+                    ///
+                    /// @return The index of that element, or @c Size() if the total is below @p target.
+                    size_t LowerBound(Type target) const;
+
+                    /// @brief Getter to get the number of elements.
+                    size_t Size() const;
+
+                private:
+
+                    /// @brief Checks that the type of the tree and the data instance are the same.
+                    template <typename Subtype>
+                    void _checkTypeCompatability(Subtype);
+
+                    /// @brief Fills the tree from @p values in one pass, pushing each slot into its parent.
+                    template <typename Iterator>
+                    void _build(Iterator first, Iterator last);
+
+                    void _checkIndex(size_t index) const;
+
+                    /// @brief Partial sums, 1-indexed.  Slot 0 is unused.
+                    std::vector<Type> _tree;
+            }; // FenwickTree
+
+            template <typename Type>
+            libdsa::structures::tree::FenwickTree<Type>::FenwickTree(size_t size) : _tree(size + 1, Type{})
+            {
+                // Intentionally empty constructor
+            }
+
+            template <typename Type>
+            template <typename Subtype, std::size_t SIZE>
+            libdsa::structures::tree::FenwickTree<Type>::FenwickTree(std::array<Subtype, SIZE> &container)
+            {
+                using array_element_type = typename std::remove_reference<decltype(*std::begin(container))>::type;
+                array_element_type temp{};
+                _checkTypeCompatability(temp);
+
+                _build(container.begin(), container.end());
+            }
+
+            template <typename Type>
+            template <typename Subtype>
+            libdsa::structures::tree::FenwickTree<Type>::FenwickTree(std::vector<Subtype> &container)
+            {
+                using vector_element_type = typename std::remove_reference<decltype(*std::begin(container))>::type;
+                vector_element_type temp{};
+                _checkTypeCompatability(temp);
+
+                _build(container.begin(), container.end());
+            }
+
+            template <typename Type>
+            template <typename Subtype>
+            void libdsa::structures::tree::FenwickTree<Type>::_checkTypeCompatability(Subtype)
+            {
+                if constexpr (!std::is_same_v<Type, Subtype>)
+                {
+                    throw std::runtime_error("FenwickTree - Invalid type passed into tree.");
+                }
+            }
+
+            template <typename Type>
+            template <typename Iterator>
+            void libdsa::structures::tree::FenwickTree<Type>::_build(Iterator first, Iterator last)
+            {
+                _tree.assign(1, Type{});
+                _tree.insert(_tree.end(), first, last);
+
+                for (size_t i = 1; i < _tree.size(); ++i)
+                {
+                    const size_t parent = i + (i & (~i + 1));
+
+                    if (parent < _tree.size())
+                    {
+                        _tree[parent] += _tree[i];
+                    }
+                }
+            }
+
+            template <typename Type>
+            void libdsa::structures::tree::FenwickTree<Type>::_checkIndex(size_t index) const
+            {
+                if (index >= Size())
+                {
+                    throw std::out_of_range("FenwickTree - Index out of range.");
+                }
+            }
+
+            template <typename Type>
+            void libdsa::structures::tree::FenwickTree<Type>::Add(size_t index, const Type &delta)
+            {
+                _checkIndex(index);
+
+                for (size_t i = index + 1; i < _tree.size(); i += i & (~i + 1))
+                {
+                    _tree[i] += delta;
+                }
+            }
+
+            template <typename Type>
+            void libdsa::structures::tree::FenwickTree<Type>::Set(size_t index, const Type &value)
+            {
+                Add(index, value - Get(index));
+            }
+
+            template <typename Type>
+            Type libdsa::structures::tree::FenwickTree<Type>::Get(size_t index) const
+            {
+                _checkIndex(index);
+                return RangeSum(index, index + 1);
+            }
+
+            template <typename Type>
+            Type libdsa::structures::tree::FenwickTree<Type>::PrefixSum(size_t end) const
+            {
+                if (end > Size())
+                {
+                    throw std::out_of_range("FenwickTree - Index out of range.");
+                }
+
+                Type sum{};
+
+                for (size_t i = end; i > 0; i &= i - 1)
+                {
+                    sum += _tree[i];
+                }
+
+                return sum;
+            }
+
+            template <typename Type>
+            Type libdsa::structures::tree::FenwickTree<Type>::RangeSum(size_t begin, size_t end) const
+            {
+                if (begin > end)
+                {
+                    throw std::invalid_argument("FenwickTree - Range begins after it ends.");
+                }
+
+                return PrefixSum(end) - PrefixSum(begin);
+            }
+
+            template <typename Type>
+            size_t libdsa::structures::tree::FenwickTree<Type>::LowerBound(Type target) const
+            {
+                // Descend by powers of two, taking every slot whose sum still leaves the target unreached.
+                size_t position = 0;
+                size_t step = 1;
+
+                while (step * 2 < _tree.size())
+                {
+                    step *= 2;
+                }
+
+                for (; step > 0; step /= 2)
+                {
+                    if (position + step < _tree.size() && _tree[position + step] < target)
+                    {
+                        position += step;
+                        target -= _tree[position];
+                    }
+                }
+
+                return position;
+            }
+
+            template <typename Type>
+            size_t libdsa::structures::tree::FenwickTree<Type>::Size() const
+            {
+                return _tree.size() - 1;
+            }
+        } // tree
+    } // structures
+} // libdsa
+
+#endif // FENWICKTREE_H_
+/// @}
@@ -0,0 +1,488 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file segmenttree
+/// @{
+
+#ifndef SEGMENTTREE_H_
+#define SEGMENTTREE_H_
+
+/// @details The @c SegmentTree answers aggregate queries over index ranges and applies updates to whole ranges, both
+/// in O(log n).  The tree is implicit: the leaves fill the second half of one array, padded to a power of two, and
+/// node i has children 2i and 2i + 1.  An update that covers a node completely is recorded in the node's pending
+/// (lazy) slot.  It is pushed down to the children only when a later operation needs to look inside that node.
+///
+/// What is aggregated and how updates act is given by a policy with these members:
+///   - @c Value and @c Update types.
+///   - @c identity(): the neutral @c Value for @c combine.
+///   - @c combine(left, right): the associative aggregate of two adjacent ranges.
+///   - @c apply(value, update, length): the aggregate of a range of @p length elements after @p update.
+///   - @c compose(newer, older): one update equivalent to applying @p older and then @p newer.
+///
+/// Policies for sums, minimums and maximums under range addition are provided.
+
+// From C++ STL
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace libdsa
+{
+    namespace structures
+    {
+        namespace tree
+        {
+            /// @brief Range sums under range addition.
+            template <typename Type>
+            struct SumAddPolicy
+            {
+                using Value = Type;
+                using Update = Type;
+
+                static Value identity()
+                {
+                    return Value{};
+                }
+
+                static Value combine(const Value &left, const Value &right)
+                {
+                    return left + right;
+                }
+
+                static Value apply(const Value &value, const Update &update, size_t length)
+                {
+                    return value + update * static_cast<Type>(length);
+                }
+
+                static Update compose(const Update &newer, const Update &older)
+                {
+                    return newer + older;
+                }
+            };
+
+            /// @brief Range minimums under range addition.
+            template <typename Type>
+            struct MinAddPolicy
+            {
+                using Value = Type;
+                using Update = Type;
+
+                static Value identity()
+                {
+                    return std::numeric_limits<Type>::max();
+                }
+
+                static Value combine(const Value &left, const Value &right)
+                {
+                    return std::min(left, right);
+                }
+
+                static Value apply(const Value &value, const Update &update, size_t)
+                {
+                    return value + update;
+                }
+
+                static Update compose(const Update &newer, const Update &older)
+                {
+                    return newer + older;
+                }
+            };
+
+            /// @brief Range maximums under range addition.
+            template <typename Type>
+            struct MaxAddPolicy
+            {
+                using Value = Type;
+                using Update = Type;
+
+                static Value identity()
+                {
+                    return std::numeric_limits<Type>::lowest();
+                }
+
+                static Value combine(const Value &left, const Value &right)
+                {
+                    return std::max(left, right);
+                }
+
+                static Value apply(const Value &value, const Update &update, size_t)
+                {
+                    return value + update;
+                }
+
+                static Update compose(const Update &newer, const Update &older)
+                {
+                    return newer + older;
+                }
+            };
+
+            template <typename Policy>
+            class SegmentTree
+            {
+                public:
+
+                    using ValueType = typename Policy::Value;
+                    using UpdateType = typename Policy::Update;
+
+                    /// @brief Constructor for @p size elements that all hold the policy's identity.
+                    SegmentTree(size_t size = 0);
+
+                    /// @brief Constructor from an std::array container in O(n).
+                    ///
+                    /// @tparam Subtype The data type of the array.
+                    /// @tparam SIZE The size of the array
+                    ///
+                    /// @param container The container we want to build from defined by the template parameters.
+                    template <typename Subtype, std::size_t SIZE>
+                    SegmentTree(std::array<Subtype, SIZE> &container);
+
+                    /// @brief Constructor from an std::vector container in O(n).
+                    ///
+                    /// @tparam Subtype The internal data type of the vector.
+                    ///
+                    /// @param container The container we want to build from defined by the template parameters.
+                    template <typename Subtype>
+                    SegmentTree(std::vector<Subtype> &container);
+
+                    /// @brief Aggregate of the elements in [@p begin, @p end).  An empty range gives the identity.
+                    ValueType Query(size_t begin, size_t end);
+
+                    /// @brief Aggregate of every element.
+                    ValueType QueryAll() const;
+
+                    /// @brief Applies @p update to every element in [@p begin, @p end).
+                    void Update(size_t begin, size_t end, const UpdateType &update);
+
+                    /// @brief Replaces the element at @p index.
+                    void Set(size_t index, const ValueType &value);
+
+                    /// @brief Gets the element at @p index.
+                    ValueType Get(size_t index);
+
+                    /// @brief Getter to get the number of elements.
+                    size_t Size() const;
+
+                private:
+
+                    /// @brief Checks that the type of the tree and the data instance are the same.
+                    template <typename Subtype>
+                    void _checkTypeCompatability(Subtype);
+
+                    /// @brief Allocates the arrays for @p size elements.
+                    void _allocate(size_t size);
+
+                    /// @brief Computes every inner node from the leaves, bottom up.
+                    void _buildInner();
+
+                    void _checkRange(size_t begin, size_t end) const;
+
+                    /// @brief Number of leaves under @p node.
+                    size_t _length(size_t node) const;
+
+                    /// @brief Applies @p update to the aggregate of @p node and records it as pending for the children.
+                    void _applyToNode(size_t node, const UpdateType &update);
+
+                    /// @brief Hands the pending update of @p node to its children.
+                    void _push(size_t node);
+
+                    /// @brief Pushes every pending update on the path from the root down to the parent of @p leaf.
+                    void _pushPath(size_t leaf);
+
+                    void _pull(size_t node);
+
+                    size_t _size;
+
+                    /// @brief Number of leaves, the smallest power of two that is at least @c _size.
+                    size_t _capacity;
+
+                    /// @brief log2 of @c _capacity.
+                    size_t _levels;
+
+                    /// @brief Aggregates; the leaves start at @c _capacity and node 0 is unused.
+                    std::vector<ValueType> _values;
+
+                    /// @brief Pending update of each inner node.
+                    std::vector<UpdateType> _pending;
+
+                    /// @brief Whether an inner node has a pending update.
+                    std::vector<uint8_t> _hasPending;
+            }; // SegmentTree
+
+            template <typename Policy>
+            libdsa::structures::tree::SegmentTree<Policy>::SegmentTree(size_t size)
+            {
+                _allocate(size);
+            }
+
+            template <typename Policy>
+            template <typename Subtype, std::size_t SIZE>
+            libdsa::structures::tree::SegmentTree<Policy>::SegmentTree(std::array<Subtype, SIZE> &container)
+            {
+                using array_element_type = typename std::remove_reference<decltype(*std::begin(container))>::type;
+                array_element_type temp{};
+                _checkTypeCompatability(temp);
+
+                _allocate(container.size());
+                std::copy(container.begin(), container.end(), _values.begin() + _capacity);
+                _buildInner();
+            }
+
+            template <typename Policy>
+            template <typename Subtype>
+            libdsa::structures::tree::SegmentTree<Policy>::SegmentTree(std::vector<Subtype> &container)
+            {
+                using vector_element_type = typename std::remove_reference<decltype(*std::begin(container))>::type;
+                vector_element_type temp{};
+                _checkTypeCompatability(temp);
+
+                _allocate(container.size());
+                std::copy(container.begin(), container.end(), _values.begin() + _capacity);
+                _buildInner();
+            }
+
+            template <typename Policy>
+            template <typename Subtype>
+            void libdsa::structures::tree::SegmentTree<Policy>::_checkTypeCompatability(Subtype)
+            {
+                if constexpr (!std::is_same_v<ValueType, Subtype>)
+                {
+                    throw std::runtime_error("SegmentTree - Invalid type passed into tree.");
+                }
+            }
+
+            template <typename Policy>
+            void libdsa::structures::tree::SegmentTree<Policy>::_allocate(size_t size)
+            {
+                _size = size;
+                _capacity = 1;
+                _levels = 0;
+
+                while (_capacity < size)
+                {
+                    _capacity *= 2;
+                    ++_levels;
+                }
+
+                _values.assign(2 * _capacity, Policy::identity());
+                _pending.assign(_capacity, UpdateType{});
+                _hasPending.assign(_capacity, 0);
+            }
+
+            template <typename Policy>
+            void libdsa::structures::tree::SegmentTree<Policy>::_buildInner()
+            {
+                for (size_t node = _capacity - 1; node > 0; --node)
+                {
+                    _pull(node);
+                }
+            }
+
+            template <typename Policy>
+            void libdsa::structures::tree::SegmentTree<Policy>::_checkRange(size_t begin, size_t end) const
+            {
+                if (begin > end)
+                {
+                    throw std::invalid_argument("SegmentTree - Range begins after it ends.");
+                }
+
+                if (end > _size)
+                {
+                    throw std::out_of_range("SegmentTree - Index out of range.");
+                }
+            }
+
+            template <typename Policy>
+            size_t libdsa::structures::tree::SegmentTree<Policy>::_length(size_t node) const
+            {
+                // A node on level k below the root covers capacity / 2^k leaves.
+                const size_t level = 63 - static_cast<size_t>(__builtin_clzll(node));
+                return _capacity >> level;
+            }
+
+            template <typename Policy>
+            void libdsa::structures::tree::SegmentTree<Policy>::_applyToNode(size_t node, const UpdateType &update)
+            {
+                _values[node] = Policy::apply(_values[node], update, _length(node));
+
+                if (node < _capacity)
+                {
+                    _pending[node] = _hasPending[node] ? Policy::compose(update, _pending[node]) : update;
+                    _hasPending[node] = 1;
+                }
+            }
+
+            template <typename Policy>
+            void libdsa::structures::tree::SegmentTree<Policy>::_push(size_t node)
+            {
+                if (_hasPending[node])
+                {
+                    _applyToNode(2 * node, _pending[node]);
+                    _applyToNode(2 * node + 1, _pending[node]);
+                    _hasPending[node] = 0;
+                }
+            }
+
+            template <typename Policy>
+            void libdsa::structures::tree::SegmentTree<Policy>::_pushPath(size_t leaf)
+            {
+                for (size_t level = _levels; level > 0; --level)
+                {
+                    _push(leaf >> level);
+                }
+            }
+
+            template <typename Policy>
+            void libdsa::structures::tree::SegmentTree<Policy>::_pull(size_t node)
+            {
+                _values[node] = Policy::combine(_values[2 * node], _values[2 * node + 1]);
+            }
+
+            template <typename Policy>
+            typename libdsa::structures::tree::SegmentTree<Policy>::ValueType
+            libdsa::structures::tree::SegmentTree<Policy>::Query(size_t begin, size_t end)
+            {
+                _checkRange(begin, end);
+
+                if (begin == end)
+                {
+                    return Policy::identity();
+                }
+
+                size_t left = begin + _capacity;
+                size_t right = end + _capacity;
+
+                // Only the nodes on the two boundary paths can hold updates that the covering nodes have not seen.
+                for (size_t level = _levels; level > 0; --level)
+                {
+                    if (((left >> level) << level) != left)
+                    {
+                        _push(left >> level);
+                    }
+
+                    if (((right >> level) << level) != right)
+                    {
+                        _push((right - 1) >> level);
+                    }
+                }
+
+                ValueType leftSum = Policy::identity();
+                ValueType rightSum = Policy::identity();
+
+                for (; left < right; left /= 2, right /= 2)
+                {
+                    if (left & 1)
+                    {
+                        leftSum = Policy::combine(leftSum, _values[left++]);
+                    }
+
+                    if (right & 1)
+                    {
+                        rightSum = Policy::combine(_values[--right], rightSum);
+                    }
+                }
+
+                return Policy::combine(leftSum, rightSum);
+            }
+
+            template <typename Policy>
+            typename libdsa::structures::tree::SegmentTree<Policy>::ValueType
+            libdsa::structures::tree::SegmentTree<Policy>::QueryAll() const
+            {
+                return _values[1];
+            }
+
+            template <typename Policy>
+            void libdsa::structures::tree::SegmentTree<Policy>::Update(size_t begin, size_t end, const UpdateType &update)
+            {
+                _checkRange(begin, end);
+
+                if (begin == end)
+                {
+                    return;
+                }
+
+                const size_t first = begin + _capacity;
+                const size_t last = end + _capacity;
+
+                for (size_t level = _levels; level > 0; --level)
+                {
+                    if (((first >> level) << level) != first)
+                    {
+                        _push(first >> level);
+                    }
+
+                    if (((last >> level) << level) != last)
+                    {
+                        _push((last - 1) >> level);
+                    }
+                }
+
+                for (size_t left = first, right = last; left < right; left /= 2, right /= 2)
+                {
+                    if (left & 1)
+                    {
+                        _applyToNode(left++, update);
+                    }
+
+                    if (right & 1)
+                    {
+                        _applyToNode(--right, update);
+                    }
+                }
+
+                // Recompute the partially covered ancestors on both boundary paths.
+                for (size_t level = 1; level <= _levels; ++level)
+                {
+                    if (((first >> level) << level) != first)
+                    {
+                        _pull(first >> level);
+                    }
+
+                    if (((last >> level) << level) != last)
+                    {
+                        _pull((last - 1) >> level);
+                    }
+                }
+            }
+
+            template <typename Policy>
+            void libdsa::structures::tree::SegmentTree<Policy>::Set(size_t index, const ValueType &value)
+            {
+                _checkRange(index, index + 1);
+
+                const size_t leaf = index + _capacity;
+                _pushPath(leaf);
+                _values[leaf] = value;
+
+                for (size_t node = leaf / 2; node > 0; node /= 2)
+                {
+                    _pull(node);
+                }
+            }
+
+            template <typename Policy>
+            typename libdsa::structures::tree::SegmentTree<Policy>::ValueType
+            libdsa::structures::tree::SegmentTree<Policy>::Get(size_t index)
+            {
+                _checkRange(index, index + 1);
+
+                const size_t leaf = index + _capacity;
+                _pushPath(leaf);
+                return _values[leaf];
+            }
+
+            template <typename Policy>
+            size_t libdsa::structures::tree::SegmentTree<Policy>::Size() const
+            {
+                return _size;
+            }
+        } // tree
+    } // structures
+} // libdsa
+
+#endif // SEGMENTTREE_H_
+/// @}
@@ -0,0 +1,558 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @name BufferPool
+/// @{
+
+#ifndef BUFFERPOOL_H_
+#define BUFFERPOOL_H_
+
+/// @details A pool of reference-counted byte buffers for the transports' receive paths.  Buffers come in a few fixed
+/// size classes; each class is carved out of large slabs, so the allocator is only involved when a class runs out
+/// of buffers altogether, and a slab is never returned until the pool goes away.
+///
+/// Every thread keeps its own cache of free buffers per class and per pool, so acquiring and releasing normally
+/// touch no lock and no memory shared with other threads.  A cache that runs dry takes a batch from the pool's
+/// shared free lists, and one that grows past @c CACHE_LIMIT hands half of it back, which keeps buffers flowing
+/// when one thread receives and another releases.
+///
+/// A @c BufferHandle shares one buffer: copies add a reference, and the buffer goes back to its pool when the last
+/// one is released.  Handles must be released before their pool is destroyed.  @c lend() wraps memory owned by
+/// someone else, such as an io_uring buffer ring, in the same kind of handle, and calls the owner back instead.
+
+// From C++ STL
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace libdsa
+{
+    namespace libstructures
+    {
+        class BufferHandle;
+
+        class BufferPool
+        {
+        public:
+            /// @brief Number of size classes, and the capacity of each.  Larger requests get a buffer of their own,
+            ///        allocated on acquire and freed on release.
+            static constexpr size_t SIZE_CLASSES = 4;
+            static constexpr size_t CLASS_CAPACITIES[SIZE_CLASSES] = {512, 4 * 1024, 16 * 1024, 64 * 1024};
+
+            /// @brief Bytes allocated at once when a size class runs out.
+            static constexpr size_t SLAB_BYTES = 1024 * 1024;
+
+            /// @brief Free buffers of one class a thread keeps before handing half of them back.
+            static constexpr size_t CACHE_LIMIT = 64;
+
+            /// @brief Room reserved in front of every buffer's bytes for its bookkeeping, which keeps the bytes cache
+            ///        line aligned.  Memory given to @c lend() must leave this much room too.
+            static constexpr size_t HEADER_BYTES = 64;
+
+            /// @brief Called with the lender and the buffer's bytes once the last handle to a lent buffer is released.
+            using GiveBack = void (*)(void *lender, char *data);
+
+            BufferPool();
+            ~BufferPool();
+
+            BufferPool(const BufferPool &) = delete;
+            BufferPool &operator=(const BufferPool &) = delete;
+
+            /// @brief Gets the pool shared by every transport that was not given one.  It is never destroyed.
+            static BufferPool &shared();
+
+            /// @brief Gets a buffer with room for at least @p size bytes, whose size is set to @p size.
+            /// @return An empty handle if memory ran out.
+            BufferHandle acquire(size_t size);
+
+            /// @brief Wraps @p capacity bytes at @p data, owned by @p lender, in a handle whose size is @p size.  No
+            ///        pool is involved: releasing the last handle calls @p giveBack(lender, data) on that thread.
+            /// @param data Must be 8-byte aligned and preceded by @c HEADER_BYTES bytes the handle may use.
+            static BufferHandle lend(char *data, size_t capacity, size_t size, GiveBack giveBack, void *lender);
+
+            /// @brief Gets the number of slabs allocated so far.
+            size_t slabCount() const;
+
+            /// @brief Gets the capacity of the buffer @c acquire() returns for @p size bytes.
+            static size_t capacityFor(size_t size);
+
+        private:
+            friend class BufferHandle;
+
+            struct Depot;
+
+            /// @brief Bookkeeping in front of every buffer's bytes.
+            struct Block
+            {
+                std::atomic<uint32_t> references;
+
+                /// @brief @c SIZE_CLASSES for buffers that belong to no class.
+                uint32_t sizeClass;
+                Depot *depot;
+
+                /// @brief Next free block of the same class.
+                Block *next;
+                size_t size;
+                size_t capacity;
+
+                /// @brief Set for lent buffers, which go back to their lender rather than to a pool.
+                GiveBack giveBack;
+                void *lender;
+
+                char *data();
+            };
+
+            /// @brief The pool's shared free lists and slabs.  It outlives the pool for as long as a thread's cache
+            ///        still refers to it.
+            struct Depot : std::enable_shared_from_this<Depot>
+            {
+                Depot();
+                ~Depot();
+
+                mutable std::mutex mutex;
+                Block *free[SIZE_CLASSES];
+                std::vector<void *> slabs;
+            };
+
+            /// @brief One thread's free buffers of one pool.
+            struct Cache
+            {
+                std::shared_ptr<Depot> depot;
+                Block *free[SIZE_CLASSES];
+                size_t count[SIZE_CLASSES];
+            };
+
+            /// @brief The caches of the calling thread, which return their buffers when the thread exits.
+            struct ThreadCaches
+            {
+                ~ThreadCaches();
+
+                std::vector<Cache> entries;
+            };
+
+            /// @brief Gets the first size class holding @p size bytes, or @c SIZE_CLASSES if none does.
+            static size_t _sizeClass(size_t size);
+
+            static ThreadCaches &_threadCaches();
+
+            /// @brief Gets the calling thread's cache for @p depot, creating it if needed.  The lookup compares plain
+            ///        pointers, so the depot's reference count is only touched when a cache is created.
+            static Cache &_cache(Depot *depot);
+
+            /// @brief Moves up to half of @c CACHE_LIMIT free blocks of @p sizeClass from the depot to @p cache,
+            ///        allocating a slab if the depot has none.
+            /// @return False if memory ran out.
+            static bool _refill(Cache &cache, size_t sizeClass);
+
+            /// @brief Moves @p count blocks of @p sizeClass from @p cache back to its depot.
+            static void _drain(Cache &cache, size_t sizeClass, size_t count);
+
+            /// @brief Hands a block whose last reference is gone back to its pool.
+            static void _release(Block *block);
+
+            std::shared_ptr<Depot> _depot;
+        }; // BufferPool
+
+        /// @brief A counted reference to a buffer of a @c BufferPool.  Copies share the bytes and the size.
+        class BufferHandle
+        {
+        public:
+            /// @brief Builds a handle to no buffer.
+            BufferHandle();
+
+            BufferHandle(const BufferHandle &other);
+            BufferHandle(BufferHandle &&other) noexcept;
+            BufferHandle &operator=(BufferHandle other) noexcept;
+
+            /// @brief Drops this reference, releasing the buffer if it was the last.
+            ~BufferHandle();
+
+            char *data();
+            const char *data() const;
+
+            /// @brief Gets the number of bytes in use.
+            size_t size() const;
+
+            /// @brief Sets the number of bytes in use, at most @c capacity().
+            void resize(size_t size);
+
+            size_t capacity() const;
+
+            /// @brief Gets the number of handles sharing the buffer.
+            uint32_t useCount() const;
+
+            explicit operator bool() const;
+
+            /// @brief Drops this reference and leaves the handle empty.
+            void reset();
+
+        private:
+            friend class BufferPool;
+
+            explicit BufferHandle(BufferPool::Block *block);
+
+            BufferPool::Block *_block;
+        }; // BufferHandle
+
+        inline char *libdsa::libstructures::BufferPool::Block::data()
+        {
+            return reinterpret_cast<char *>(this) + HEADER_BYTES;
+        }
+
+        inline libdsa::libstructures::BufferPool::Depot::Depot() : free()
+        {
+            // Intentionally empty constructor
+        }
+
+        inline libdsa::libstructures::BufferPool::Depot::~Depot()
+        {
+            for (void *slab : slabs)
+            {
+                std::free(slab);
+            }
+        }
+
+        inline libdsa::libstructures::BufferPool::ThreadCaches::~ThreadCaches()
+        {
+            for (Cache &cache : entries)
+            {
+                for (size_t sizeClass = 0; sizeClass < SIZE_CLASSES; ++sizeClass)
+                {
+                    _drain(cache, sizeClass, cache.count[sizeClass]);
+                }
+            }
+        }
+
+        inline libdsa::libstructures::BufferPool::BufferPool() : _depot(std::make_shared<Depot>())
+        {
+            static_assert(sizeof(Block) <= HEADER_BYTES, "A block's bookkeeping must fit in front of its bytes");
+        }
+
+        inline libdsa::libstructures::BufferPool::~BufferPool()
+        {
+            // Intentionally empty destructor: the depot goes once no thread's cache refers to it.
+        }
+
+        inline libdsa::libstructures::BufferPool &libdsa::libstructures::BufferPool::shared()
+        {
+            // Leaked on purpose, so that threads exiting after static destruction can still return their buffers.
+            static BufferPool *pool = new BufferPool();
+            return *pool;
+        }
+
+        inline libdsa::libstructures::BufferHandle libdsa::libstructures::BufferPool::acquire(size_t size)
+        {
+            const size_t sizeClass = _sizeClass(size);
+            Block *block = nullptr;
+
+            if (sizeClass == SIZE_CLASSES)
+            {
+                // aligned_alloc wants a multiple of the alignment.
+                const size_t bytes = (HEADER_BYTES + size + HEADER_BYTES - 1) / HEADER_BYTES * HEADER_BYTES;
+                void *memory = std::aligned_alloc(HEADER_BYTES, bytes);
+
+                if (memory == nullptr)
+                {
+                    return BufferHandle();
+                }
+
+                block = new (memory) Block();
+                block->capacity = size;
+                block->depot = nullptr;
+                block->giveBack = nullptr;
+            }
+            else
+            {
+                Cache &cache = _cache(_depot.get());
+
+                if (cache.count[sizeClass] == 0 && !_refill(cache, sizeClass))
+                {
+                    return BufferHandle();
+                }
+
+                block = cache.free[sizeClass];
+                cache.free[sizeClass] = block->next;
+                --cache.count[sizeClass];
+            }
+
+            block->references.store(1, std::memory_order_relaxed);
+            block->sizeClass = static_cast<uint32_t>(sizeClass);
+            block->next = nullptr;
+            block->size = size;
+            return BufferHandle(block);
+        }
+
+        inline libdsa::libstructures::BufferHandle libdsa::libstructures::BufferPool::lend(char *data, size_t capacity,
+                                                                                           size_t size,
+                                                                                           GiveBack giveBack,
+                                                                                           void *lender)
+        {
+            Block *block = new (data - HEADER_BYTES) Block();
+            block->references.store(1, std::memory_order_relaxed);
+            block->sizeClass = static_cast<uint32_t>(SIZE_CLASSES);
+            block->depot = nullptr;
+            block->next = nullptr;
+            block->size = std::min(size, capacity);
+            block->capacity = capacity;
+            block->giveBack = giveBack;
+            block->lender = lender;
+            return BufferHandle(block);
+        }
+
+        inline size_t libdsa::libstructures::BufferPool::slabCount() const
+        {
+            std::lock_guard<std::mutex> lock(_depot->mutex);
+            return _depot->slabs.size();
+        }
+
+        inline size_t libdsa::libstructures::BufferPool::capacityFor(size_t size)
+        {
+            const size_t sizeClass = _sizeClass(size);
+            return sizeClass == SIZE_CLASSES ? size : CLASS_CAPACITIES[sizeClass];
+        }
+
+        inline size_t libdsa::libstructures::BufferPool::_sizeClass(size_t size)
+        {
+            size_t sizeClass = 0;
+
+            while (sizeClass < SIZE_CLASSES && CLASS_CAPACITIES[sizeClass] < size)
+            {
+                ++sizeClass;
+            }
+
+            return sizeClass;
+        }
+
+        inline libdsa::libstructures::BufferPool::ThreadCaches &libdsa::libstructures::BufferPool::_threadCaches()
+        {
+            static thread_local ThreadCaches caches;
+            return caches;
+        }
+
+        inline libdsa::libstructures::BufferPool::Cache &
+        libdsa::libstructures::BufferPool::_cache(Depot *depot)
+        {
+            std::vector<Cache> &entries = _threadCaches().entries;
+
+            for (Cache &cache : entries)
+            {
+                if (cache.depot.get() == depot)
+                {
+                    return cache;
+                }
+            }
+
+            // Caches of pools that no longer exist hold the only reference to their depot, and its slabs hold
+            // their buffers, so dropping the cache frees everything.
+            for (size_t i = 0; i < entries.size();)
+            {
+                if (entries[i].depot.use_count() == 1)
+                {
+                    entries[i] = std::move(entries.back());
+                    entries.pop_back();
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+
+            entries.push_back(Cache{depot->shared_from_this(), {}, {}});
+            return entries.back();
+        }
+
+        inline bool libdsa::libstructures::BufferPool::_refill(Cache &cache, size_t sizeClass)
+        {
+            Depot &depot = *cache.depot;
+            std::lock_guard<std::mutex> lock(depot.mutex);
+
+            if (depot.free[sizeClass] == nullptr)
+            {
+                const size_t stride = HEADER_BYTES + CLASS_CAPACITIES[sizeClass];
+                const size_t blocks = std::max<size_t>(SLAB_BYTES / stride, 1);
+                char *slab = static_cast<char *>(std::aligned_alloc(HEADER_BYTES, blocks * stride));
+
+                if (slab == nullptr)
+                {
+                    return false;
+                }
+
+                depot.slabs.push_back(slab);
+
+                // Threaded back to front, so the list hands the slab out in address order.
+                for (size_t i = blocks; i-- > 0;)
+                {
+                    Block *block = new (slab + i * stride) Block();
+                    block->depot = &depot;
+                    block->giveBack = nullptr;
+                    block->capacity = CLASS_CAPACITIES[sizeClass];
+                    block->next = depot.free[sizeClass];
+                    depot.free[sizeClass] = block;
+                }
+            }
+
+            while (depot.free[sizeClass] != nullptr && cache.count[sizeClass] < CACHE_LIMIT / 2)
+            {
+                Block *block = depot.free[sizeClass];
+                depot.free[sizeClass] = block->next;
+                block->next = cache.free[sizeClass];
+                cache.free[sizeClass] = block;
+                ++cache.count[sizeClass];
+            }
+
+            return true;
+        }
+
+        inline void libdsa::libstructures::BufferPool::_drain(Cache &cache, size_t sizeClass, size_t count)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+
+            // Unlink the run first, then splice it into the depot under the lock in one step.
+            Block *first = cache.free[sizeClass];
+            Block *last = first;
+
+            for (size_t i = 1; i < count; ++i)
+            {
+                last = last->next;
+            }
+
+            cache.free[sizeClass] = last->next;
+            cache.count[sizeClass] -= count;
+
+            std::lock_guard<std::mutex> lock(cache.depot->mutex);
+            last->next = cache.depot->free[sizeClass];
+            cache.depot->free[sizeClass] = first;
+        }
+
+        inline void libdsa::libstructures::BufferPool::_release(Block *block)
+        {
+            if (block->giveBack != nullptr)
+            {
+                const GiveBack giveBack = block->giveBack;
+                void *lender = block->lender;
+                char *data = block->data();
+
+                block->~Block();
+                giveBack(lender, data);
+                return;
+            }
+
+            if (block->sizeClass == SIZE_CLASSES)
+            {
+                block->~Block();
+                std::free(block);
+                return;
+            }
+
+            // A thread that only releases, such as a consumer handed buffers by the receiving thread, gets a cache
+            // too, so it takes the depot's lock once per half a cache rather than once per buffer.
+            Cache &cache = _cache(block->depot);
+            const size_t sizeClass = block->sizeClass;
+
+            block->next = cache.free[sizeClass];
+            cache.free[sizeClass] = block;
+
+            if (++cache.count[sizeClass] > CACHE_LIMIT)
+            {
+                _drain(cache, sizeClass, CACHE_LIMIT / 2);
+            }
+        }
+
+        inline libdsa::libstructures::BufferHandle::BufferHandle() : _block(nullptr)
+        {
+            // Intentionally empty constructor
+        }
+
+        inline libdsa::libstructures::BufferHandle::BufferHandle(BufferPool::Block *block) : _block(block)
+        {
+            // Intentionally empty constructor
+        }
+
+        inline libdsa::libstructures::BufferHandle::BufferHandle(const BufferHandle &other) : _block(other._block)
+        {
+            if (_block != nullptr)
+            {
+                _block->references.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        inline libdsa::libstructures::BufferHandle::BufferHandle(BufferHandle &&other) noexcept : _block(other._block)
+        {
+            other._block = nullptr;
+        }
+
+        inline libdsa::libstructures::BufferHandle &
+        libdsa::libstructures::BufferHandle::operator=(BufferHandle other) noexcept
+        {
+            std::swap(_block, other._block);
+            return *this;
+        }
+
+        inline libdsa::libstructures::BufferHandle::~BufferHandle()
+        {
+            reset();
+        }
+
+        inline char *libdsa::libstructures::BufferHandle::data()
+        {
+            return _block == nullptr ? nullptr : _block->data();
+        }
+
+        inline const char *libdsa::libstructures::BufferHandle::data() const
+        {
+            return _block == nullptr ? nullptr : _block->data();
+        }
+
+        inline size_t libdsa::libstructures::BufferHandle::size() const
+        {
+            return _block == nullptr ? 0 : _block->size;
+        }
+
+        inline void libdsa::libstructures::BufferHandle::resize(size_t size)
+        {
+            if (_block != nullptr)
+            {
+                _block->size = std::min(size, _block->capacity);
+            }
+        }
+
+        inline size_t libdsa::libstructures::BufferHandle::capacity() const
+        {
+            return _block == nullptr ? 0 : _block->capacity;
+        }
+
+        inline uint32_t libdsa::libstructures::BufferHandle::useCount() const
+        {
+            return _block == nullptr ? 0 : _block->references.load(std::memory_order_relaxed);
+        }
+
+        inline libdsa::libstructures::BufferHandle::operator bool() const
+        {
+            return _block != nullptr;
+        }
+
+        inline void libdsa::libstructures::BufferHandle::reset()
+        {
+            // The last reference has to see every write made through the others before the buffer is reused.
+            if (_block != nullptr && _block->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                BufferPool::_release(_block);
+            }
+
+            _block = nullptr;
+        }
+    } // libstructures
+} // libdsa
+
+#endif // BUFFERPOOL_H_
+
+/// @}
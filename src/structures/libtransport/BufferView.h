@@ -0,0 +1,110 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @name BufferView
+/// @{
+
+#ifndef BUFFERVIEW_H_
+#define BUFFERVIEW_H_
+
+/// @details Non-owning views of caller memory for the transports' scatter-gather calls.  A list of views describes
+/// one logical message spread over several buffers, such as a header kept apart from its body, and goes to the kernel
+/// in a single @c sendmsg or @c recvmsg without being gathered into one buffer first.
+
+#include <sys/uio.h>
+
+// From C++ STL
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace libdsa
+{
+    namespace libstructures
+    {
+        /// @brief Read-only view of @c size bytes at @c data.
+        struct BufferView
+        {
+            const char *data;
+            size_t size;
+
+            BufferView() : data(nullptr), size(0)
+            {
+                // Intentionally empty constructor
+            }
+
+            BufferView(const char *viewData, size_t viewSize) : data(viewData), size(viewSize)
+            {
+                // Intentionally empty constructor
+            }
+
+            BufferView(const std::string &text) : data(text.data()), size(text.size())
+            {
+                // Intentionally empty constructor
+            }
+
+            BufferView(const std::vector<char> &bytes) : data(bytes.data()), size(bytes.size())
+            {
+                // Intentionally empty constructor
+            }
+        };
+
+        /// @brief Writable view of @c size bytes at @c data.
+        struct MutableBufferView
+        {
+            char *data;
+            size_t size;
+
+            MutableBufferView() : data(nullptr), size(0)
+            {
+                // Intentionally empty constructor
+            }
+
+            MutableBufferView(char *viewData, size_t viewSize) : data(viewData), size(viewSize)
+            {
+                // Intentionally empty constructor
+            }
+        };
+
+        /// @brief Total number of bytes covered by @p count views.
+        template <typename View>
+        size_t totalSize(const View *views, size_t count)
+        {
+            size_t total = 0;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                total += views[i].size;
+            }
+
+            return total;
+        }
+
+        /// @brief Fills @p vectors with up to @p capacity views, starting @p skip bytes into the first one.
+        /// @return The number of vectors filled.
+        template <typename View>
+        size_t toIovecs(const View *views, size_t count, size_t skip, iovec *vectors, size_t capacity)
+        {
+            size_t filled = 0;
+
+            for (size_t i = 0; i < count && filled < capacity; ++i)
+            {
+                if (views[i].size <= skip)
+                {
+                    skip -= views[i].size;
+                    continue;
+                }
+
+                vectors[filled].iov_base = const_cast<char *>(views[i].data) + skip;
+                vectors[filled].iov_len = views[i].size - skip;
+                skip = 0;
+                ++filled;
+            }
+
+            return filled;
+        }
+    } // libstructures
+} // libdsa
+
+#endif // BUFFERVIEW_H_
+
+/// @}
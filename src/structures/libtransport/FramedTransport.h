@@ -0,0 +1,420 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @name FramedTransport
+/// @{
+
+#ifndef FRAMED_TRANSPORT_H_
+#define FRAMED_TRANSPORT_H_
+
+/// @details Message framing on top of @c TcpServerTransport.  Every message travels as a four byte big-endian length
+/// followed by that many bytes of payload.  Received bytes are cut into messages per connection: frames that arrived
+/// whole are handed to the application straight from the transport's buffer, and only a frame split across reads is
+/// copied, into a buffer that never holds more than that one frame.
+///
+/// Sending is batched.  @c sendMessage() appends the frame to the connection's batch and marks the connection dirty;
+/// when the turn of the event loop ends, every dirty connection writes its whole batch in one system call, so a
+/// turn that answers a hundred requests on one connection costs one write instead of a hundred.  Messages of
+/// @c COALESCE_LIMIT bytes or more are not worth copying: they leave at once, gathered in one @c sendmsg with the
+/// batch in front of them, straight from the caller's buffer.  Since the layer does its own batching, accepted
+/// connections turn Nagle's algorithm off, which would otherwise hold a batch back until the previous one is
+/// acknowledged.
+
+// From C++ STL
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// From libtransport
+#include "BufferView.h"
+#include "TcpServerTransport.h"
+
+namespace libdsa
+{
+    namespace libstructures
+    {
+        class FramedTransport
+        {
+        public:
+            using ConnectionId = TcpServerTransport::ConnectionId;
+
+            /// @brief Application hooks.  Any of them may be left empty.
+            struct Callbacks
+            {
+                /// @brief A client connected.
+                std::function<void(ConnectionId)> onAccept;
+
+                /// @brief A whole message arrived.  @p data is only valid for the duration of the call.
+                std::function<void(ConnectionId, const char *data, size_t size)> onMessage;
+
+                /// @brief The connection closed, from either side, or sent a message larger than allowed.
+                std::function<void(ConnectionId)> onClose;
+            };
+
+            /// @brief Bytes of the length prefix in front of every message.
+            static constexpr size_t HEADER_SIZE = 4;
+
+            /// @brief Largest message accepted unless the constructor says otherwise.
+            static constexpr uint32_t DEFAULT_MAX_MESSAGE_SIZE = 16 * 1024 * 1024;
+
+            /// @brief Smallest message sent straight from the caller's buffer instead of being copied into the batch.
+            static constexpr size_t COALESCE_LIMIT = 16 * 1024;
+
+            /// @brief Takes over the callbacks of @p transport, which must outlive this object.
+            /// @param maxMessageSize Connections announcing a larger message are closed.
+            explicit FramedTransport(TcpServerTransport &transport, uint32_t maxMessageSize = DEFAULT_MAX_MESSAGE_SIZE);
+
+            /// @brief Hands the transport back without callbacks.  Batched messages are dropped.
+            ~FramedTransport();
+
+            FramedTransport(const FramedTransport &) = delete;
+            FramedTransport &operator=(const FramedTransport &) = delete;
+
+            /// @brief Replaces the application hooks.
+            void setCallbacks(Callbacks callbacks);
+
+            /// @brief Frames @p size bytes as one message to @p connection.  Small messages are batched until the
+            ///        end of the turn or the next @c flush(); messages sent from outside the transport's callbacks
+            ///        should be followed by a @c flush().
+            /// @return False if the connection is unknown, the message is larger than allowed, or the connection
+            ///         failed while writing, in which case it is closed.
+            bool sendMessage(ConnectionId connection, const char *data, size_t size);
+
+            /// @brief Writes the batch of every connection that has one, each in a single send.
+            /// @return The number of connections written to.
+            size_t flush();
+
+            /// @brief Writes the batch of @p connection now.
+            /// @return False if the connection is unknown or failed while writing, in which case it is closed.
+            bool flush(ConnectionId connection);
+
+            /// @brief Gets the number of bytes, prefixes included, batched for @p connection and not yet handed to
+            ///        the transport.
+            size_t batchedBytes(ConnectionId connection) const;
+
+            /// @brief Writes @p size as a big-endian length prefix to the @c HEADER_SIZE bytes at @p header.
+            static void encodeHeader(uint32_t size, char *header);
+
+            /// @brief Reads the big-endian length prefix at @p header.
+            static uint32_t decodeHeader(const char *header);
+
+        private:
+            /// @brief Per connection state.
+            struct Connection
+            {
+                Connection();
+
+                /// @brief A frame split across reads, prefix included, until the rest of it arrives.
+                std::vector<char> partial;
+
+                /// @brief Frames waiting for the end of the turn, and whether the connection is listed in @c _dirty.
+                std::vector<char> batch;
+                bool dirty;
+            };
+
+            /// @brief Cuts @p size received bytes into messages and reports each.
+            void _receive(ConnectionId connection, const char *data, size_t size);
+
+            /// @brief Closes @p connection if @p size is more than a message may hold.
+            /// @return Whether the connection was closed.
+            bool _rejectOversized(ConnectionId connection, uint32_t size);
+
+            /// @brief Hands the batch of @p connection, with @p count more views behind it, to the transport.
+            /// @return False if the connection failed while writing, in which case it is closed.
+            bool _write(ConnectionId connection, Connection &state, const BufferView *views, size_t count);
+
+            Connection *_find(ConnectionId connection);
+
+            TcpServerTransport &_transport;
+            Callbacks _callbacks;
+            uint32_t _maxMessageSize;
+            std::unordered_map<ConnectionId, Connection> _connections;
+
+            /// @brief Connections with a batch, in the order their first message of the turn was sent.
+            std::vector<ConnectionId> _dirty;
+        }; // FramedTransport
+
+        inline libdsa::libstructures::FramedTransport::Connection::Connection() : dirty(false)
+        {
+            // Intentionally empty constructor
+        }
+
+        inline libdsa::libstructures::FramedTransport::FramedTransport(TcpServerTransport &transport,
+                                                                       uint32_t maxMessageSize)
+            : _transport(transport), _maxMessageSize(maxMessageSize)
+        {
+            TcpServerTransport::Callbacks callbacks;
+
+            callbacks.onAccept = [this](ConnectionId connection) {
+                _connections.emplace(connection, Connection());
+                _transport.setNoDelay(connection, true);
+
+                if (_callbacks.onAccept)
+                {
+                    _callbacks.onAccept(connection);
+                }
+            };
+
+            callbacks.onRead = [this](ConnectionId connection, const char *data, size_t size) {
+                _receive(connection, data, size);
+            };
+
+            callbacks.onClose = [this](ConnectionId connection) {
+                _connections.erase(connection);
+
+                if (_callbacks.onClose)
+                {
+                    _callbacks.onClose(connection);
+                }
+            };
+
+            callbacks.onTurnEnd = [this]() { flush(); };
+
+            _transport.setCallbacks(std::move(callbacks));
+        }
+
+        inline libdsa::libstructures::FramedTransport::~FramedTransport()
+        {
+            _transport.setCallbacks(TcpServerTransport::Callbacks());
+        }
+
+        inline void libdsa::libstructures::FramedTransport::setCallbacks(Callbacks callbacks)
+        {
+            _callbacks = std::move(callbacks);
+        }
+
+        inline bool libdsa::libstructures::FramedTransport::sendMessage(ConnectionId connection, const char *data,
+                                                                        size_t size)
+        {
+            Connection *state = _find(connection);
+
+            if (state == nullptr || size > _maxMessageSize)
+            {
+                return false;
+            }
+
+            char header[HEADER_SIZE];
+            encodeHeader(static_cast<uint32_t>(size), header);
+
+            if (size >= COALESCE_LIMIT)
+            {
+                const BufferView views[] = {BufferView(header, HEADER_SIZE), BufferView(data, size)};
+                return _write(connection, *state, views, 2);
+            }
+
+            state->batch.insert(state->batch.end(), header, header + HEADER_SIZE);
+            state->batch.insert(state->batch.end(), data, data + size);
+
+            if (!state->dirty)
+            {
+                state->dirty = true;
+                _dirty.push_back(connection);
+            }
+
+            return true;
+        }
+
+        inline size_t libdsa::libstructures::FramedTransport::flush()
+        {
+            // Writing can close connections, whose callbacks could mark others dirty, so work on a snapshot.
+            std::vector<ConnectionId> dirty;
+            dirty.swap(_dirty);
+
+            size_t written = 0;
+
+            for (ConnectionId connection : dirty)
+            {
+                Connection *state = _find(connection);
+
+                if (state == nullptr)
+                {
+                    continue;
+                }
+
+                state->dirty = false;
+
+                if (!state->batch.empty())
+                {
+                    _write(connection, *state, nullptr, 0);
+                    ++written;
+                }
+            }
+
+            // Keep the list's capacity for the next turn unless the writes above started a new one.
+            if (_dirty.empty())
+            {
+                dirty.clear();
+                _dirty.swap(dirty);
+            }
+
+            return written;
+        }
+
+        inline bool libdsa::libstructures::FramedTransport::flush(ConnectionId connection)
+        {
+            Connection *state = _find(connection);
+            return state != nullptr && _write(connection, *state, nullptr, 0);
+        }
+
+        inline size_t libdsa::libstructures::FramedTransport::batchedBytes(ConnectionId connection) const
+        {
+            auto found = _connections.find(connection);
+            return found == _connections.end() ? 0 : found->second.batch.size();
+        }
+
+        inline void libdsa::libstructures::FramedTransport::encodeHeader(uint32_t size, char *header)
+        {
+            header[0] = static_cast<char>(size >> 24);
+            header[1] = static_cast<char>(size >> 16);
+            header[2] = static_cast<char>(size >> 8);
+            header[3] = static_cast<char>(size);
+        }
+
+        inline uint32_t libdsa::libstructures::FramedTransport::decodeHeader(const char *header)
+        {
+            const unsigned char *bytes = reinterpret_cast<const unsigned char *>(header);
+            return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) |
+                   uint32_t(bytes[3]);
+        }
+
+        inline void libdsa::libstructures::FramedTransport::_receive(ConnectionId connection, const char *data,
+                                                                     size_t size)
+        {
+            while (size > 0)
+            {
+                // A message callback may have closed the connection.
+                Connection *state = _find(connection);
+
+                if (state == nullptr)
+                {
+                    return;
+                }
+
+                // Frames that arrived whole are reported in place.
+                if (state->partial.empty() && size >= HEADER_SIZE)
+                {
+                    const uint32_t length = decodeHeader(data);
+
+                    if (_rejectOversized(connection, length))
+                    {
+                        return;
+                    }
+
+                    if (size - HEADER_SIZE >= length)
+                    {
+                        const char *message = data + HEADER_SIZE;
+                        data += HEADER_SIZE + length;
+                        size -= HEADER_SIZE + length;
+
+                        if (_callbacks.onMessage)
+                        {
+                            _callbacks.onMessage(connection, message, length);
+                        }
+                        continue;
+                    }
+                }
+
+                // Otherwise collect the prefix first, then exactly as much as it announces.
+                std::vector<char> &partial = state->partial;
+                const size_t wanted = partial.size() < HEADER_SIZE
+                                          ? HEADER_SIZE - partial.size()
+                                          : HEADER_SIZE + decodeHeader(partial.data()) - partial.size();
+                const size_t taken = std::min(wanted, size);
+
+                partial.insert(partial.end(), data, data + taken);
+                data += taken;
+                size -= taken;
+
+                if (partial.size() < HEADER_SIZE)
+                {
+                    continue;
+                }
+
+                const uint32_t length = decodeHeader(partial.data());
+
+                if (_rejectOversized(connection, length))
+                {
+                    return;
+                }
+
+                if (partial.size() == HEADER_SIZE + length)
+                {
+                    // Moved out first, since the callback may close the connection and free its state.
+                    std::vector<char> frame;
+                    frame.swap(partial);
+
+                    if (_callbacks.onMessage)
+                    {
+                        _callbacks.onMessage(connection, frame.data() + HEADER_SIZE, length);
+                    }
+                }
+                else
+                {
+                    partial.reserve(HEADER_SIZE + length);
+                }
+            }
+        }
+
+        inline bool libdsa::libstructures::FramedTransport::_rejectOversized(ConnectionId connection, uint32_t size)
+        {
+            if (size <= _maxMessageSize)
+            {
+                return false;
+            }
+
+            std::printf("*** ERROR: Connection %llu announced a %u byte message; at most %u are allowed\n",
+                        static_cast<unsigned long long>(connection), size, _maxMessageSize);
+            _transport.disconnect(connection);
+            return true;
+        }
+
+        inline bool libdsa::libstructures::FramedTransport::_write(ConnectionId connection, Connection &state,
+                                                                   const BufferView *views, size_t count)
+        {
+            // The batch is moved out while the transport works on it, since a failed write closes the connection
+            // and frees its state.
+            std::vector<char> batch;
+            batch.swap(state.batch);
+
+            // At most the batch, a prefix and a payload.
+            BufferView gathered[3];
+            size_t used = 0;
+
+            if (!batch.empty())
+            {
+                gathered[used++] = BufferView(batch);
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                gathered[used++] = views[i];
+            }
+
+            const bool sent = used == 0 || _transport.sendv(connection, gathered, used);
+
+            // Hand the emptied buffer back so the next batch reuses its capacity.
+            Connection *survivor = _find(connection);
+
+            if (survivor != nullptr)
+            {
+                batch.clear();
+                survivor->batch.swap(batch);
+            }
+
+            return sent;
+        }
+
+        inline libdsa::libstructures::FramedTransport::Connection *
+        libdsa::libstructures::FramedTransport::_find(ConnectionId connection)
+        {
+            auto found = _connections.find(connection);
+            return found == _connections.end() ? nullptr : &found->second;
+        }
+    } // libstructures
+} // libdsa
+
+#endif // FRAMED_TRANSPORT_H_
+
+/// @}
@@ -0,0 +1,648 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @name IoUring
+/// @{
+
+#ifndef IOURING_H_
+#define IOURING_H_
+
+/// @details Thin wrapper over the raw io_uring system calls, enough for a network event loop without pulling in
+/// liburing.  @c IoUring owns the ring: the submission queue the application fills and the completion queue the
+/// kernel fills, both shared through mmap.  Submissions are only handed to the kernel by @c submit(), so any number of
+/// them can be queued between two system calls, and one @c submit() both hands them over and waits for completions.
+///
+/// @c BufferRing is a group of equally sized receive buffers registered with a ring.  A receive that selects from the
+/// group gets whichever buffer is free when data arrives, so an idle connection pins no memory.  The completion names
+/// the buffer it used, and the buffer must be given back with @c recycle() once the data has been consumed, which
+/// is a store to memory the kernel shares.  Alternatively @c lend() hands the buffer itself to the application as a
+/// @c BufferHandle, which any thread may release; the ring's thread then gives it back in @c reclaim().  Lent buffers
+/// may outlive the ring.  Registering a mapped buffer ring needs Linux 5.19.
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// From C++ STL
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+// From libtransport
+#include "BufferPool.h"
+
+namespace libdsa
+{
+    namespace libstructures
+    {
+        class IoUring
+        {
+        public:
+            IoUring();
+
+            /// @brief Releases the ring.  The kernel cancels every request still in flight.
+            ~IoUring();
+
+            IoUring(const IoUring &) = delete;
+            IoUring &operator=(const IoUring &) = delete;
+
+            /// @brief Creates a ring with room for @p entries queued submissions.
+            /// @return False, with @c errno set, if the kernel does not offer io_uring or refuses the ring.
+            bool setup(unsigned entries);
+
+            /// @brief Releases the ring.  Safe to call on a ring that was never set up.
+            void teardown();
+
+            bool isSetup() const;
+
+            /// @brief True if the kernel reported every one of the @c IORING_FEAT_* bits in @p features.
+            bool hasFeatures(uint32_t features) const;
+
+            /// @brief True if the kernel implements the @c IORING_OP_* operation @p opcode.
+            bool supports(uint8_t opcode) const;
+
+            int fd() const;
+
+            /// @brief Claims the next submission slot, zeroed.  When the queue is full, the queued submissions are
+            ///        handed to the kernel first.
+            /// @return Null if the kernel would not take any of the queued submissions.
+            io_uring_sqe *nextSqe();
+
+            /// @brief Hands every queued submission to the kernel, then waits until at least @p waitFor completions
+            ///        are available or @p timeoutMilliseconds pass.  A negative timeout waits indefinitely.
+            /// @return Zero, also when the wait timed out or was interrupted, or a negative @c errno value.
+            int submit(unsigned waitFor = 0, int timeoutMilliseconds = -1);
+
+            /// @brief Calls @p function with every completion available now, oldest first.  Each completion is
+            ///        copied and its slot released before the call, so @p function may submit more work.
+            /// @return The number of completions handled.
+            template <typename Function>
+            size_t forEachCompletion(Function function);
+
+            /// @brief Passes a @c IORING_REGISTER_* request straight to the kernel.
+            /// @return Zero or a negative @c errno value.
+            int registerResource(unsigned opcode, void *argument, unsigned count);
+
+        private:
+            void _probe();
+
+            int _ring_fd;
+            io_uring_params _params;
+
+            void *_sqRing;
+            size_t _sqRingSize;
+            void *_cqRing;
+            size_t _cqRingSize;
+            io_uring_sqe *_sqes;
+            size_t _sqesSize;
+
+            /// @brief Views into the shared rings.  The kernel moves the submission head and the completion tail.
+            unsigned *_sqHead;
+            unsigned *_sqTail;
+            unsigned *_sqArray;
+            unsigned _sqMask;
+            unsigned _sqEntries;
+            unsigned *_cqHead;
+            unsigned *_cqTail;
+            unsigned _cqMask;
+            io_uring_cqe *_cqes;
+
+            /// @brief Tail including the submissions claimed but not yet published to the kernel.
+            unsigned _sqLocalTail;
+
+            /// @brief Indexed by opcode.
+            std::vector<bool> _supported;
+        }; // IoUring
+
+        class BufferRing
+        {
+        public:
+            BufferRing();
+
+            /// @brief Frees the buffers.  The ring they were registered with must be torn down first.
+            ~BufferRing();
+
+            BufferRing(const BufferRing &) = delete;
+            BufferRing &operator=(const BufferRing &) = delete;
+
+            /// @brief Allocates @p count buffers of @p bufferSize bytes and registers them with @p ring as group
+            ///        @p groupId.
+            /// @param count A power of two no larger than 32768.
+            /// @return False if the memory could not be allocated or the kernel refused the buffer ring.
+            bool setup(IoUring &ring, uint16_t groupId, unsigned count, unsigned bufferSize);
+
+            uint16_t groupId() const;
+
+            unsigned bufferSize() const;
+
+            /// @brief Gets the memory of buffer @p id, as named by a completion's @c IORING_CQE_BUFFER_SHIFT bits.
+            char *buffer(uint16_t id);
+
+            /// @brief Makes buffer @p id available to the kernel again.
+            void recycle(uint16_t id);
+
+            /// @brief Hands buffer @p id, holding @p size received bytes, to the application without copying it.  The
+            ///        buffer returns to the kernel in the first @c reclaim() after its last handle is released.
+            BufferHandle lend(uint16_t id, size_t size);
+
+            /// @brief Recycles every lent buffer whose handles have all been released.  Call it on the ring's thread.
+            void reclaim();
+
+        private:
+            static constexpr size_t PAGE_BYTES = 4096;
+
+            /// @brief The buffers' memory and what is lent out of it, shared with the threads releasing lent buffers.
+            ///        The last of the ring and the lent buffers to go frees it.
+            struct Lending
+            {
+                std::mutex mutex;
+                char *buffers;
+                size_t stride;
+
+                /// @brief Buffers released since the last @c reclaim().
+                std::vector<uint16_t> returned;
+
+                /// @brief Buffers lent and not yet released.
+                size_t outstanding;
+
+                /// @brief Set once the ring is gone, after which released buffers are only counted.
+                bool orphaned;
+            };
+
+            /// @brief @c BufferPool::GiveBack for lent buffers.
+            static void _giveBack(void *lender, char *data);
+
+            /// @brief Rounds @p size up to whole pages, as @c std::aligned_alloc requires.
+            static size_t _pageAligned(size_t size);
+
+            void _release();
+
+            io_uring_buf_ring *_ring;
+            size_t _ringSize;
+            char *_buffers;
+            size_t _buffersSize;
+            Lending *_lending;
+            unsigned _count;
+            unsigned _bufferSize;
+            uint16_t _groupId;
+            uint16_t _tail;
+        }; // BufferRing
+
+        inline libdsa::libstructures::IoUring::IoUring()
+            : _ring_fd(-1), _params(), _sqRing(nullptr), _sqRingSize(0), _cqRing(nullptr), _cqRingSize(0),
+              _sqes(nullptr), _sqesSize(0), _sqHead(nullptr), _sqTail(nullptr), _sqArray(nullptr), _sqMask(0),
+              _sqEntries(0), _cqHead(nullptr), _cqTail(nullptr), _cqMask(0), _cqes(nullptr), _sqLocalTail(0)
+        {
+            // Intentionally empty constructor
+        }
+
+        inline libdsa::libstructures::IoUring::~IoUring()
+        {
+            teardown();
+        }
+
+        inline bool libdsa::libstructures::IoUring::setup(unsigned entries)
+        {
+            if (isSetup())
+            {
+                return false;
+            }
+
+            // A completion queue four times the submission queue absorbs the bursts multishot requests produce.
+            std::memset(&_params, 0, sizeof(_params));
+            _params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+            _params.cq_entries = entries * 4;
+            _ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &_params));
+
+            if (_ring_fd < 0 && errno == EINVAL)
+            {
+                // Kernels older than 5.19 reject the flags they do not know.
+                std::memset(&_params, 0, sizeof(_params));
+                _params.flags = IORING_SETUP_CQSIZE;
+                _params.cq_entries = entries * 4;
+                _ring_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &_params));
+            }
+
+            if (_ring_fd < 0)
+            {
+                return false;
+            }
+
+            _sqRingSize = _params.sq_off.array + _params.sq_entries * sizeof(unsigned);
+            _cqRingSize = _params.cq_off.cqes + _params.cq_entries * sizeof(io_uring_cqe);
+
+            if (_params.features & IORING_FEAT_SINGLE_MMAP)
+            {
+                _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+            }
+
+            _sqRing = ::mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                             IORING_OFF_SQ_RING);
+
+            if (_sqRing == MAP_FAILED)
+            {
+                _sqRing = nullptr;
+                teardown();
+                return false;
+            }
+
+            if (_params.features & IORING_FEAT_SINGLE_MMAP)
+            {
+                _cqRing = _sqRing;
+            }
+            else
+            {
+                _cqRing = ::mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                                 IORING_OFF_CQ_RING);
+
+                if (_cqRing == MAP_FAILED)
+                {
+                    _cqRing = nullptr;
+                    teardown();
+                    return false;
+                }
+            }
+
+            _sqesSize = _params.sq_entries * sizeof(io_uring_sqe);
+            void *sqes = ::mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring_fd,
+                                IORING_OFF_SQES);
+
+            if (sqes == MAP_FAILED)
+            {
+                teardown();
+                return false;
+            }
+
+            char *sq = static_cast<char *>(_sqRing);
+            char *cq = static_cast<char *>(_cqRing);
+
+            _sqes = static_cast<io_uring_sqe *>(sqes);
+            _sqHead = reinterpret_cast<unsigned *>(sq + _params.sq_off.head);
+            _sqTail = reinterpret_cast<unsigned *>(sq + _params.sq_off.tail);
+            _sqArray = reinterpret_cast<unsigned *>(sq + _params.sq_off.array);
+            _sqMask = *reinterpret_cast<unsigned *>(sq + _params.sq_off.ring_mask);
+            _sqEntries = *reinterpret_cast<unsigned *>(sq + _params.sq_off.ring_entries);
+            _cqHead = reinterpret_cast<unsigned *>(cq + _params.cq_off.head);
+            _cqTail = reinterpret_cast<unsigned *>(cq + _params.cq_off.tail);
+            _cqMask = *reinterpret_cast<unsigned *>(cq + _params.cq_off.ring_mask);
+            _cqes = reinterpret_cast<io_uring_cqe *>(cq + _params.cq_off.cqes);
+            _sqLocalTail = *_sqTail;
+
+            _probe();
+            return true;
+        }
+
+        inline void libdsa::libstructures::IoUring::teardown()
+        {
+            if (_sqes != nullptr)
+            {
+                ::munmap(_sqes, _sqesSize);
+            }
+
+            if (_cqRing != nullptr && _cqRing != _sqRing)
+            {
+                ::munmap(_cqRing, _cqRingSize);
+            }
+
+            if (_sqRing != nullptr)
+            {
+                ::munmap(_sqRing, _sqRingSize);
+            }
+
+            if (_ring_fd >= 0)
+            {
+                ::close(_ring_fd);
+            }
+
+            _ring_fd = -1;
+            _sqRing = _cqRing = nullptr;
+            _sqes = nullptr;
+            _sqHead = _sqTail = _sqArray = _cqHead = _cqTail = nullptr;
+            _cqes = nullptr;
+            _supported.clear();
+        }
+
+        inline bool libdsa::libstructures::IoUring::isSetup() const
+        {
+            return _ring_fd >= 0;
+        }
+
+        inline bool libdsa::libstructures::IoUring::hasFeatures(uint32_t features) const
+        {
+            return isSetup() && (_params.features & features) == features;
+        }
+
+        inline bool libdsa::libstructures::IoUring::supports(uint8_t opcode) const
+        {
+            return opcode < _supported.size() && _supported[opcode];
+        }
+
+        inline int libdsa::libstructures::IoUring::fd() const
+        {
+            return _ring_fd;
+        }
+
+        inline io_uring_sqe *libdsa::libstructures::IoUring::nextSqe()
+        {
+            if (_sqLocalTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) >= _sqEntries)
+            {
+                submit();
+
+                if (_sqLocalTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE) >= _sqEntries)
+                {
+                    return nullptr;
+                }
+            }
+
+            const unsigned index = _sqLocalTail & _sqMask;
+            io_uring_sqe *sqe = &_sqes[index];
+
+            std::memset(sqe, 0, sizeof(*sqe));
+            _sqArray[index] = index;
+            ++_sqLocalTail;
+            return sqe;
+        }
+
+        inline int libdsa::libstructures::IoUring::submit(unsigned waitFor, int timeoutMilliseconds)
+        {
+            // Publishing the tail is what makes the submissions written since the last call visible to the kernel.
+            __atomic_store_n(_sqTail, _sqLocalTail, __ATOMIC_RELEASE);
+            const unsigned pending = _sqLocalTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+
+            if (pending == 0 && waitFor == 0)
+            {
+                return 0;
+            }
+
+            unsigned flags = 0;
+            __kernel_timespec timeout{};
+            io_uring_getevents_arg argument{};
+
+            if (waitFor > 0)
+            {
+                flags |= IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+                argument.sigmask_sz = _NSIG / 8;
+
+                if (timeoutMilliseconds >= 0)
+                {
+                    timeout.tv_sec = timeoutMilliseconds / 1000;
+                    timeout.tv_nsec = static_cast<long long>(timeoutMilliseconds % 1000) * 1000000;
+                    argument.ts = reinterpret_cast<uint64_t>(&timeout);
+                }
+            }
+
+            const long result = ::syscall(__NR_io_uring_enter, _ring_fd, pending, waitFor, flags,
+                                          waitFor > 0 ? &argument : nullptr, waitFor > 0 ? sizeof(argument) : 0);
+
+            if (result < 0)
+            {
+                // ETIME is the timeout expiring.  EBUSY and EAGAIN mean the completion queue has to be drained
+                // before the kernel takes more work, which the caller does next anyway.
+                if (errno == ETIME || errno == EINTR || errno == EBUSY || errno == EAGAIN)
+                {
+                    return 0;
+                }
+
+                return -errno;
+            }
+
+            return 0;
+        }
+
+        template <typename Function>
+        size_t libdsa::libstructures::IoUring::forEachCompletion(Function function)
+        {
+            unsigned head = *_cqHead;
+            const unsigned tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+            size_t handled = 0;
+
+            while (head != tail)
+            {
+                const io_uring_cqe completion = _cqes[head & _cqMask];
+                __atomic_store_n(_cqHead, ++head, __ATOMIC_RELEASE);
+
+                function(completion);
+                ++handled;
+            }
+
+            return handled;
+        }
+
+        inline int libdsa::libstructures::IoUring::registerResource(unsigned opcode, void *argument, unsigned count)
+        {
+            const long result = ::syscall(__NR_io_uring_register, _ring_fd, opcode, argument, count);
+            return result < 0 ? -errno : 0;
+        }
+
+        inline void libdsa::libstructures::IoUring::_probe()
+        {
+            constexpr unsigned OPERATIONS = 256;
+
+            // The probe ends in a flexible array, so it cannot live on the stack.
+            const size_t size = sizeof(io_uring_probe) + OPERATIONS * sizeof(io_uring_probe_op);
+            io_uring_probe *probe = static_cast<io_uring_probe *>(std::calloc(1, size));
+
+            _supported.assign(OPERATIONS, false);
+
+            if (probe != nullptr && registerResource(IORING_REGISTER_PROBE, probe, OPERATIONS) == 0)
+            {
+                for (unsigned i = 0; i < probe->ops_len && i < OPERATIONS; ++i)
+                {
+                    _supported[probe->ops[i].op] = (probe->ops[i].flags & IO_URING_OP_SUPPORTED) != 0;
+                }
+            }
+
+            std::free(probe);
+        }
+
+        inline libdsa::libstructures::BufferRing::BufferRing()
+            : _ring(nullptr), _ringSize(0), _buffers(nullptr), _buffersSize(0), _lending(nullptr), _count(0),
+              _bufferSize(0), _groupId(0), _tail(0)
+        {
+            // Intentionally empty constructor
+        }
+
+        inline libdsa::libstructures::BufferRing::~BufferRing()
+        {
+            _release();
+        }
+
+        inline bool libdsa::libstructures::BufferRing::setup(IoUring &ring, uint16_t groupId, unsigned count,
+                                                             unsigned bufferSize)
+        {
+            if (_buffers != nullptr || count == 0 || count > 32768 || (count & (count - 1)) != 0)
+            {
+                return false;
+            }
+
+            // Each buffer is preceded by the bookkeeping of the handle it may be lent through.
+            const size_t stride = BufferPool::HEADER_BYTES + bufferSize;
+            _buffersSize = _pageAligned(static_cast<size_t>(count) * stride);
+            void *buffers = std::aligned_alloc(PAGE_BYTES, _buffersSize);
+
+            if (buffers == nullptr)
+            {
+                return false;
+            }
+
+            _buffers = static_cast<char *>(buffers);
+            _lending = new Lending{{}, _buffers, stride, {}, 0, false};
+            _count = count;
+            _bufferSize = bufferSize;
+            _groupId = groupId;
+            _tail = 0;
+
+            // The kernel requires the ring of buffer descriptors to be page aligned.  A zero tail tells it the ring
+            // starts out empty.
+            _ringSize = _pageAligned(count * sizeof(io_uring_buf));
+            _ring = static_cast<io_uring_buf_ring *>(std::aligned_alloc(PAGE_BYTES, _ringSize));
+
+            if (_ring == nullptr)
+            {
+                _release();
+                return false;
+            }
+
+            std::memset(_ring, 0, _ringSize);
+
+            io_uring_buf_reg registration{};
+            registration.ring_addr = reinterpret_cast<uint64_t>(_ring);
+            registration.ring_entries = count;
+            registration.bgid = groupId;
+
+            if (ring.registerResource(IORING_REGISTER_PBUF_RING, &registration, 1) != 0)
+            {
+                _release();
+                return false;
+            }
+
+            for (unsigned id = 0; id < count; ++id)
+            {
+                recycle(static_cast<uint16_t>(id));
+            }
+
+            return true;
+        }
+
+        inline uint16_t libdsa::libstructures::BufferRing::groupId() const
+        {
+            return _groupId;
+        }
+
+        inline unsigned libdsa::libstructures::BufferRing::bufferSize() const
+        {
+            return _bufferSize;
+        }
+
+        inline char *libdsa::libstructures::BufferRing::buffer(uint16_t id)
+        {
+            return _buffers + static_cast<size_t>(id) * _lending->stride + BufferPool::HEADER_BYTES;
+        }
+
+        inline void libdsa::libstructures::BufferRing::recycle(uint16_t id)
+        {
+            // The first descriptor's reserved field doubles as the ring's tail, so only the named fields are written.
+            // The descriptors are indexed from the ring's start because C++ compilers lay out the header's flexible
+            // array member behind an empty struct, one word past where the kernel reads it.
+            io_uring_buf *descriptor = reinterpret_cast<io_uring_buf *>(_ring) + (_tail & (_count - 1));
+            descriptor->addr = reinterpret_cast<uint64_t>(buffer(id));
+            descriptor->len = _bufferSize;
+            descriptor->bid = id;
+
+            __atomic_store_n(&_ring->tail, ++_tail, __ATOMIC_RELEASE);
+        }
+
+        inline libdsa::libstructures::BufferHandle libdsa::libstructures::BufferRing::lend(uint16_t id, size_t size)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_lending->mutex);
+                ++_lending->outstanding;
+            }
+
+            return BufferPool::lend(buffer(id), _bufferSize, size, &BufferRing::_giveBack, _lending);
+        }
+
+        inline void libdsa::libstructures::BufferRing::reclaim()
+        {
+            std::vector<uint16_t> returned;
+
+            {
+                std::lock_guard<std::mutex> lock(_lending->mutex);
+
+                if (_lending->returned.empty())
+                {
+                    return;
+                }
+
+                returned.swap(_lending->returned);
+            }
+
+            for (uint16_t id : returned)
+            {
+                recycle(id);
+            }
+        }
+
+        inline void libdsa::libstructures::BufferRing::_giveBack(void *lender, char *data)
+        {
+            Lending *lending = static_cast<Lending *>(lender);
+            std::unique_lock<std::mutex> lock(lending->mutex);
+
+            --lending->outstanding;
+
+            if (!lending->orphaned)
+            {
+                const size_t offset = static_cast<size_t>(data - lending->buffers) - BufferPool::HEADER_BYTES;
+                lending->returned.push_back(static_cast<uint16_t>(offset / lending->stride));
+                return;
+            }
+
+            if (lending->outstanding == 0)
+            {
+                lock.unlock();
+                std::free(lending->buffers);
+                delete lending;
+            }
+        }
+
+        inline size_t libdsa::libstructures::BufferRing::_pageAligned(size_t size)
+        {
+            return (size + PAGE_BYTES - 1) / PAGE_BYTES * PAGE_BYTES;
+        }
+
+        inline void libdsa::libstructures::BufferRing::_release()
+        {
+            bool lent = false;
+
+            if (_lending != nullptr)
+            {
+                std::lock_guard<std::mutex> lock(_lending->mutex);
+                _lending->orphaned = true;
+                lent = _lending->outstanding != 0;
+            }
+
+            // Buffers still lent out keep the memory alive; the last one released frees it.
+            if (!lent)
+            {
+                std::free(_buffers);
+                delete _lending;
+            }
+
+            std::free(_ring);
+            _lending = nullptr;
+
+            _buffers = nullptr;
+            _ring = nullptr;
+            _count = 0;
+        }
+    } // libstructures
+} // libdsa
+
+#endif // IOURING_H_
+
+/// @}
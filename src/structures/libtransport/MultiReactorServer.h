@@ -0,0 +1,269 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @name MultiReactorServer
+/// @{
+
+#ifndef MULTI_REACTOR_SERVER_H_
+#define MULTI_REACTOR_SERVER_H_
+
+/// @details Runs one @c TcpServerTransport per thread, all listening on the same address.  Every reactor opens its
+/// own listening socket with @c SO_REUSEPORT, so the kernel hashes each new connection to one of them and queues it
+/// there: no accept queue is shared, no lock is taken and no connection is handed from one thread to another.  A
+/// connection stays with the reactor that accepted it, whose thread runs all of its callbacks, so per-connection
+/// state needs no synchronisation as long as it belongs to one reactor.
+///
+/// Each thread can be pinned to its own CPU, chosen round-robin from the CPUs the process may run on, which keeps
+/// a reactor's connections and buffers in one core's caches.
+
+#include <pthread.h>
+#include <sched.h>
+
+// From C++ STL
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// From libtransport
+#include "TcpServerTransport.h"
+
+namespace libdsa
+{
+    namespace libstructures
+    {
+        class MultiReactorServer
+        {
+        public:
+            using Backend = TcpServerTransport::Backend;
+
+            /// @brief Builds the reactors, but does not open them.
+            /// @param ip IP address to listen on, in network byte order.
+            /// @param port The port every reactor listens on.  Zero lets the system pick one; see @c port().
+            /// @param reactors Number of reactors and threads.  Zero means one per CPU the process may run on.
+            /// @param backend The event loop each reactor tries first.
+            MultiReactorServer(uint32_t ip, uint16_t port = 8080, size_t reactors = 0,
+                               Backend backend = Backend::EPOLL);
+
+            /// @brief Stops the threads and closes every reactor.
+            ~MultiReactorServer();
+
+            MultiReactorServer(const MultiReactorServer &) = delete;
+            MultiReactorServer &operator=(const MultiReactorServer &) = delete;
+
+            size_t reactorCount() const;
+
+            /// @brief Gets reactor @p index, whose callbacks should be set before @c start().  Once started, it
+            ///        belongs to its thread: only @c stop() may be called on it from elsewhere.
+            TcpServerTransport &reactor(size_t index);
+
+            /// @brief Opens every reactor and starts a thread running each.
+            /// @param pin Whether to pin each thread to its own CPU.  Each thread pins itself before running its
+            ///            reactor; one that cannot be pinned reports it and runs unpinned, with @c cpu() at -1.
+            /// @return False if already started or a reactor could not open, in which case none is left open.
+            bool start(bool pin = true);
+
+            /// @brief Stops every thread, then closes the reactors on the calling thread, which therefore runs their
+            ///        @c onClose callbacks.
+            void stop();
+
+            bool isRunning() const;
+
+            /// @brief Gets the port the reactors listen on, which is the system's choice if it was 0.
+            uint16_t port() const;
+
+            /// @brief Gets the CPU the thread of reactor @p index is pinned to, or -1 if it is not pinned.
+            int cpu(size_t index) const;
+
+        private:
+            /// @brief Lists the CPUs the calling process may run on.
+            static std::vector<int> _allowedCpus();
+
+            /// @brief Pins the calling thread, which runs reactor @p index, to @p cpu unless it is -1.
+            /// @return @p cpu, or -1 if it is -1 or the thread could not be pinned.
+            static int _pin(size_t index, int cpu);
+
+            std::vector<std::unique_ptr<TcpServerTransport>> _reactors;
+            std::vector<std::thread> _threads;
+            std::vector<int> _cpus;
+        }; // MultiReactorServer
+
+        inline libdsa::libstructures::MultiReactorServer::MultiReactorServer(uint32_t ip, uint16_t port,
+                                                                             size_t reactors, Backend backend)
+        {
+            if (reactors == 0)
+            {
+                reactors = std::max<size_t>(_allowedCpus().size(), 1);
+            }
+
+            for (size_t i = 0; i < reactors; ++i)
+            {
+                _reactors.emplace_back(new TcpServerTransport(ip, port, backend));
+                _reactors.back()->setReusePort(true);
+            }
+
+            _cpus.assign(reactors, -1);
+        }
+
+        inline libdsa::libstructures::MultiReactorServer::~MultiReactorServer()
+        {
+            stop();
+        }
+
+        inline size_t libdsa::libstructures::MultiReactorServer::reactorCount() const
+        {
+            return _reactors.size();
+        }
+
+        inline libdsa::libstructures::TcpServerTransport &
+        libdsa::libstructures::MultiReactorServer::reactor(size_t index)
+        {
+            return *_reactors[index];
+        }
+
+        inline bool libdsa::libstructures::MultiReactorServer::start(bool pin)
+        {
+            if (isRunning())
+            {
+                return false;
+            }
+
+            for (size_t i = 0; i < _reactors.size(); ++i)
+            {
+                // When the system picks the port, it does so for the first reactor and the others join it.
+                if (i > 0)
+                {
+                    _reactors[i]->setPort(_reactors[0]->port());
+                }
+
+                if (!_reactors[i]->open())
+                {
+                    for (size_t j = 0; j < i; ++j)
+                    {
+                        _reactors[j]->close();
+                    }
+
+                    return false;
+                }
+            }
+
+            const std::vector<int> cpus = pin ? _allowedCpus() : std::vector<int>();
+
+            std::vector<std::future<int>> pinned;
+
+            for (size_t i = 0; i < _reactors.size(); ++i)
+            {
+                TcpServerTransport *reactor = _reactors[i].get();
+                const int target = cpus.empty() ? -1 : cpus[i % cpus.size()];
+                std::promise<int> promise;
+                pinned.push_back(promise.get_future());
+
+                // The thread pins itself before it runs, so the reactor's first allocations land on that CPU.
+                _threads.emplace_back([reactor, target, i, promise = std::move(promise)]() mutable {
+                    promise.set_value(_pin(i, target));
+                    reactor->run();
+                });
+            }
+
+            for (size_t i = 0; i < _reactors.size(); ++i)
+            {
+                _cpus[i] = pinned[i].get();
+            }
+
+            return true;
+        }
+
+        inline void libdsa::libstructures::MultiReactorServer::stop()
+        {
+            if (!isRunning())
+            {
+                return;
+            }
+
+            for (const std::unique_ptr<TcpServerTransport> &reactor : _reactors)
+            {
+                reactor->stop();
+            }
+
+            for (std::thread &thread : _threads)
+            {
+                thread.join();
+            }
+
+            _threads.clear();
+
+            for (const std::unique_ptr<TcpServerTransport> &reactor : _reactors)
+            {
+                reactor->close();
+            }
+
+            _cpus.assign(_reactors.size(), -1);
+        }
+
+        inline bool libdsa::libstructures::MultiReactorServer::isRunning() const
+        {
+            return !_threads.empty();
+        }
+
+        inline uint16_t libdsa::libstructures::MultiReactorServer::port() const
+        {
+            return _reactors.empty() ? 0 : _reactors[0]->port();
+        }
+
+        inline int libdsa::libstructures::MultiReactorServer::cpu(size_t index) const
+        {
+            return _cpus[index];
+        }
+
+        inline int libdsa::libstructures::MultiReactorServer::_pin(size_t index, int cpu)
+        {
+            if (cpu < 0)
+            {
+                return -1;
+            }
+
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+
+            const int result = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+
+            if (result != 0)
+            {
+                std::printf("*** ERROR: Unable to pin reactor %zu to CPU %d: %s\n", index, cpu, std::strerror(result));
+                return -1;
+            }
+
+            return cpu;
+        }
+
+        inline std::vector<int> libdsa::libstructures::MultiReactorServer::_allowedCpus()
+        {
+            std::vector<int> cpus;
+            cpu_set_t set;
+            CPU_ZERO(&set);
+
+            if (::sched_getaffinity(0, sizeof(set), &set) != 0)
+            {
+                return cpus;
+            }
+
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            {
+                if (CPU_ISSET(cpu, &set))
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+
+            return cpus;
+        }
+    } // libstructures
+} // libdsa
+
+#endif // MULTI_REACTOR_SERVER_H_
+
+/// @}
@@ -0,0 +1,339 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @name TcpClientTransport
+/// @{
+
+#ifndef TCPCLIENT_TRANSPORT_H_
+#define TCPCLIENT_TRANSPORT_H_
+
+/// @details The client side of @c TcpServerTransport: one single threaded event loop over one epoll instance that
+/// drives any number of outgoing connections.  @c connect() starts a non-blocking connection and returns at once;
+/// the loop reports it through @c onConnect once the handshake completes, or through @c onClose if it fails.
+/// Everything after the handshake, from reading and queueing output to closing, is the @c TcpEventLoop the server's
+/// epoll backend runs on.
+///
+/// Each connection keeps one output buffer.  @c send() and @c sendv() write straight from the caller's buffers,
+/// gathered into one @c sendmsg, when nothing is queued, and copy only what the kernel did not take.  Output sent
+/// before the connection is established is queued and written once it is.  All callbacks run on the thread calling
+/// @c poll() or @c run().
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// From C++ STL
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+
+// From libtransport
+#include "BufferView.h"
+#include "TcpEventLoop.h"
+
+namespace libdsa
+{
+    namespace libstructures
+    {
+        class TcpClientTransport
+        {
+        public:
+            /// @brief Identifies one connection while it is open.  Identifiers are never reused and never 0.
+            using ConnectionId = TcpEventLoop::ConnectionId;
+
+            /// @brief Application hooks.  Any of them may be left empty.
+            struct Callbacks
+            {
+                /// @brief The connection is established.
+                std::function<void(ConnectionId)> onConnect;
+
+                /// @brief Bytes arrived.  @p data is only valid for the duration of the call.
+                std::function<void(ConnectionId, const char *data, size_t size)> onRead;
+
+                /// @brief Output that had to be queued has now been written completely.
+                std::function<void(ConnectionId)> onWrite;
+
+                /// @brief The connection closed, from either side, or could not be established.  Its identifier is
+                ///        invalid once this returns.
+                std::function<void(ConnectionId)> onClose;
+            };
+
+            /// @brief Bytes read from a socket per @c recv call.
+            static constexpr size_t READ_BUFFER_SIZE = TcpEventLoop::READ_BUFFER_SIZE;
+
+            /// @brief Buffers gathered into one @c sendmsg call.
+            static constexpr size_t MAX_IOVECS = TcpEventLoop::MAX_IOVECS;
+
+            /// @brief Readiness events collected per @c epoll_wait call.
+            static constexpr int MAX_EVENTS = TcpEventLoop::MAX_EVENTS;
+
+            /// @brief Builds the @c TcpClientTransport object, but does not ready it for immediate use.
+            TcpClientTransport();
+
+            /// @brief Closes every connection.
+            ~TcpClientTransport();
+
+            TcpClientTransport(const TcpClientTransport &) = delete;
+            TcpClientTransport &operator=(const TcpClientTransport &) = delete;
+
+            /// @brief Replaces the application hooks.
+            void setCallbacks(Callbacks callbacks);
+
+            /// @brief Sets up the event loop.
+            /// @return Whether the attempt to open the transport was successful.
+            bool open();
+
+            /// @brief Closes every connection, reporting each through @c onClose, then the event loop.
+            /// @return Whether the transport was open.
+            bool close();
+
+            bool isOpen() const;
+
+            /// @brief Starts connecting to @p port at @p ip, in network byte order like @c TcpServerTransport takes it.
+            /// @return The new connection, or 0 if the transport is not open or the connection failed at once.
+            ConnectionId connect(uint32_t ip, uint16_t port);
+
+            /// @brief Runs one turn of the event loop: waits up to @p timeoutMilliseconds for readiness and handles
+            ///        every event reported.  A negative timeout waits indefinitely.
+            /// @return The number of events handled.
+            size_t poll(int timeoutMilliseconds = -1);
+
+            /// @brief Runs the event loop until @c stop() is called.
+            void run();
+
+            /// @brief Makes @c run() return after its current turn.  Safe to call from any thread.
+            void stop();
+
+            /// @brief Sends @p size bytes to @p connection, queueing what the socket cannot take right away.
+            /// @return False if the connection is unknown or failed while writing, in which case it is closed.
+            bool send(ConnectionId connection, const char *data, size_t size);
+
+            /// @brief Sends the @p count buffers of @p views, in order, as one stream of bytes.  The buffers may be
+            ///        reused as soon as the call returns.
+            /// @return False if the connection is unknown or failed while writing, in which case it is closed.
+            bool sendv(ConnectionId connection, const BufferView *views, size_t count);
+
+            /// @brief Closes @p connection immediately, dropping any queued output.
+            /// @return False if the connection is unknown.
+            bool disconnect(ConnectionId connection);
+
+            /// @brief Turns Nagle's algorithm off (@p enable) or back on for @p connection.
+            /// @return False if the connection is unknown or the socket refused the option.
+            bool setNoDelay(ConnectionId connection, bool enable);
+
+            /// @brief Gets whether @p connection has completed its handshake and is still open.
+            bool isConnected(ConnectionId connection) const;
+
+            /// @brief Gets the number of open connections, established or not.
+            size_t connectionCount() const;
+
+            /// @brief Gets the number of bytes queued for @p connection and not yet written.
+            size_t pendingBytes(ConnectionId connection) const;
+
+        private:
+            /// @brief Checks how a pending connection ended and reports it.
+            void _finishConnect(ConnectionId connection);
+
+            Callbacks _callbacks;
+
+            /// @brief The connections and the loop waiting on them.
+            TcpEventLoop _loop;
+        }; // TcpClientTransport
+
+        inline libdsa::libstructures::TcpClientTransport::TcpClientTransport() : _loop(TcpEventLoop::WAKEUP_ID + 1)
+        {
+            // Intentionally empty constructor
+        }
+
+        inline libdsa::libstructures::TcpClientTransport::~TcpClientTransport()
+        {
+            close();
+        }
+
+        inline void libdsa::libstructures::TcpClientTransport::setCallbacks(Callbacks callbacks)
+        {
+            _callbacks = std::move(callbacks);
+            _loop.setHandlers(TcpEventLoop::Handlers{_callbacks.onRead, {}, _callbacks.onWrite, _callbacks.onClose, {},
+                                                     {}});
+        }
+
+        inline bool libdsa::libstructures::TcpClientTransport::open()
+        {
+            if (isOpen())
+            {
+                return false;
+            }
+
+            if (!_loop.open(true))
+            {
+                std::printf("*** ERROR: Unable to set up the client event loop: %s\n", std::strerror(errno));
+                return false;
+            }
+
+            return true;
+        }
+
+        inline bool libdsa::libstructures::TcpClientTransport::close()
+        {
+            const bool wasOpen = isOpen();
+            _loop.close();
+            return wasOpen;
+        }
+
+        inline bool libdsa::libstructures::TcpClientTransport::isOpen() const
+        {
+            return _loop.isOpen();
+        }
+
+        inline libdsa::libstructures::TcpClientTransport::ConnectionId
+        libdsa::libstructures::TcpClientTransport::connect(uint32_t ip, uint16_t port)
+        {
+            if (!isOpen())
+            {
+                return 0;
+            }
+
+            const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+            if (fd < 0)
+            {
+                std::printf("*** ERROR: Unable to create client socket: %s\n", std::strerror(errno));
+                return 0;
+            }
+
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(port);
+            address.sin_addr.s_addr = ip;
+
+            // A non-blocking connect finishes later; the socket turns writable once the handshake is done.
+            if (::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 &&
+                errno != EINPROGRESS)
+            {
+                std::printf("*** ERROR: Unable to connect to port %u: %s\n", port, std::strerror(errno));
+                ::close(fd);
+                return 0;
+            }
+
+            const ConnectionId id = _loop.add(fd);
+
+            if (id != 0)
+            {
+                _loop.find(id)->connecting = true;
+            }
+
+            return id;
+        }
+
+        inline size_t libdsa::libstructures::TcpClientTransport::poll(int timeoutMilliseconds)
+        {
+            if (!isOpen())
+            {
+                return 0;
+            }
+
+            return _loop.wait(timeoutMilliseconds, [this](ConnectionId id, uint32_t flags) {
+                const TcpEventLoop::Connection *state = _loop.find(id);
+
+                if (state != nullptr && state->connecting)
+                {
+                    _finishConnect(id);
+                }
+
+                _loop.handle(id, flags);
+            });
+        }
+
+        inline void libdsa::libstructures::TcpClientTransport::run()
+        {
+            _loop.run([this](int timeoutMilliseconds) { poll(timeoutMilliseconds); });
+        }
+
+        inline void libdsa::libstructures::TcpClientTransport::stop()
+        {
+            _loop.stop();
+        }
+
+        inline bool libdsa::libstructures::TcpClientTransport::send(ConnectionId connection, const char *data,
+                                                                    size_t size)
+        {
+            const BufferView view(data, size);
+            return sendv(connection, &view, 1);
+        }
+
+        inline bool libdsa::libstructures::TcpClientTransport::sendv(ConnectionId connection, const BufferView *views,
+                                                                     size_t count)
+        {
+            return _loop.sendv(connection, views, count);
+        }
+
+        inline bool libdsa::libstructures::TcpClientTransport::disconnect(ConnectionId connection)
+        {
+            if (_loop.find(connection) == nullptr)
+            {
+                return false;
+            }
+
+            _loop.closeConnection(connection);
+            return true;
+        }
+
+        inline bool libdsa::libstructures::TcpClientTransport::setNoDelay(ConnectionId connection, bool enable)
+        {
+            return _loop.setTcpOption(connection, TCP_NODELAY, enable);
+        }
+
+        inline bool libdsa::libstructures::TcpClientTransport::isConnected(ConnectionId connection) const
+        {
+            const TcpEventLoop::Connection *state = _loop.find(connection);
+            return state != nullptr && !state->connecting;
+        }
+
+        inline size_t libdsa::libstructures::TcpClientTransport::connectionCount() const
+        {
+            return _loop.connectionCount();
+        }
+
+        inline size_t libdsa::libstructures::TcpClientTransport::pendingBytes(ConnectionId connection) const
+        {
+            return _loop.pendingBytes(connection);
+        }
+
+        inline void libdsa::libstructures::TcpClientTransport::_finishConnect(ConnectionId connection)
+        {
+            TcpEventLoop::Connection *state = _loop.find(connection);
+            int error = 0;
+            socklen_t length = sizeof(error);
+
+            if (::getsockopt(state->fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0 || error != 0)
+            {
+                _loop.closeConnection(connection);
+                return;
+            }
+
+            // Still in progress: an event arrived before the handshake finished.
+            sockaddr_in peer{};
+            socklen_t peerLength = sizeof(peer);
+
+            if (::getpeername(state->fd, reinterpret_cast<sockaddr *>(&peer), &peerLength) != 0)
+            {
+                return;
+            }
+
+            state->connecting = false;
+
+            if (_callbacks.onConnect)
+            {
+                _callbacks.onConnect(connection);
+            }
+        }
+    } // libstructures
+} // libdsa
+
+#endif // TCPCLIENT_TRANSPORT_H_
+
+/// @}
@@ -0,0 +1,1088 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @name TcpEventLoop
+/// @{
+
+#ifndef TCP_EVENT_LOOP_H_
+#define TCP_EVENT_LOOP_H_
+
+/// @details The part of @c TcpServerTransport and @c TcpClientTransport that does not care which side opened a
+/// connection: the table of open connections with their output queues, and a single threaded event loop over one
+/// epoll instance.  Sockets are registered once, edge-triggered, for both reading and writing, so the loop never has
+/// to re-arm a descriptor.  An edge is only reported when a socket's state changes, so every readiness event is
+/// handled until the kernel reports @c EAGAIN: all available bytes are read, and queued output is written until the
+/// socket buffer is full.  An eventfd registered with the loop lets @c stop() wake it from any thread.
+///
+/// A peer that finishes sending only closes its half of the stream and may still be reading, so output queued when
+/// the end of its stream arrives is still written, and the connection closes once that output is gone.
+///
+/// The owning transport creates the sockets, hands them to @c add(), and forwards the readiness events it does not
+/// handle itself to @c handle().  Everything the loop has to report about a connection goes through @c Handlers, all
+/// of which run on the thread calling @c wait().
+
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// From C++ STL
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// From libtransport
+#include "BufferPool.h"
+#include "BufferView.h"
+
+namespace libdsa
+{
+    namespace libstructures
+    {
+        class TcpEventLoop
+        {
+        public:
+            /// @brief Identifies one connection while it is open.  Identifiers are never reused.
+            using ConnectionId = uint64_t;
+
+            /// @brief What the loop reports about a connection; see @c TcpServerTransport::Callbacks.  Any of them may
+            ///        be left empty.
+            struct Handlers
+            {
+                std::function<void(ConnectionId, const char *data, size_t size)> onRead;
+                std::function<void(ConnectionId, BufferHandle buffer)> onReadBuffer;
+                std::function<void(ConnectionId)> onWrite;
+                std::function<void(ConnectionId)> onClose;
+                std::function<void(ConnectionId)> onReadable;
+                std::function<void(ConnectionId, uint64_t tag)> onZeroCopyComplete;
+            };
+
+            /// @brief A run of queued output, either a copy the queue owns or a buffer it borrows from a
+            ///        @c sendZeroCopy() call.
+            struct Segment
+            {
+                std::vector<char> owned;
+
+                /// @brief Null for owned segments.
+                const char *borrowed;
+                size_t size;
+
+                /// @brief Bytes already written.
+                size_t offset;
+
+                /// @brief Borrowed segments only: the call's tag, and whether this is the call's last segment.
+                uint64_t tag;
+                bool last;
+
+                const char *data() const
+                {
+                    return (borrowed != nullptr ? borrowed : owned.data()) + offset;
+                }
+
+                size_t remaining() const
+                {
+                    return size - offset;
+                }
+            };
+
+            /// @brief Whether a connection's socket takes @c MSG_ZEROCOPY.  Only tried on the first large
+            ///        @c sendZeroCopy(), and given up once the kernel reports that it copied anyway.
+            enum class ZeroCopy
+            {
+                UNTRIED,
+                ENABLED,
+                DISABLED
+            };
+
+            /// @brief Per connection state.
+            struct Connection
+            {
+                explicit Connection(int socket);
+
+                int fd;
+
+                /// @brief Set while an outgoing connection waits for its handshake.  Output stays queued until then.
+                bool connecting;
+
+                /// @brief Set once the peer's stream has ended.  The connection closes when its output drains.
+                bool peerFinished;
+
+                /// @brief Output the socket has not taken yet, and its size in bytes.
+                std::deque<Segment> output;
+                size_t outputBytes;
+
+                /// @brief io_uring only: the output an in-flight send is reading, which must not move until the send
+                ///        completes.
+                Segment inFlight;
+                bool sending;
+
+                ZeroCopy zeroCopy;
+
+                /// @brief Number of @c MSG_ZEROCOPY sends made, and how many of them the kernel has released.  The
+                ///        kernel numbers them the same way, from zero.
+                uint32_t zeroCopyIssued;
+                uint32_t zeroCopyReleased;
+
+                /// @brief Tags whose bytes have all been written, each with the last send that may still hold them.
+                std::deque<std::pair<uint32_t, uint64_t>> zeroCopyWaiting;
+            };
+
+            /// @brief Bytes read from a socket per @c recv call.
+            static constexpr size_t READ_BUFFER_SIZE = 64 * 1024;
+
+            /// @brief Buffers gathered into one @c sendmsg or @c recvmsg call.
+            static constexpr size_t MAX_IOVECS = 64;
+
+            /// @brief Smallest @c sendZeroCopy() that uses @c MSG_ZEROCOPY.  Below this, pinning the pages and
+            ///        reading the completion cost more than copying.
+            static constexpr size_t ZERO_COPY_THRESHOLD = 16 * 1024;
+
+            /// @brief Readiness events collected per @c epoll_wait call.
+            static constexpr int MAX_EVENTS = 256;
+
+            /// @brief epoll tag of the wakeup descriptor.  Tags from 1 up to the first connection are the owner's.
+            static constexpr ConnectionId WAKEUP_ID = 0;
+
+            /// @brief Builds the @c TcpEventLoop object, but does not ready it for immediate use.
+            /// @param firstId The identifier of the first connection.  Smaller ones are left for the owner's tags.
+            explicit TcpEventLoop(ConnectionId firstId);
+
+            /// @brief Closes every connection and the loop's descriptors.
+            ~TcpEventLoop();
+
+            TcpEventLoop(const TcpEventLoop &) = delete;
+            TcpEventLoop &operator=(const TcpEventLoop &) = delete;
+
+            void setHandlers(Handlers handlers);
+
+            /// @brief Makes @c onReadBuffer take its buffers from @p pool, which must outlive them.
+            void setBufferPool(BufferPool &pool);
+
+            BufferPool &bufferPool() const;
+
+            /// @brief Creates the wakeup eventfd and, when @p epoll is set, the epoll instance watching it.  An owner
+            ///        that waits on something else, such as an io_uring, watches @c wakeupFd() itself.
+            /// @return Whether the descriptors could be created.  On failure nothing is left behind.
+            bool open(bool epoll);
+
+            /// @brief Closes every connection, reporting each through @c onClose, then the loop's descriptors.
+            void close();
+
+            bool isOpen() const;
+
+            int wakeupFd() const;
+
+            /// @brief Empties the wakeup counter so the next @c stop() produces a new edge.
+            void drainWakeup();
+
+            /// @brief Adds @p fd to the epoll set under @p tag.
+            /// @return False if the kernel refused it.
+            bool watch(int fd, ConnectionId tag, uint32_t events);
+
+            /// @brief Waits up to @p timeoutMilliseconds for readiness and drains the wakeup descriptor.  Every other
+            ///        event goes to @p handle, as handle(tag, flags).
+            /// @return The number of events reported.
+            template <typename Handle>
+            size_t wait(int timeoutMilliseconds, Handle handle);
+
+            /// @brief Handles the readiness @p flags of @p connection: reads, or reports @c onReadable, and writes
+            ///        queued output.  Does nothing if the connection has already closed.
+            void handle(ConnectionId connection, uint32_t flags);
+
+            /// @brief Calls @p poll with an infinite timeout until @c stop() is called.
+            template <typename Poll>
+            void run(Poll poll);
+
+            /// @brief Makes @c run() return after its current turn.  Safe to call from any thread.
+            void stop();
+
+            /// @brief Takes ownership of the connected socket @p fd and, if the loop runs on epoll, watches it.
+            /// @return The new connection, or 0 if the socket could not be watched, in which case it is closed.
+            ConnectionId add(int fd);
+
+            /// @brief Forgets @p connection and closes its socket without reporting anything.
+            void discard(ConnectionId connection);
+
+            Connection *find(ConnectionId connection);
+            const Connection *find(ConnectionId connection) const;
+
+            /// @brief Gets an open connection, or 0 if there is none.
+            ConnectionId anyConnection() const;
+
+            size_t connectionCount() const;
+
+            /// @brief Gets the number of bytes queued for @p connection and not yet written.
+            size_t pendingBytes(ConnectionId connection) const;
+
+            /// @brief Writes the @p count buffers of @p views straight to the socket, gathered into one @c sendmsg,
+            ///        and queues what it did not take.  Output queued before it, or before the connection is
+            ///        established, is not overtaken.
+            /// @return False if the connection is unknown or failed while writing, in which case it is closed.
+            bool sendv(ConnectionId connection, const BufferView *views, size_t count);
+
+            /// @brief See @c TcpServerTransport::sendZeroCopy().
+            bool sendZeroCopy(ConnectionId connection, const BufferView *views, size_t count, uint64_t tag);
+
+            /// @brief See @c TcpServerTransport::recvv().
+            ssize_t recvv(ConnectionId connection, const MutableBufferView *views, size_t count);
+
+            /// @brief Sets the @c IPPROTO_TCP option @p option of @p connection to @p enable.
+            bool setTcpOption(ConnectionId connection, int option, bool enable);
+
+            /// @brief Copies @p views, from @p skip bytes into the first, to the end of the output queue.
+            void append(Connection &state, const BufferView *views, size_t count, size_t skip);
+
+            /// @brief Closes the socket, reports every zero-copy tag still held and then @c onClose.
+            void closeConnection(ConnectionId connection);
+
+        private:
+            /// @brief Reads until the socket is drained.  Closes the connection on error, and on end of stream once
+            ///        its queued output is written.
+            void _read(ConnectionId connection, bool peerClosed);
+
+            /// @brief Writes queued output until the socket is full, and reports it if that emptied the queue.  A
+            ///        connection whose peer has finished is closed once nothing is left.
+            /// @return False if the connection failed or was closed.
+            bool _flush(ConnectionId connection);
+
+            /// @brief Writes queued output until the socket is full, gathering segments of the same kind into one
+            ///        @c sendmsg.
+            /// @return False if the connection failed, in which case it has been closed.
+            bool _write(ConnectionId connection);
+
+            /// @brief Drops @p size written bytes from the front of the output queue.
+            void _consume(Connection &state, size_t size);
+
+            /// @brief Turns on @c SO_ZEROCOPY the first time it is needed.
+            /// @return Whether the connection's sends may use @c MSG_ZEROCOPY.
+            bool _enableZeroCopy(Connection &state);
+
+            /// @brief Reads the kernel's zero-copy notifications from the socket's error queue.
+            void _readErrorQueue(Connection &state);
+
+            /// @brief Reports every waiting tag the kernel has released.
+            void _reportZeroCopy(ConnectionId connection);
+
+            int _epoll_fd;
+
+            /// @brief eventfd that wakes the loop for @c stop().
+            int _wakeup_fd;
+
+            Handlers _handlers;
+            std::unordered_map<ConnectionId, Connection> _connections;
+            ConnectionId _nextId;
+            std::atomic<bool> _stopping;
+            std::unique_ptr<char[]> _readBuffer;
+            BufferPool *_bufferPool;
+        }; // TcpEventLoop
+
+        inline libdsa::libstructures::TcpEventLoop::Connection::Connection(int socket)
+            : fd(socket), connecting(false), peerFinished(false), outputBytes(0), inFlight{{}, nullptr, 0, 0, 0, false}, sending(false),
+              zeroCopy(ZeroCopy::UNTRIED), zeroCopyIssued(0), zeroCopyReleased(0)
+        {
+            // Intentionally empty constructor
+        }
+
+        inline libdsa::libstructures::TcpEventLoop::TcpEventLoop(ConnectionId firstId)
+            : _epoll_fd(-1), _wakeup_fd(-1), _nextId(firstId), _stopping(false), _bufferPool(&BufferPool::shared())
+        {
+            // Intentionally empty constructor
+        }
+
+        inline libdsa::libstructures::TcpEventLoop::~TcpEventLoop()
+        {
+            close();
+        }
+
+        inline void libdsa::libstructures::TcpEventLoop::setHandlers(Handlers handlers)
+        {
+            _handlers = std::move(handlers);
+        }
+
+        inline void libdsa::libstructures::TcpEventLoop::setBufferPool(BufferPool &pool)
+        {
+            _bufferPool = &pool;
+        }
+
+        inline libdsa::libstructures::BufferPool &libdsa::libstructures::TcpEventLoop::bufferPool() const
+        {
+            return *_bufferPool;
+        }
+
+        inline bool libdsa::libstructures::TcpEventLoop::open(bool epoll)
+        {
+            this->_wakeup_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+            if (this->_wakeup_fd >= 0 && epoll)
+            {
+                this->_epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+            }
+
+            if (this->_wakeup_fd < 0 ||
+                (epoll && (this->_epoll_fd < 0 || !watch(this->_wakeup_fd, WAKEUP_ID, EPOLLIN | EPOLLET))))
+            {
+                // Keep the reason for the owner's error message.
+                const int error = errno;
+                close();
+                errno = error;
+                return false;
+            }
+
+            if (epoll)
+            {
+                _readBuffer.reset(new char[READ_BUFFER_SIZE]);
+            }
+
+            return true;
+        }
+
+        inline void libdsa::libstructures::TcpEventLoop::close()
+        {
+            while (!_connections.empty())
+            {
+                closeConnection(_connections.begin()->first);
+            }
+
+            for (int *fd : {&this->_epoll_fd, &this->_wakeup_fd})
+            {
+                if (*fd >= 0)
+                {
+                    ::close(*fd);
+                    *fd = -1;
+                }
+            }
+        }
+
+        inline bool libdsa::libstructures::TcpEventLoop::isOpen() const
+        {
+            return this->_wakeup_fd >= 0;
+        }
+
+        inline int libdsa::libstructures::TcpEventLoop::wakeupFd() const
+        {
+            return this->_wakeup_fd;
+        }
+
+        inline void libdsa::libstructures::TcpEventLoop::drainWakeup()
+        {
+            uint64_t count;
+            while (::read(this->_wakeup_fd, &count, sizeof(count)) > 0)
+            {
+                // Drain the counter so the next stop() produces a new edge.
+            }
+        }
+
+        inline bool libdsa::libstructures::TcpEventLoop::watch(int fd, ConnectionId tag, uint32_t events)
+        {
+            epoll_event event{};
+            event.events = events;
+            event.data.u64 = tag;
+
+            return ::epoll_ctl(this->_epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+        }
+
+        template <typename Handle>
+        size_t libdsa::libstructures::TcpEventLoop::wait(int timeoutMilliseconds, Handle handle)
+        {
+            epoll_event events[MAX_EVENTS];
+            const int ready = ::epoll_wait(this->_epoll_fd, events, MAX_EVENTS, timeoutMilliseconds);
+
+            if (ready <= 0)
+            {
+                return 0;
+            }
+
+            for (int i = 0; i < ready; ++i)
+            {
+                if (events[i].data.u64 == WAKEUP_ID)
+                {
+                    drainWakeup();
+                    continue;
+                }
+
+                handle(static_cast<ConnectionId>(events[i].data.u64), events[i].events);
+            }
+
+            return static_cast<size_t>(ready);
+        }
+
+        inline void libdsa::libstructures::TcpEventLoop::handle(ConnectionId connection, uint32_t flags)
+        {
+            // An earlier event in this batch, or a callback, may already have closed the connection.
+            if (find(connection) == nullptr)
+            {
+                return;
+            }
+
+            // Zero-copy notifications arrive on the error queue, which raises EPOLLERR by itself.
+            if ((flags & EPOLLERR) && find(connection)->zeroCopy != ZeroCopy::UNTRIED)
+            {
+                _readErrorQueue(*find(connection));
+                _reportZeroCopy(connection);
+            }
+
+            if ((flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) && find(connection) != nullptr)
+            {
+                if (_handlers.onReadable)
+                {
+                    _handlers.onReadable(connection);
+                }
+                else
+                {
+                    _read(connection, flags & (EPOLLRDHUP | EPOLLHUP | EPOLLERR));
+                }
+            }
+
+            if ((flags & EPOLLOUT) && find(connection) != nullptr)
+            {
+                _flush(connection);
+            }
+        }
+
+        template <typename Poll>
+        void libdsa::libstructures::TcpEventLoop::run(Poll poll)
+        {
+            while (!_stopping.load() && isOpen())
+            {
+                poll(-1);
+            }
+
+            _stopping.store(false);
+        }
+
+        inline void libdsa::libstructures::TcpEventLoop::stop()
+        {
+            _stopping.store(true);
+
+            const uint64_t one = 1;
+            if (this->_wakeup_fd >= 0 && ::write(this->_wakeup_fd, &one, sizeof(one)) < 0)
+            {
+                // The counter can only be full if the loop already has a wakeup pending.
+            }
+        }
+
+        inline libdsa::libstructures::TcpEventLoop::ConnectionId libdsa::libstructures::TcpEventLoop::add(int fd)
+        {
+            const ConnectionId id = _nextId++;
+
+            if (this->_epoll_fd >= 0 && !watch(fd, id, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET))
+            {
+                ::close(fd);
+                return 0;
+            }
+
+            _connections.emplace(id, Connection(fd));
+            return id;
+        }
+
+        inline void libdsa::libstructures::TcpEventLoop::discard(ConnectionId connection)
+        {
+            auto found = _connections.find(connection);
+
+            if (found != _connections.end())
+            {
+                ::close(found->second.fd);
+                _connections.erase(found);
+            }
+        }
+
+        inline libdsa::libstructures::TcpEventLoop::Connection *
+        libdsa::libstructures::TcpEventLoop::find(ConnectionId connection)
+        {
+            auto found = _connections.find(connection);
+            return found == _connections.end() ? nullptr : &found->second;
+        }
+
+        inline const libdsa::libstructures::TcpEventLoop::Connection *
+        libdsa::libstructures::TcpEventLoop::find(ConnectionId connection) const
+        {
+            auto found = _connections.find(connection);
+            return found == _connections.end() ? nullptr : &found->second;
+        }
+
+        inline libdsa::libstructures::TcpEventLoop::ConnectionId
+        libdsa::libstructures::TcpEventLoop::anyConnection() const
+        {
+            return _connections.empty() ? 0 : _connections.begin()->first;
+        }
+
+        inline size_t libdsa::libstructures::TcpEventLoop::connectionCount() const
+        {
+            return _connections.size();
+        }
+
+        inline size_t libdsa::libstructures::TcpEventLoop::pendingBytes(ConnectionId connection) const
+        {
+            const Connection *state = find(connection);
+            return state == nullptr ? 0 : state->outputBytes + state->inFlight.remaining();
+        }
+
+        inline bool libdsa::libstructures::TcpEventLoop::sendv(ConnectionId connection, const BufferView *views,
+                                                               size_t count)
+        {
+            Connection *state = find(connection);
+
+            if (state == nullptr)
+            {
+                return false;
+            }
+
+            // Appending behind queued output keeps the byte order; the socket will say when it can take more.
+            if (state->connecting || !state->output.empty())
+            {
+                append(*state, views, count, 0);
+                return true;
+            }
+
+            const size_t total = totalSize(views, count);
+            size_t written = 0;
+
+            while (written < total)
+            {
+                iovec vectors[MAX_IOVECS];
+                msghdr message{};
+                message.msg_iov = vectors;
+                message.msg_iovlen = toIovecs(views, count, written, vectors, MAX_IOVECS);
+
+                const ssize_t result = ::sendmsg(state->fd, &message, MSG_NOSIGNAL);
+
+                if (result > 0)
+                {
+                    written += static_cast<size_t>(result);
+                }
+                else if (result < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                else if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                {
+                    break;
+                }
+                else
+                {
+                    closeConnection(connection);
+                    return false;
+                }
+            }
+
+            append(*state, views, count, written);
+            return true;
+        }
+
+        inline bool libdsa::libstructures::TcpEventLoop::sendZeroCopy(ConnectionId connection, const BufferView *views,
+                                                                      size_t count, uint64_t tag)
+        {
+            Connection *state = find(connection);
+
+            if (state == nullptr)
+            {
+                return false;
+            }
+
+            if (totalSize(views, count) < ZERO_COPY_THRESHOLD || !_enableZeroCopy(*state))
+            {
+                if (!sendv(connection, views, count))
+                {
+                    return false;
+                }
+
+                // Whatever was not written has been copied, so the caller's buffers are free already.
+                if (_handlers.onZeroCopyComplete)
+                {
+                    _handlers.onZeroCopyComplete(connection, tag);
+                }
+
+                return true;
+            }
+
+            const bool idle = state->output.empty();
+            size_t last = count;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (views[i].size != 0)
+                {
+                    last = i;
+                }
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (views[i].size != 0)
+                {
+                    state->output.push_back(Segment{{}, views[i].data, views[i].size, 0, tag, i == last});
+                    state->outputBytes += views[i].size;
+                }
+            }
+
+            if (idle && !_write(connection))
+            {
+                return false;
+            }
+
+            _reportZeroCopy(connection);
+            return true;
+        }
+
+        inline ssize_t libdsa::libstructures::TcpEventLoop::recvv(ConnectionId connection,
+                                                                  const MutableBufferView *views, size_t count)
+        {
+            Connection *state = find(connection);
+
+            if (state == nullptr)
+            {
+                return -1;
+            }
+
+            iovec vectors[MAX_IOVECS];
+            msghdr message{};
+            message.msg_iov = vectors;
+            message.msg_iovlen = toIovecs(views, count, 0, vectors, MAX_IOVECS);
+
+            if (message.msg_iovlen == 0)
+            {
+                return 0;
+            }
+
+            for (;;)
+            {
+                const ssize_t received = ::recvmsg(state->fd, &message, 0);
+
+                if (received > 0)
+                {
+                    return received;
+                }
+
+                if (received < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+
+                if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                {
+                    return 0;
+                }
+
+                // At the end of the stream, queued output still goes out first.
+                if (received == 0)
+                {
+                    state->peerFinished = true;
+                    return _flush(connection) ? 0 : -1;
+                }
+
+                closeConnection(connection);
+                return -1;
+            }
+        }
+
+        inline bool libdsa::libstructures::TcpEventLoop::setTcpOption(ConnectionId connection, int option,
+                                                                      bool enable)
+        {
+            const Connection *state = find(connection);
+            const int value = enable ? 1 : 0;
+
+            return state != nullptr && ::setsockopt(state->fd, IPPROTO_TCP, option, &value, sizeof(value)) == 0;
+        }
+
+        inline void libdsa::libstructures::TcpEventLoop::_read(ConnectionId connection, bool peerClosed)
+        {
+            for (;;)
+            {
+                Connection *state = find(connection);
+
+                if (state == nullptr)
+                {
+                    return;
+                }
+
+                char *target = _readBuffer.get();
+                size_t capacity = READ_BUFFER_SIZE;
+                BufferHandle pooled;
+
+                if (_handlers.onReadBuffer)
+                {
+                    // The bytes go straight into the buffer the application gets, sized to what the socket holds so
+                    // that a small message it keeps does not pin a whole read buffer.
+                    int available = 0;
+
+                    if (::ioctl(state->fd, FIONREAD, &available) != 0 || available <= 0)
+                    {
+                        available = 1;
+                    }
+
+                    pooled = _bufferPool->acquire(std::min(static_cast<size_t>(available), READ_BUFFER_SIZE));
+
+                    if (!pooled)
+                    {
+                        std::printf("*** ERROR: Unable to get a receive buffer for connection %llu\n",
+                                    static_cast<unsigned long long>(connection));
+                        closeConnection(connection);
+                        return;
+                    }
+
+                    target = pooled.data();
+                    capacity = pooled.capacity();
+                }
+
+                const ssize_t received = ::recv(state->fd, target, capacity, 0);
+
+                if (received > 0)
+                {
+                    if (pooled)
+                    {
+                        pooled.resize(static_cast<size_t>(received));
+                        _handlers.onReadBuffer(connection, std::move(pooled));
+                    }
+                    else if (_handlers.onRead)
+                    {
+                        _handlers.onRead(connection, target, static_cast<size_t>(received));
+                    }
+
+                    // A short read drained the socket, and new data will raise a new edge.  Once the peer has hung
+                    // up, keep reading until the end of the stream shows up.
+                    if (static_cast<size_t>(received) < capacity && !peerClosed)
+                    {
+                        return;
+                    }
+                }
+                else if (received == 0)
+                {
+                    state->peerFinished = true;
+                    _flush(connection);
+                    return;
+                }
+                else if (received < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                else if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                {
+                    return;
+                }
+                else
+                {
+                    closeConnection(connection);
+                    return;
+                }
+            }
+        }
+
+        inline bool libdsa::libstructures::TcpEventLoop::_flush(ConnectionId connection)
+        {
+            const Connection *state = find(connection);
+
+            if (!state->connecting && !state->output.empty())
+            {
+                if (!_write(connection))
+                {
+                    return false;
+                }
+
+                _reportZeroCopy(connection);
+                state = find(connection);
+
+                if (state != nullptr && state->output.empty() && _handlers.onWrite)
+                {
+                    _handlers.onWrite(connection);
+                }
+
+                state = find(connection);
+            }
+
+            if (state == nullptr)
+            {
+                return false;
+            }
+
+            if (state->peerFinished && state->output.empty())
+            {
+                closeConnection(connection);
+                return false;
+            }
+
+            return true;
+        }
+
+        inline bool libdsa::libstructures::TcpEventLoop::_write(ConnectionId connection)
+        {
+            Connection *state = find(connection);
+
+            while (!state->output.empty())
+            {
+                // Borrowed and owned bytes never share a call, since MSG_ZEROCOPY would pin the owned ones too.
+                const bool zeroCopy = state->output.front().borrowed != nullptr && state->zeroCopy == ZeroCopy::ENABLED;
+                iovec vectors[MAX_IOVECS];
+                msghdr message{};
+                message.msg_iov = vectors;
+
+                for (const Segment &segment : state->output)
+                {
+                    const bool segmentZeroCopy = segment.borrowed != nullptr && state->zeroCopy == ZeroCopy::ENABLED;
+
+                    if (message.msg_iovlen == MAX_IOVECS || segmentZeroCopy != zeroCopy)
+                    {
+                        break;
+                    }
+
+                    vectors[message.msg_iovlen].iov_base = const_cast<char *>(segment.data());
+                    vectors[message.msg_iovlen].iov_len = segment.remaining();
+                    ++message.msg_iovlen;
+                }
+
+                const ssize_t written = ::sendmsg(state->fd, &message, MSG_NOSIGNAL | (zeroCopy ? MSG_ZEROCOPY : 0));
+
+                if (written > 0)
+                {
+                    if (zeroCopy)
+                    {
+                        ++state->zeroCopyIssued;
+                    }
+
+                    _consume(*state, static_cast<size_t>(written));
+                }
+                else if (written < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                {
+                    return true;
+                }
+                else if (written < 0 && errno == ENOBUFS && zeroCopy)
+                {
+                    // Out of memory for pinning pages; the borrowed buffers are still valid to copy from.
+                    state->zeroCopy = ZeroCopy::DISABLED;
+                }
+                else
+                {
+                    closeConnection(connection);
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        inline void libdsa::libstructures::TcpEventLoop::append(Connection &state, const BufferView *views,
+                                                                size_t count, size_t skip)
+        {
+            const size_t total = totalSize(views, count);
+
+            if (total <= skip)
+            {
+                return;
+            }
+
+            if (state.output.empty() || state.output.back().borrowed != nullptr)
+            {
+                state.output.push_back(Segment{{}, nullptr, 0, 0, 0, false});
+            }
+
+            Segment &back = state.output.back();
+
+            // Drop the written prefix once it is most of the buffer, so a connection that is always behind does not
+            // keep growing its queue.
+            if (back.offset > back.size / 2)
+            {
+                back.owned.erase(back.owned.begin(), back.owned.begin() + back.offset);
+                back.size -= back.offset;
+                back.offset = 0;
+            }
+
+            back.owned.reserve(back.size + total - skip);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (views[i].size <= skip)
+                {
+                    skip -= views[i].size;
+                    continue;
+                }
+
+                back.owned.insert(back.owned.end(), views[i].data + skip, views[i].data + views[i].size);
+                skip = 0;
+            }
+
+            state.outputBytes += back.owned.size() - back.size;
+            back.size = back.owned.size();
+        }
+
+        inline void libdsa::libstructures::TcpEventLoop::_consume(Connection &state, size_t size)
+        {
+            state.outputBytes -= size;
+
+            while (size > 0)
+            {
+                Segment &front = state.output.front();
+                const size_t taken = std::min(size, front.remaining());
+
+                front.offset += taken;
+                size -= taken;
+
+                if (front.remaining() != 0)
+                {
+                    break;
+                }
+
+                // Every byte of the call is written, but the latest zero-copy send may still be reading the last ones.
+                if (front.borrowed != nullptr && front.last)
+                {
+                    state.zeroCopyWaiting.emplace_back(state.zeroCopyIssued - 1, front.tag);
+                }
+
+                state.output.pop_front();
+            }
+        }
+
+        inline bool libdsa::libstructures::TcpEventLoop::_enableZeroCopy(Connection &state)
+        {
+            if (state.zeroCopy == ZeroCopy::UNTRIED)
+            {
+                const int enable = 1;
+                state.zeroCopy = ::setsockopt(state.fd, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) == 0
+                                     ? ZeroCopy::ENABLED
+                                     : ZeroCopy::DISABLED;
+            }
+
+            return state.zeroCopy == ZeroCopy::ENABLED;
+        }
+
+        inline void libdsa::libstructures::TcpEventLoop::_readErrorQueue(Connection &state)
+        {
+            for (;;)
+            {
+                char control[CMSG_SPACE(sizeof(sock_extended_err)) + 64];
+                msghdr message{};
+                message.msg_control = control;
+                message.msg_controllen = sizeof(control);
+
+                if (::recvmsg(state.fd, &message, MSG_ERRQUEUE) < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    return;
+                }
+
+                for (cmsghdr *header = CMSG_FIRSTHDR(&message); header != nullptr;
+                     header = CMSG_NXTHDR(&message, header))
+                {
+                    if (!(header->cmsg_level == SOL_IP && header->cmsg_type == IP_RECVERR) &&
+                        !(header->cmsg_level == SOL_IPV6 && header->cmsg_type == IPV6_RECVERR))
+                    {
+                        continue;
+                    }
+
+                    sock_extended_err error;
+                    std::memcpy(&error, CMSG_DATA(header), sizeof(error));
+
+                    if (error.ee_origin != SO_EE_ORIGIN_ZEROCOPY || error.ee_errno != 0)
+                    {
+                        continue;
+                    }
+
+                    // Each notification covers the sends numbered ee_info through ee_data, and TCP releases them in
+                    // order.
+                    state.zeroCopyReleased = error.ee_data + 1;
+
+                    // The kernel had to copy after all, as it does for loopback, so zero copy only adds overhead here.
+                    if (error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+                    {
+                        state.zeroCopy = ZeroCopy::DISABLED;
+                    }
+                }
+            }
+        }
+
+        inline void libdsa::libstructures::TcpEventLoop::_reportZeroCopy(ConnectionId connection)
+        {
+            for (;;)
+            {
+                Connection *state = find(connection);
+
+                // A send is released once the released count has moved past it; the difference handles wrap-around.
+                if (state == nullptr || state->zeroCopyWaiting.empty() ||
+                    static_cast<int32_t>(state->zeroCopyReleased - state->zeroCopyWaiting.front().first) <= 0)
+                {
+                    return;
+                }
+
+                const uint64_t tag = state->zeroCopyWaiting.front().second;
+                state->zeroCopyWaiting.pop_front();
+
+                if (_handlers.onZeroCopyComplete)
+                {
+                    _handlers.onZeroCopyComplete(connection, tag);
+                }
+            }
+        }
+
+        inline void libdsa::libstructures::TcpEventLoop::closeConnection(ConnectionId connection)
+        {
+            auto found = _connections.find(connection);
+
+            if (found == _connections.end())
+            {
+                return;
+            }
+
+            Connection &state = found->second;
+            std::vector<uint64_t> tags;
+
+            for (const std::pair<uint32_t, uint64_t> &waiting : state.zeroCopyWaiting)
+            {
+                tags.push_back(waiting.second);
+            }
+
+            for (const Segment &segment : state.output)
+            {
+                if (segment.borrowed != nullptr && segment.last)
+                {
+                    tags.push_back(segment.tag);
+                }
+            }
+
+            // A reset discards what the kernel still has queued, so it stops reading the borrowed buffers.
+            if (state.zeroCopyIssued != state.zeroCopyReleased)
+            {
+                const linger reset{1, 0};
+                ::setsockopt(state.fd, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+            }
+
+            // Closing the descriptor also removes it from the epoll set.
+            ::close(state.fd);
+            _connections.erase(found);
+
+            for (uint64_t tag : tags)
+            {
+                if (_handlers.onZeroCopyComplete)
+                {
+                    _handlers.onZeroCopyComplete(connection, tag);
+                }
+            }
+
+            if (_handlers.onClose)
+            {
+                _handlers.onClose(connection);
+            }
+        }
+    } // libstructures
+} // libdsa
+
+#endif // TCP_EVENT_LOOP_H_
+
+/// @}
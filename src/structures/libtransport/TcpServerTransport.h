@@ -6,13 +6,60 @@
 #ifndef TCPSERVER_TRANSPORT_H_
 #define TCPSERVER_TRANSPORT_H_
 
-#include <sys/socket.h>
+/// @details The server is a single threaded event loop over one epoll instance.  The listening socket and every
+/// accepted connection are non-blocking and registered once, edge-triggered, for both reading and writing, so the
+/// loop never has to re-arm a descriptor.  An edge is only reported when a socket's state changes, so every readiness
+/// event is handled until the kernel reports @c EAGAIN: all pending connections are accepted, all available bytes are
+/// read, and queued output is written until the socket buffer is full.  To use more than one core, several
+/// transports listen on the same address, one per thread, and let the kernel spread connections across them (see
+/// @c setReusePort() and @c MultiReactorServer).
+///
+/// Each connection keeps its own output queue.  @c send() and @c sendv() write straight from the caller's buffers
+/// when nothing is queued, gathering any number of them into one @c sendmsg, and copy only what the kernel did not
+/// take; the rest goes out when the socket becomes writable again.  On epoll, @c sendZeroCopy() does not copy at all:
+/// the queue borrows the caller's buffers, large sends use @c MSG_ZEROCOPY so the kernel transmits straight from them,
+/// and @c onZeroCopyComplete says when they may be reused.  The application sees the connection through the accept,
+/// read, write and close callbacks, all of which run on the thread calling @c poll() or @c run().  With an
+/// @c onReadable callback the application pulls received bytes into its own buffers with @c recvv() instead; with
+/// @c onReadBuffer it receives them in reference-counted buffers it may keep, which the bytes are received straight
+/// into: buffers from a @c BufferPool on epoll, the ring's own buffers on io_uring.  Every turn of the loop ends with
+/// @c onTurnEnd, where a layer above can write what the turn produced in one batch (see @c FramedTransport).
+///
+/// The loop can instead run on io_uring, which replaces the receive and send system calls with requests queued in
+/// memory shared with the kernel.  One multishot accept request keeps producing connections and one multishot receive
+/// per connection keeps producing data, each chunk in a buffer the kernel picked from a registered buffer ring (see
+/// @c BufferRing).  Every send becomes a queued request, and one system call per turn submits all the requests the
+/// turn produced and waits for the next completions.  A connection has at most one send in flight, and its buffer is
+/// left untouched until the completion arrives; output sent meanwhile is queued behind it.  These sends copy, so on
+/// io_uring @c sendZeroCopy() behaves like @c sendv() and reports its tag before returning.  When the kernel lacks
+/// any of this, as every kernel before Linux 6.0 does, @c open() quietly uses epoll; @c backend() tells which one runs.
+
 #include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 // From C++ STL
-#include <array>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// From libtransport
+#include "BufferPool.h"
+#include "BufferView.h"
+#include "IoUring.h"
+#include "TcpEventLoop.h"
 
-#define MAX_PACKET_SIZE 1024
 namespace libdsa
 {
     namespace libstructures
@@ -20,65 +67,967 @@ namespace libdsa
         class TcpServerTransport
         {
         public:
+            /// @brief Identifies one accepted connection while it is open.  Identifiers are never reused.
+            using ConnectionId = TcpEventLoop::ConnectionId;
+
+            /// @brief Application hooks.  Any of them may be left empty.
+            struct Callbacks
+            {
+                /// @brief A client connected.
+                std::function<void(ConnectionId)> onAccept;
+
+                /// @brief Bytes arrived.  @p data is only valid for the duration of the call.
+                std::function<void(ConnectionId, const char *data, size_t size)> onRead;
+
+                /// @brief Bytes arrived, in the buffer they were received into, which the application may keep for as
+                ///        long as it likes.  Takes the place of @c onRead when set.  On io_uring, holding many of them
+                ///        leaves fewer of the @c URING_BUFFER_COUNT receive buffers to the kernel.
+                std::function<void(ConnectionId, BufferHandle buffer)> onReadBuffer;
+
+                /// @brief Output that had to be queued has now been written completely.
+                std::function<void(ConnectionId)> onWrite;
+
+                /// @brief The connection closed, from either side.  Its identifier is invalid once this returns.
+                std::function<void(ConnectionId)> onClose;
+
+                /// @brief epoll only.  When set, the transport does not read by itself: it reports that bytes or the
+                ///        end of the stream arrived, and the application calls @c recvv() until it returns 0.
+                std::function<void(ConnectionId)> onReadable;
+
+                /// @brief The buffers of the @c sendZeroCopy() call tagged @p tag may be reused.
+                std::function<void(ConnectionId, uint64_t tag)> onZeroCopyComplete;
+
+                /// @brief A turn of the event loop handled everything it collected, or timed out.  Output produced
+                ///        during the turn can be written from here in one batch per connection.
+                std::function<void()> onTurnEnd;
+            };
+
+            /// @brief How the event loop learns about and performs socket operations.
+            enum class Backend
+            {
+                /// @brief Edge-triggered readiness, then one system call per receive or send.
+                EPOLL,
+
+                /// @brief Completion-based, with multishot accept and receive and batched submissions.
+                IO_URING
+            };
+
+            /// @brief Bytes read from a socket per @c recv call.
+            static constexpr size_t READ_BUFFER_SIZE = TcpEventLoop::READ_BUFFER_SIZE;
+
+            /// @brief Buffers gathered into one @c sendmsg or @c recvmsg call.
+            static constexpr size_t MAX_IOVECS = TcpEventLoop::MAX_IOVECS;
+
+            /// @brief Smallest @c sendZeroCopy() that uses @c MSG_ZEROCOPY.  Below this, pinning the pages and
+            ///        reading the completion cost more than copying.
+            static constexpr size_t ZERO_COPY_THRESHOLD = TcpEventLoop::ZERO_COPY_THRESHOLD;
+
+            /// @brief Submission queue entries of the io_uring backend.  The completion queue holds four times as many.
+            static constexpr unsigned URING_ENTRIES = 1024;
+
+            /// @brief Receive buffers shared by all connections of the io_uring backend, and the size of each.
+            static constexpr unsigned URING_BUFFER_COUNT = 512;
+            static constexpr unsigned URING_BUFFER_SIZE = 16 * 1024;
+
+            /// @brief Readiness events collected per @c epoll_wait call.
+            static constexpr int MAX_EVENTS = TcpEventLoop::MAX_EVENTS;
+
+            /// @brief Length of the kernel's queue of connections not yet accepted.
+            static constexpr int LISTEN_BACKLOG = 4096;
+
             /// @brief Builds the @c TcpServerTransport object, but does not ready it for immediate use.
-            /// @param ip IP address the user wants to communicate with.
-            /// @param port The port the Server Socket will use.
-            TcpServerTransport(uint32_t ip, uint16_t port = 8080);
+            /// @param ip IP address to listen on, in network byte order.
+            /// @param port The port the Server Socket will use.  Zero lets the system pick one; see @c port().
+            /// @param backend The event loop to try first.  @c IO_URING falls back to @c EPOLL when unsupported.
+            TcpServerTransport(uint32_t ip, uint16_t port = 8080, Backend backend = Backend::EPOLL);
+
+            /// @brief Closes every connection and the listening socket.
+            ~TcpServerTransport();
+
+            TcpServerTransport(const TcpServerTransport &) = delete;
+            TcpServerTransport &operator=(const TcpServerTransport &) = delete;
+
+            /// @brief Replaces the application hooks.
+            void setCallbacks(Callbacks callbacks);
+
+            /// @brief Makes @c onReadBuffer take its buffers from @p pool, which must outlive them, instead of from
+            ///        @c BufferPool::shared().  epoll only: io_uring lends out its own receive buffers.
+            void setBufferPool(BufferPool &pool);
 
-            /// @brief Opens the @c TcpServerTransport socket for send/receive.
+            /// @brief Changes the port the next @c open() listens on.
+            void setPort(uint16_t port);
+
+            /// @brief Lets the next @c open() share its address with other listeners that set this too, typically
+            ///        one per thread; the kernel then spreads new connections across them (@c SO_REUSEPORT).
+            void setReusePort(bool enable);
+
+            /// @brief Binds and listens on the configured address and sets up the event loop.
             /// @return Whether the attempt to open the transport was successful.
             bool open();
 
-            /// @brief Closes the @c TcpServerTransport socket.
-            /// @return Whether the attempt to close the socket was successful.
+            /// @brief Closes every connection, reporting each through @c onClose, then the listening socket.
+            /// @return Whether the transport was open.
             bool close();
 
-            bool send(std::array<char, MAX_PACKET_SIZE> buffer);
+            bool isOpen() const;
+
+            /// @brief Gets the port the transport listens on, which is the system's choice if it was opened with 0.
+            uint16_t port() const;
+
+            /// @brief Gets the backend the event loop runs on.  Before @c open() this is the one requested.
+            Backend backend() const;
+
+            /// @brief Runs one turn of the event loop: waits up to @p timeoutMilliseconds for readiness or
+            ///        completions and handles every one reported.  A negative timeout waits indefinitely.
+            /// @return The number of events or completions handled.
+            size_t poll(int timeoutMilliseconds = -1);
 
-            std::array<char, MAX_PACKET_SIZE> receive(std::array<char, MAX_PACKET_SIZE> buffer);
+            /// @brief Runs the event loop until @c stop() is called.
+            void run();
+
+            /// @brief Makes @c run() return after its current turn.  Safe to call from any thread.
+            void stop();
+
+            /// @brief Sends @p size bytes to @p connection, queueing what the socket cannot take right away.  On
+            ///        io_uring everything is queued and submitted with the loop's next turn.
+            /// @return False if the connection is unknown or failed while writing, in which case it is closed.
+            bool send(ConnectionId connection, const char *data, size_t size);
+
+            /// @brief Sends the @p count buffers of @p views, in order, as one stream of bytes.  The buffers may be
+            ///        reused as soon as the call returns.
+            /// @return False if the connection is unknown or failed while writing, in which case it is closed.
+            bool sendv(ConnectionId connection, const BufferView *views, size_t count);
+
+            /// @brief Sends the @p count buffers of @p views without copying them.  They must stay alive and
+            ///        unchanged until @c onZeroCopyComplete reports @p tag, which can happen before this returns
+            ///        when the data was small enough to copy or the socket does not support zero copy.  If the
+            ///        connection closes first, the tag is reported before @c onClose and the connection is reset
+            ///        rather than shut down, which discards what the kernel still had queued from the buffers.  On
+            ///        io_uring the data is copied.
+            /// @return False if the connection is unknown or failed while writing, in which case it is closed.
+            bool sendZeroCopy(ConnectionId connection, const BufferView *views, size_t count, uint64_t tag);
+
+            /// @brief epoll only.  Reads as many bytes as are available, up to the total size of @p views, straight
+            ///        into the caller's buffers.
+            /// @return The number of bytes read; 0 when nothing is available now; -1 if the connection is unknown
+            ///         or has just closed, in which case @c onClose has run.  After the peer's stream ends, 0 is
+            ///         returned until queued output has been written and the connection closes.
+            ssize_t recvv(ConnectionId connection, const MutableBufferView *views, size_t count);
+
+            /// @brief Closes @p connection immediately, dropping any queued output.
+            /// @return False if the connection is unknown.
+            bool disconnect(ConnectionId connection);
+
+            /// @brief Turns Nagle's algorithm off (@p enable) or back on for @p connection.  With it off, every
+            ///        write leaves at once instead of waiting for earlier segments to be acknowledged.
+            /// @return False if the connection is unknown or the socket refused the option.
+            bool setNoDelay(ConnectionId connection, bool enable);
+
+            /// @brief Corks (@p enable) or uncorks @p connection.  While corked, the kernel sends only full
+            ///        segments, so several writes leave as one; uncorking sends what is left.
+            /// @return False if the connection is unknown or the socket refused the option.
+            bool setCork(ConnectionId connection, bool enable);
+
+            /// @brief Gets the number of open connections.
+            size_t connectionCount() const;
+
+            /// @brief Gets the number of bytes queued for @p connection and not yet written.
+            size_t pendingBytes(ConnectionId connection) const;
 
         private:
+            using Segment = TcpEventLoop::Segment;
+            using Connection = TcpEventLoop::Connection;
+
+            /// @brief Tag of the listening socket, for epoll and io_uring.  The wakeup descriptor has
+            ///        @c TcpEventLoop::WAKEUP_ID, and connections count from one above the listener.
+            static constexpr ConnectionId LISTENER_ID = TcpEventLoop::WAKEUP_ID + 1;
+
+            /// @brief io_uring requests carry the connection in the upper bits of their user data and the operation
+            ///        in the lowest three.
+            enum Operation : uint64_t
+            {
+                OPERATION_ACCEPT,
+                OPERATION_RECEIVE,
+                OPERATION_SEND,
+                OPERATION_WAKEUP
+            };
+
+            static constexpr uint64_t OPERATION_BITS = 3;
+
+            /// @brief Sets up the ring, its buffers and the standing requests.
+            /// @return False if the kernel lacks a feature the backend needs, leaving nothing behind.
+            bool _openUring();
+
+            /// @brief Receives one byte through a multishot receive on a socket pair, which tells whether the kernel
+            ///        keeps such a receive armed after a completion.  No other request may be in flight on @p ring.
+            static bool _supportsMultishotReceive(IoUring &ring, BufferRing &buffers);
+
+            size_t _pollEpoll(int timeoutMilliseconds);
+            size_t _pollUring(int timeoutMilliseconds);
+
+            void _complete(const io_uring_cqe &completion);
+
+            /// @brief Queues a request on the ring for @p connection.
+            /// @return False if the submission queue could not take it.
+            bool _armAccept();
+            bool _armReceive(ConnectionId connection, int fd);
+            bool _armWakeup();
+
+            /// @brief Starts a send of the queued output if none is in flight.
+            /// @return False if the connection failed, in which case it has been closed.
+            bool _submitSend(ConnectionId connection);
+
+            /// @brief Registers an accepted socket and reports it.
+            void _register(int fd);
+
+            /// @brief Accepts every pending connection.
+            void _accept();
+
+            /// @brief Shuts down the socket first on io_uring, then closes the connection in the loop.
+            void _closeConnection(ConnectionId connection);
+
             /// @brief Reference ID to the underlying socket file descriptor
             int _socket_fd;
 
             struct sockaddr_in _address;
 
+            Callbacks _callbacks;
+
+            /// @brief The connections and, on epoll, the loop waiting on them.
+            TcpEventLoop _loop;
+
+            /// @brief Set when accepting stopped on an error rather than on an empty queue.
+            bool _acceptPending;
+            bool _reusePort;
+
+            Backend _backend;
+
+            /// @brief io_uring backend only.  The ring has to go before the buffers registered with it.
+            std::unique_ptr<IoUring> _ring;
+            std::unique_ptr<BufferRing> _receiveBuffers;
+
+            /// @brief Connections whose send found the submission queue full, retried after the next turn.
+            std::vector<ConnectionId> _sendsPending;
+
+            /// @brief Output of closed connections whose send was still in flight, kept until its completion arrives.
+            std::unordered_map<ConnectionId, std::vector<char>> _orphanedSends;
         }; // TcpServerTransport
 
-        libdsa::libstructures::TcpServerTransport::TcpServerTransport(uint32_t ip, uint16_t port)
+        inline libdsa::libstructures::TcpServerTransport::TcpServerTransport(uint32_t ip, uint16_t port,
+                                                                             Backend backend)
+            : _socket_fd(-1), _address(), _loop(LISTENER_ID + 1), _acceptPending(false), _reusePort(false),
+              _backend(backend)
         {
+            this->_address.sin_family = AF_INET;
             this->_address.sin_port = htons(port);
-            this->_address.sin_family = AF_INET6;
             this->_address.sin_addr.s_addr = ip;
+        }
+
+        inline libdsa::libstructures::TcpServerTransport::~TcpServerTransport()
+        {
+            close();
+        }
+
+        inline void libdsa::libstructures::TcpServerTransport::setCallbacks(Callbacks callbacks)
+        {
+            _callbacks = std::move(callbacks);
+            _loop.setHandlers(TcpEventLoop::Handlers{_callbacks.onRead, _callbacks.onReadBuffer, _callbacks.onWrite,
+                                                     _callbacks.onClose, _callbacks.onReadable,
+                                                     _callbacks.onZeroCopyComplete});
+        }
+
+        inline void libdsa::libstructures::TcpServerTransport::setBufferPool(BufferPool &pool)
+        {
+            _loop.setBufferPool(pool);
+        }
+
+        inline void libdsa::libstructures::TcpServerTransport::setPort(uint16_t port)
+        {
+            this->_address.sin_port = htons(port);
+        }
+
+        inline void libdsa::libstructures::TcpServerTransport::setReusePort(bool enable)
+        {
+            _reusePort = enable;
+        }
+
+        inline bool libdsa::libstructures::TcpServerTransport::open()
+        {
+            if (isOpen())
+            {
+                return false;
+            }
+
+            this->_socket_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+            if (this->_socket_fd < 0)
+            {
+                std::printf("*** ERROR: Unable to create server socket: %s\n", std::strerror(errno));
+                return false;
+            }
+
+            const int enable = 1;
+            ::setsockopt(this->_socket_fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+            if (_reusePort && ::setsockopt(this->_socket_fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) != 0)
+            {
+                std::printf("*** ERROR: Unable to share the server socket's port: %s\n", std::strerror(errno));
+                close();
+                return false;
+            }
+
+            if (::bind(this->_socket_fd, reinterpret_cast<const sockaddr *>(&this->_address), sizeof(this->_address)) != 0)
+            {
+                std::printf("*** ERROR: Unable to bind server socket to port %u: %s\n", ntohs(this->_address.sin_port),
+                            std::strerror(errno));
+                close();
+                return false;
+            }
+
+            if (::listen(this->_socket_fd, LISTEN_BACKLOG) != 0)
+            {
+                std::printf("*** ERROR: Unable to listen on server socket: %s\n", std::strerror(errno));
+                close();
+                return false;
+            }
+
+            // Record the port the system picked when asked for port 0.
+            socklen_t length = sizeof(this->_address);
+            ::getsockname(this->_socket_fd, reinterpret_cast<sockaddr *>(&this->_address), &length);
+
+            if (_backend == Backend::IO_URING && _openUring())
+            {
+                return true;
+            }
+
+            _backend = Backend::EPOLL;
+
+            if (!_loop.open(true) || !_loop.watch(this->_socket_fd, LISTENER_ID, EPOLLIN | EPOLLET))
+            {
+                std::printf("*** ERROR: Unable to set up the server event loop: %s\n", std::strerror(errno));
+                close();
+                return false;
+            }
+
+            return true;
+        }
+
+        inline bool libdsa::libstructures::TcpServerTransport::close()
+        {
+            const bool wasOpen = isOpen();
+
+            while (_loop.connectionCount() > 0)
+            {
+                _closeConnection(_loop.anyConnection());
+            }
+
+            // Closing the ring cancels whatever it still had in flight, after which nothing reads the buffers.
+            _ring.reset();
+            _receiveBuffers.reset();
+            _orphanedSends.clear();
+            _sendsPending.clear();
+            _loop.close();
+
+            if (this->_socket_fd >= 0)
+            {
+                ::close(this->_socket_fd);
+                this->_socket_fd = -1;
+            }
+
+            return wasOpen;
+        }
+
+        inline bool libdsa::libstructures::TcpServerTransport::isOpen() const
+        {
+            return this->_socket_fd >= 0;
+        }
+
+        inline uint16_t libdsa::libstructures::TcpServerTransport::port() const
+        {
+            return ntohs(this->_address.sin_port);
+        }
 
-            if (this->_socket_fd = socket(AF_INET6, SOCK_STREAM, 0) < 0)
+        inline libdsa::libstructures::TcpServerTransport::Backend
+        libdsa::libstructures::TcpServerTransport::backend() const
+        {
+            return _backend;
+        }
+
+        inline size_t libdsa::libstructures::TcpServerTransport::poll(int timeoutMilliseconds)
+        {
+            if (!isOpen())
+            {
+                return 0;
+            }
+
+            const size_t handled = _ring ? _pollUring(timeoutMilliseconds) : _pollEpoll(timeoutMilliseconds);
+
+            if (_callbacks.onTurnEnd && isOpen())
+            {
+                _callbacks.onTurnEnd();
+            }
+
+            return handled;
+        }
+
+        inline size_t libdsa::libstructures::TcpServerTransport::_pollEpoll(int timeoutMilliseconds)
+        {
+            const size_t handled = _loop.wait(timeoutMilliseconds, [this](ConnectionId id, uint32_t flags) {
+                if (id == LISTENER_ID)
+                {
+                    _accept();
+                }
+                else
+                {
+                    _loop.handle(id, flags);
+                }
+            });
+
+            // Connections closed during this turn may have freed the descriptors a stalled accept needed.
+            if (_acceptPending)
             {
-                printf("*** ERROR: Unable to create server socket");
-                exit(-1);
+                _accept();
             }
+
+            return handled;
+        }
+
+        inline void libdsa::libstructures::TcpServerTransport::run()
+        {
+            _loop.run([this](int timeoutMilliseconds) { poll(timeoutMilliseconds); });
+        }
+
+        inline void libdsa::libstructures::TcpServerTransport::stop()
+        {
+            _loop.stop();
         }
 
-        bool libdsa::libstructures::TcpServerTransport::open()
+        inline bool libdsa::libstructures::TcpServerTransport::send(ConnectionId connection, const char *data,
+                                                                    size_t size)
         {
+            const BufferView view(data, size);
+            return sendv(connection, &view, 1);
+        }
+
+        inline bool libdsa::libstructures::TcpServerTransport::sendv(ConnectionId connection, const BufferView *views,
+                                                                     size_t count)
+        {
+            if (!_ring)
+            {
+                return _loop.sendv(connection, views, count);
+            }
+
+            Connection *state = _loop.find(connection);
 
-            if (bind(this->_socket_fd, (const struct sockaddr *)&(this->_address), 1024) == 0)
+            if (state == nullptr)
             {
-                printf("*** ERROR: Unable to bind server socket to port %u", this->_address.sin_port);
                 return false;
             }
 
-            if (listen(this->_socket_fd, 20) < 0)
+            _loop.append(*state, views, count, 0);
+            return _submitSend(connection);
+        }
+
+        inline bool libdsa::libstructures::TcpServerTransport::sendZeroCopy(ConnectionId connection,
+                                                                            const BufferView *views, size_t count,
+                                                                            uint64_t tag)
+        {
+            if (!_ring)
+            {
+                return _loop.sendZeroCopy(connection, views, count, tag);
+            }
+
+            if (!sendv(connection, views, count))
             {
-                printf("*** ERROR: More than 20 connection attempts made. Unable to find a connection for server.\n");
                 return false;
             }
 
-            if (accept(this->_socket_fd, (sockaddr *)&this->_address, ((socklen_t *)sizeof(this->_address))) < 0)
+            // The ring's sends copy, so the caller's buffers are free already.
+            if (_callbacks.onZeroCopyComplete)
+            {
+                _callbacks.onZeroCopyComplete(connection, tag);
+            }
+
+            return true;
+        }
+
+        inline ssize_t libdsa::libstructures::TcpServerTransport::recvv(ConnectionId connection,
+                                                                        const MutableBufferView *views, size_t count)
+        {
+            if (_ring)
+            {
+                return _loop.find(connection) == nullptr ? -1 : 0;
+            }
+
+            return _loop.recvv(connection, views, count);
+        }
+
+        inline bool libdsa::libstructures::TcpServerTransport::disconnect(ConnectionId connection)
+        {
+            if (_loop.find(connection) == nullptr)
+            {
+                return false;
+            }
+
+            _closeConnection(connection);
+            return true;
+        }
+
+        inline bool libdsa::libstructures::TcpServerTransport::setNoDelay(ConnectionId connection, bool enable)
+        {
+            return _loop.setTcpOption(connection, TCP_NODELAY, enable);
+        }
+
+        inline bool libdsa::libstructures::TcpServerTransport::setCork(ConnectionId connection, bool enable)
+        {
+            return _loop.setTcpOption(connection, TCP_CORK, enable);
+        }
+
+        inline size_t libdsa::libstructures::TcpServerTransport::connectionCount() const
+        {
+            return _loop.connectionCount();
+        }
+
+        inline size_t libdsa::libstructures::TcpServerTransport::pendingBytes(ConnectionId connection) const
+        {
+            return _loop.pendingBytes(connection);
+        }
+
+        inline void libdsa::libstructures::TcpServerTransport::_accept()
+        {
+            for (;;)
+            {
+                const int fd = ::accept4(this->_socket_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+                if (fd < 0)
+                {
+                    if (errno == EINTR || errno == ECONNABORTED)
+                    {
+                        continue;
+                    }
+
+                    // EAGAIN once the queue is drained.  Anything else, such as running out of descriptors, leaves
+                    // clients queued with no new edge to announce them, so try again after the next turn.
+                    _acceptPending = errno != EAGAIN && errno != EWOULDBLOCK;
+                    return;
+                }
+
+                _register(fd);
+            }
+        }
+
+        inline void libdsa::libstructures::TcpServerTransport::_closeConnection(ConnectionId connection)
+        {
+            Connection *state = _loop.find(connection);
+
+            if (_ring && state != nullptr)
+            {
+                // The ring holds its own reference to the socket, so only a shutdown ends the requests still using
+                // it and tells the peer.  Their completions arrive for an unknown connection and are dropped.
+                ::shutdown(state->fd, SHUT_RDWR);
+
+                if (state->sending)
+                {
+                    _orphanedSends.emplace(connection, std::move(state->inFlight.owned));
+                }
+            }
+
+            _loop.closeConnection(connection);
+        }
+
+        inline void libdsa::libstructures::TcpServerTransport::_register(int fd)
+        {
+            const ConnectionId id = _loop.add(fd);
+
+            if (id == 0)
+            {
+                return;
+            }
+
+            if (_ring && !_armReceive(id, fd))
+            {
+                _loop.discard(id);
+                return;
+            }
+
+            if (_callbacks.onAccept)
+            {
+                _callbacks.onAccept(id);
+            }
+        }
+
+        inline bool libdsa::libstructures::TcpServerTransport::_openUring()
+        {
+            std::unique_ptr<IoUring> ring(new IoUring());
+
+            if (!ring->setup(URING_ENTRIES) ||
+                !ring->hasFeatures(IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL |
+                                   IORING_FEAT_EXT_ARG) ||
+                !ring->supports(IORING_OP_ACCEPT) || !ring->supports(IORING_OP_RECV) ||
+                !ring->supports(IORING_OP_SEND) || !ring->supports(IORING_OP_POLL_ADD))
+            {
+                return false;
+            }
+
+            std::unique_ptr<BufferRing> buffers(new BufferRing());
+
+            // The probe only lists opcodes, not the multishot flag of a receive, so that is tried for real.
+            if (!buffers->setup(*ring, 0, URING_BUFFER_COUNT, URING_BUFFER_SIZE) ||
+                !_supportsMultishotReceive(*ring, *buffers))
+            {
+                // The buffers must outlive the ring they may have been registered with.
+                ring.reset();
+                return false;
+            }
+
+            _ring = std::move(ring);
+            _receiveBuffers = std::move(buffers);
+
+            if (!_loop.open(false) || !_armAccept() || !_armWakeup() || _ring->submit() != 0)
+            {
+                _ring.reset();
+                _receiveBuffers.reset();
+                _loop.close();
+                return false;
+            }
+
+            return true;
+        }
+
+        inline bool libdsa::libstructures::TcpServerTransport::_supportsMultishotReceive(IoUring &ring,
+                                                                                        BufferRing &buffers)
+        {
+            int pair[2];
+
+            if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0, pair) != 0)
             {
-                printf("*** ERROR: Server unable to accept client connection.\n");
                 return false;
             }
 
+            io_uring_sqe *sqe = ring.nextSqe();
+
+            if (sqe != nullptr)
+            {
+                sqe->opcode = IORING_OP_RECV;
+                sqe->fd = pair[0];
+                sqe->ioprio = IORING_RECV_MULTISHOT;
+                sqe->flags = IOSQE_BUFFER_SELECT;
+                sqe->buf_group = buffers.groupId();
+            }
+
+            // One byte, then the end of the stream, which finishes the receive whether or not it stayed armed.
+            const char byte = 0;
+            const bool sent = ::send(pair[1], &byte, 1, MSG_NOSIGNAL) == 1;
+            ::close(pair[1]);
+
+            // Kernels without multishot receive either reject the flag or complete the receive after one chunk.
+            bool armed = false;
+            bool finished = sqe == nullptr || !sent;
+
+            while (!finished && ring.submit(1, 1000) == 0)
+            {
+                const size_t handled = ring.forEachCompletion([&](const io_uring_cqe &completion) {
+                    if (completion.flags & IORING_CQE_F_BUFFER)
+                    {
+                        buffers.recycle(static_cast<uint16_t>(completion.flags >> IORING_CQE_BUFFER_SHIFT));
+                    }
+
+                    if (completion.res > 0 && (completion.flags & IORING_CQE_F_MORE))
+                    {
+                        armed = true;
+                    }
+
+                    finished = finished || !(completion.flags & IORING_CQE_F_MORE);
+                });
+
+                if (handled == 0)
+                {
+                    break;
+                }
+            }
+
+            ::close(pair[0]);
+            return armed && finished;
+        }
+
+        inline size_t libdsa::libstructures::TcpServerTransport::_pollUring(int timeoutMilliseconds)
+        {
+            // Buffers the application released since the last turn go back to the kernel before it waits.
+            _receiveBuffers->reclaim();
+
+            // One system call submits everything queued since the last turn and waits for what comes back.
+            const int result = _ring->submit(1, timeoutMilliseconds);
+
+            if (result < 0)
+            {
+                std::printf("*** ERROR: Unable to submit to the server ring: %s\n", std::strerror(-result));
+                return 0;
+            }
+
+            const size_t handled = _ring->forEachCompletion([this](const io_uring_cqe &completion) {
+                _complete(completion);
+            });
+
+            // Connections closed during this turn may have freed the descriptors a failed accept needed.
+            if (_acceptPending)
+            {
+                _acceptPending = false;
+                _armAccept();
+            }
+
+            // Sends that found the submission queue full get another try now that it has been submitted.
+            std::vector<ConnectionId> retries;
+            retries.swap(_sendsPending);
+
+            for (ConnectionId id : retries)
+            {
+                if (_loop.find(id) != nullptr)
+                {
+                    _submitSend(id);
+                }
+            }
+
+            return handled;
+        }
+
+        inline void libdsa::libstructures::TcpServerTransport::_complete(const io_uring_cqe &completion)
+        {
+            const ConnectionId id = completion.user_data >> OPERATION_BITS;
+            const uint64_t operation = completion.user_data & ((uint64_t(1) << OPERATION_BITS) - 1);
+            const bool more = (completion.flags & IORING_CQE_F_MORE) != 0;
+
+            switch (operation)
+            {
+            case OPERATION_ACCEPT:
+                if (completion.res >= 0)
+                {
+                    _register(completion.res);
+                }
+
+                if (!more)
+                {
+                    // A failure such as running out of descriptors ends the request; retry after the next turn
+                    // instead of spinning on it.
+                    if (completion.res < 0 && completion.res != -EINTR && completion.res != -ECONNABORTED)
+                    {
+                        _acceptPending = true;
+                    }
+                    else
+                    {
+                        _armAccept();
+                    }
+                }
+                break;
+
+            case OPERATION_RECEIVE:
+            {
+                if (completion.flags & IORING_CQE_F_BUFFER)
+                {
+                    const uint16_t buffer = static_cast<uint16_t>(completion.flags >> IORING_CQE_BUFFER_SHIFT);
+
+                    if (completion.res > 0 && _callbacks.onReadBuffer && _loop.find(id) != nullptr)
+                    {
+                        // The kernel's buffer itself goes to the application, and back to the kernel once released.
+                        _callbacks.onReadBuffer(id, _receiveBuffers->lend(buffer, static_cast<size_t>(completion.res)));
+                    }
+                    else
+                    {
+                        if (completion.res > 0 && _callbacks.onRead && _loop.find(id) != nullptr)
+                        {
+                            _callbacks.onRead(id, _receiveBuffers->buffer(buffer),
+                                              static_cast<size_t>(completion.res));
+                        }
+
+                        _receiveBuffers->recycle(buffer);
+                    }
+                }
+
+                Connection *state = _loop.find(id);
+
+                if (state == nullptr)
+                {
+                    break;
+                }
+
+                if (completion.res == 0)
+                {
+                    // The peer is done sending but may still read: close only once its output is out.
+                    state->peerFinished = true;
+
+                    if (!state->sending && pendingBytes(id) == 0)
+                    {
+                        _closeConnection(id);
+                    }
+                }
+                else if (completion.res < 0 && completion.res != -ENOBUFS)
+                {
+                    _closeConnection(id);
+                }
+                else if (!more && !_armReceive(id, state->fd))
+                {
+                    _closeConnection(id);
+                }
+                break;
+            }
+
+            case OPERATION_SEND:
+            {
+                Connection *state = _loop.find(id);
+
+                if (state == nullptr)
+                {
+                    _orphanedSends.erase(id);
+                    break;
+                }
+
+                state->sending = false;
+
+                if (completion.res < 0)
+                {
+                    _closeConnection(id);
+                    break;
+                }
+
+                // A short send leaves the rest of the in-flight segment to go out next, ahead of the queue.
+                state->inFlight.offset += static_cast<size_t>(completion.res);
+
+                if (state->inFlight.remaining() == 0)
+                {
+                    state->inFlight = Segment{{}, nullptr, 0, 0, 0, false};
+                }
+
+                if (pendingBytes(id) > 0)
+                {
+                    _submitSend(id);
+                    break;
+                }
+
+                if (_callbacks.onWrite)
+                {
+                    _callbacks.onWrite(id);
+                }
+
+                state = _loop.find(id);
+
+                if (state != nullptr && state->peerFinished && !state->sending && pendingBytes(id) == 0)
+                {
+                    _closeConnection(id);
+                }
+                break;
+            }
+
+            case OPERATION_WAKEUP:
+            {
+                _loop.drainWakeup();
+
+                if (!more)
+                {
+                    _armWakeup();
+                }
+                break;
+            }
+            }
+        }
+
+        inline bool libdsa::libstructures::TcpServerTransport::_armAccept()
+        {
+            io_uring_sqe *sqe = _ring->nextSqe();
+
+            if (sqe == nullptr)
+            {
+                _acceptPending = true;
+                return false;
+            }
+
+            // The accepted sockets stay blocking: the ring waits for readiness itself and never blocks the loop.
+            sqe->opcode = IORING_OP_ACCEPT;
+            sqe->fd = this->_socket_fd;
+            sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+            sqe->accept_flags = SOCK_CLOEXEC;
+            sqe->user_data = LISTENER_ID << OPERATION_BITS | OPERATION_ACCEPT;
+            return true;
+        }
+
+        inline bool libdsa::libstructures::TcpServerTransport::_armReceive(ConnectionId connection, int fd)
+        {
+            io_uring_sqe *sqe = _ring->nextSqe();
+
+            if (sqe == nullptr)
+            {
+                return false;
+            }
+
+            // No buffer of its own: the kernel picks one from the ring for every chunk that arrives.
+            sqe->opcode = IORING_OP_RECV;
+            sqe->fd = fd;
+            sqe->ioprio = IORING_RECV_MULTISHOT;
+            sqe->flags = IOSQE_BUFFER_SELECT;
+            sqe->buf_group = _receiveBuffers->groupId();
+            sqe->user_data = connection << OPERATION_BITS | OPERATION_RECEIVE;
+            return true;
+        }
+
+        inline bool libdsa::libstructures::TcpServerTransport::_armWakeup()
+        {
+            io_uring_sqe *sqe = _ring->nextSqe();
+
+            if (sqe == nullptr)
+            {
+                return false;
+            }
+
+            sqe->opcode = IORING_OP_POLL_ADD;
+            sqe->fd = _loop.wakeupFd();
+            sqe->poll32_events = POLLIN;
+            sqe->len = IORING_POLL_ADD_MULTI;
+            sqe->user_data = TcpEventLoop::WAKEUP_ID << OPERATION_BITS | OPERATION_WAKEUP;
+            return true;
+        }
+
+        inline bool libdsa::libstructures::TcpServerTransport::_submitSend(ConnectionId connection)
+        {
+            Connection *state = _loop.find(connection);
+
+            if (state->sending)
+            {
+                return true;
+            }
+
+            if (state->inFlight.remaining() == 0)
+            {
+                if (state->output.empty())
+                {
+                    return true;
+                }
+
+                // Moving the segment keeps its bytes where they are, so later sends append to a new one.
+                state->inFlight = std::move(state->output.front());
+                state->output.pop_front();
+                state->outputBytes -= state->inFlight.remaining();
+            }
+
+            io_uring_sqe *sqe = _ring->nextSqe();
+
+            // No entry means the kernel would not even take a flush, typically EBUSY while completions back up.  The
+            // connection is healthy, so its output stays queued and the send is retried after the next turn.
+            if (sqe == nullptr)
+            {
+                if (std::find(_sendsPending.begin(), _sendsPending.end(), connection) == _sendsPending.end())
+                {
+                    _sendsPending.push_back(connection);
+                }
+
+                return true;
+            }
+
+            state->sending = true;
+
+            sqe->opcode = IORING_OP_SEND;
+            sqe->fd = state->fd;
+            sqe->addr = reinterpret_cast<uint64_t>(state->inFlight.data());
+            sqe->len = static_cast<uint32_t>(std::min<size_t>(state->inFlight.remaining(), UINT32_MAX));
+            sqe->msg_flags = MSG_NOSIGNAL;
+            sqe->user_data = connection << OPERATION_BITS | OPERATION_SEND;
             return true;
         }
     } // libstructures
@@ -7,9 +7,56 @@
 // Class Header
 #include <binarytree.h>
 
+// From C++ STL
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <stdexcept>
+
 // From Gtest
 #include <gtest/gtest.h>
 
+namespace
+{
+    /// @brief Element whose copies start failing once a budget runs out, counting the live instances.
+    struct ThrowingValue
+    {
+        static int live;
+        static int copiesLeft;
+
+        explicit ThrowingValue(int value) : _value(value)
+        {
+            ++live;
+        }
+
+        ThrowingValue(const ThrowingValue &other) : _value(other._value)
+        {
+            if (copiesLeft >= 0 && copiesLeft-- == 0)
+            {
+                throw std::runtime_error("copy failed");
+            }
+
+            ++live;
+        }
+
+        ~ThrowingValue()
+        {
+            --live;
+        }
+
+        bool operator<(const ThrowingValue &other) const
+        {
+            return _value < other._value;
+        }
+
+        int _value;
+    };
+
+    int ThrowingValue::live = 0;
+    int ThrowingValue::copiesLeft = -1;
+}
+
 /// @brief Tests the basic constructor  
 TEST(BinaryTree, test_emptyConstructor)
 {
@@ -47,4 +94,133 @@ TEST(BinaryTree, test_validSizeRequestWithEmptyTree)
 {
     auto tree = libdsa::structures::tree::BinaryTree<uint8_t>();
     ASSERT_EQ(0, tree.Size());
-}
\ No newline at end of file
+}
+
+TEST(BinaryTree, test_containerConstructorStoresElements)
+{
+    std::vector<uint8_t> vector = {'C', 'O', 'D', 'E'};
+    auto tree = libdsa::structures::tree::BinaryTree<uint8_t>(vector);
+
+    ASSERT_EQ(4, tree.Size());
+
+    std::vector<uint8_t> sorted(tree.begin(), tree.end());
+    ASSERT_EQ((std::vector<uint8_t>{'C', 'D', 'E', 'O'}), sorted);
+}
+
+TEST(BinaryTree, test_insertFindErase)
+{
+    auto tree = libdsa::structures::tree::BinaryTree<int>();
+
+    ASSERT_TRUE(tree.Insert(5));
+    ASSERT_TRUE(tree.Insert(3));
+    ASSERT_TRUE(tree.Insert(8));
+    ASSERT_FALSE(tree.Insert(5));
+    ASSERT_EQ(3, tree.Size());
+
+    ASSERT_TRUE(tree.Contains(3));
+    ASSERT_EQ(8, *tree.Find(8));
+    ASSERT_TRUE(tree.Find(4) == tree.end());
+
+    ASSERT_TRUE(tree.Erase(5));
+    ASSERT_FALSE(tree.Erase(5));
+    ASSERT_FALSE(tree.Contains(5));
+    ASSERT_EQ(2, tree.Size());
+}
+
+TEST(BinaryTree, test_lowerAndUpperBound)
+{
+    std::vector<int> vector = {10, 20, 30, 40};
+    auto tree = libdsa::structures::tree::BinaryTree<int>(vector);
+
+    ASSERT_EQ(20, *tree.LowerBound(20));
+    ASSERT_EQ(30, *tree.UpperBound(20));
+    ASSERT_EQ(20, *tree.LowerBound(15));
+    ASSERT_EQ(10, *tree.LowerBound(-1));
+    ASSERT_TRUE(tree.LowerBound(41) == tree.end());
+    ASSERT_TRUE(tree.UpperBound(40) == tree.end());
+
+    // Stepping back from end() reaches the largest element.
+    auto last = tree.end();
+    --last;
+    ASSERT_EQ(40, *last);
+}
+
+TEST(BinaryTree, test_staysBalancedAgainstStdSet)
+{
+    std::mt19937 rng(11);
+    std::set<int> reference;
+    auto tree = libdsa::structures::tree::BinaryTree<int>();
+
+    // Sorted inserts are the worst case for an unbalanced tree.
+    for (int i = 0; i < 4096; ++i)
+    {
+        tree.Insert(i);
+        reference.insert(i);
+    }
+
+    ASSERT_LE(tree.Height(), 18);
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        const int value = static_cast<int>(rng() % 8192);
+
+        if (rng() % 2 == 0)
+        {
+            ASSERT_EQ(reference.insert(value).second, tree.Insert(value));
+        }
+        else
+        {
+            ASSERT_EQ(reference.erase(value) == 1, tree.Erase(value));
+        }
+    }
+
+    ASSERT_EQ(reference.size(), tree.Size());
+    ASSERT_TRUE(std::equal(reference.begin(), reference.end(), tree.begin(), tree.end()));
+
+    // AVL height is at most about 1.44 log2(n).
+    ASSERT_LE(tree.Height(), 1.45 * std::log2(static_cast<double>(tree.Size()) + 2));
+}
+
+TEST(BinaryTree, test_copyAndMove)
+{
+    std::vector<int> vector = {3, 1, 2};
+    auto tree = libdsa::structures::tree::BinaryTree<int>(vector);
+
+    auto copy = tree;
+    copy.Insert(4);
+
+    ASSERT_EQ(3, tree.Size());
+    ASSERT_EQ(4, copy.Size());
+
+    auto moved = std::move(copy);
+    ASSERT_EQ(4, moved.Size());
+    ASSERT_TRUE(moved.Contains(4));
+
+    moved.Clear();
+    ASSERT_TRUE(moved.Empty());
+    ASSERT_EQ(0, moved.Height());
+}
+
+TEST(BinaryTree, test_throwingCopyFreesPartialClone)
+{
+    {
+        libdsa::structures::tree::BinaryTree<ThrowingValue> tree;
+
+        for (int i = 0; i < 64; ++i)
+        {
+            tree.Insert(ThrowingValue(i));
+        }
+
+        const int live = ThrowingValue::live;
+
+        // Fail part way through, once several subtrees of the clone have been built.
+        ThrowingValue::copiesLeft = 40;
+        ASSERT_THROW(libdsa::structures::tree::BinaryTree<ThrowingValue> copy(tree), std::runtime_error);
+        ThrowingValue::copiesLeft = -1;
+
+        ASSERT_EQ(live, ThrowingValue::live);
+        ASSERT_EQ(64U, tree.Size());
+    }
+
+    ASSERT_EQ(0, ThrowingValue::live);
+}
@@ -0,0 +1,314 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file concurrentmaptest
+/// @brief Contains test functions for all member functions and use cases of the @c ConcurrentMap class.
+/// @{
+
+// Class Header
+#include <concurrentmap.h>
+#include <epoch.h>
+
+// From C++ STL
+#include <atomic>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+namespace
+{
+    /// @brief Counts its own destructions so tests can observe when retired objects are freed.
+    struct Tracked
+    {
+        static std::atomic<int> destroyed;
+
+        ~Tracked()
+        {
+            destroyed.fetch_add(1);
+        }
+    };
+
+    std::atomic<int> Tracked::destroyed{0};
+
+    /// @brief Value whose copies start throwing after a set number of them, and which counts its live instances.
+    struct ThrowingValue
+    {
+        static int live;
+        static int copiesLeft;
+
+        explicit ThrowingValue(int value) : _value(value)
+        {
+            ++live;
+        }
+
+        ThrowingValue(const ThrowingValue &other) : _value(other._value)
+        {
+            _countCopy();
+            ++live;
+        }
+
+        ThrowingValue &operator=(const ThrowingValue &other)
+        {
+            _countCopy();
+            _value = other._value;
+            return *this;
+        }
+
+        ~ThrowingValue()
+        {
+            --live;
+        }
+
+        static void _countCopy()
+        {
+            if (copiesLeft >= 0 && copiesLeft-- == 0)
+            {
+                throw std::runtime_error("copy failed");
+            }
+        }
+
+        int _value;
+    };
+
+    int ThrowingValue::live = 0;
+    int ThrowingValue::copiesLeft = -1;
+}
+
+TEST(EpochManager, test_retireWaitsForPinnedReader)
+{
+    Tracked::destroyed = 0;
+    libdsa::structures::utilities::EpochManager epochs;
+
+    {
+        auto guard = epochs.pin();
+        auto nested = epochs.pin();
+
+        epochs.retire(new Tracked());
+
+        for (int i = 0; i < 5; ++i)
+        {
+            epochs.collect();
+        }
+
+        ASSERT_EQ(Tracked::destroyed, 0);
+        ASSERT_EQ(epochs.pending(), 1);
+    }
+
+    epochs.collect();
+    epochs.collect();
+
+    ASSERT_EQ(Tracked::destroyed, 1);
+    ASSERT_EQ(epochs.pending(), 0);
+}
+
+TEST(EpochManager, test_destructorFreesPending)
+{
+    Tracked::destroyed = 0;
+
+    {
+        libdsa::structures::utilities::EpochManager epochs;
+        epochs.retire(new Tracked());
+        epochs.retire(new Tracked());
+    }
+
+    ASSERT_EQ(Tracked::destroyed, 2);
+}
+
+TEST(EpochManager, test_tooManyThreads)
+{
+    libdsa::structures::utilities::EpochManager epochs(1);
+    auto guard = epochs.pin();
+
+    std::thread other([&]() { ASSERT_THROW(epochs.pin(), std::runtime_error); });
+    other.join();
+}
+
+TEST(ConcurrentMap, test_matchesMap)
+{
+    std::mt19937 generator(37);
+    std::uniform_int_distribution<int> distribution(0, 3000);
+
+    libdsa::structures::tree::ConcurrentMap<int, int> map;
+    std::map<int, int> reference;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        const int key = distribution(generator);
+
+        switch (i % 3)
+        {
+            case 0:
+                ASSERT_EQ(map.Insert(key, i), reference.emplace(key, i).second);
+                break;
+            case 1:
+                ASSERT_EQ(map.InsertOrAssign(key, i), reference.count(key) == 0);
+                reference[key] = i;
+                break;
+            default:
+                ASSERT_EQ(map.Erase(key), reference.erase(key) == 1);
+                break;
+        }
+    }
+
+    ASSERT_EQ(map.Size(), reference.size());
+    ASSERT_LE(map.Height(), 18);
+
+    auto expected = reference.begin();
+
+    map.ForEach([&](const int &key, const int &value) {
+        ASSERT_EQ(key, expected->first);
+        ASSERT_EQ(value, expected->second);
+        ++expected;
+    });
+
+    ASSERT_EQ(expected, reference.end());
+
+    int value = 0;
+
+    for (int key = 0; key <= 3000; ++key)
+    {
+        ASSERT_EQ(map.Contains(key), reference.count(key) == 1);
+        ASSERT_EQ(map.Find(key, value), reference.count(key) == 1);
+    }
+
+    size_t visited = map.RangeScan(100, 200, [](const int &key, const int &) {
+        ASSERT_GE(key, 100);
+        ASSERT_LT(key, 200);
+    });
+
+    ASSERT_EQ(visited, std::distance(reference.lower_bound(100), reference.lower_bound(200)));
+}
+
+TEST(ConcurrentMap, test_readersDuringWrites)
+{
+    libdsa::structures::tree::ConcurrentMap<int, int> map;
+
+    for (int key = 0; key < 1000; key += 2)
+    {
+        map.Insert(key, key * 10);
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+
+    for (int thread = 0; thread < 4; ++thread)
+    {
+        readers.emplace_back([&, thread]() {
+            std::mt19937 generator(thread);
+            std::uniform_int_distribution<int> distribution(0, 999);
+
+            while (!done.load())
+            {
+                // Even keys are never removed, odd keys come and go, and a present value is always key * 10.
+                int key = distribution(generator);
+                int value = -1;
+                bool found = map.Find(key, value);
+
+                if ((key % 2 == 0 && !found) || (found && value != key * 10))
+                {
+                    failures.fetch_add(1);
+                }
+
+                int previous = -1;
+                map.RangeScan(key, key + 50, [&](const int &current, const int &) {
+                    if (current <= previous)
+                    {
+                        failures.fetch_add(1);
+                    }
+
+                    previous = current;
+                });
+            }
+        });
+    }
+
+    for (int round = 0; round < 10; ++round)
+    {
+        for (int key = 1; key < 1000; key += 2)
+        {
+            map.Insert(key, key * 10);
+        }
+
+        for (int key = 1; key < 1000; key += 2)
+        {
+            map.Erase(key);
+        }
+    }
+
+    done = true;
+
+    for (std::thread &reader : readers)
+    {
+        reader.join();
+    }
+
+    ASSERT_EQ(failures, 0);
+    ASSERT_EQ(map.Size(), 500);
+}
+
+TEST(ConcurrentMap, test_throwingCopyLeavesMapIntact)
+{
+    {
+        libdsa::structures::tree::ConcurrentMap<int, ThrowingValue> map;
+        std::map<int, int> reference;
+
+        for (int key = 0; key < 200; key += 2)
+        {
+            map.Insert(key, ThrowingValue(key));
+            reference[key] = key;
+        }
+
+        // Fail each kind of write at each copy along its path.  A write that throws changes nothing.
+        for (int failAt = 0; failAt < 12; ++failAt)
+        {
+            for (int operation = 0; operation < 3; ++operation)
+            {
+                ThrowingValue::copiesLeft = failAt;
+
+                try
+                {
+                    switch (operation)
+                    {
+                        case 0:
+                            map.InsertOrAssign(100, ThrowingValue(1000 + failAt));
+                            reference[100] = 1000 + failAt;
+                            break;
+                        case 1:
+                            map.Insert(2 * failAt + 1, ThrowingValue(failAt));
+                            reference[2 * failAt + 1] = failAt;
+                            break;
+                        default:
+                            map.Erase(4 * failAt);
+                            reference.erase(4 * failAt);
+                            break;
+                    }
+                }
+                catch (const std::runtime_error &)
+                {
+                    // The reference keeps the previous contents too.
+                }
+
+                ThrowingValue::copiesLeft = -1;
+
+                ASSERT_EQ(map.Size(), reference.size());
+                auto expected = reference.begin();
+
+                map.ForEach([&](const int &key, const ThrowingValue &value) {
+                    ASSERT_EQ(key, expected->first);
+                    ASSERT_EQ(value._value, expected->second);
+                    ++expected;
+                });
+
+                ASSERT_EQ(expected, reference.end());
+            }
+        }
+    }
+
+    // Every copy made by a failed write was freed along with the map.
+    ASSERT_EQ(ThrowingValue::live, 0);
+}
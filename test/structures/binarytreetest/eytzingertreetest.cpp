@@ -0,0 +1,121 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file eytzingertreetest
+/// @brief Contains test functions for all member functions and use cases of the @c EytzingerTree class.
+/// @{
+
+// Class Header
+#include <eytzingertree.h>
+
+// From C++ STL
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+TEST(EytzingerTree, test_emptyConstructor)
+{
+    auto tree = libdsa::structures::tree::EytzingerTree<int>();
+
+    ASSERT_EQ(tree.Size(), 0);
+    ASSERT_EQ(tree.LowerBound(5), nullptr);
+    ASSERT_FALSE(tree.Contains(5));
+    ASSERT_EQ(tree.FindMany(std::vector<int>{1, 2, 3}), std::vector<const int *>(3, nullptr));
+}
+
+TEST(EytzingerTree, test_arrayConstructor)
+{
+    std::array<int, 5> valid = {9, 3, 7, 1, 5};
+    std::array<uint8_t, 2> invalid = {1, 2};
+
+    auto tree = libdsa::structures::tree::EytzingerTree<int>(valid);
+
+    ASSERT_EQ(tree.Size(), 5);
+    ASSERT_TRUE(tree.Contains(7));
+    ASSERT_FALSE(tree.Contains(4));
+    ASSERT_THROW(auto bad = libdsa::structures::tree::EytzingerTree<int>(invalid), std::runtime_error);
+}
+
+TEST(EytzingerTree, test_vectorConstructor)
+{
+    std::vector<long> valid = {4, 2, 8};
+    std::vector<int> invalid = {1, 2};
+
+    ASSERT_NO_THROW(auto tree = libdsa::structures::tree::EytzingerTree<long>(valid));
+    ASSERT_THROW(auto tree = libdsa::structures::tree::EytzingerTree<long>(invalid), std::runtime_error);
+}
+
+TEST(EytzingerTree, test_lowerBoundMatchesSortedSearch)
+{
+    // Every size up to a few full levels covers both complete and partial bottom rows.
+    for (int size = 1; size <= 70; ++size)
+    {
+        std::vector<int> keys;
+
+        for (int i = 0; i < size; ++i)
+        {
+            keys.push_back(2 * i + 1);
+        }
+
+        auto tree = libdsa::structures::tree::EytzingerTree<int>(keys);
+
+        for (int probe = 0; probe <= 2 * size + 1; ++probe)
+        {
+            auto expected = std::lower_bound(keys.begin(), keys.end(), probe);
+            const int *found = tree.LowerBound(probe);
+
+            if (expected == keys.end())
+            {
+                ASSERT_EQ(found, nullptr);
+            }
+            else
+            {
+                ASSERT_NE(found, nullptr);
+                ASSERT_EQ(*found, *expected);
+            }
+
+            ASSERT_EQ(tree.Contains(probe), probe % 2 == 1 && probe < 2 * size);
+        }
+    }
+}
+
+TEST(EytzingerTree, test_duplicatesAndComparator)
+{
+    std::vector<int> keys = {5, 1, 5, 3, 5, 9};
+
+    auto tree = libdsa::structures::tree::EytzingerTree<int, std::greater<int>>(keys);
+
+    ASSERT_EQ(tree.Size(), 6);
+    ASSERT_EQ(*tree.LowerBound(6), 5);
+    ASSERT_EQ(*tree.LowerBound(2), 1);
+    ASSERT_EQ(tree.LowerBound(0), nullptr);
+    ASSERT_EQ(*tree.LowerBound(100), 9);
+}
+
+TEST(EytzingerTree, test_findManyMatchesLowerBound)
+{
+    std::mt19937 generator(34);
+    std::uniform_int_distribution<int> distribution(0, 1 << 20);
+
+    std::vector<int> keys(10000);
+    std::generate(keys.begin(), keys.end(), [&]() { return distribution(generator); });
+
+    std::vector<int> queries(1237);
+    std::generate(queries.begin(), queries.end(), [&]() { return distribution(generator); });
+    queries.push_back(1 << 21);
+
+    auto tree = libdsa::structures::tree::EytzingerTree<int>(keys);
+    std::vector<const int *> results = tree.FindMany(queries);
+
+    ASSERT_EQ(results.size(), queries.size());
+
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        ASSERT_EQ(results[i], tree.LowerBound(queries[i]));
+    }
+
+    ASSERT_EQ(results.back(), nullptr);
+}
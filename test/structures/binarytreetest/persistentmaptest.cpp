@@ -0,0 +1,208 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file persistentmaptest
+/// @brief Contains test functions for all member functions and use cases of the @c PersistentMap class.
+/// @{
+
+// Class Header
+#include <persistentmap.h>
+
+// From C++ STL
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+namespace
+{
+    /// @brief Value that counts how often it is copied and how many instances are alive.
+    struct Counted
+    {
+        static int copies;
+        static int alive;
+
+        int _value;
+
+        Counted(int value) : _value(value)
+        {
+            ++alive;
+        }
+
+        Counted(const Counted &other) : _value(other._value)
+        {
+            ++copies;
+            ++alive;
+        }
+
+        ~Counted()
+        {
+            --alive;
+        }
+    };
+
+    int Counted::copies = 0;
+    int Counted::alive = 0;
+}
+
+using Map = libdsa::structures::tree::PersistentMap<int, int>;
+
+TEST(PersistentMap, test_emptyMap)
+{
+    Map map;
+
+    ASSERT_TRUE(map.Empty());
+    ASSERT_EQ(map.Height(), 0);
+    ASSERT_EQ(map.Find(1), nullptr);
+    ASSERT_EQ(map.Erase(1).Size(), 0);
+}
+
+TEST(PersistentMap, test_versionsAreIndependent)
+{
+    Map empty;
+    Map one = empty.Set(1, 10);
+    Map two = one.Set(2, 20);
+    Map replaced = two.Set(1, 11);
+    Map erased = replaced.Erase(2);
+
+    ASSERT_EQ(empty.Size(), 0);
+    ASSERT_EQ(one.Size(), 1);
+    ASSERT_EQ(two.Size(), 2);
+    ASSERT_EQ(replaced.Size(), 2);
+    ASSERT_EQ(erased.Size(), 1);
+
+    ASSERT_EQ(*two.Find(1), 10);
+    ASSERT_EQ(*replaced.Find(1), 11);
+    ASSERT_TRUE(replaced.Contains(2));
+    ASSERT_FALSE(erased.Contains(2));
+    ASSERT_FALSE(one.Contains(2));
+}
+
+TEST(PersistentMap, test_matchesMapAcrossSnapshots)
+{
+    std::mt19937 generator(39);
+    std::uniform_int_distribution<int> distribution(0, 2000);
+
+    Map map;
+    std::map<int, int> reference;
+
+    std::vector<Map> snapshots;
+    std::vector<std::map<int, int>> expected;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        const int key = distribution(generator);
+
+        if (i % 3 == 2)
+        {
+            map = map.Erase(key);
+            reference.erase(key);
+        }
+        else
+        {
+            map = map.Set(key, i);
+            reference[key] = i;
+        }
+
+        if (i % 1000 == 0)
+        {
+            snapshots.push_back(map);
+            expected.push_back(reference);
+        }
+    }
+
+    snapshots.push_back(map);
+    expected.push_back(reference);
+
+    ASSERT_LE(map.Height(), 16);
+
+    for (size_t i = 0; i < snapshots.size(); ++i)
+    {
+        ASSERT_EQ(snapshots[i].Size(), expected[i].size());
+
+        auto it = expected[i].begin();
+
+        snapshots[i].ForEach([&](const int &key, const int &value) {
+            ASSERT_EQ(key, it->first);
+            ASSERT_EQ(value, it->second);
+            ++it;
+        });
+
+        ASSERT_EQ(it, expected[i].end());
+    }
+}
+
+TEST(PersistentMap, test_updatesShareStructure)
+{
+    Counted::copies = 0;
+    Counted::alive = 0;
+
+    {
+        libdsa::structures::tree::PersistentMap<int, Counted> map;
+
+        for (int i = 0; i < 1024; ++i)
+        {
+            map = map.Set(i, Counted(i));
+        }
+
+        const int height = map.Height();
+        std::vector<libdsa::structures::tree::PersistentMap<int, Counted>> versions;
+
+        Counted::copies = 0;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            versions.push_back(map);
+        }
+
+        // Snapshots copy nothing, and an update copies a bounded number of nodes on one path.
+        ASSERT_EQ(Counted::copies, 0);
+
+        auto updated = map.Set(512, Counted(-1));
+        ASSERT_LE(Counted::copies, 2 * height + 2);
+        ASSERT_EQ(updated.Find(512)->_value, -1);
+        ASSERT_EQ(versions.back().Find(512)->_value, 512);
+
+        // Keeping both versions costs only the copied path.
+        ASSERT_LE(Counted::alive, 1024 + 2 * height + 2);
+    }
+
+    ASSERT_EQ(Counted::alive, 0);
+}
+
+TEST(PersistentMap, test_snapshotsAcrossThreads)
+{
+    Map map;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        map = map.Set(i, i);
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(4, 0);
+
+    for (int thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back([&, thread, snapshot = map]() mutable {
+            // Each thread derives its own versions while sharing nodes with the others.
+            for (int i = 0; i < 500; ++i)
+            {
+                snapshot = snapshot.Erase(thread * 500 + i);
+            }
+
+            failures[thread] = snapshot.Size() == 1500 && !snapshot.Contains(thread * 500) ? 0 : 1;
+        });
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(failures, std::vector<int>(4, 0));
+    ASSERT_EQ(map.Size(), 2000);
+}
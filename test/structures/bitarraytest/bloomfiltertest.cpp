@@ -0,0 +1,142 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file bloomfiltertest
+/// @brief Contains test functions for all member functions and use cases of @c BloomFilter and
+///        @c CountingBloomFilter.
+
+// Source Class Header
+#include <bloomfilter.h>
+
+// From C++ STL
+#include <string>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+TEST(BloomFilter, testNoFalseNegatives)
+{
+    libdsa::structures::BloomFilter<uint64_t> filter(10000, 0.01);
+
+    for (uint64_t i = 0; i < 10000; ++i)
+    {
+        filter.insert(i * 7919);
+    }
+
+    for (uint64_t i = 0; i < 10000; ++i)
+    {
+        ASSERT_TRUE(filter.contains(i * 7919));
+    }
+}
+
+TEST(BloomFilter, testFalsePositiveRate)
+{
+    libdsa::structures::BloomFilter<uint64_t> filter(20000, 0.01);
+
+    for (uint64_t i = 0; i < 20000; ++i)
+    {
+        filter.insert(i);
+    }
+
+    size_t falsePositives = 0;
+    for (uint64_t i = 1000000; i < 1100000; ++i)
+    {
+        falsePositives += filter.contains(i) ? 1 : 0;
+    }
+
+    // Blocking costs a little accuracy, so allow up to twice the requested rate.
+    ASSERT_LT(falsePositives, 2000U);
+    ASSERT_LT(filter.estimatedFalsePositiveRate(), 0.02);
+}
+
+TEST(BloomFilter, testBatchMatchesSingle)
+{
+    libdsa::structures::BloomFilter<std::string> batched(1000, 0.01);
+    libdsa::structures::BloomFilter<std::string> single(1000, 0.01);
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < 500; ++i)
+    {
+        keys.push_back("key-" + std::to_string(i));
+        single.insert(keys.back());
+    }
+
+    batched.insert(keys);
+
+    std::vector<std::string> queries;
+    for (int i = 0; i < 1000; ++i)
+    {
+        queries.push_back("key-" + std::to_string(i));
+    }
+
+    std::vector<bool> answers = batched.contains(queries);
+
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        ASSERT_EQ(single.contains(queries[i]), answers[i]);
+    }
+}
+
+TEST(BloomFilter, testUnion)
+{
+    auto left = libdsa::structures::BloomFilter<int>::fromBlocks(64, 4);
+    auto right = libdsa::structures::BloomFilter<int>::fromBlocks(64, 4);
+
+    left.insert(1);
+    right.insert(2);
+    left.unionWith(right);
+
+    ASSERT_TRUE(left.contains(1));
+    ASSERT_TRUE(left.contains(2));
+
+    auto mismatched = libdsa::structures::BloomFilter<int>::fromBlocks(32, 4);
+    ASSERT_THROW(left.unionWith(mismatched), std::runtime_error);
+}
+
+TEST(BloomFilter, testInvalidParameters)
+{
+    ASSERT_THROW((libdsa::structures::BloomFilter<int>(0, 0.01)), std::invalid_argument);
+    ASSERT_THROW((libdsa::structures::BloomFilter<int>(100, 1.5)), std::invalid_argument);
+    ASSERT_THROW(libdsa::structures::BloomFilter<int>::fromBlocks(8, 0), std::invalid_argument);
+
+    // Two integers select the sizing constructor, whose rate must lie below one.
+    ASSERT_THROW((libdsa::structures::BloomFilter<int>(1000, 3)), std::invalid_argument);
+}
+
+TEST(CountingBloomFilter, testInsertRemove)
+{
+    libdsa::structures::CountingBloomFilter<uint64_t> filter(1000, 0.01);
+
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        filter.insert(i);
+    }
+
+    for (uint64_t i = 0; i < 500; ++i)
+    {
+        ASSERT_TRUE(filter.remove(i));
+    }
+
+    // Remaining keys must still be found.
+    for (uint64_t i = 500; i < 1000; ++i)
+    {
+        ASSERT_TRUE(filter.contains(i));
+    }
+
+    // Most removed keys should now be reported absent.
+    size_t stillPresent = 0;
+    for (uint64_t i = 0; i < 500; ++i)
+    {
+        stillPresent += filter.contains(i) ? 1 : 0;
+    }
+
+    ASSERT_LT(stillPresent, 25U);
+}
+
+TEST(CountingBloomFilter, testRemoveAbsentKey)
+{
+    libdsa::structures::CountingBloomFilter<uint64_t> filter(100, 0.01);
+
+    filter.insert(1);
+    ASSERT_FALSE(filter.remove(2));
+    ASSERT_TRUE(filter.contains(1));
+}
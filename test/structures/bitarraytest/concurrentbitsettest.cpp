@@ -0,0 +1,120 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file concurrentbitsettest
+/// @brief Contains test functions for all member functions and use cases of @c ConcurrentBitSet.
+
+// Source Class Header
+#include <concurrentbitset.h>
+
+// From C++ STL
+#include <algorithm>
+#include <thread>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+TEST(ConcurrentBitSet, testSingleBitOperations)
+{
+    libdsa::structures::ConcurrentBitSet set(100);
+
+    ASSERT_FALSE(set.testAndSet(42));
+    ASSERT_TRUE(set.testAndSet(42));
+    ASSERT_TRUE(set.test(42));
+
+    ASSERT_TRUE(set.clear(42));
+    ASSERT_FALSE(set.clear(42));
+    ASSERT_FALSE(set.test(42));
+}
+
+TEST(ConcurrentBitSet, testWordOperations)
+{
+    libdsa::structures::ConcurrentBitSet set(70);
+
+    ASSERT_EQ(0U, set.fetchOrWord(0, 0xF0));
+    ASSERT_EQ(0xF0U, set.fetchAndWord(0, 0x30));
+    ASSERT_EQ(0x30U, set.loadWord(0));
+
+    // Bits past the end of the set are never set.
+    set.fetchOrWord(1, ~uint64_t(0));
+    ASSERT_EQ(0x3FU, set.loadWord(1));
+    ASSERT_EQ(8U, set.count());
+}
+
+TEST(ConcurrentBitSet, testClaimUntilFull)
+{
+    libdsa::structures::ConcurrentBitSet set(130);
+
+    for (size_t i = 0; i < 130; ++i)
+    {
+        ASSERT_NE(130U, set.claimFirstFree());
+    }
+
+    ASSERT_EQ(130U, set.claimFirstFree());
+
+    set.clear(77);
+    ASSERT_EQ(77U, set.claimFirstFree());
+}
+
+TEST(ConcurrentBitSet, testConcurrentClaimsAreUnique)
+{
+    constexpr size_t threadCount = 8;
+    constexpr size_t perThread = 2000;
+    libdsa::structures::ConcurrentBitSet set(threadCount * perThread);
+
+    std::vector<std::vector<size_t>> claimed(threadCount);
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < threadCount; ++t)
+    {
+        threads.emplace_back([&set, &claimed, t]()
+        {
+            for (size_t i = 0; i < perThread; ++i)
+            {
+                claimed[t].push_back(set.claimFirstFree());
+            }
+        });
+    }
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<size_t> all;
+    for (const std::vector<size_t> &slots : claimed)
+    {
+        all.insert(all.end(), slots.begin(), slots.end());
+    }
+
+    std::sort(all.begin(), all.end());
+
+    // Every slot was handed out exactly once.
+    for (size_t i = 0; i < all.size(); ++i)
+    {
+        ASSERT_EQ(i, all[i]);
+    }
+
+    ASSERT_EQ(set.size(), set.count());
+}
+
+TEST(ConcurrentBitSet, testHintsBelongToEachSet)
+{
+    constexpr size_t wordCount = 100;
+    libdsa::structures::ConcurrentBitSet first(wordCount * 64);
+    libdsa::structures::ConcurrentBitSet busy(wordCount * 64);
+    libdsa::structures::ConcurrentBitSet second(wordCount * 64);
+
+    const size_t start = first.claimFirstFree();
+
+    // Filling every word but the last drags this thread's hint in the busy set to the end.
+    for (size_t word = 0; word + 1 < wordCount; ++word)
+    {
+        busy.fetchOrWord(word, ~uint64_t(0));
+    }
+
+    ASSERT_EQ((wordCount - 1) * 64, busy.claimFirstFree());
+
+    // A set's first claim is not steered by claims made in other sets.
+    ASSERT_EQ(start, second.claimFirstFree());
+    ASSERT_EQ(start + 1, first.claimFirstFree());
+}
@@ -0,0 +1,234 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file ewahtest
+/// @brief Contains test functions for all member functions and use cases of @c EwahEncoder, @c EwahDecoder and
+///        @c EwahBitmap.
+
+// Source Class Header
+#include <ewah.h>
+
+// From C++ STL
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+namespace
+{
+    /// @brief Builds a bit array made of long empty and full stretches separated by a few noisy words.
+    libdsa::structures::BitVector clusteredBits(size_t size, uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        libdsa::structures::BitVector bitVector(size);
+
+        size_t position = 0;
+        while (position < size)
+        {
+            const size_t length = std::min<size_t>(size - position, 64 * (1 + rng() % 200));
+            const int kind = static_cast<int>(rng() % 3);
+
+            for (size_t i = position; i < position + length; ++i)
+            {
+                if (kind == 1 || (kind == 2 && rng() % 4 == 0))
+                {
+                    bitVector.set(i);
+                }
+            }
+
+            position += length;
+        }
+
+        return bitVector;
+    }
+
+    /// @brief Serializes a hand-made stream of @p words claiming to hold @p bitCount bits.
+    std::stringstream serialized(uint64_t bitCount, const std::vector<uint64_t> &words)
+    {
+        std::stringstream stream;
+        const uint32_t header[2] = {libdsa::structures::ewah::MAGIC, libdsa::structures::ewah::VERSION};
+        const uint64_t streamLength = words.size();
+
+        stream.write(reinterpret_cast<const char *>(header), sizeof(header));
+        stream.write(reinterpret_cast<const char *>(&bitCount), sizeof(bitCount));
+        stream.write(reinterpret_cast<const char *>(&streamLength), sizeof(streamLength));
+        stream.write(reinterpret_cast<const char *>(words.data()),
+                     static_cast<std::streamsize>(words.size() * sizeof(uint64_t)));
+        return stream;
+    }
+}
+
+TEST(EwahBitmap, testRoundTrip)
+{
+    libdsa::structures::BitVector bitVector = clusteredBits(100003, 1);
+    libdsa::structures::EwahBitmap compressed = libdsa::structures::EwahBitmap::encode(bitVector);
+
+    ASSERT_EQ(bitVector.size(), compressed.size());
+    ASSERT_EQ(bitVector.count(), compressed.count());
+    ASSERT_EQ(bitVector, compressed.decode());
+}
+
+TEST(EwahBitmap, testCompressesEmptyAndFull)
+{
+    libdsa::structures::BitVector empty(1 << 20);
+    libdsa::structures::BitVector full(1 << 20, true);
+
+    libdsa::structures::EwahBitmap emptyCompressed = libdsa::structures::EwahBitmap::encode(empty);
+    libdsa::structures::EwahBitmap fullCompressed = libdsa::structures::EwahBitmap::encode(full);
+
+    // A single marker word describes the whole array.
+    ASSERT_EQ(1U, emptyCompressed.stream().size());
+    ASSERT_EQ(1U, fullCompressed.stream().size());
+    ASSERT_EQ(size_t(1 << 20), fullCompressed.count());
+    ASSERT_EQ(full, fullCompressed.decode());
+}
+
+TEST(EwahBitmap, testStreamingEncodeDecode)
+{
+    libdsa::structures::EwahEncoder encoder;
+
+    encoder.addRun(false, 10);
+    encoder.addWord(0x1234);
+    encoder.addWord(~uint64_t(0));
+    encoder.addRun(true, 5);
+
+    libdsa::structures::EwahBitmap compressed = encoder.finish(17 * 64);
+    libdsa::structures::EwahDecoder decoder = compressed.decoder();
+
+    std::vector<uint64_t> words;
+    uint64_t word;
+    while (decoder.next(word))
+    {
+        words.push_back(word);
+    }
+
+    ASSERT_EQ(17U, words.size());
+    ASSERT_EQ(0U, words[9]);
+    ASSERT_EQ(0x1234U, words[10]);
+    ASSERT_EQ(~uint64_t(0), words[11]);
+    ASSERT_EQ(~uint64_t(0), words[16]);
+
+    libdsa::structures::EwahEncoder mismatched;
+    mismatched.addRun(false, 2);
+    ASSERT_THROW(mismatched.finish(10), std::runtime_error);
+}
+
+TEST(EwahBitmap, testCompressedOperations)
+{
+    const libdsa::structures::BitVector left = clusteredBits(200000, 2);
+    const libdsa::structures::BitVector right = clusteredBits(200000, 3);
+
+    const libdsa::structures::EwahBitmap a = libdsa::structures::EwahBitmap::encode(left);
+    const libdsa::structures::EwahBitmap b = libdsa::structures::EwahBitmap::encode(right);
+
+    libdsa::structures::BitVector expected = left;
+    expected &= right;
+    ASSERT_EQ(expected, a.AND(b).decode());
+    ASSERT_EQ(libdsa::structures::EwahBitmap::encode(expected), a.AND(b));
+
+    expected = left;
+    expected |= right;
+    ASSERT_EQ(expected, a.OR(b).decode());
+
+    expected = left;
+    expected ^= right;
+    ASSERT_EQ(expected, a.XOR(b).decode());
+
+    // Difference in both directions so the run may be on either side.
+    for (int direction = 0; direction < 2; ++direction)
+    {
+        const libdsa::structures::BitVector &first = direction == 0 ? left : right;
+        const libdsa::structures::BitVector &second = direction == 0 ? right : left;
+
+        expected = second;
+        expected ^= libdsa::structures::BitVector(second.size(), true);
+        expected &= first;
+
+        ASSERT_EQ(expected, (direction == 0 ? a.difference(b) : b.difference(a)).decode());
+    }
+
+    ASSERT_THROW(a.AND(libdsa::structures::EwahBitmap::encode(libdsa::structures::BitVector(10))),
+                 std::runtime_error);
+}
+
+TEST(EwahBitmap, testSerialization)
+{
+    libdsa::structures::EwahBitmap compressed = libdsa::structures::EwahBitmap::encode(clusteredBits(5000, 4));
+
+    std::stringstream buffer;
+    compressed.serialize(buffer);
+
+    ASSERT_EQ(compressed, libdsa::structures::EwahBitmap::deserialize(buffer));
+
+    std::stringstream garbage("not a bitmap at all, definitely not");
+    ASSERT_THROW(libdsa::structures::EwahBitmap::deserialize(garbage), std::runtime_error);
+
+    // Truncated payload.
+    std::string truncated;
+    {
+        std::stringstream whole;
+        compressed.serialize(whole);
+        truncated = whole.str().substr(0, whole.str().size() - 8);
+    }
+    std::stringstream shortStream(truncated);
+    ASSERT_THROW(libdsa::structures::EwahBitmap::deserialize(shortStream), std::runtime_error);
+
+    // A stream length far past the end of the input is rejected rather than allocated.
+    std::string oversized;
+    {
+        std::stringstream whole;
+        compressed.serialize(whole);
+        oversized = whole.str();
+        const uint64_t streamLength = uint64_t(1) << 60;
+        oversized.replace(16, sizeof(streamLength), reinterpret_cast<const char *>(&streamLength),
+                          sizeof(streamLength));
+    }
+    std::stringstream oversizedStream(oversized);
+    ASSERT_THROW(libdsa::structures::EwahBitmap::deserialize(oversizedStream), std::runtime_error);
+
+    // Likewise from a stream that cannot seek, which is read only as far as it goes.
+    std::stringbuf unseekable(oversized);
+    struct ForwardOnly : std::streambuf
+    {
+        explicit ForwardOnly(std::streambuf &source) : _source(source) {}
+        int_type underflow() override { return _source.sgetc(); }
+        int_type uflow() override { return _source.sbumpc(); }
+        std::streambuf &_source;
+    } forwardOnly(unseekable);
+    std::istream forwardStream(&forwardOnly);
+    ASSERT_THROW(libdsa::structures::EwahBitmap::deserialize(forwardStream), std::runtime_error);
+}
+
+TEST(EwahBitmap, testMalformedStreamsAreRejected)
+{
+    using libdsa::structures::EwahBitmap;
+    using libdsa::structures::ewah::makeMarker;
+
+    // A well formed stream of 100 bits: one literal word, then a clean run of one zero word.
+    std::stringstream valid = serialized(100, {makeMarker(false, 0, 1), 0x5, makeMarker(false, 1, 0)});
+    ASSERT_EQ(EwahBitmap::deserialize(valid).decode().count(), 2);
+
+    // A bit count whose word count would wrap around to nothing.
+    std::stringstream hugeCount = serialized(SIZE_MAX - 10, {makeMarker(false, 0, 0)});
+    ASSERT_THROW(EwahBitmap::deserialize(hugeCount), std::runtime_error);
+
+    // Markers describing fewer or more words than the bit count needs, however many more.
+    std::stringstream tooFew = serialized(200, {makeMarker(true, 2, 0)});
+    ASSERT_THROW(EwahBitmap::deserialize(tooFew), std::runtime_error);
+
+    std::stringstream tooMany = serialized(64, {makeMarker(false, 1, 1), 0x1});
+    ASSERT_THROW(EwahBitmap::deserialize(tooMany), std::runtime_error);
+
+    std::vector<uint64_t> runs(1 << 12, makeMarker(true, libdsa::structures::ewah::MAX_RUN_LENGTH, 0));
+    std::stringstream farTooMany = serialized(128, runs);
+    ASSERT_THROW(EwahBitmap::deserialize(farTooMany), std::runtime_error);
+
+    // Set bits past the bit count, from the final literal or from a run of ones.
+    std::stringstream pastLiteral = serialized(100, {makeMarker(false, 1, 1), uint64_t(1) << 40});
+    ASSERT_THROW(EwahBitmap::deserialize(pastLiteral), std::runtime_error);
+
+    std::stringstream pastRun = serialized(100, {makeMarker(true, 2, 0)});
+    ASSERT_THROW(EwahBitmap::deserialize(pastRun), std::runtime_error);
+}
@@ -0,0 +1,137 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file mappedbitarraytest
+/// @brief Contains test functions for all member functions and use cases of @c MappedBitArray.
+
+// Source Class Header
+#include <mappedbitarray.h>
+
+// From C++ STL
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+namespace
+{
+    /// @brief Builds a unique file path in the temporary directory for one test.
+    std::string temporaryPath(const std::string &name)
+    {
+        return ::testing::TempDir() + "libdsa_" + name + "_" + std::to_string(::getpid()) + ".bits";
+    }
+}
+
+TEST(MappedBitArray, testCreateAndReopen)
+{
+    const std::string path = temporaryPath("reopen");
+
+    {
+        libdsa::structures::MappedBitArray bits = libdsa::structures::MappedBitArray::create(path, 1000);
+        bits.set(3);
+        bits.set(999);
+        bits.sync();
+    }
+
+    libdsa::structures::MappedBitArray bits = libdsa::structures::MappedBitArray::open(path);
+
+    ASSERT_EQ(1000U, bits.size());
+    ASSERT_TRUE(bits.test(3));
+    ASSERT_TRUE(bits.test(999));
+    ASSERT_FALSE(bits.test(4));
+    ASSERT_EQ(2U, bits.count());
+    ASSERT_FALSE(bits.writable());
+    ASSERT_THROW(bits.set(5), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+TEST(MappedBitArray, testOpenInvalidFile)
+{
+    const std::string path = temporaryPath("invalid");
+
+    {
+        std::ofstream file(path);
+        file << std::string(128, 'x');
+    }
+
+    ASSERT_THROW(libdsa::structures::MappedBitArray::open(path), std::runtime_error);
+    ASSERT_THROW(libdsa::structures::MappedBitArray::open(temporaryPath("missing")), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+TEST(MappedBitArray, testOpenRejectsOverflowingBitCount)
+{
+    const std::string path = temporaryPath("overflow");
+
+    // A bit count near the top of the range would round up to zero words and pass the size check.
+    {
+        libdsa::structures::mapped::Header header{};
+        header.magic = libdsa::structures::mapped::MAGIC;
+        header.version = libdsa::structures::mapped::VERSION;
+        header.bitCount = UINT64_MAX;
+        header.wordCount = 0;
+
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+
+    ASSERT_THROW(libdsa::structures::MappedBitArray::open(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+TEST(MappedBitArray, testParallelOperations)
+{
+    constexpr size_t size = 1000003;
+    std::mt19937_64 rng(7);
+    libdsa::structures::BitVector left(size);
+    libdsa::structures::BitVector right(size);
+
+    for (size_t i = 0; i < left.wordCount(); ++i)
+    {
+        left.words()[i] = rng();
+        right.words()[i] = rng();
+    }
+
+    // Keep the tail of the final word clear as BitVector expects.
+    left.resize(size);
+    right.resize(size);
+
+    const std::string leftPath = temporaryPath("left");
+    const std::string rightPath = temporaryPath("right");
+    const std::string outputPath = temporaryPath("output");
+
+    libdsa::structures::MappedBitArray a = libdsa::structures::MappedBitArray::create(leftPath, left);
+    libdsa::structures::MappedBitArray b = libdsa::structures::MappedBitArray::create(rightPath, right);
+    libdsa::structures::MappedBitArray output = libdsa::structures::MappedBitArray::create(outputPath, size);
+
+    libdsa::common::ThreadPool pool(4);
+
+    libdsa::structures::BitVector expected = left;
+    expected &= right;
+    output.assign(libdsa::structures::mapped::Operation::AND, a, b, pool);
+    ASSERT_EQ(0, std::memcmp(expected.words(), output.words(), expected.wordCount() * sizeof(uint64_t)));
+    ASSERT_EQ(expected.count(), output.count(pool));
+
+    expected = left;
+    expected ^= right;
+    output.assign(libdsa::structures::mapped::Operation::XOR, a, b, pool);
+    ASSERT_EQ(0, std::memcmp(expected.words(), output.words(), expected.wordCount() * sizeof(uint64_t)));
+
+    // The output may alias an operand.
+    expected = left;
+    expected |= right;
+    a.assign(libdsa::structures::mapped::Operation::OR, a, b, pool);
+    ASSERT_EQ(0, std::memcmp(expected.words(), a.words(), expected.wordCount() * sizeof(uint64_t)));
+
+    libdsa::structures::MappedBitArray small = libdsa::structures::MappedBitArray::create(outputPath + "2", 10);
+    ASSERT_THROW(small.assign(libdsa::structures::mapped::Operation::AND, a, b, pool), std::runtime_error);
+
+    for (const std::string &path : {leftPath, rightPath, outputPath, outputPath + "2"})
+    {
+        std::remove(path.c_str());
+    }
+}
@@ -0,0 +1,170 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file rankselecttest
+/// @brief Contains test functions for all member functions and use cases of @c BitVector and @c RankSelect.
+
+// Source Class Headers
+#include <bitvector.h>
+#include <rankselect.h>
+
+// From C++ STL
+#include <cstdint>
+#include <random>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+TEST(BitVector, testConstructFromBoolVector)
+{
+    std::vector<bool> set{true, false, true, true, false};
+
+    libdsa::structures::BitVector bitVector(set);
+
+    ASSERT_EQ(5U, bitVector.size());
+    ASSERT_EQ(3U, bitVector.count());
+    ASSERT_EQ(set, bitVector.toVector());
+}
+
+TEST(BitVector, testFilledConstructorClearsTail)
+{
+    libdsa::structures::BitVector bitVector(70, true);
+
+    ASSERT_EQ(2U, bitVector.wordCount());
+    ASSERT_EQ(70U, bitVector.count());
+    ASSERT_EQ(0x3FU, bitVector.words()[1]);
+}
+
+TEST(BitVector, testLogicalOperations)
+{
+    libdsa::structures::BitVector s1(std::vector<bool>{true, false, true});
+    libdsa::structures::BitVector s2(std::vector<bool>{true, true, false});
+
+    libdsa::structures::BitVector result = s1;
+    result &= s2;
+    ASSERT_EQ((std::vector<bool>{true, false, false}), result.toVector());
+
+    result = s1;
+    result |= s2;
+    ASSERT_EQ((std::vector<bool>{true, true, true}), result.toVector());
+
+    result = s1;
+    result ^= s2;
+    ASSERT_EQ((std::vector<bool>{false, true, true}), result.toVector());
+}
+
+TEST(BitVector, testLogicalOperationInvalidSize)
+{
+    libdsa::structures::BitVector s1(3);
+    libdsa::structures::BitVector s2(4);
+
+    ASSERT_THROW(s1 &= s2, std::runtime_error);
+}
+
+TEST(BitVector, testFindFirstAndNext)
+{
+    libdsa::structures::BitVector bitVector(300);
+
+    ASSERT_EQ(300U, bitVector.findFirst());
+
+    bitVector.set(5);
+    bitVector.set(64);
+    bitVector.set(299);
+
+    ASSERT_EQ(5U, bitVector.findFirst());
+    ASSERT_EQ(64U, bitVector.findNext(5));
+    ASSERT_EQ(64U, bitVector.findNext(6));
+    ASSERT_EQ(299U, bitVector.findNext(64));
+    ASSERT_EQ(300U, bitVector.findNext(299));
+    ASSERT_EQ(300U, bitVector.findNext(1000));
+
+    // Searching after the largest position must not wrap around to bit 0.
+    bitVector.set(0);
+    ASSERT_EQ(300U, bitVector.findNext(SIZE_MAX));
+}
+
+TEST(BitVector, testSetBitIteration)
+{
+    libdsa::structures::BitVector bitVector(1000);
+    std::vector<size_t> expected{0, 63, 64, 127, 500, 999};
+
+    for (size_t position : expected)
+    {
+        bitVector.set(position);
+    }
+
+    std::vector<size_t> visited;
+    bitVector.forEachSetBit([&visited](size_t position) { visited.push_back(position); });
+    ASSERT_EQ(expected, visited);
+
+    visited.clear();
+    for (size_t position : bitVector.setBits())
+    {
+        visited.push_back(position);
+    }
+    ASSERT_EQ(expected, visited);
+
+    libdsa::structures::BitVector empty(128);
+    ASSERT_TRUE(empty.setBits().begin() == empty.setBits().end());
+}
+
+TEST(RankSelect, testRankAndSelectSmall)
+{
+    // Binary: 0110 1001
+    libdsa::structures::BitVector bitVector(std::vector<bool>{false, true, true, false, true, false, false, true});
+    libdsa::structures::RankSelect index(bitVector);
+
+    ASSERT_EQ(4U, index.count());
+    ASSERT_EQ(0U, index.rank1(0));
+    ASSERT_EQ(0U, index.rank1(1));
+    ASSERT_EQ(2U, index.rank1(3));
+    ASSERT_EQ(4U, index.rank1(8));
+    ASSERT_EQ(4U, index.rank0(8));
+
+    ASSERT_EQ(1U, index.select1(0));
+    ASSERT_EQ(2U, index.select1(1));
+    ASSERT_EQ(4U, index.select1(2));
+    ASSERT_EQ(7U, index.select1(3));
+}
+
+TEST(RankSelect, testOutOfRange)
+{
+    libdsa::structures::BitVector bitVector(10);
+    libdsa::structures::RankSelect index(bitVector);
+
+    ASSERT_THROW(index.rank1(11), std::out_of_range);
+    ASSERT_THROW(index.select1(0), std::out_of_range);
+}
+
+TEST(RankSelect, testRandomAgainstLinearScan)
+{
+    std::mt19937_64 rng(42);
+    libdsa::structures::BitVector bitVector(200000);
+
+    // Mix sparse and dense regions so both the sampled and unsampled select paths are exercised.
+    for (size_t i = 0; i < bitVector.size(); ++i)
+    {
+        const uint64_t threshold = (i / 50000) % 2 == 0 ? 5 : 90;
+        if (rng() % 100 < threshold)
+        {
+            bitVector.set(i);
+        }
+    }
+
+    libdsa::structures::RankSelect index(bitVector);
+    ASSERT_EQ(bitVector.count(), index.count());
+
+    size_t ones = 0;
+    for (size_t i = 0; i < bitVector.size(); ++i)
+    {
+        ASSERT_EQ(ones, index.rank1(i));
+
+        if (bitVector.test(i))
+        {
+            ASSERT_EQ(i, index.select1(ones));
+            ++ones;
+        }
+    }
+
+    // The index must stay within a few percent of the bit array itself.
+    ASSERT_LT(index.indexBytes() * 100, bitVector.wordCount() * sizeof(uint64_t) * 6);
+}
@@ -0,0 +1,265 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file roaringbitmaptest
+/// @brief Contains test functions for all member functions and use cases of @c RoaringBitmap.
+
+// Source Class Header
+#include <roaringbitmap.h>
+
+// From C++ STL
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+namespace
+{
+    /// @brief Builds a random key set mixing sparse, dense and contiguous chunks.
+    std::set<uint32_t> randomKeys(uint64_t seed)
+    {
+        std::mt19937_64 rng(seed);
+        std::set<uint32_t> keys;
+
+        // Sparse keys across the whole 32-bit space.
+        for (int i = 0; i < 2000; ++i)
+        {
+            keys.insert(static_cast<uint32_t>(rng()));
+        }
+
+        // A dense chunk that will need a bitmap container.
+        for (int i = 0; i < 20000; ++i)
+        {
+            keys.insert((3U << 16) | static_cast<uint32_t>(rng() % 65536));
+        }
+
+        // A contiguous range that compresses into runs.
+        const uint32_t start = (5U << 16) + static_cast<uint32_t>(rng() % 1000);
+        for (uint32_t value = start; value < start + 30000; ++value)
+        {
+            keys.insert(value);
+        }
+
+        return keys;
+    }
+}
+
+TEST(RoaringBitmap, testAddContainsRemove)
+{
+    libdsa::structures::RoaringBitmap bitmap;
+
+    bitmap.add(7);
+    bitmap.add(1U << 20);
+    bitmap.add(0xFFFFFFFFU);
+    bitmap.add(7);
+
+    ASSERT_EQ(3U, bitmap.cardinality());
+    ASSERT_TRUE(bitmap.contains(7));
+    ASSERT_TRUE(bitmap.contains(1U << 20));
+    ASSERT_TRUE(bitmap.contains(0xFFFFFFFFU));
+    ASSERT_FALSE(bitmap.contains(8));
+
+    bitmap.remove(7);
+    ASSERT_FALSE(bitmap.contains(7));
+    ASSERT_EQ(2U, bitmap.cardinality());
+
+    std::vector<uint32_t> expected{1U << 20, 0xFFFFFFFFU};
+    ASSERT_EQ(expected, bitmap.toVector());
+}
+
+TEST(RoaringBitmap, testContainerSelection)
+{
+    libdsa::structures::RoaringBitmap bitmap;
+    libdsa::structures::roaring::ContainerType type;
+
+    // Chunk 0 stays sparse, chunk 1 becomes dense.
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        bitmap.add(i * 3);
+    }
+
+    for (uint32_t i = 0; i < 10000; ++i)
+    {
+        bitmap.add((1U << 16) + i * 2);
+    }
+
+    ASSERT_TRUE(bitmap.containerType(0, type));
+    ASSERT_EQ(libdsa::structures::roaring::ContainerType::ARRAY, type);
+    ASSERT_TRUE(bitmap.containerType(1U << 16, type));
+    ASSERT_EQ(libdsa::structures::roaring::ContainerType::BITMAP, type);
+    ASSERT_FALSE(bitmap.containerType(2U << 16, type));
+
+    // A contiguous range is smallest as a single run.
+    libdsa::structures::RoaringBitmap range;
+    for (uint32_t i = 100; i < 60000; ++i)
+    {
+        range.add(i);
+    }
+
+    const size_t before = range.sizeInBytes();
+    range.runOptimize();
+
+    ASSERT_TRUE(range.containerType(0, type));
+    ASSERT_EQ(libdsa::structures::roaring::ContainerType::RUN, type);
+    ASSERT_LT(range.sizeInBytes(), before);
+    ASSERT_EQ(59900U, range.cardinality());
+    ASSERT_TRUE(range.contains(100));
+    ASSERT_TRUE(range.contains(59999));
+    ASSERT_FALSE(range.contains(60000));
+
+    // Adding next to a run extends it.
+    range.add(60000);
+    range.add(98);
+    range.add(99);
+    ASSERT_EQ(59903U, range.cardinality());
+    ASSERT_TRUE(range.contains(98));
+}
+
+TEST(RoaringBitmap, testRemoveKeepsLayouts)
+{
+    libdsa::structures::roaring::ContainerType type;
+
+    // Removing from a run shrinks or splits it in place.
+    libdsa::structures::RoaringBitmap range;
+    for (uint32_t i = 1000; i < 50000; ++i)
+    {
+        range.add(i);
+    }
+
+    range.runOptimize();
+    range.remove(1000);
+    range.remove(49999);
+    range.remove(20000);
+    range.remove(20000);
+    range.remove(60000);
+
+    ASSERT_TRUE(range.containerType(0, type));
+    ASSERT_EQ(libdsa::structures::roaring::ContainerType::RUN, type);
+    ASSERT_EQ(48997U, range.cardinality());
+    ASSERT_FALSE(range.contains(1000));
+    ASSERT_TRUE(range.contains(1001));
+    ASSERT_FALSE(range.contains(20000));
+    ASSERT_TRUE(range.contains(19999));
+    ASSERT_TRUE(range.contains(20001));
+    ASSERT_TRUE(range.contains(49998));
+    ASSERT_FALSE(range.contains(49999));
+
+    // Every other value removed leaves runs of one, which an array holds more compactly.
+    libdsa::structures::RoaringBitmap small;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        small.add(i);
+    }
+
+    small.runOptimize();
+    for (uint32_t i = 0; i < 100; i += 2)
+    {
+        small.remove(i);
+    }
+
+    ASSERT_TRUE(small.containerType(0, type));
+    ASSERT_EQ(libdsa::structures::roaring::ContainerType::ARRAY, type);
+    ASSERT_EQ(50U, small.cardinality());
+
+    // A bitmap drops back to an array once it fits in one.
+    libdsa::structures::RoaringBitmap dense;
+    for (uint32_t i = 0; i < 4097; ++i)
+    {
+        dense.add(i * 2);
+    }
+
+    ASSERT_TRUE(dense.containerType(0, type));
+    ASSERT_EQ(libdsa::structures::roaring::ContainerType::BITMAP, type);
+    dense.remove(0);
+    ASSERT_TRUE(dense.containerType(0, type));
+    ASSERT_EQ(libdsa::structures::roaring::ContainerType::ARRAY, type);
+    ASSERT_EQ(4096U, dense.cardinality());
+    ASSERT_TRUE(dense.contains(8192));
+
+    // Removing the last key of a chunk drops its container.
+    dense.add(5U << 16);
+    dense.remove(5U << 16);
+    ASSERT_FALSE(dense.containerType(5U << 16, type));
+}
+
+TEST(RoaringBitmap, testRemoveMatchesStdSet)
+{
+    std::set<uint32_t> keys = randomKeys(11);
+    libdsa::structures::RoaringBitmap bitmap(std::vector<uint32_t>(keys.begin(), keys.end()));
+    bitmap.runOptimize();
+
+    std::mt19937_64 rng(12);
+    std::vector<uint32_t> all(keys.begin(), keys.end());
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        const uint32_t value = all[rng() % all.size()];
+        bitmap.remove(value);
+        keys.erase(value);
+    }
+
+    ASSERT_EQ(keys.size(), bitmap.cardinality());
+    ASSERT_EQ(std::vector<uint32_t>(keys.begin(), keys.end()), bitmap.toVector());
+}
+
+TEST(RoaringBitmap, testOperationsMatchStdSet)
+{
+    const std::set<uint32_t> left = randomKeys(1);
+    const std::set<uint32_t> right = randomKeys(2);
+
+    libdsa::structures::RoaringBitmap a(std::vector<uint32_t>(left.begin(), left.end()));
+    libdsa::structures::RoaringBitmap b(std::vector<uint32_t>(right.begin(), right.end()));
+
+    // Exercise every pairing of layouts: plain, both run optimized and only one run optimized.
+    for (int pass = 0; pass < 3; ++pass)
+    {
+        if (pass == 1)
+        {
+            a.runOptimize();
+        }
+        else if (pass == 2)
+        {
+            b.runOptimize();
+        }
+
+        std::vector<uint32_t> expected;
+        std::set_intersection(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+        ASSERT_EQ(expected, a.AND(b).toVector());
+
+        expected.clear();
+        std::set_union(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+        ASSERT_EQ(expected, a.OR(b).toVector());
+
+        expected.clear();
+        std::set_symmetric_difference(left.begin(), left.end(), right.begin(), right.end(),
+                                      std::back_inserter(expected));
+        ASSERT_EQ(expected, a.XOR(b).toVector());
+
+        expected.clear();
+        std::set_difference(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+        ASSERT_EQ(expected, a.difference(b).toVector());
+
+        expected.clear();
+        std::set_difference(right.begin(), right.end(), left.begin(), left.end(), std::back_inserter(expected));
+        ASSERT_EQ(expected, b.difference(a).toVector());
+    }
+}
+
+TEST(RoaringBitmap, testSparseFootprint)
+{
+    // 0.1% density over a 2^26 key range, which needs 8 MiB as a dense bit array.
+    constexpr uint32_t universe = 1U << 26;
+    std::mt19937 rng(3);
+    std::vector<uint32_t> keys;
+
+    for (uint32_t i = 0; i < universe / 1000; ++i)
+    {
+        keys.push_back(static_cast<uint32_t>(rng() % universe));
+    }
+
+    libdsa::structures::RoaringBitmap bitmap(keys);
+
+    ASSERT_LT(bitmap.sizeInBytes() * 20, universe / 8);
+}
@@ -0,0 +1,194 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file bplustreetest
+/// @brief Contains test functions for all member functions and use cases of the @c BPlusTree class.
+/// @{
+
+// Class Header
+#include <bplustree.h>
+
+// From C++ STL
+#include <map>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+using Tree = libdsa::structures::tree::BPlusTree<int, int>;
+
+TEST(BPlusTree, test_emptyTree)
+{
+    Tree tree;
+
+    ASSERT_TRUE(tree.Empty());
+    ASSERT_EQ(tree.Height(), 0);
+    ASSERT_EQ(tree.begin(), tree.end());
+    ASSERT_EQ(tree.Find(3), tree.end());
+    ASSERT_EQ(tree.LowerBound(3), tree.end());
+    ASSERT_EQ(tree.RangeScan(0, 10, [](const int &, int &) {}), 0);
+}
+
+TEST(BPlusTree, test_insertMatchesMap)
+{
+    std::mt19937 generator(35);
+    std::uniform_int_distribution<int> distribution(0, 50000);
+
+    Tree tree;
+    std::map<int, int> reference;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        const int key = distribution(generator);
+        ASSERT_EQ(tree.Insert(key, i), reference.emplace(key, i).second);
+    }
+
+    ASSERT_EQ(tree.Size(), reference.size());
+    ASSERT_GT(tree.Height(), 2);
+
+    auto expected = reference.begin();
+
+    for (auto it = tree.begin(); it != tree.end(); ++it, ++expected)
+    {
+        ASSERT_EQ(it.GetKey(), expected->first);
+        ASSERT_EQ(it.GetValue(), expected->second);
+    }
+
+    ASSERT_EQ(expected, reference.end());
+
+    for (int probe = -1; probe <= 50001; probe += 7)
+    {
+        auto found = tree.LowerBound(probe);
+        auto wanted = reference.lower_bound(probe);
+
+        if (wanted == reference.end())
+        {
+            ASSERT_EQ(found, tree.end());
+        }
+        else
+        {
+            ASSERT_EQ(found.GetKey(), wanted->first);
+        }
+
+        ASSERT_EQ(tree.Contains(probe), reference.count(probe) == 1);
+    }
+}
+
+TEST(BPlusTree, test_findAllowsUpdate)
+{
+    Tree tree;
+    tree.Insert(4, 40);
+
+    ASSERT_FALSE(tree.Insert(4, 41));
+    ASSERT_EQ(tree.Find(4).GetValue(), 40);
+
+    tree.Find(4).GetValue() = 44;
+    ASSERT_EQ(tree.Find(4).GetValue(), 44);
+
+    // A const tree only hands out read-only values.
+    const Tree &view = tree;
+    Tree::ConstIterator found = view.Find(4);
+    static_assert(std::is_same<decltype(found.GetValue()), const int &>::value, "Const lookups must be read-only.");
+    ASSERT_EQ(found.GetValue(), 44);
+    ASSERT_EQ(found, Tree::ConstIterator(tree.Find(4)));
+    ASSERT_EQ(view.RangeScan(0, 10, [](const int &, const int &value) { ASSERT_EQ(value, 44); }), 1);
+}
+
+TEST(BPlusTree, test_nodesFillTheirLines)
+{
+    // A leaf spends 16 bytes on its header and 8 on the link to the next leaf, leaving room for 29 pairs.  An inner
+    // node with 19 keys has 20 children, which fills its 256 bytes exactly.
+    ASSERT_EQ(Tree::NODE_BYTES, 256);
+    ASSERT_EQ(Tree::LEAF_CAPACITY, 29);
+    ASSERT_EQ(Tree::INNER_CAPACITY, 19);
+}
+
+TEST(BPlusTree, test_bulkLoad)
+{
+    std::vector<std::pair<int, int>> sorted;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        sorted.emplace_back(3 * i, i);
+    }
+
+    Tree tree(sorted);
+
+    ASSERT_EQ(tree.Size(), sorted.size());
+
+    size_t index = 0;
+
+    for (auto it = tree.begin(); it != tree.end(); ++it, ++index)
+    {
+        ASSERT_EQ(it.GetKey(), sorted[index].first);
+    }
+
+    ASSERT_EQ(index, sorted.size());
+    ASSERT_TRUE(tree.Contains(2997));
+    ASSERT_FALSE(tree.Contains(2998));
+
+    // A packed tree keeps accepting inserts into full leaves.
+    for (int i = 0; i < 3000; ++i)
+    {
+        ASSERT_TRUE(tree.Insert(3 * i + 1, -i));
+    }
+
+    ASSERT_EQ(tree.Size(), 13000);
+    ASSERT_EQ(tree.Find(301).GetValue(), -100);
+
+    std::vector<std::pair<int, int>> unsorted = {{2, 0}, {1, 0}};
+    std::vector<std::pair<int, int>> duplicated = {{1, 0}, {1, 0}};
+
+    ASSERT_THROW(tree.BulkLoad(unsorted), std::invalid_argument);
+    ASSERT_THROW(tree.BulkLoad(duplicated), std::invalid_argument);
+    ASSERT_EQ(tree.Size(), 13000);
+}
+
+TEST(BPlusTree, test_rangeScan)
+{
+    Tree tree;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        tree.Insert(2 * i, i);
+    }
+
+    std::vector<int> keys;
+    size_t visited = tree.RangeScan(101, 2001, [&](const int &key, int &) { keys.push_back(key); });
+
+    ASSERT_EQ(visited, 950);
+    ASSERT_EQ(keys.size(), 950);
+    ASSERT_EQ(keys.front(), 102);
+    ASSERT_EQ(keys.back(), 2000);
+
+    ASSERT_EQ(tree.RangeScan(9999, 20000, [](const int &, int &) {}), 0);
+    ASSERT_EQ(tree.RangeScan(9998, 20000, [](const int &, int &value) { value = -1; }), 1);
+    ASSERT_EQ(tree.Find(9998).GetValue(), -1);
+}
+
+TEST(BPlusTree, test_copyAndMove)
+{
+    Tree tree;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        tree.Insert(i, i * i);
+    }
+
+    Tree copy(tree);
+    Tree moved(std::move(tree));
+
+    ASSERT_EQ(copy.Size(), 1000);
+    ASSERT_EQ(moved.Size(), 1000);
+    ASSERT_TRUE(tree.Empty());
+    ASSERT_EQ(copy.Find(30).GetValue(), 900);
+
+    copy.Clear();
+    ASSERT_TRUE(copy.Empty());
+    ASSERT_EQ(moved.Find(999).GetValue(), 998001);
+
+    tree = moved;
+    ASSERT_EQ(tree.Size(), 1000);
+}
@@ -0,0 +1,268 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file flattreetest
+/// @brief Contains test functions for all member functions and use cases of the @c FlatBinaryTree and @c FlatTree
+///        classes.
+/// @{
+
+// Class Header
+#include <flattree.h>
+
+// From C++ STL
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+using libdsa::structures::FlatBinaryTree;
+using libdsa::structures::FlatTree;
+using libdsa::structures::flat::NodeIndex;
+using libdsa::structures::flat::NULL_INDEX;
+using libdsa::structures::utilities::TreeNode;
+
+namespace
+{
+    /// @brief Builds a unique file path in the temporary directory for one test.
+    std::string temporaryPath(const std::string &name)
+    {
+        return ::testing::TempDir() + "libdsa_" + name + "_" + std::to_string(::getpid()) + ".tree";
+    }
+}
+
+TEST(FlatBinaryTree, test_writeAndSearch)
+{
+    const std::string path = temporaryPath("binary");
+    std::mt19937 generator(43);
+    std::uniform_int_distribution<int> values(-100000, 100000);
+    std::set<int> reference;
+    libdsa::structures::tree::BinaryTree<int> tree;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        const int value = values(generator);
+        reference.insert(value);
+        tree.Insert(value);
+    }
+
+    FlatBinaryTree<int>::write(path, tree);
+    FlatBinaryTree<int> flat = FlatBinaryTree<int>::open(path);
+
+    ASSERT_EQ(flat.size(), reference.size());
+    ASSERT_TRUE(flat.verify());
+    ASSERT_LE(flat.height(), 13);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        const int value = values(generator);
+        auto expected = reference.lower_bound(value);
+        const int *found = flat.lowerBound(value);
+
+        if (expected == reference.end())
+        {
+            ASSERT_EQ(found, nullptr);
+        }
+        else
+        {
+            ASSERT_NE(found, nullptr);
+            ASSERT_EQ(*found, *expected);
+        }
+
+        ASSERT_EQ(flat.contains(value), reference.count(value) == 1);
+    }
+
+    std::vector<int> visited;
+    flat.forEach([&](int value) { visited.push_back(value); });
+    ASSERT_EQ(visited, std::vector<int>(reference.begin(), reference.end()));
+
+    std::remove(path.c_str());
+}
+
+TEST(FlatBinaryTree, test_shape)
+{
+    const std::string path = temporaryPath("shape");
+    FlatBinaryTree<long>::write(path, std::vector<long>{10, 20, 30, 40, 50, 60, 70});
+    FlatBinaryTree<long> flat = FlatBinaryTree<long>::open(path);
+
+    // Pre-order layout of the balanced tree: the root first and each left child right after its parent.
+    ASSERT_EQ(flat.height(), 3);
+    ASSERT_EQ(flat.datum(flat.root()), 40);
+    ASSERT_EQ(flat.left(0), 1);
+    ASSERT_EQ(flat.datum(flat.left(0)), 20);
+    ASSERT_EQ(flat.datum(flat.right(0)), 60);
+    ASSERT_EQ(flat.left(2), NULL_INDEX);
+    ASSERT_EQ(*flat.find(70), 70);
+    ASSERT_EQ(flat.find(35), nullptr);
+
+    std::remove(path.c_str());
+}
+
+TEST(FlatBinaryTree, test_emptyAndInvalid)
+{
+    const std::string path = temporaryPath("empty");
+    FlatBinaryTree<int>::write(path, std::vector<int>());
+
+    {
+        FlatBinaryTree<int> flat = FlatBinaryTree<int>::open(path);
+        ASSERT_TRUE(flat.empty());
+        ASSERT_EQ(flat.root(), NULL_INDEX);
+        ASSERT_EQ(flat.lowerBound(0), nullptr);
+        ASSERT_EQ(flat.height(), 0);
+    }
+
+    ASSERT_THROW(FlatBinaryTree<int>::write(path, std::vector<int>{1, 3, 2}), std::invalid_argument);
+    ASSERT_THROW(FlatBinaryTree<int>::write(path, std::vector<int>{1, 1}), std::invalid_argument);
+
+    // A file of another element type or layout is rejected.
+    FlatBinaryTree<int>::write(path, std::vector<int>{1, 2, 3});
+    ASSERT_THROW(FlatBinaryTree<long>::open(path), std::runtime_error);
+    ASSERT_THROW(FlatTree<int>::open(path), std::runtime_error);
+
+    // A height beyond the node count would make forEach reserve whatever the header claims.
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        const uint32_t height = 0xFFFFFFFFU;
+        file.seekp(offsetof(libdsa::structures::flat::Header, height));
+        file.write(reinterpret_cast<const char *>(&height), sizeof(height));
+    }
+
+    ASSERT_THROW(FlatBinaryTree<int>::open(path), std::runtime_error);
+
+    {
+        std::ofstream file(path);
+        file << "not a tree";
+    }
+
+    ASSERT_THROW(FlatBinaryTree<int>::open(path), std::runtime_error);
+    ASSERT_THROW(FlatBinaryTree<int>::open(path + ".missing"), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+TEST(FlatBinaryTree, test_rewriteKeepsOpenReaders)
+{
+    const std::string path = temporaryPath("rewrite");
+    FlatBinaryTree<int>::write(path, std::vector<int>{1, 2, 3});
+    FlatBinaryTree<int> old = FlatBinaryTree<int>::open(path);
+
+    // The new file is written aside and renamed into place, so the old mapping keeps its contents.
+    std::vector<int> larger(10000);
+    for (size_t i = 0; i < larger.size(); ++i)
+    {
+        larger[i] = static_cast<int>(i * 2);
+    }
+
+    FlatBinaryTree<int>::write(path, larger);
+    ASSERT_EQ(old.size(), 3);
+    ASSERT_EQ(*old.find(3), 3);
+
+    FlatBinaryTree<int> current = FlatBinaryTree<int>::open(path);
+    ASSERT_EQ(current.size(), larger.size());
+    ASSERT_EQ(*current.find(19998), 19998);
+
+    std::remove(path.c_str());
+}
+
+TEST(FlatTree, test_writeAndNavigate)
+{
+    const std::string path = temporaryPath("nary");
+    std::vector<std::unique_ptr<TreeNode<char>>> owner;
+    auto make = [&](char datum) {
+        owner.push_back(std::make_unique<TreeNode<char>>(datum));
+        return owner.back().get();
+    };
+
+    // a has children b, e and f; b has c and d; f has g.
+    TreeNode<char> *a = make('a');
+    TreeNode<char> *b = make('b');
+    TreeNode<char> *f = make('f');
+    a->children = {b, make('e'), f};
+    b->children = {make('c'), make('d')};
+    f->children = {make('g')};
+
+    FlatTree<char>::write(path, a);
+    FlatTree<char> flat = FlatTree<char>::open(path);
+
+    ASSERT_EQ(flat.size(), 7);
+    ASSERT_TRUE(flat.verify());
+
+    std::string visited;
+    flat.preOrder([&](char datum) { visited += datum; });
+    ASSERT_EQ(visited, "abcdefg");
+
+    const NodeIndex root = flat.root();
+    ASSERT_EQ(flat.childCount(root), 3);
+    ASSERT_EQ(flat.subtreeSize(root), 7);
+
+    std::string children;
+
+    for (NodeIndex child = flat.firstChild(root); child != NULL_INDEX; child = flat.nextSibling(child))
+    {
+        children += flat.datum(child);
+    }
+
+    ASSERT_EQ(children, "bef");
+
+    const NodeIndex e = flat.nextSibling(flat.firstChild(root));
+    ASSERT_EQ(flat.firstChild(e), NULL_INDEX);
+    ASSERT_EQ(flat.subtreeSize(flat.firstChild(root)), 3);
+    ASSERT_EQ(flat.datum(flat.firstChild(flat.nextSibling(e))), 'g');
+
+    std::remove(path.c_str());
+}
+
+TEST(FlatTree, test_randomTreeMatchesSource)
+{
+    const std::string path = temporaryPath("random");
+    std::mt19937 generator(44);
+    std::vector<std::unique_ptr<TreeNode<int>>> nodes;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        nodes.push_back(std::make_unique<TreeNode<int>>(i));
+
+        if (i != 0)
+        {
+            nodes[generator() % i]->children.push_back(nodes.back().get());
+        }
+    }
+
+    FlatTree<int>::write(path, nodes.front().get());
+    FlatTree<int> flat = FlatTree<int>::open(path);
+
+    ASSERT_EQ(flat.size(), nodes.size());
+    ASSERT_TRUE(flat.verify());
+
+    // Walk both trees side by side.
+    std::vector<std::pair<const TreeNode<int> *, NodeIndex>> stack{{nodes.front().get(), flat.root()}};
+
+    while (!stack.empty())
+    {
+        auto [source, index] = stack.back();
+        stack.pop_back();
+
+        ASSERT_EQ(flat.datum(index), source->_datum);
+        ASSERT_EQ(flat.childCount(index), source->children.size());
+
+        NodeIndex child = flat.firstChild(index);
+
+        for (const TreeNode<int> *sourceChild : source->children)
+        {
+            stack.emplace_back(sourceChild, child);
+            child = flat.nextSibling(child);
+        }
+    }
+
+    FlatTree<int>::write(path, nullptr);
+    ASSERT_TRUE(FlatTree<int>::open(path).empty());
+
+    std::remove(path.c_str());
+}
+
+/// @}
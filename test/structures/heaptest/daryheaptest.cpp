@@ -0,0 +1,177 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file daryheaptest
+/// @brief Contains test functions for all member functions and use cases of the @c DaryHeap class.
+/// @{
+
+// Class Header
+#include <daryheap.h>
+
+// From C++ STL
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+TEST(DaryHeap, test_emptyHeap)
+{
+    libdsa::structures::DaryHeap<int> heap;
+
+    ASSERT_TRUE(heap.empty());
+    ASSERT_EQ(heap.size(), 0);
+    ASSERT_THROW(heap.top(), std::out_of_range);
+    ASSERT_THROW(heap.pop(), std::out_of_range);
+    ASSERT_THROW(heap.erase(0), std::out_of_range);
+    ASSERT_FALSE(heap.contains(0));
+}
+
+TEST(DaryHeap, test_pushPopSorts)
+{
+    std::mt19937 generator(36);
+    std::uniform_int_distribution<int> distribution(-1000, 1000);
+
+    libdsa::structures::DaryHeap<int, 8> heap;
+    std::vector<int> values(3000);
+
+    for (int &value : values)
+    {
+        value = distribution(generator);
+        heap.push(value);
+    }
+
+    std::sort(values.begin(), values.end());
+
+    for (int value : values)
+    {
+        ASSERT_EQ(heap.top(), value);
+        ASSERT_EQ(heap.pop(), value);
+    }
+
+    ASSERT_TRUE(heap.empty());
+}
+
+TEST(DaryHeap, test_customComparator)
+{
+    libdsa::structures::DaryHeap<int, 2, std::greater<int>> heap(std::vector<int>{3, 9, 1, 7});
+
+    ASSERT_EQ(heap.pop(), 9);
+    ASSERT_EQ(heap.pop(), 7);
+    ASSERT_EQ(heap.pop(), 3);
+    ASSERT_EQ(heap.pop(), 1);
+}
+
+TEST(DaryHeap, test_heapifyAndPushRange)
+{
+    std::vector<int> initial = {50, 20, 80, 10, 70, 30, 60, 40};
+    libdsa::structures::DaryHeap<int> heap(initial);
+
+    ASSERT_EQ(heap.size(), initial.size());
+    ASSERT_EQ(heap.get(2), 80);
+
+    // A small batch is sifted in, a large one triggers a rebuild.
+    std::vector<int> small = {5, 90};
+    std::vector<libdsa::structures::DaryHeap<int>::Handle> handles = heap.pushRange(small.begin(), small.end());
+
+    ASSERT_EQ(handles.size(), 2);
+    ASSERT_EQ(heap.get(handles[0]), 5);
+    ASSERT_EQ(heap.top(), 5);
+
+    std::vector<int> large;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        large.push_back(1000 - i);
+    }
+
+    heap.pushRange(large.begin(), large.end());
+    ASSERT_EQ(heap.size(), 110);
+
+    int previous = heap.pop();
+
+    while (!heap.empty())
+    {
+        int current = heap.pop();
+        ASSERT_LE(previous, current);
+        previous = current;
+    }
+}
+
+TEST(DaryHeap, test_decreaseKey)
+{
+    libdsa::structures::DaryHeap<int> heap;
+
+    std::vector<libdsa::structures::DaryHeap<int>::Handle> handles;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        handles.push_back(heap.push(100 + i));
+    }
+
+    heap.decreaseKey(handles[77], 3);
+    ASSERT_EQ(heap.topHandle(), handles[77]);
+    ASSERT_EQ(heap.get(handles[77]), 3);
+
+    heap.decreaseKey(handles[40], 50);
+    ASSERT_THROW(heap.decreaseKey(handles[40], 51), std::invalid_argument);
+
+    ASSERT_EQ(heap.pop(), 3);
+    ASSERT_EQ(heap.pop(), 50);
+    ASSERT_EQ(heap.pop(), 100);
+    ASSERT_THROW(heap.decreaseKey(handles[77], 1), std::out_of_range);
+}
+
+TEST(DaryHeap, test_eraseKeepsOrder)
+{
+    std::mt19937 generator(360);
+    std::uniform_int_distribution<int> distribution(0, 10000);
+
+    libdsa::structures::DaryHeap<int> heap;
+    std::vector<libdsa::structures::DaryHeap<int>::Handle> handles;
+    std::vector<int> kept;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        handles.push_back(heap.push(distribution(generator)));
+    }
+
+    for (size_t i = 0; i < handles.size(); ++i)
+    {
+        if (i % 3 == 0)
+        {
+            int value = heap.get(handles[i]);
+            ASSERT_EQ(heap.erase(handles[i]), value);
+            ASSERT_FALSE(heap.contains(handles[i]));
+        }
+        else
+        {
+            kept.push_back(heap.get(handles[i]));
+        }
+    }
+
+    std::sort(kept.begin(), kept.end());
+    ASSERT_EQ(heap.size(), kept.size());
+
+    for (int value : kept)
+    {
+        ASSERT_EQ(heap.pop(), value);
+    }
+}
+
+TEST(DaryHeap, test_handlesAreReused)
+{
+    libdsa::structures::DaryHeap<int> heap;
+
+    auto first = heap.push(1);
+    heap.pop();
+    auto second = heap.push(2);
+
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(heap.get(second), 2);
+
+    heap.clear();
+    ASSERT_TRUE(heap.empty());
+    ASSERT_FALSE(heap.contains(second));
+}
@@ -0,0 +1,285 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file paralleltreetest
+/// @brief Contains test functions for all member functions and use cases of the @c WorkStealingPool class and the
+///        parallel tree traversals, along with @c ThreadPool::parallelFor.
+/// @{
+
+// Class Header
+#include <paralleltree.h>
+#include <threadpool.h>
+
+// From C++ STL
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+using libdsa::common::WorkStealingPool;
+using libdsa::structures::utilities::TreeNode;
+
+namespace
+{
+    /// @brief Owns the nodes of a random tree built with @c TreeNode pointers.
+    struct RandomTree
+    {
+        std::vector<std::unique_ptr<TreeNode<long>>> _nodes;
+
+        RandomTree(size_t count, unsigned seed)
+        {
+            std::mt19937 generator(seed);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                _nodes.push_back(std::make_unique<TreeNode<long>>(static_cast<long>(i)));
+
+                if (i != 0)
+                {
+                    // Favouring recent parents gives long chains as well as bushy nodes.
+                    std::uniform_int_distribution<size_t> parents(i > 50 ? i - 50 : 0, i - 1);
+                    _nodes[parents(generator)]->children.push_back(_nodes[i].get());
+                }
+            }
+        }
+
+        TreeNode<long> *root()
+        {
+            return _nodes.front().get();
+        }
+    };
+}
+
+TEST(WorkStealingPool, test_taskGroupRunsEveryTask)
+{
+    WorkStealingPool pool(4);
+    std::atomic<int> count{0};
+
+    ASSERT_EQ(pool.size(), 4);
+
+    WorkStealingPool::TaskGroup group(pool);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        group.run([&count]() { count.fetch_add(1); });
+    }
+
+    group.wait();
+    ASSERT_EQ(count.load(), 1000);
+}
+
+TEST(WorkStealingPool, test_nestedForkJoin)
+{
+    WorkStealingPool pool(3);
+
+    // Naive recursive Fibonacci forks far more tasks than there are workers, and every level waits on the next.
+    std::function<long(int)> fibonacci = [&](int n) -> long {
+        if (n < 2)
+        {
+            return n;
+        }
+
+        long left = 0;
+        WorkStealingPool::TaskGroup group(pool);
+        group.run([&]() { left = fibonacci(n - 1); });
+        const long right = fibonacci(n - 2);
+        group.wait();
+
+        return left + right;
+    };
+
+    ASSERT_EQ(fibonacci(20), 6765);
+}
+
+TEST(WorkStealingPool, test_exceptionReachesWaiter)
+{
+    WorkStealingPool pool(2);
+    WorkStealingPool::TaskGroup group(pool);
+
+    group.run([]() { throw std::runtime_error("task failed"); });
+    group.run([]() {});
+
+    ASSERT_THROW(group.wait(), std::runtime_error);
+}
+
+TEST(WorkStealingPool, test_helpingDepthIsBounded)
+{
+    WorkStealingPool pool(2);
+    std::atomic<size_t> deepest(0);
+
+    WorkStealingPool::TaskGroup outer(pool);
+    outer.run([&]() {
+        WorkStealingPool::TaskGroup slow(pool);
+        WorkStealingPool::TaskGroup many(pool);
+        std::atomic<bool> started(false);
+
+        // Once the other worker has stolen the slow task, every wait below has to help while it runs.
+        slow.run([&]() {
+            started = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        });
+
+        while (!started)
+        {
+            std::this_thread::yield();
+        }
+
+        // Each of these waits for the slow task too, so every one picked up while helping nests one level deeper.
+        for (int i = 0; i < 1000; ++i)
+        {
+            many.run([&]() {
+                thread_local size_t nesting = 0;
+                const size_t depth = ++nesting;
+                size_t previous = deepest.load();
+
+                while (depth > previous && !deepest.compare_exchange_weak(previous, depth))
+                {
+                }
+
+                slow.wait();
+                --nesting;
+            });
+        }
+
+        slow.wait();
+        many.wait();
+    });
+
+    outer.wait();
+    ASSERT_LE(deepest.load(), WorkStealingPool::MAX_HELP_DEPTH + 1);
+}
+
+TEST(ThreadPool, test_parallelForWaitsForEveryChunk)
+{
+    libdsa::common::ThreadPool pool(4);
+    std::atomic<size_t> finished{0};
+
+    // The first chunk fails at once while the others are still running.
+    auto body = [&finished](size_t chunkBegin, size_t) {
+        if (chunkBegin == 0)
+        {
+            throw std::runtime_error("chunk failed");
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ++finished;
+    };
+
+    ASSERT_THROW(pool.parallelFor(0, 4, 1, body), std::runtime_error);
+    ASSERT_EQ(finished.load(), 3);
+}
+
+TEST(ParallelTree, test_emptyTree)
+{
+    WorkStealingPool pool(2);
+    int visits = 0;
+
+    libdsa::common::parallelPreOrder<int>(pool, nullptr, [&](int) { ++visits; });
+    libdsa::common::parallelPostOrder<int>(pool, nullptr, [&](int) { ++visits; });
+
+    ASSERT_EQ(visits, 0);
+    ASSERT_EQ((libdsa::common::parallelReduce<int>(pool, nullptr, 7, [](int datum) { return datum; },
+                                                   [](int a, int b) { return a + b; })),
+              7);
+}
+
+TEST(ParallelTree, test_preOrderVisitsParentsFirst)
+{
+    WorkStealingPool pool(4);
+    RandomTree tree(20000, 42);
+    std::vector<std::atomic<bool>> visited(tree._nodes.size());
+    std::atomic<bool> ordered{true};
+
+    // Record each node's parent so a visit can check that the parent came first.
+    std::vector<long> parent(tree._nodes.size(), -1);
+
+    for (const auto &node : tree._nodes)
+    {
+        for (TreeNode<long> *child : node->children)
+        {
+            parent[child->_datum] = node->_datum;
+        }
+    }
+
+    libdsa::common::parallelPreOrder(pool, tree.root(), [&](long datum) {
+        if (parent[datum] >= 0 && !visited[parent[datum]].load())
+        {
+            ordered.store(false);
+        }
+
+        visited[datum].store(true);
+    }, 2);
+
+    ASSERT_TRUE(ordered.load());
+
+    for (const std::atomic<bool> &flag : visited)
+    {
+        ASSERT_TRUE(flag.load());
+    }
+}
+
+TEST(ParallelTree, test_postOrderVisitsChildrenFirst)
+{
+    WorkStealingPool pool(4);
+    RandomTree tree(20000, 43);
+    std::vector<std::atomic<bool>> visited(tree._nodes.size());
+    std::atomic<bool> ordered{true};
+
+    libdsa::common::parallelPostOrder(pool, tree.root(), [&](long datum) {
+        for (TreeNode<long> *child : tree._nodes[datum]->children)
+        {
+            if (!visited[child->_datum].load())
+            {
+                ordered.store(false);
+            }
+        }
+
+        visited[datum].store(true);
+    });
+
+    ASSERT_TRUE(ordered.load());
+    ASSERT_TRUE(visited.front().load());
+}
+
+TEST(ParallelTree, test_reduceMatchesSequentialFold)
+{
+    WorkStealingPool pool(4);
+    RandomTree tree(50000, 44);
+
+    const long sum = libdsa::common::parallelReduce(pool, static_cast<const TreeNode<long> *>(tree.root()), 0L,
+                                                    [](long datum) { return datum; },
+                                                    [](long a, long b) { return a + b; });
+
+    ASSERT_EQ(sum, 50000L * 49999L / 2);
+
+    // Concatenation is not commutative, so this checks that partial results are combined in pre-order.
+    std::string expected;
+    std::vector<TreeNode<long> *> stack{tree.root()};
+
+    while (!stack.empty())
+    {
+        TreeNode<long> *node = stack.back();
+        stack.pop_back();
+        expected += std::to_string(node->_datum % 10);
+        stack.insert(stack.end(), node->children.rbegin(), node->children.rend());
+    }
+
+    for (size_t cutoff : {0, 1, 4, 64})
+    {
+        const std::string digits = libdsa::common::parallelReduce(
+            pool, static_cast<const TreeNode<long> *>(tree.root()), std::string(),
+            [](long datum) { return std::to_string(datum % 10); },
+            [](std::string a, const std::string &b) { return a += b; }, cutoff);
+
+        ASSERT_EQ(digits, expected);
+    }
+}
+
+/// @}
@@ -0,0 +1,225 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file adaptiveradixtreetest
+/// @brief Contains test functions for all member functions and use cases of the @c AdaptiveRadixTree class.
+/// @{
+
+// Class Header
+#include <adaptiveradixtree.h>
+
+// From C++ STL
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+using Tree = libdsa::structures::tree::AdaptiveRadixTree<int>;
+
+namespace
+{
+    /// @brief Checks that the tree holds exactly the elements of @p reference in the same order.
+    void expectSameElements(const Tree &tree, const std::map<std::string, int> &reference)
+    {
+        ASSERT_EQ(tree.Size(), reference.size());
+
+        auto expected = reference.begin();
+
+        tree.ForEach([&](const std::string &key, int &value) {
+            ASSERT_NE(expected, reference.end());
+            ASSERT_EQ(key, expected->first);
+            ASSERT_EQ(value, expected->second);
+            ++expected;
+        });
+
+        ASSERT_EQ(expected, reference.end());
+    }
+}
+
+TEST(AdaptiveRadixTree, test_emptyTree)
+{
+    Tree tree;
+
+    ASSERT_TRUE(tree.Empty());
+    ASSERT_EQ(tree.Find("a"), nullptr);
+    ASSERT_EQ(tree.LongestPrefixMatch("abc"), nullptr);
+    ASSERT_EQ(tree.PrefixScan("", [](const std::string &, int &) {}), 0);
+    ASSERT_FALSE(tree.Erase("a"));
+}
+
+TEST(AdaptiveRadixTree, test_keysThatArePrefixes)
+{
+    Tree tree;
+
+    ASSERT_TRUE(tree.Insert("", 0));
+    ASSERT_TRUE(tree.Insert("a", 1));
+    ASSERT_TRUE(tree.Insert("ab", 2));
+    ASSERT_TRUE(tree.Insert("abc", 3));
+    ASSERT_FALSE(tree.Insert("ab", 20));
+
+    ASSERT_EQ(*tree.Find(""), 0);
+    ASSERT_EQ(*tree.Find("ab"), 2);
+    ASSERT_EQ(tree.Find("abcd"), nullptr);
+
+    ASSERT_TRUE(tree.Erase("ab"));
+    ASSERT_EQ(tree.Find("ab"), nullptr);
+    ASSERT_EQ(*tree.Find("abc"), 3);
+
+    std::map<std::string, int> reference = {{"", 0}, {"a", 1}, {"abc", 3}};
+    expectSameElements(tree, reference);
+}
+
+TEST(AdaptiveRadixTree, test_matchesMap)
+{
+    std::mt19937 generator(38);
+    std::uniform_int_distribution<int> length(0, 10);
+    std::uniform_int_distribution<int> letter(0, 3);
+
+    Tree tree;
+    std::map<std::string, int> reference;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        std::string key;
+        const int size = length(generator);
+
+        for (int j = 0; j < size; ++j)
+        {
+            key.push_back(static_cast<char>('a' + letter(generator)));
+        }
+
+        if (i % 3 == 2)
+        {
+            ASSERT_EQ(tree.Erase(key), reference.erase(key) == 1);
+        }
+        else
+        {
+            ASSERT_EQ(tree.Insert(key, i), reference.emplace(key, i).second);
+        }
+    }
+
+    expectSameElements(tree, reference);
+
+    for (const auto &element : reference)
+    {
+        ASSERT_EQ(*tree.Find(element.first), element.second);
+    }
+}
+
+TEST(AdaptiveRadixTree, test_longCompressedPaths)
+{
+    // Prefixes longer than the stored bytes force the optimistic checks to fall back to the leaves.
+    const std::string base = "https://service.example.com/api/v1/";
+    std::vector<std::string> routes = {"users", "users/settings", "orders", "orders/history", "o", ""};
+
+    Tree tree;
+    std::map<std::string, int> reference;
+
+    for (size_t i = 0; i < routes.size(); ++i)
+    {
+        ASSERT_TRUE(tree.Insert(base + routes[i], static_cast<int>(i)));
+        reference.emplace(base + routes[i], static_cast<int>(i));
+    }
+
+    ASSERT_TRUE(tree.Insert("https://service.example.org/", 99));
+    reference.emplace("https://service.example.org/", 99);
+
+    ASSERT_EQ(tree.Find("https://service.example.com/api/v2/users"), nullptr);
+    ASSERT_EQ(tree.Find("https://service.example.com/api/v1/user"), nullptr);
+    ASSERT_EQ(*tree.Find(base + "orders/history"), 3);
+    expectSameElements(tree, reference);
+
+    for (const std::string &route : routes)
+    {
+        ASSERT_TRUE(tree.Erase(base + route));
+        reference.erase(base + route);
+        expectSameElements(tree, reference);
+    }
+}
+
+TEST(AdaptiveRadixTree, test_nodeGrowthAndShrink)
+{
+    Tree tree;
+    std::map<std::string, int> reference;
+
+    // Every byte value below one prefix drives a node through all four sizes and back.
+    for (int byte = 255; byte >= 0; --byte)
+    {
+        std::string key = "k" + std::string(1, static_cast<char>(byte)) + "v";
+        tree.Insert(key, byte);
+        reference.emplace(key, byte);
+    }
+
+    expectSameElements(tree, reference);
+
+    for (int byte = 0; byte < 256; byte += 2)
+    {
+        std::string key = "k" + std::string(1, static_cast<char>(byte)) + "v";
+        ASSERT_TRUE(tree.Erase(key));
+        reference.erase(key);
+    }
+
+    expectSameElements(tree, reference);
+
+    for (int byte = 1; byte < 256; byte += 2)
+    {
+        std::string key = "k" + std::string(1, static_cast<char>(byte)) + "v";
+        ASSERT_EQ(*tree.Find(key), byte);
+        ASSERT_TRUE(tree.Erase(key));
+    }
+
+    ASSERT_TRUE(tree.Empty());
+}
+
+TEST(AdaptiveRadixTree, test_prefixScan)
+{
+    Tree tree;
+    std::vector<std::string> keys = {"car", "card", "care", "cart", "cat", "dog", "do"};
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        tree.Insert(keys[i], static_cast<int>(i));
+    }
+
+    std::vector<std::string> found;
+    size_t visited = tree.PrefixScan("car", [&](const std::string &key, int &) { found.push_back(key); });
+
+    ASSERT_EQ(visited, 4);
+    ASSERT_EQ(found, (std::vector<std::string>{"car", "card", "care", "cart"}));
+
+    ASSERT_EQ(tree.PrefixScan("ca", [](const std::string &, int &) {}), 5);
+    ASSERT_EQ(tree.PrefixScan("do", [](const std::string &, int &) {}), 2);
+    ASSERT_EQ(tree.PrefixScan("cb", [](const std::string &, int &) {}), 0);
+    ASSERT_EQ(tree.PrefixScan("cards", [](const std::string &, int &) {}), 0);
+    ASSERT_EQ(tree.PrefixScan("", [](const std::string &, int &) {}), keys.size());
+}
+
+TEST(AdaptiveRadixTree, test_integerKeysAndLongestPrefixMatch)
+{
+    Tree tree;
+
+    // Routes keyed by the leading bytes of an IPv4 address.
+    const std::string address = Tree::EncodeKey(static_cast<uint32_t>(0x0A010203));
+
+    tree.Insert(address.substr(0, 1), 8);
+    tree.Insert(address.substr(0, 2), 16);
+    tree.Insert(Tree::EncodeKey(static_cast<uint32_t>(0x0A020000)).substr(0, 2), 160);
+
+    ASSERT_EQ(*tree.LongestPrefixMatch(address), 16);
+    ASSERT_EQ(*tree.LongestPrefixMatch(Tree::EncodeKey(static_cast<uint32_t>(0x0A030000))), 8);
+    ASSERT_EQ(tree.LongestPrefixMatch(Tree::EncodeKey(static_cast<uint32_t>(0x0B000000))), nullptr);
+
+    Tree numbers;
+
+    for (uint32_t value : {70000u, 5u, 256u, 65536u, 255u})
+    {
+        numbers.Insert(Tree::EncodeKey(value), static_cast<int>(value));
+    }
+
+    std::vector<int> ordered;
+    numbers.ForEach([&](const std::string &, int &value) { ordered.push_back(value); });
+
+    ASSERT_EQ(ordered, (std::vector<int>{5, 255, 256, 65536, 70000}));
+}
@@ -0,0 +1,133 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file fenwicktreetest
+/// @brief Contains test functions for all member functions and use cases of the @c FenwickTree class.
+/// @{
+
+// Class Header
+#include <fenwicktree.h>
+
+// From C++ STL
+#include <array>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+TEST(FenwickTree, test_emptyTree)
+{
+    libdsa::structures::tree::FenwickTree<int> tree;
+
+    ASSERT_EQ(tree.Size(), 0);
+    ASSERT_EQ(tree.PrefixSum(0), 0);
+    ASSERT_EQ(tree.LowerBound(1), 0);
+    ASSERT_THROW(tree.Add(0, 1), std::out_of_range);
+    ASSERT_THROW(tree.PrefixSum(1), std::out_of_range);
+}
+
+TEST(FenwickTree, test_sizeConstructor)
+{
+    libdsa::structures::tree::FenwickTree<long> tree(10);
+
+    ASSERT_EQ(tree.Size(), 10);
+    ASSERT_EQ(tree.PrefixSum(10), 0);
+
+    tree.Add(3, 5);
+    tree.Add(7, 2);
+
+    ASSERT_EQ(tree.PrefixSum(3), 0);
+    ASSERT_EQ(tree.PrefixSum(4), 5);
+    ASSERT_EQ(tree.RangeSum(4, 10), 2);
+    ASSERT_EQ(tree.Get(3), 5);
+}
+
+TEST(FenwickTree, test_containerConstructors)
+{
+    std::array<int, 6> array = {3, 1, 4, 1, 5, 9};
+    std::vector<int> vector(array.begin(), array.end());
+
+    libdsa::structures::tree::FenwickTree<int> fromArray(array);
+    libdsa::structures::tree::FenwickTree<int> fromVector(vector);
+
+    for (size_t end = 0; end <= array.size(); ++end)
+    {
+        const int expected = std::accumulate(array.begin(), array.begin() + end, 0);
+        ASSERT_EQ(fromArray.PrefixSum(end), expected);
+        ASSERT_EQ(fromVector.PrefixSum(end), expected);
+    }
+
+    std::vector<double> doubles = {1.0, 2.0};
+    ASSERT_THROW(libdsa::structures::tree::FenwickTree<int> invalid(doubles), std::runtime_error);
+}
+
+TEST(FenwickTree, test_setAndGet)
+{
+    std::vector<int> values = {2, 7, 1, 8, 2, 8};
+    libdsa::structures::tree::FenwickTree<int> tree(values);
+
+    tree.Set(1, -3);
+    tree.Set(5, 0);
+
+    ASSERT_EQ(tree.Get(1), -3);
+    ASSERT_EQ(tree.Get(5), 0);
+    ASSERT_EQ(tree.PrefixSum(6), 2 - 3 + 1 + 8 + 2);
+    ASSERT_THROW(tree.Get(6), std::out_of_range);
+    ASSERT_THROW(tree.RangeSum(4, 2), std::invalid_argument);
+}
+
+TEST(FenwickTree, test_lowerBound)
+{
+    std::vector<int> values = {1, 0, 2, 3, 0, 4};
+    libdsa::structures::tree::FenwickTree<int> tree(values);
+
+    // Prefix sums through each index: 1 1 3 6 6 10.
+    ASSERT_EQ(tree.LowerBound(0), 0);
+    ASSERT_EQ(tree.LowerBound(1), 0);
+    ASSERT_EQ(tree.LowerBound(2), 2);
+    ASSERT_EQ(tree.LowerBound(3), 2);
+    ASSERT_EQ(tree.LowerBound(4), 3);
+    ASSERT_EQ(tree.LowerBound(7), 5);
+    ASSERT_EQ(tree.LowerBound(10), 5);
+    ASSERT_EQ(tree.LowerBound(11), 6);
+}
+
+TEST(FenwickTree, test_randomAgainstArray)
+{
+    std::mt19937 generator(40);
+    std::uniform_int_distribution<int> values(-100, 100);
+
+    std::vector<long long> reference(1000);
+
+    for (long long &value : reference)
+    {
+        value = values(generator);
+    }
+
+    libdsa::structures::tree::FenwickTree<long long> tree(reference);
+    std::uniform_int_distribution<size_t> indices(0, reference.size());
+
+    for (int operation = 0; operation < 5000; ++operation)
+    {
+        size_t begin = indices(generator);
+        size_t end = indices(generator);
+
+        if (begin > end)
+        {
+            std::swap(begin, end);
+        }
+
+        if (operation % 2 == 0 && begin < reference.size())
+        {
+            const long long delta = values(generator);
+            tree.Add(begin, delta);
+            reference[begin] += delta;
+        }
+
+        ASSERT_EQ(tree.RangeSum(begin, end),
+                  std::accumulate(reference.begin() + begin, reference.begin() + end, 0LL));
+    }
+}
+
+/// @}
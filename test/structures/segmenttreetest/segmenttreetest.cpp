@@ -0,0 +1,207 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file segmenttreetest
+/// @brief Contains test functions for all member functions and use cases of the @c SegmentTree class.
+/// @{
+
+// Class Header
+#include <segmenttree.h>
+
+// From C++ STL
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+using SumTree = libdsa::structures::tree::SegmentTree<libdsa::structures::tree::SumAddPolicy<long long>>;
+using MinTree = libdsa::structures::tree::SegmentTree<libdsa::structures::tree::MinAddPolicy<int>>;
+using MaxTree = libdsa::structures::tree::SegmentTree<libdsa::structures::tree::MaxAddPolicy<int>>;
+
+namespace
+{
+    /// @brief Policy that assigns a value to a range and tracks the range sum, to check that a pending update is
+    ///        composed rather than summed.
+    struct SumAssignPolicy
+    {
+        using Value = long long;
+        using Update = long long;
+
+        static Value identity()
+        {
+            return 0;
+        }
+
+        static Value combine(const Value &left, const Value &right)
+        {
+            return left + right;
+        }
+
+        static Value apply(const Value &, const Update &update, size_t length)
+        {
+            return update * static_cast<long long>(length);
+        }
+
+        static Update compose(const Update &newer, const Update &)
+        {
+            return newer;
+        }
+    };
+}
+
+TEST(SegmentTree, test_emptyTree)
+{
+    SumTree tree;
+
+    ASSERT_EQ(tree.Size(), 0);
+    ASSERT_EQ(tree.QueryAll(), 0);
+    ASSERT_EQ(tree.Query(0, 0), 0);
+    ASSERT_THROW(tree.Get(0), std::out_of_range);
+    ASSERT_THROW(tree.Query(0, 1), std::out_of_range);
+}
+
+TEST(SegmentTree, test_sizeConstructorUsesIdentity)
+{
+    MinTree tree(5);
+
+    ASSERT_EQ(tree.Size(), 5);
+    ASSERT_EQ(tree.QueryAll(), std::numeric_limits<int>::max());
+
+    tree.Set(2, 7);
+    ASSERT_EQ(tree.Query(0, 5), 7);
+    ASSERT_EQ(tree.Query(3, 5), std::numeric_limits<int>::max());
+}
+
+TEST(SegmentTree, test_containerConstructors)
+{
+    std::array<int, 7> array = {5, -2, 8, 3, 3, -7, 1};
+    std::vector<int> vector(array.begin(), array.end());
+
+    MaxTree fromArray(array);
+    MinTree fromVector(vector);
+
+    ASSERT_EQ(fromArray.QueryAll(), 8);
+    ASSERT_EQ(fromVector.QueryAll(), -7);
+    ASSERT_EQ(fromArray.Query(3, 7), 3);
+    ASSERT_EQ(fromVector.Query(0, 2), -2);
+
+    std::vector<long> longs = {1, 2};
+    ASSERT_THROW(MinTree invalid(longs), std::runtime_error);
+}
+
+TEST(SegmentTree, test_rangeUpdate)
+{
+    std::vector<long long> values = {1, 2, 3, 4, 5, 6};
+    SumTree tree(values);
+
+    tree.Update(1, 4, 10);
+
+    ASSERT_EQ(tree.QueryAll(), 21 + 30);
+    ASSERT_EQ(tree.Query(0, 2), 1 + 12);
+    ASSERT_EQ(tree.Get(3), 14);
+    ASSERT_EQ(tree.Get(4), 5);
+
+    tree.Update(2, 2, 100);
+    ASSERT_EQ(tree.QueryAll(), 51);
+    ASSERT_THROW(tree.Update(4, 2, 1), std::invalid_argument);
+    ASSERT_THROW(tree.Update(0, 7, 1), std::out_of_range);
+}
+
+TEST(SegmentTree, test_composedUpdates)
+{
+    libdsa::structures::tree::SegmentTree<SumAssignPolicy> tree(10);
+
+    tree.Update(0, 10, 3);
+    tree.Update(2, 8, 5);
+    tree.Update(0, 10, 1);
+    tree.Update(4, 6, 2);
+
+    ASSERT_EQ(tree.QueryAll(), 8 + 4);
+    ASSERT_EQ(tree.Query(3, 5), 3);
+    ASSERT_EQ(tree.Get(5), 2);
+}
+
+TEST(SegmentTree, test_randomAgainstArray)
+{
+    std::mt19937 generator(40);
+    std::uniform_int_distribution<int> values(-50, 50);
+    std::uniform_int_distribution<int> operations(0, 3);
+
+    std::vector<int> reference(777);
+
+    for (int &value : reference)
+    {
+        value = values(generator);
+    }
+
+    MinTree minimums(reference);
+    MaxTree maximums(reference);
+    std::vector<long long> wide(reference.begin(), reference.end());
+    SumTree sums(wide);
+    std::uniform_int_distribution<size_t> indices(0, reference.size());
+
+    for (int operation = 0; operation < 4000; ++operation)
+    {
+        size_t begin = indices(generator);
+        size_t end = indices(generator);
+
+        if (begin > end)
+        {
+            std::swap(begin, end);
+        }
+
+        const int value = values(generator);
+
+        switch (operations(generator))
+        {
+            case 0:
+                minimums.Update(begin, end, value);
+                maximums.Update(begin, end, value);
+                sums.Update(begin, end, value);
+
+                for (size_t i = begin; i < end; ++i)
+                {
+                    reference[i] += value;
+                }
+                break;
+
+            case 1:
+                if (begin < reference.size())
+                {
+                    minimums.Set(begin, value);
+                    maximums.Set(begin, value);
+                    sums.Set(begin, value);
+                    reference[begin] = value;
+                }
+                break;
+
+            case 2:
+                if (begin < reference.size())
+                {
+                    ASSERT_EQ(minimums.Get(begin), reference[begin]);
+                    ASSERT_EQ(sums.Get(begin), reference[begin]);
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        if (begin == end)
+        {
+            continue;
+        }
+
+        ASSERT_EQ(minimums.Query(begin, end), *std::min_element(reference.begin() + begin, reference.begin() + end));
+        ASSERT_EQ(maximums.Query(begin, end), *std::max_element(reference.begin() + begin, reference.begin() + end));
+        ASSERT_EQ(sums.Query(begin, end), std::accumulate(reference.begin() + begin, reference.begin() + end, 0LL));
+    }
+
+    ASSERT_EQ(sums.QueryAll(), std::accumulate(reference.begin(), reference.end(), 0LL));
+}
+
+/// @}
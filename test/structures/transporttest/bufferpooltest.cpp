@@ -0,0 +1,226 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file bufferpooltest
+/// @brief Contains test functions for all member functions and use cases of the @c BufferPool and @c BufferHandle
+///        classes.
+
+/// Class Header
+#include <BufferPool.h>
+
+// From C++ STL
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+using libdsa::libstructures::BufferHandle;
+using libdsa::libstructures::BufferPool;
+
+TEST(BufferPoolTest, testSizeClasses)
+{
+    BufferPool pool;
+
+    ASSERT_EQ(BufferPool::capacityFor(0), 512);
+    ASSERT_EQ(BufferPool::capacityFor(512), 512);
+    ASSERT_EQ(BufferPool::capacityFor(513), 4 * 1024);
+    ASSERT_EQ(BufferPool::capacityFor(64 * 1024), 64 * 1024);
+    ASSERT_EQ(BufferPool::capacityFor(64 * 1024 + 1), 64 * 1024 + 1);
+
+    for (size_t size : {size_t(1), size_t(600), size_t(10000), size_t(65536), size_t(200000)})
+    {
+        BufferHandle buffer = pool.acquire(size);
+
+        ASSERT_TRUE(buffer);
+        ASSERT_EQ(buffer.size(), size);
+        ASSERT_EQ(buffer.capacity(), BufferPool::capacityFor(size));
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(buffer.data()) % 64, 0);
+
+        // The whole capacity is usable.
+        std::memset(buffer.data(), 0x5A, buffer.capacity());
+    }
+
+    // One slab for each class used; the oversized buffer had its own allocation.
+    ASSERT_EQ(pool.slabCount(), BufferPool::SIZE_CLASSES);
+}
+
+TEST(BufferPoolTest, testBuffersAreReused)
+{
+    BufferPool pool;
+    const char *first = nullptr;
+
+    {
+        BufferHandle buffer = pool.acquire(100);
+        first = buffer.data();
+    }
+
+    // The thread's cache hands the most recently released buffer out again.
+    BufferHandle again = pool.acquire(200);
+    ASSERT_EQ(again.data(), first);
+    ASSERT_EQ(again.size(), 200);
+    again.reset();
+    ASSERT_FALSE(again);
+    ASSERT_EQ(again.size(), 0);
+
+    // Cycling through far more buffers than that needs only as many slabs as hold the most buffers out at once.
+    for (int round = 0; round < 100; ++round)
+    {
+        std::vector<BufferHandle> held;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            held.push_back(pool.acquire(64 * 1024));
+        }
+    }
+
+    ASSERT_EQ(pool.slabCount(), 1 + (100 + 14) / 15);
+}
+
+TEST(BufferPoolTest, testHandlesCountReferences)
+{
+    BufferPool pool;
+    BufferHandle empty;
+
+    ASSERT_FALSE(empty);
+    ASSERT_EQ(empty.data(), nullptr);
+    ASSERT_EQ(empty.useCount(), 0);
+
+    BufferHandle original = pool.acquire(5);
+    std::memcpy(original.data(), "hello", 5);
+    const char *bytes = original.data();
+
+    BufferHandle copy = original;
+    ASSERT_EQ(original.useCount(), 2);
+    ASSERT_EQ(copy.data(), bytes);
+
+    BufferHandle moved = std::move(copy);
+    ASSERT_FALSE(copy);
+    ASSERT_EQ(moved.useCount(), 2);
+
+    // Copies share the size as well as the bytes.
+    moved.resize(4);
+    ASSERT_EQ(original.size(), 4);
+    moved.resize(100000);
+    ASSERT_EQ(original.size(), original.capacity());
+
+    // The buffer stays out of the pool while any handle refers to it.
+    original.reset();
+    ASSERT_EQ(moved.useCount(), 1);
+    BufferHandle other = pool.acquire(5);
+    ASSERT_NE(other.data(), bytes);
+    ASSERT_EQ(std::string(moved.data(), 4), "hell");
+
+    moved = BufferHandle();
+    BufferHandle reused = pool.acquire(5);
+    ASSERT_EQ(reused.data(), bytes);
+}
+
+TEST(BufferPoolTest, testLentBuffersGoBackToTheirLender)
+{
+    alignas(64) char memory[BufferPool::HEADER_BYTES + 32];
+    std::vector<char *> givenBack;
+
+    BufferHandle lent = BufferPool::lend(memory + BufferPool::HEADER_BYTES, 32, 5, [](void *lender, char *data) {
+        static_cast<std::vector<char *> *>(lender)->push_back(data);
+    }, &givenBack);
+
+    ASSERT_EQ(lent.data(), memory + BufferPool::HEADER_BYTES);
+    ASSERT_EQ(lent.size(), 5);
+    ASSERT_EQ(lent.capacity(), 32);
+
+    // Only the last reference gives the bytes back, and no pool is involved.
+    BufferHandle copy = lent;
+    lent.reset();
+    ASSERT_TRUE(givenBack.empty());
+    copy.reset();
+    ASSERT_EQ(givenBack, std::vector<char *>{memory + BufferPool::HEADER_BYTES});
+}
+
+TEST(BufferPoolTest, testBuffersCrossThreads)
+{
+    BufferPool pool;
+    constexpr size_t PRODUCERS = 4;
+    constexpr size_t BUFFERS = 20000;
+
+    std::mutex mutex;
+    std::vector<BufferHandle> handedOver;
+    std::atomic<size_t> producing{PRODUCERS};
+    std::atomic<bool> corrupted{false};
+    std::vector<std::thread> threads;
+
+    // Producers fill buffers that a consumer thread releases, as between a receiving reactor and a worker.
+    for (size_t p = 0; p < PRODUCERS; ++p)
+    {
+        threads.emplace_back([&, p]() {
+            for (size_t i = 0; i < BUFFERS; ++i)
+            {
+                BufferHandle buffer = pool.acquire(i % 3 == 0 ? 3000 : 300);
+                std::memset(buffer.data(), static_cast<int>(p), buffer.size());
+
+                // Wait for the consumer rather than let any number of buffers pile up.
+                for (;;)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+
+                        if (handedOver.size() < 1024)
+                        {
+                            handedOver.push_back(std::move(buffer));
+                            break;
+                        }
+                    }
+
+                    std::this_thread::yield();
+                }
+            }
+
+            --producing;
+        });
+    }
+
+    threads.emplace_back([&]() {
+        for (;;)
+        {
+            std::vector<BufferHandle> batch;
+            bool done = producing.load() == 0;
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                batch.swap(handedOver);
+            }
+
+            for (const BufferHandle &buffer : batch)
+            {
+                const char *end = buffer.data() + buffer.size();
+                const char first = buffer.data()[0];
+
+                if (std::find_if(buffer.data(), end, [first](char byte) { return byte != first; }) != end)
+                {
+                    corrupted = true;
+                }
+            }
+
+            if (done && batch.empty())
+            {
+                return;
+            }
+        }
+    });
+
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_FALSE(corrupted.load());
+
+    // Released buffers flowed back to the producers, so the pool stayed far below one buffer per message.
+    const size_t small = PRODUCERS * BUFFERS * 2 / 3 / (BufferPool::SLAB_BYTES / (64 + 512));
+    const size_t large = PRODUCERS * BUFFERS / 3 / (BufferPool::SLAB_BYTES / (64 + 4096));
+    ASSERT_LT(pool.slabCount(), (small + large) / 4);
+}
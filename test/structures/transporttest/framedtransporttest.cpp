@@ -0,0 +1,233 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file framedtransporttest
+/// @brief Contains test functions for all member functions and use cases of the @c FramedTransport class.
+
+/// Class Header
+#include <FramedTransport.h>
+
+// From the transport tests
+#include <loopbackclient.h>
+
+// From C++ STL
+#include <string>
+#include <thread>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+namespace
+{
+    using libdsa::libstructures::FramedTransport;
+    using libdsa::libstructures::TcpServerTransport;
+    using Backend = TcpServerTransport::Backend;
+    using loopback::connectClient;
+    using loopback::pollUntil;
+    using loopback::readExactly;
+
+    /// @brief Reads one framed message from a blocking socket.
+    std::string readMessage(int fd)
+    {
+        const std::string header = readExactly(fd, FramedTransport::HEADER_SIZE);
+
+        if (header.size() != FramedTransport::HEADER_SIZE)
+        {
+            return std::string();
+        }
+
+        return readExactly(fd, FramedTransport::decodeHeader(header.data()));
+    }
+
+    /// @brief Prefixes @p payload with its length.
+    std::string frame(const std::string &payload)
+    {
+        std::string framed(FramedTransport::HEADER_SIZE, '\0');
+        FramedTransport::encodeHeader(static_cast<uint32_t>(payload.size()), &framed[0]);
+        return framed + payload;
+    }
+}
+
+TEST(FramedTransportTest, testHeaderIsBigEndian)
+{
+    char header[FramedTransport::HEADER_SIZE];
+    FramedTransport::encodeHeader(0x01020304, header);
+
+    ASSERT_EQ(header[0], 1);
+    ASSERT_EQ(header[1], 2);
+    ASSERT_EQ(header[2], 3);
+    ASSERT_EQ(header[3], 4);
+    ASSERT_EQ(FramedTransport::decodeHeader(header), 0x01020304u);
+
+    FramedTransport::encodeHeader(0xFFFFFFFF, header);
+    ASSERT_EQ(FramedTransport::decodeHeader(header), 0xFFFFFFFFu);
+}
+
+TEST(FramedTransportTest, testMessagesAreReassembled)
+{
+    for (Backend backend : {Backend::EPOLL, Backend::IO_URING})
+    {
+        TcpServerTransport server(htonl(INADDR_LOOPBACK), 0, backend);
+        FramedTransport framed(server);
+        std::vector<std::string> messages;
+
+        FramedTransport::Callbacks callbacks;
+        callbacks.onMessage = [&](uint64_t, const char *data, size_t size) { messages.emplace_back(data, size); };
+        framed.setCallbacks(callbacks);
+
+        ASSERT_TRUE(server.open());
+        const int client = connectClient(server.port());
+
+        // Several whole frames in one write, an empty one among them.
+        const std::string burst = frame("first") + frame("") + frame("third");
+        ASSERT_EQ(::send(client, burst.data(), burst.size(), 0), static_cast<ssize_t>(burst.size()));
+        ASSERT_TRUE(pollUntil(server, [&]() { return messages.size() == 3; }));
+        ASSERT_EQ(messages, (std::vector<std::string>{"first", "", "third"}));
+
+        // A frame trickling in a byte at a time, prefix included.
+        const std::string split = frame("one byte at a time");
+
+        for (char byte : split)
+        {
+            ASSERT_EQ(::send(client, &byte, 1, 0), 1);
+            server.poll(0);
+        }
+
+        ASSERT_TRUE(pollUntil(server, [&]() { return messages.size() == 4; }));
+        ASSERT_EQ(messages.back(), "one byte at a time");
+
+        // A frame larger than one read of the transport.
+        const std::string large(1024 * 1024 + 3, 'L');
+        const std::string framedLarge = frame(large) + frame("after");
+        std::thread writer([&]() { ::send(client, framedLarge.data(), framedLarge.size(), 0); });
+
+        ASSERT_TRUE(pollUntil(server, [&]() { return messages.size() == 6; }));
+        writer.join();
+        ASSERT_TRUE(messages[4] == large);
+        ASSERT_EQ(messages[5], "after");
+        ::close(client);
+    }
+}
+
+TEST(FramedTransportTest, testRepliesAreBatchedPerTurn)
+{
+    for (Backend backend : {Backend::EPOLL, Backend::IO_URING})
+    {
+        TcpServerTransport server(htonl(INADDR_LOOPBACK), 0, backend);
+        FramedTransport framed(server);
+        uint64_t connection = 0;
+        size_t batched = 0;
+
+        FramedTransport::Callbacks callbacks;
+        callbacks.onAccept = [&](uint64_t id) { connection = id; };
+        callbacks.onMessage = [&](uint64_t id, const char *data, size_t size) {
+            ASSERT_TRUE(framed.sendMessage(id, data, size));
+            batched = std::max(batched, framed.batchedBytes(id));
+        };
+        framed.setCallbacks(callbacks);
+
+        ASSERT_TRUE(server.open());
+        const int client = connectClient(server.port());
+        ASSERT_TRUE(pollUntil(server, [&]() { return connection != 0; }));
+
+        // Messages sent outside the loop wait for a flush.
+        ASSERT_TRUE(framed.sendMessage(connection, "queued", 6));
+        ASSERT_TRUE(framed.sendMessage(connection, "too", 3));
+        ASSERT_EQ(framed.batchedBytes(connection), 2 * FramedTransport::HEADER_SIZE + 9);
+        ASSERT_EQ(server.pendingBytes(connection), 0);
+        ASSERT_EQ(framed.flush(), 1);
+        ASSERT_EQ(framed.batchedBytes(connection), 0);
+        ASSERT_EQ(framed.flush(), 0);
+
+        server.poll(0);
+        ASSERT_EQ(readMessage(client), "queued");
+        ASSERT_EQ(readMessage(client), "too");
+
+        // Echoes of a burst pile up during the turn and leave together when it ends.
+        std::string burst;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            burst += frame("message " + std::to_string(i));
+        }
+
+        ASSERT_EQ(::send(client, burst.data(), burst.size(), 0), static_cast<ssize_t>(burst.size()));
+        ASSERT_TRUE(pollUntil(server, [&]() { return batched == burst.size(); }));
+        ASSERT_EQ(framed.batchedBytes(connection), 0);
+
+        server.poll(0);
+        ASSERT_EQ(readExactly(client, burst.size()), burst);
+        ::close(client);
+    }
+}
+
+TEST(FramedTransportTest, testLargeMessagesKeepTheirOrder)
+{
+    TcpServerTransport server(htonl(INADDR_LOOPBACK), 0);
+    FramedTransport framed(server);
+    uint64_t connection = 0;
+
+    FramedTransport::Callbacks callbacks;
+    callbacks.onAccept = [&](uint64_t id) { connection = id; };
+    framed.setCallbacks(callbacks);
+
+    ASSERT_TRUE(server.open());
+    const int client = connectClient(server.port());
+    ASSERT_TRUE(pollUntil(server, [&]() { return connection != 0; }));
+
+    // The large message takes the batch in front of it along instead of overtaking it.
+    const std::string large(4 * FramedTransport::COALESCE_LIMIT, 'x');
+    ASSERT_TRUE(framed.sendMessage(connection, "small", 5));
+    ASSERT_TRUE(framed.sendMessage(connection, large.data(), large.size()));
+    ASSERT_EQ(framed.batchedBytes(connection), 0);
+    ASSERT_TRUE(framed.sendMessage(connection, "last", 4));
+    ASSERT_TRUE(framed.flush(connection));
+
+    std::string first;
+    std::string second;
+    std::string third;
+    std::thread reader([&]() {
+        first = readMessage(client);
+        second = readMessage(client);
+        third = readMessage(client);
+    });
+
+    ASSERT_TRUE(pollUntil(server, [&]() { return server.pendingBytes(connection) == 0; }));
+    reader.join();
+    ASSERT_EQ(first, "small");
+    ASSERT_TRUE(second == large);
+    ASSERT_EQ(third, "last");
+    ::close(client);
+}
+
+TEST(FramedTransportTest, testOversizedMessageClosesConnection)
+{
+    TcpServerTransport server(htonl(INADDR_LOOPBACK), 0);
+    FramedTransport framed(server, 16);
+    uint64_t connection = 0;
+    bool closed = false;
+    size_t received = 0;
+
+    FramedTransport::Callbacks callbacks;
+    callbacks.onAccept = [&](uint64_t id) { connection = id; };
+    callbacks.onMessage = [&](uint64_t, const char *, size_t) { ++received; };
+    callbacks.onClose = [&](uint64_t) { closed = true; };
+    framed.setCallbacks(callbacks);
+
+    ASSERT_TRUE(server.open());
+    const int client = connectClient(server.port());
+    ASSERT_TRUE(pollUntil(server, [&]() { return connection != 0; }));
+
+    const std::string tooLong(17, 'x');
+    ASSERT_FALSE(framed.sendMessage(connection, tooLong.data(), tooLong.size()));
+    ASSERT_FALSE(framed.sendMessage(connection + 1, "x", 1));
+
+    const std::string bytes = frame("fits") + frame(tooLong);
+    ASSERT_EQ(::send(client, bytes.data(), bytes.size(), 0), static_cast<ssize_t>(bytes.size()));
+
+    ASSERT_TRUE(pollUntil(server, [&]() { return closed; }));
+    ASSERT_EQ(received, 1);
+    ASSERT_EQ(server.connectionCount(), 0);
+    ASSERT_EQ(framed.batchedBytes(connection), 0);
+    ::close(client);
+}
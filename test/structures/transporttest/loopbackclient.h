@@ -0,0 +1,120 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file loopbackclient
+/// @{
+
+#ifndef LOOPBACK_CLIENT_H_
+#define LOOPBACK_CLIENT_H_
+
+/// @details Plain blocking sockets and polling loops shared by the transport tests and benchmarks, which drive a
+/// transport from the other end of a loopback connection.
+
+// From C++ STL
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// From POSIX
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace loopback
+{
+    /// @brief Opens a blocking client socket connected to the loopback address on @p port.
+    ///
+    /// @return The socket, or -1 if the connection failed.
+    inline int connectClient(uint16_t port)
+    {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+
+        if (fd < 0)
+        {
+            return -1;
+        }
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0)
+        {
+            ::close(fd);
+            return -1;
+        }
+
+        return fd;
+    }
+
+    /// @brief Reads from a blocking socket until @p size bytes arrived or the stream ended.
+    ///
+    /// @return The number of bytes read into @p data.
+    inline size_t readUpTo(int fd, char *data, size_t size)
+    {
+        size_t done = 0;
+
+        while (done < size)
+        {
+            const ssize_t received = ::recv(fd, data + done, size - done, 0);
+
+            if (received <= 0)
+            {
+                break;
+            }
+
+            done += static_cast<size_t>(received);
+        }
+
+        return done;
+    }
+
+    /// @brief Reads exactly @p size bytes from a blocking socket into @p data.
+    inline bool readExactly(int fd, char *data, size_t size)
+    {
+        return readUpTo(fd, data, size) == size;
+    }
+
+    /// @brief Reads exactly @p size bytes from a blocking socket.
+    ///
+    /// @return The bytes read, which fall short of @p size only if the stream ended first.
+    inline std::string readExactly(int fd, size_t size)
+    {
+        std::string result(size, '\0');
+        result.resize(readUpTo(fd, &result[0], size));
+        return result;
+    }
+
+    /// @brief Polls @p transport until @p condition holds or a few seconds pass.
+    template <typename Transport, typename Condition>
+    bool pollUntil(Transport &transport, Condition condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+        while (!condition() && std::chrono::steady_clock::now() < deadline)
+        {
+            transport.poll(10);
+        }
+
+        return condition();
+    }
+
+    /// @brief Polls @p first and @p second in turn until @p condition holds or a few seconds pass.
+    template <typename First, typename Second, typename Condition>
+    bool pollUntil(First &first, Second &second, Condition condition)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+        while (!condition() && std::chrono::steady_clock::now() < deadline)
+        {
+            first.poll(1);
+            second.poll(1);
+        }
+
+        return condition();
+    }
+} // loopback
+
+#endif // LOOPBACK_CLIENT_H_
+/// @}
@@ -0,0 +1,150 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file multireactorservertest
+/// @brief Contains test functions for all member functions and use cases of the @c MultiReactorServer class.
+
+/// Class Header
+#include <MultiReactorServer.h>
+
+// From the transport tests
+#include <loopbackclient.h>
+
+// From C++ STL
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+namespace
+{
+    using libdsa::libstructures::MultiReactorServer;
+    using libdsa::libstructures::TcpServerTransport;
+    using loopback::connectClient;
+    using loopback::readExactly;
+}
+
+TEST(MultiReactorServerTest, testReusePortSharesAddress)
+{
+    TcpServerTransport first(htonl(INADDR_LOOPBACK), 0);
+    first.setReusePort(true);
+    ASSERT_TRUE(first.open());
+
+    TcpServerTransport second(htonl(INADDR_LOOPBACK), 0);
+    second.setPort(first.port());
+    second.setReusePort(true);
+    ASSERT_TRUE(second.open());
+    ASSERT_EQ(second.port(), first.port());
+
+    // Both sides have to agree to share.
+    TcpServerTransport third(htonl(INADDR_LOOPBACK), first.port());
+    ASSERT_FALSE(third.open());
+}
+
+TEST(MultiReactorServerTest, testConnectionsAreSpreadAcrossReactors)
+{
+    constexpr size_t REACTORS = 4;
+    MultiReactorServer server(htonl(INADDR_LOOPBACK), 0, REACTORS);
+    ASSERT_EQ(server.reactorCount(), REACTORS);
+
+    std::atomic<size_t> accepted[REACTORS] = {};
+    std::atomic<size_t> closed{0};
+
+    for (size_t i = 0; i < REACTORS; ++i)
+    {
+        TcpServerTransport &reactor = server.reactor(i);
+
+        TcpServerTransport::Callbacks callbacks;
+        callbacks.onAccept = [&accepted, i](uint64_t) { ++accepted[i]; };
+        callbacks.onRead = [&reactor](uint64_t connection, const char *data, size_t size) {
+            reactor.send(connection, data, size);
+        };
+        callbacks.onClose = [&closed](uint64_t) { ++closed; };
+        reactor.setCallbacks(callbacks);
+    }
+
+    ASSERT_TRUE(server.start(false));
+    ASSERT_TRUE(server.isRunning());
+    ASSERT_FALSE(server.start(false));
+    ASSERT_NE(server.port(), 0);
+
+    // The kernel hashes each connection's addresses to a listener, so 64 of them reach all four.
+    constexpr size_t CLIENTS = 64;
+    std::vector<int> clients;
+
+    for (size_t i = 0; i < CLIENTS; ++i)
+    {
+        clients.push_back(connectClient(server.port()));
+        ASSERT_GE(clients.back(), 0);
+
+        const std::string message = "client " + std::to_string(i);
+        ASSERT_EQ(::send(clients.back(), message.data(), message.size(), 0), static_cast<ssize_t>(message.size()));
+        ASSERT_EQ(readExactly(clients.back(), message.size()), message);
+    }
+
+    size_t total = 0;
+
+    for (size_t i = 0; i < REACTORS; ++i)
+    {
+        ASSERT_GT(accepted[i].load(), 0);
+        total += accepted[i].load();
+    }
+
+    ASSERT_EQ(total, CLIENTS);
+
+    // Stopping closes the connections still open.
+    server.stop();
+    ASSERT_FALSE(server.isRunning());
+    ASSERT_EQ(closed.load(), CLIENTS);
+
+    for (int client : clients)
+    {
+        ::close(client);
+    }
+}
+
+TEST(MultiReactorServerTest, testThreadsArePinned)
+{
+    MultiReactorServer server(htonl(INADDR_LOOPBACK), 0, 2);
+
+    ASSERT_EQ(server.cpu(0), -1);
+    ASSERT_TRUE(server.start());
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    ASSERT_EQ(::sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+
+    for (size_t i = 0; i < server.reactorCount(); ++i)
+    {
+        ASSERT_GE(server.cpu(i), 0);
+        ASSERT_TRUE(CPU_ISSET(server.cpu(i), &allowed));
+    }
+
+    // Reactors hand out CPUs in turn, so two reactors share one only when there is just one.
+    if (CPU_COUNT(&allowed) > 1)
+    {
+        ASSERT_NE(server.cpu(0), server.cpu(1));
+    }
+
+    server.stop();
+    ASSERT_EQ(server.cpu(0), -1);
+
+    // A default server has a reactor for every CPU it may use.
+    MultiReactorServer perCpu(htonl(INADDR_LOOPBACK), 0);
+    ASSERT_EQ(perCpu.reactorCount(), static_cast<size_t>(CPU_COUNT(&allowed)));
+}
+
+TEST(MultiReactorServerTest, testStartFailsWhenPortInUse)
+{
+    TcpServerTransport occupant(htonl(INADDR_LOOPBACK), 0);
+    ASSERT_TRUE(occupant.open());
+
+    MultiReactorServer server(htonl(INADDR_LOOPBACK), occupant.port(), 2);
+    ASSERT_FALSE(server.start());
+    ASSERT_FALSE(server.isRunning());
+    ASSERT_FALSE(server.reactor(0).isOpen());
+    ASSERT_FALSE(server.reactor(1).isOpen());
+}
@@ -0,0 +1,174 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file tcpclienttransporttest
+/// @brief Contains test functions for all member functions and use cases of the @c TcpClientTransport class.
+
+/// Class Header
+#include <TcpClientTransport.h>
+
+// From libtransport
+#include <TcpServerTransport.h>
+
+// From the transport tests
+#include <loopbackclient.h>
+
+// From C++ STL
+#include <chrono>
+#include <string>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+namespace
+{
+    using libdsa::libstructures::BufferView;
+    using libdsa::libstructures::TcpClientTransport;
+    using libdsa::libstructures::TcpServerTransport;
+    using loopback::pollUntil;
+
+    /// @brief Makes @p server send back everything it receives.
+    void echo(TcpServerTransport &server)
+    {
+        TcpServerTransport::Callbacks callbacks;
+        callbacks.onRead = [&server](uint64_t id, const char *data, size_t size) { server.send(id, data, size); };
+        server.setCallbacks(callbacks);
+    }
+}
+
+TEST(TcpClientTransportTest, testConnectAndEcho)
+{
+    TcpServerTransport server(htonl(INADDR_LOOPBACK), 0);
+    echo(server);
+    ASSERT_TRUE(server.open());
+
+    TcpClientTransport client;
+    std::string received;
+    size_t connects = 0;
+    size_t writes = 0;
+
+    TcpClientTransport::Callbacks callbacks;
+    callbacks.onConnect = [&](uint64_t) { ++connects; };
+    callbacks.onRead = [&](uint64_t, const char *data, size_t size) { received.append(data, size); };
+    callbacks.onWrite = [&](uint64_t) { ++writes; };
+    client.setCallbacks(callbacks);
+
+    ASSERT_EQ(client.connect(htonl(INADDR_LOOPBACK), server.port()), 0u);
+    ASSERT_TRUE(client.open());
+    ASSERT_FALSE(client.open());
+
+    const uint64_t id = client.connect(htonl(INADDR_LOOPBACK), server.port());
+    ASSERT_NE(id, 0u);
+    ASSERT_EQ(client.connectionCount(), 1);
+    ASSERT_TRUE(client.setNoDelay(id, true));
+
+    // Output sent before the handshake completes waits for it.
+    const std::string head = "sent while connecting";
+    ASSERT_TRUE(client.send(id, head.data(), head.size()));
+    ASSERT_TRUE(pollUntil(server, client, [&]() { return received == head; }));
+    ASSERT_EQ(connects, 1);
+    ASSERT_TRUE(client.isConnected(id));
+
+    const std::string first = "gathered ";
+    const std::string second = "from two buffers";
+    const BufferView views[] = {BufferView(first), BufferView(second)};
+    received.clear();
+    ASSERT_TRUE(client.sendv(id, views, 2));
+    ASSERT_TRUE(pollUntil(server, client, [&]() { return received == first + second; }));
+
+    // More than the socket buffers hold is queued, then written as the peer drains it.
+    std::string large(8 * 1024 * 1024, '\0');
+    for (size_t i = 0; i < large.size(); ++i)
+    {
+        large[i] = static_cast<char>(i * 31 + i / 4096);
+    }
+
+    received.clear();
+    writes = 0;
+    ASSERT_TRUE(client.send(id, large.data(), large.size()));
+    ASSERT_GT(client.pendingBytes(id), 0);
+    ASSERT_TRUE(pollUntil(server, client, [&]() { return received.size() == large.size(); }));
+    ASSERT_TRUE(received == large);
+    ASSERT_EQ(client.pendingBytes(id), 0);
+    ASSERT_EQ(writes, 1);
+
+    ASSERT_TRUE(client.close());
+    ASSERT_FALSE(client.isOpen());
+    ASSERT_EQ(client.connectionCount(), 0);
+}
+
+TEST(TcpClientTransportTest, testRefusedConnectionIsClosed)
+{
+    // Find a port nothing listens on by opening a server there and closing it again.
+    uint16_t port = 0;
+    {
+        TcpServerTransport server(htonl(INADDR_LOOPBACK), 0);
+        ASSERT_TRUE(server.open());
+        port = server.port();
+    }
+
+    TcpClientTransport client;
+    std::vector<uint64_t> closed;
+    size_t connects = 0;
+
+    TcpClientTransport::Callbacks callbacks;
+    callbacks.onConnect = [&](uint64_t) { ++connects; };
+    callbacks.onClose = [&](uint64_t id) { closed.push_back(id); };
+    client.setCallbacks(callbacks);
+    ASSERT_TRUE(client.open());
+
+    const uint64_t id = client.connect(htonl(INADDR_LOOPBACK), port);
+    ASSERT_NE(id, 0u);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (closed.empty() && std::chrono::steady_clock::now() < deadline)
+    {
+        client.poll(10);
+    }
+
+    ASSERT_EQ(closed, std::vector<uint64_t>{id});
+    ASSERT_EQ(connects, 0);
+    ASSERT_FALSE(client.isConnected(id));
+    ASSERT_FALSE(client.send(id, "x", 1));
+    ASSERT_FALSE(client.disconnect(id));
+}
+
+TEST(TcpClientTransportTest, testEitherSideCloses)
+{
+    TcpServerTransport server(htonl(INADDR_LOOPBACK), 0);
+    std::vector<uint64_t> accepted;
+    size_t serverClosed = 0;
+
+    TcpServerTransport::Callbacks serverCallbacks;
+    serverCallbacks.onAccept = [&](uint64_t id) { accepted.push_back(id); };
+    serverCallbacks.onClose = [&](uint64_t) { ++serverClosed; };
+    server.setCallbacks(serverCallbacks);
+    ASSERT_TRUE(server.open());
+
+    TcpClientTransport client;
+    std::vector<uint64_t> closed;
+
+    TcpClientTransport::Callbacks callbacks;
+    callbacks.onClose = [&](uint64_t id) { closed.push_back(id); };
+    client.setCallbacks(callbacks);
+    ASSERT_TRUE(client.open());
+
+    const uint64_t first = client.connect(htonl(INADDR_LOOPBACK), server.port());
+    const uint64_t second = client.connect(htonl(INADDR_LOOPBACK), server.port());
+    ASSERT_NE(first, second);
+    ASSERT_TRUE(pollUntil(server, client, [&]() {
+        return accepted.size() == 2 && client.isConnected(first) && client.isConnected(second);
+    }));
+
+    // The server hanging up is seen by the client.
+    ASSERT_TRUE(server.disconnect(accepted[0]));
+    ASSERT_TRUE(pollUntil(server, client, [&]() { return closed.size() == 1; }));
+    ASSERT_EQ(client.connectionCount(), 1);
+
+    // And the client hanging up by the server.
+    const uint64_t survivor = closed[0] == first ? second : first;
+    ASSERT_TRUE(client.disconnect(survivor));
+    ASSERT_EQ(closed.size(), 2);
+    ASSERT_TRUE(pollUntil(server, client, [&]() { return serverClosed == 2; }));
+    ASSERT_EQ(client.connectionCount(), 0);
+}
@@ -6,17 +6,587 @@
 /// Class Header
 #include <TcpServerTransport.h>
 
+// From the transport tests
+#include <loopbackclient.h>
+
+// From C++ STL
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
 // From Gtest
 #include <gtest/gtest.h>
 
+namespace
+{
+    using loopback::connectClient;
+    using loopback::pollUntil;
+    using loopback::readExactly;
+
+    using Backend = libdsa::libstructures::TcpServerTransport::Backend;
+
+    void echoManyClients(Backend backend)
+    {
+        libdsa::libstructures::TcpServerTransport server(htonl(INADDR_LOOPBACK), 0, backend);
+        size_t accepted = 0;
+        size_t echoed = 0;
+
+        libdsa::libstructures::TcpServerTransport::Callbacks callbacks;
+        callbacks.onAccept = [&](uint64_t) { ++accepted; };
+        callbacks.onRead = [&](uint64_t connection, const char *data, size_t size) {
+            echoed += size;
+            server.send(connection, data, size);
+        };
+        server.setCallbacks(callbacks);
+
+        ASSERT_TRUE(server.open());
+
+        constexpr size_t CLIENTS = 200;
+        std::vector<int> clients;
+
+        for (size_t i = 0; i < CLIENTS; ++i)
+        {
+            clients.push_back(connectClient(server.port()));
+            ASSERT_GE(clients.back(), 0);
+        }
+
+        ASSERT_TRUE(pollUntil(server, [&]() { return accepted == CLIENTS; }));
+        ASSERT_EQ(server.connectionCount(), CLIENTS);
+
+        for (size_t i = 0; i < CLIENTS; ++i)
+        {
+            const std::string message = "client " + std::to_string(i);
+            ASSERT_EQ(::send(clients[i], message.data(), message.size(), 0), static_cast<ssize_t>(message.size()));
+        }
+
+        size_t expected = 0;
+
+        for (size_t i = 0; i < CLIENTS; ++i)
+        {
+            expected += ("client " + std::to_string(i)).size();
+        }
+
+        ASSERT_TRUE(pollUntil(server, [&]() { return echoed == expected; }));
+
+        // On io_uring the echoes are still queued until the loop's next turn submits them.
+        server.poll(0);
+
+        for (size_t i = 0; i < CLIENTS; ++i)
+        {
+            const std::string message = "client " + std::to_string(i);
+            ASSERT_EQ(readExactly(clients[i], message.size()), message);
+            ::close(clients[i]);
+        }
+    }
+
+    void closeIsReported(Backend backend)
+    {
+        libdsa::libstructures::TcpServerTransport server(htonl(INADDR_LOOPBACK), 0, backend);
+        std::vector<uint64_t> opened;
+        std::vector<uint64_t> closed;
+
+        libdsa::libstructures::TcpServerTransport::Callbacks callbacks;
+        callbacks.onAccept = [&](uint64_t connection) { opened.push_back(connection); };
+        callbacks.onClose = [&](uint64_t connection) { closed.push_back(connection); };
+        server.setCallbacks(callbacks);
+
+        ASSERT_TRUE(server.open());
+
+        const int first = connectClient(server.port());
+        const int second = connectClient(server.port());
+
+        ASSERT_TRUE(pollUntil(server, [&]() { return opened.size() == 2; }));
+        ASSERT_NE(opened[0], opened[1]);
+
+        // The client hanging up is noticed by the loop.
+        ::close(first);
+        ASSERT_TRUE(pollUntil(server, [&]() { return closed.size() == 1; }));
+        ASSERT_EQ(server.connectionCount(), 1);
+
+        // The server hanging up is seen by the client as the end of the stream.
+        const uint64_t remaining = opened[0] == closed[0] ? opened[1] : opened[0];
+        ASSERT_TRUE(server.disconnect(remaining));
+        ASSERT_FALSE(server.disconnect(remaining));
+        ASSERT_FALSE(server.send(remaining, "x", 1));
+        ASSERT_EQ(closed.size(), 2);
+
+        char byte;
+        ASSERT_EQ(::recv(second, &byte, 1, 0), 0);
+        ::close(second);
+    }
+
+    void largeSendIsQueued(Backend backend)
+    {
+        libdsa::libstructures::TcpServerTransport server(htonl(INADDR_LOOPBACK), 0, backend);
+        uint64_t connection = 0;
+        size_t drained = 0;
+
+        libdsa::libstructures::TcpServerTransport::Callbacks callbacks;
+        callbacks.onAccept = [&](uint64_t id) { connection = id; };
+        callbacks.onWrite = [&](uint64_t) { ++drained; };
+        server.setCallbacks(callbacks);
+
+        ASSERT_TRUE(server.open());
+
+        const int client = connectClient(server.port());
+        ASSERT_TRUE(pollUntil(server, [&]() { return connection != 0; }));
+
+        // Far more than the socket buffers hold, so most of it has to wait in the connection's queue.
+        std::string payload(16 * 1024 * 1024, '\0');
+
+        for (size_t i = 0; i < payload.size(); ++i)
+        {
+            payload[i] = static_cast<char>(i * 31);
+        }
+
+        ASSERT_TRUE(server.send(connection, payload.data(), payload.size()));
+        ASSERT_GT(server.pendingBytes(connection), 0);
+
+        // Output sent while the first send is outstanding goes out after it, in order.
+        ASSERT_TRUE(server.send(connection, "tail", 4));
+
+        std::string received;
+        std::thread reader([&]() { received = readExactly(client, payload.size() + 4); });
+
+        ASSERT_TRUE(pollUntil(server, [&]() { return server.pendingBytes(connection) == 0; }));
+        ASSERT_GE(drained, 1);
+
+        reader.join();
+        ASSERT_TRUE(received == payload + "tail");
+        ::close(client);
+    }
+}
+
 TEST(TcpServerTransportTest, testValidServerCreation)
 {
     ASSERT_NO_THROW(libdsa::libstructures::TcpServerTransport server(INADDR_ANY, 8080U));
 }
 
-TEST(TcpServerTransportTest, testServerOpenToManyAttempts)
+TEST(TcpServerTransportTest, testServerOpenFailsWhenPortInUse)
+{
+    libdsa::libstructures::TcpServerTransport first(htonl(INADDR_LOOPBACK), 0);
+
+    ASSERT_TRUE(first.open());
+    ASSERT_TRUE(first.isOpen());
+    ASSERT_NE(first.port(), 0);
+    ASSERT_FALSE(first.open());
+
+    libdsa::libstructures::TcpServerTransport second(htonl(INADDR_LOOPBACK), first.port());
+
+    ASSERT_EQ(second.open(), false);
+    ASSERT_FALSE(second.isOpen());
+    ASSERT_TRUE(first.close());
+    ASSERT_FALSE(first.close());
+}
+
+TEST(TcpServerTransportTest, testEchoManyClients)
+{
+    echoManyClients(Backend::EPOLL);
+}
+
+TEST(TcpServerTransportTest, testCloseIsReported)
+{
+    closeIsReported(Backend::EPOLL);
+}
+
+TEST(TcpServerTransportTest, testLargeSendIsQueued)
+{
+    largeSendIsQueued(Backend::EPOLL);
+}
+
+TEST(TcpServerTransportTest, testBackendSelection)
+{
+    libdsa::libstructures::TcpServerTransport byDefault(htonl(INADDR_LOOPBACK), 0);
+    ASSERT_EQ(byDefault.backend(), Backend::EPOLL);
+    ASSERT_TRUE(byDefault.open());
+    ASSERT_EQ(byDefault.backend(), Backend::EPOLL);
+
+    // Either the kernel provides io_uring or the transport falls back; both must leave a working server.
+    libdsa::libstructures::TcpServerTransport requested(htonl(INADDR_LOOPBACK), 0, Backend::IO_URING);
+    ASSERT_EQ(requested.backend(), Backend::IO_URING);
+    ASSERT_TRUE(requested.open());
+    ASSERT_TRUE(requested.backend() == Backend::IO_URING || requested.backend() == Backend::EPOLL);
+    ASSERT_TRUE(requested.close());
+}
+
+TEST(TcpServerTransportTest, testUringEchoManyClients)
+{
+    echoManyClients(Backend::IO_URING);
+}
+
+TEST(TcpServerTransportTest, testUringCloseIsReported)
+{
+    closeIsReported(Backend::IO_URING);
+}
+
+TEST(TcpServerTransportTest, testUringLargeSendIsQueued)
 {
-    libdsa::libstructures::TcpServerTransport server(INADDR_ANY, 8080U);
+    largeSendIsQueued(Backend::IO_URING);
+}
+
+TEST(TcpServerTransportTest, testSendvGathersBuffers)
+{
+    for (Backend backend : {Backend::EPOLL, Backend::IO_URING})
+    {
+        libdsa::libstructures::TcpServerTransport server(htonl(INADDR_LOOPBACK), 0, backend);
+        uint64_t connection = 0;
+
+        libdsa::libstructures::TcpServerTransport::Callbacks callbacks;
+        callbacks.onAccept = [&](uint64_t id) { connection = id; };
+        server.setCallbacks(callbacks);
+
+        ASSERT_TRUE(server.open());
+
+        const int client = connectClient(server.port());
+        ASSERT_TRUE(pollUntil(server, [&]() { return connection != 0; }));
+
+        const std::string header = "HDR:";
+        const std::string body = "a message split over several buffers";
+        const std::string trailer = ":END";
+        const libdsa::libstructures::BufferView views[] = {header, {}, body, trailer};
+
+        ASSERT_TRUE(server.sendv(connection, views, 4));
+        ASSERT_TRUE(pollUntil(server, [&]() { return server.pendingBytes(connection) == 0; }));
+        ASSERT_EQ(readExactly(client, header.size() + body.size() + trailer.size()), header + body + trailer);
+
+        // More views than one system call takes, and more bytes than the socket holds.
+        std::vector<std::string> parts;
+        std::vector<libdsa::libstructures::BufferView> many;
+        std::string expected;
+
+        for (size_t i = 0; i < 3 * libdsa::libstructures::TcpServerTransport::MAX_IOVECS; ++i)
+        {
+            parts.push_back(std::string(64 * 1024, static_cast<char>('a' + i % 26)));
+        }
+
+        for (const std::string &part : parts)
+        {
+            many.emplace_back(part);
+            expected += part;
+        }
+
+        ASSERT_TRUE(server.sendv(connection, many.data(), many.size()));
+
+        // The queue owns a copy, so the caller's buffers can change straight away.
+        for (std::string &part : parts)
+        {
+            part.assign(part.size(), '!');
+        }
+
+        std::string received;
+        std::thread reader([&]() { received = readExactly(client, expected.size()); });
 
-    ASSERT_EQ(server.open(), false);
-}
\ No newline at end of file
+        ASSERT_TRUE(pollUntil(server, [&]() { return server.pendingBytes(connection) == 0; }));
+        reader.join();
+        ASSERT_TRUE(received == expected);
+        ::close(client);
+    }
+}
+
+TEST(TcpServerTransportTest, testRecvvPullsIntoCallerBuffers)
+{
+    libdsa::libstructures::TcpServerTransport server(htonl(INADDR_LOOPBACK), 0);
+    std::string headers;
+    std::string bodies;
+    bool closed = false;
+    ssize_t last = 0;
+
+    libdsa::libstructures::TcpServerTransport::Callbacks callbacks;
+    callbacks.onReadable = [&](uint64_t connection) {
+        // Read until nothing is left, as edge-triggered readiness requires.
+        for (;;)
+        {
+            char header[4];
+            char body[6];
+            const libdsa::libstructures::MutableBufferView views[] = {{header, sizeof(header)}, {body, sizeof(body)}};
+            last = server.recvv(connection, views, 2);
+
+            if (last <= 0)
+            {
+                return;
+            }
+
+            const size_t inHeader = std::min<size_t>(static_cast<size_t>(last), sizeof(header));
+            headers.append(header, inHeader);
+            bodies.append(body, static_cast<size_t>(last) - inHeader);
+        }
+    };
+    callbacks.onRead = [&](uint64_t, const char *, size_t) { FAIL() << "onRead is bypassed in pull mode"; };
+    callbacks.onClose = [&](uint64_t) { closed = true; };
+    server.setCallbacks(callbacks);
+
+    ASSERT_TRUE(server.open());
+
+    const int client = connectClient(server.port());
+    const std::string message = "0123456789";
+    ASSERT_EQ(::send(client, message.data(), message.size(), 0), static_cast<ssize_t>(message.size()));
+
+    ASSERT_TRUE(pollUntil(server, [&]() { return headers.size() + bodies.size() == message.size(); }));
+    ASSERT_EQ(headers, "0123");
+    ASSERT_EQ(bodies, "456789");
+
+    // The end of the stream shows up as -1 once the connection is closed.
+    ::close(client);
+    ASSERT_TRUE(pollUntil(server, [&]() { return closed; }));
+    ASSERT_EQ(last, -1);
+    ASSERT_EQ(server.connectionCount(), 0);
+}
+
+TEST(TcpServerTransportTest, testHalfCloseFlushesQueuedOutput)
+{
+    for (Backend backend : {Backend::EPOLL, Backend::IO_URING})
+    {
+        libdsa::libstructures::TcpServerTransport server(htonl(INADDR_LOOPBACK), 0, backend);
+        uint64_t connection = 0;
+        bool closed = false;
+
+        libdsa::libstructures::TcpServerTransport::Callbacks callbacks;
+        callbacks.onAccept = [&](uint64_t id) { connection = id; };
+        callbacks.onClose = [&](uint64_t) { closed = true; };
+        server.setCallbacks(callbacks);
+
+        ASSERT_TRUE(server.open());
+
+        const int client = connectClient(server.port());
+        ASSERT_TRUE(pollUntil(server, [&]() { return connection != 0; }));
+
+        std::string payload(16 * 1024 * 1024, '\0');
+
+        for (size_t i = 0; i < payload.size(); ++i)
+        {
+            payload[i] = static_cast<char>(i * 7 + i / 4096);
+        }
+
+        ASSERT_TRUE(server.send(connection, payload.data(), payload.size()));
+        ASSERT_GT(server.pendingBytes(connection), 0);
+
+        // The client is done sending, but still reads: everything queued reaches it before the server hangs up.
+        ASSERT_EQ(::shutdown(client, SHUT_WR), 0);
+
+        std::string received;
+        char extra = 0;
+        ssize_t afterEnd = -1;
+        std::thread reader([&]() {
+            received = readExactly(client, payload.size());
+            afterEnd = ::recv(client, &extra, 1, 0);
+        });
+
+        ASSERT_TRUE(pollUntil(server, [&]() { return closed; }));
+
+        reader.join();
+        ASSERT_TRUE(received == payload);
+        ASSERT_EQ(afterEnd, 0);
+        ASSERT_EQ(server.connectionCount(), 0);
+        ::close(client);
+    }
+}
+
+TEST(TcpServerTransportTest, testSendZeroCopy)
+{
+    for (Backend backend : {Backend::EPOLL, Backend::IO_URING})
+    {
+        libdsa::libstructures::TcpServerTransport server(htonl(INADDR_LOOPBACK), 0, backend);
+        uint64_t connection = 0;
+        std::vector<uint64_t> completed;
+
+        libdsa::libstructures::TcpServerTransport::Callbacks callbacks;
+        callbacks.onAccept = [&](uint64_t id) { connection = id; };
+        callbacks.onZeroCopyComplete = [&](uint64_t, uint64_t tag) { completed.push_back(tag); };
+        server.setCallbacks(callbacks);
+
+        ASSERT_TRUE(server.open());
+
+        const int client = connectClient(server.port());
+        ASSERT_TRUE(pollUntil(server, [&]() { return connection != 0; }));
+
+        // Small sends are copied, so they are complete before the call returns.
+        const std::string small = "small";
+        const libdsa::libstructures::BufferView smallView(small);
+        ASSERT_TRUE(server.sendZeroCopy(connection, &smallView, 1, 1));
+        ASSERT_EQ(completed, std::vector<uint64_t>{1});
+
+        // A large send borrows both buffers until the kernel lets go of them.
+        std::string first(4 * 1024 * 1024, '\0');
+        std::string second(3 * 1024 * 1024 + 17, '\0');
+
+        for (size_t i = 0; i < first.size(); ++i)
+        {
+            first[i] = static_cast<char>(i * 7);
+        }
+
+        for (size_t i = 0; i < second.size(); ++i)
+        {
+            second[i] = static_cast<char>(i * 13);
+        }
+
+        const libdsa::libstructures::BufferView large[] = {first, second};
+        ASSERT_TRUE(server.sendZeroCopy(connection, large, 2, 2));
+        ASSERT_TRUE(server.send(connection, "tail", 4));
+
+        std::string received;
+        std::thread reader([&]() { received = readExactly(client, small.size() + first.size() + second.size() + 4); });
+
+        ASSERT_TRUE(pollUntil(server, [&]() { return completed.size() == 2 && server.pendingBytes(connection) == 0; }));
+        ASSERT_EQ(completed.back(), 2);
+
+        reader.join();
+        ASSERT_TRUE(received == small + first + second + "tail");
+        ::close(client);
+    }
+}
+
+TEST(TcpServerTransportTest, testZeroCopyTagsReportedOnClose)
+{
+    libdsa::libstructures::TcpServerTransport server(htonl(INADDR_LOOPBACK), 0);
+    uint64_t connection = 0;
+    std::vector<uint64_t> events;
+
+    libdsa::libstructures::TcpServerTransport::Callbacks callbacks;
+    callbacks.onAccept = [&](uint64_t id) { connection = id; };
+    callbacks.onZeroCopyComplete = [&](uint64_t, uint64_t tag) { events.push_back(tag); };
+    callbacks.onClose = [&](uint64_t) { events.push_back(0); };
+    server.setCallbacks(callbacks);
+
+    ASSERT_TRUE(server.open());
+
+    const int client = connectClient(server.port());
+    ASSERT_TRUE(pollUntil(server, [&]() { return connection != 0; }));
+
+    // Nobody reads, so most of the payload is still borrowed when the connection goes away.
+    const std::string payload(8 * 1024 * 1024, 'z');
+    const libdsa::libstructures::BufferView view(payload);
+    ASSERT_TRUE(server.sendZeroCopy(connection, &view, 1, 5));
+    ASSERT_GT(server.pendingBytes(connection), 0);
+
+    ASSERT_TRUE(server.disconnect(connection));
+    ASSERT_EQ(events, (std::vector<uint64_t>{5, 0}));
+    ::close(client);
+}
+
+TEST(TcpServerTransportTest, testSocketOptions)
+{
+    for (Backend backend : {Backend::EPOLL, Backend::IO_URING})
+    {
+        libdsa::libstructures::TcpServerTransport server(htonl(INADDR_LOOPBACK), 0, backend);
+        uint64_t connection = 0;
+        size_t turns = 0;
+
+        libdsa::libstructures::TcpServerTransport::Callbacks callbacks;
+        callbacks.onAccept = [&](uint64_t id) { connection = id; };
+        callbacks.onTurnEnd = [&]() { ++turns; };
+        server.setCallbacks(callbacks);
+
+        ASSERT_FALSE(server.setNoDelay(2, true));
+        ASSERT_FALSE(server.setCork(2, true));
+        ASSERT_TRUE(server.open());
+
+        // Turns that time out end too.
+        server.poll(0);
+        ASSERT_EQ(turns, 1);
+
+        const int client = connectClient(server.port());
+        ASSERT_TRUE(pollUntil(server, [&]() { return connection != 0; }));
+
+        ASSERT_TRUE(server.setNoDelay(connection, true));
+        ASSERT_TRUE(server.setCork(connection, true));
+
+        // Corked output still arrives once the cork is pulled.
+        ASSERT_TRUE(server.send(connection, "part one, ", 10));
+        ASSERT_TRUE(server.send(connection, "part two", 8));
+        ASSERT_TRUE(pollUntil(server, [&]() { return server.pendingBytes(connection) == 0; }));
+        ASSERT_TRUE(server.setCork(connection, false));
+        ASSERT_EQ(readExactly(client, 18), "part one, part two");
+
+        ASSERT_TRUE(server.setNoDelay(connection, false));
+        ::close(client);
+    }
+}
+
+TEST(TcpServerTransportTest, testReadBuffersCanBeKept)
+{
+    for (Backend backend : {Backend::EPOLL, Backend::IO_URING})
+    {
+        libdsa::libstructures::BufferPool pool;
+        std::vector<libdsa::libstructures::BufferHandle> kept;
+        size_t received = 0;
+
+        {
+            libdsa::libstructures::TcpServerTransport server(htonl(INADDR_LOOPBACK), 0, backend);
+            server.setBufferPool(pool);
+
+            libdsa::libstructures::TcpServerTransport::Callbacks callbacks;
+            callbacks.onRead = [&](uint64_t, const char *, size_t) {
+                FAIL() << "onReadBuffer takes the place of onRead";
+            };
+            callbacks.onReadBuffer = [&](uint64_t, libdsa::libstructures::BufferHandle buffer) {
+                received += buffer.size();
+                kept.push_back(std::move(buffer));
+            };
+            server.setCallbacks(callbacks);
+
+            ASSERT_TRUE(server.open());
+            const int client = connectClient(server.port());
+
+            // Each message waits for the previous one, so every one of them lands in a buffer of its own.  On epoll
+            // that buffer is sized to the message rather than to the read.
+            for (const std::string message : {"first", "second", "third"})
+            {
+                const size_t expected = received + message.size();
+                ASSERT_EQ(::send(client, message.data(), message.size(), 0), static_cast<ssize_t>(message.size()));
+                ASSERT_TRUE(pollUntil(server, [&]() { return received == expected; }));
+            }
+
+            // Buffers released by the application are received into again, however many messages go by.
+            const size_t keptCount = kept.size();
+            callbacks.onReadBuffer = [&](uint64_t, libdsa::libstructures::BufferHandle buffer) {
+                received += buffer.size();
+            };
+            server.setCallbacks(callbacks);
+
+            for (unsigned i = 0; i < 2 * libdsa::libstructures::TcpServerTransport::URING_BUFFER_COUNT; ++i)
+            {
+                const size_t expected = received + 1;
+                ASSERT_EQ(::send(client, "x", 1, 0), 1);
+                ASSERT_TRUE(pollUntil(server, [&]() { return received == expected; }));
+            }
+
+            ASSERT_EQ(kept.size(), keptCount);
+            ::close(client);
+        }
+
+        // The buffers outlive both the callbacks and the transport.
+        std::string joined;
+
+        for (const libdsa::libstructures::BufferHandle &buffer : kept)
+        {
+            ASSERT_EQ(buffer.useCount(), 1);
+            joined.append(buffer.data(), buffer.size());
+
+            if (backend == Backend::EPOLL)
+            {
+                ASSERT_EQ(buffer.capacity(), libdsa::libstructures::BufferPool::capacityFor(buffer.size()));
+            }
+        }
+
+        ASSERT_EQ(joined, "firstsecondthird");
+        kept.clear();
+    }
+}
+
+TEST(TcpServerTransportTest, testStopEndsRun)
+{
+    for (Backend backend : {Backend::EPOLL, Backend::IO_URING})
+    {
+        libdsa::libstructures::TcpServerTransport server(htonl(INADDR_LOOPBACK), 0, backend);
+        ASSERT_TRUE(server.open());
+
+        std::thread loop([&]() { server.run(); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        server.stop();
+        loop.join();
+
+        ASSERT_TRUE(server.isOpen());
+    }
+}
@@ -0,0 +1,216 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file compacttreetest
+/// @brief Contains test functions for all member functions and use cases of the @c CompactTree class.
+/// @{
+
+// Class Header
+#include <compacttree.h>
+
+// From C++ STL
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+using libdsa::structures::utilities::CompactTree;
+using libdsa::structures::utilities::NodeIndex;
+using libdsa::structures::utilities::NULL_INDEX;
+using libdsa::structures::utilities::TreeNode;
+
+namespace
+{
+    /// @brief Element whose copies start failing once a budget runs out, counting the live instances.
+    struct ThrowingValue
+    {
+        static int live;
+        static int copiesLeft;
+
+        explicit ThrowingValue(int value) : _value(value)
+        {
+            ++live;
+        }
+
+        ThrowingValue(const ThrowingValue &other) : _value(other._value)
+        {
+            if (copiesLeft >= 0 && copiesLeft-- == 0)
+            {
+                throw std::runtime_error("copy failed");
+            }
+
+            ++live;
+        }
+
+        ~ThrowingValue()
+        {
+            --live;
+        }
+
+        int _value;
+    };
+
+    int ThrowingValue::live = 0;
+    int ThrowingValue::copiesLeft = -1;
+}
+
+TEST(CompactTree, test_emptyTree)
+{
+    CompactTree<int> tree;
+
+    ASSERT_TRUE(tree.empty());
+    ASSERT_EQ(tree.size(), 0);
+    ASSERT_EQ(tree.root(), NULL_INDEX);
+    ASSERT_EQ(tree.capacity(), 0);
+    ASSERT_THROW(tree.addChild(0, 1), std::out_of_range);
+    ASSERT_THROW(tree.datum(0), std::out_of_range);
+}
+
+TEST(CompactTree, test_nodeIsSmall)
+{
+    // A datum and three 32-bit links, with no child vector.
+    ASSERT_EQ(sizeof(CompactTree<int>::Node), 16);
+    ASSERT_LT(sizeof(CompactTree<int>::Node), sizeof(TreeNode<int>));
+}
+
+TEST(CompactTree, test_childrenKeepOrder)
+{
+    CompactTree<int> tree;
+    const NodeIndex root = tree.addRoot(0);
+
+    ASSERT_THROW(tree.addRoot(1), std::runtime_error);
+
+    const NodeIndex first = tree.addChild(root, 1);
+    tree.addChild(root, 2);
+    tree.addChild(root, 3);
+    tree.addChild(first, 4);
+
+    ASSERT_EQ(tree.size(), 5);
+    ASSERT_EQ(tree.childCount(root), 3);
+    ASSERT_EQ(tree.childCount(first), 1);
+
+    std::vector<int> children;
+
+    for (NodeIndex child = tree.firstChild(root); child != NULL_INDEX; child = tree.nextSibling(child))
+    {
+        children.push_back(tree.datum(child));
+    }
+
+    ASSERT_EQ(children, (std::vector<int>{1, 2, 3}));
+
+    tree.datum(first) = 10;
+    ASSERT_EQ(tree.node(first)._datum, 10);
+}
+
+TEST(CompactTree, test_preOrder)
+{
+    CompactTree<int> tree;
+    const NodeIndex root = tree.addRoot(1);
+    const NodeIndex left = tree.addChild(root, 2);
+    const NodeIndex middle = tree.addChild(root, 5);
+    tree.addChild(root, 7);
+    tree.addChild(left, 3);
+    tree.addChild(left, 4);
+    tree.addChild(middle, 6);
+
+    std::vector<int> visited;
+    tree.preOrder([&](int datum) { visited.push_back(datum); });
+
+    ASSERT_EQ(visited, (std::vector<int>{1, 2, 3, 4, 5, 6, 7}));
+}
+
+TEST(CompactTree, test_fromTreeNode)
+{
+    std::vector<std::unique_ptr<TreeNode<std::string>>> owner;
+    auto make = [&](const std::string &datum) {
+        owner.push_back(std::make_unique<TreeNode<std::string>>(datum));
+        return owner.back().get();
+    };
+
+    TreeNode<std::string> *root = make("a");
+    TreeNode<std::string> *b = make("b");
+    root->children = {b, make("e")};
+    b->children = {make("c"), make("d")};
+
+    CompactTree<std::string> tree(root);
+    std::string visited;
+    tree.preOrder([&](const std::string &datum) { visited += datum; });
+
+    ASSERT_EQ(tree.size(), 5);
+    ASSERT_EQ(visited, "abcde");
+
+    CompactTree<std::string> empty(nullptr);
+    ASSERT_TRUE(empty.empty());
+}
+
+TEST(CompactTree, test_resetKeepsBlocks)
+{
+    CompactTree<long> tree;
+    NodeIndex parent = tree.addRoot(0);
+
+    // A path long enough to span several blocks.
+    for (long i = 1; i < 3 * static_cast<long>(CompactTree<long>::BLOCK_SIZE); ++i)
+    {
+        parent = tree.addChild(parent, i);
+    }
+
+    const size_t capacity = tree.capacity();
+    ASSERT_GE(capacity, tree.size());
+
+    long sum = 0;
+    tree.preOrder([&](long datum) { sum += datum; });
+    ASSERT_EQ(sum, static_cast<long>(tree.size()) * static_cast<long>(tree.size() - 1) / 2);
+
+    tree.reset();
+
+    ASSERT_TRUE(tree.empty());
+    ASSERT_EQ(tree.capacity(), capacity);
+    ASSERT_EQ(tree.addRoot(5), 0);
+
+    tree.release();
+    ASSERT_EQ(tree.capacity(), 0);
+}
+
+TEST(CompactTree, test_move)
+{
+    CompactTree<int> tree;
+    tree.addChild(tree.addRoot(1), 2);
+
+    CompactTree<int> moved(std::move(tree));
+    ASSERT_EQ(moved.size(), 2);
+    ASSERT_TRUE(tree.empty());
+
+    CompactTree<int> assigned;
+    assigned.addRoot(9);
+    assigned = std::move(moved);
+    ASSERT_EQ(assigned.datum(assigned.firstChild(0)), 2);
+}
+
+TEST(CompactTree, test_throwingCopyReleasesPartialTree)
+{
+    {
+        std::vector<std::unique_ptr<TreeNode<ThrowingValue>>> nodes;
+        nodes.push_back(std::make_unique<TreeNode<ThrowingValue>>(ThrowingValue(0)));
+
+        for (int i = 1; i < 2000; ++i)
+        {
+            nodes.push_back(std::make_unique<TreeNode<ThrowingValue>>(ThrowingValue(i)));
+            nodes[(i - 1) / 4]->children.push_back(nodes.back().get());
+        }
+
+        const int live = ThrowingValue::live;
+
+        // Fail part way through, once the copy holds many constructed nodes.
+        ThrowingValue::copiesLeft = 1500;
+        ASSERT_THROW(CompactTree<ThrowingValue> tree(nodes.front().get()), std::runtime_error);
+        ThrowingValue::copiesLeft = -1;
+
+        ASSERT_EQ(ThrowingValue::live, live);
+    }
+
+    ASSERT_EQ(ThrowingValue::live, 0);
+}
+
+/// @}
@@ -0,0 +1,135 @@
+/// @author [Software Engineer]
+/// @date [2024]
+/// @file latencyhistogramtest
+/// @brief Contains test functions for all member functions and use cases of the @c LatencyHistogram class.
+/// @{
+
+// Class Header
+#include <latencyhistogram.h>
+
+// From C++ STL
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// From Gtest
+#include <gtest/gtest.h>
+
+using libdsa::structures::utilities::LatencyHistogram;
+
+TEST(LatencyHistogram, test_emptyHistogram)
+{
+    LatencyHistogram histogram;
+
+    ASSERT_EQ(histogram.count(), 0);
+    ASSERT_EQ(histogram.min(), 0);
+    ASSERT_EQ(histogram.max(), 0);
+    ASSERT_EQ(histogram.mean(), 0);
+    ASSERT_EQ(histogram.percentile(50), 0);
+}
+
+TEST(LatencyHistogram, test_bucketsCoverEveryValue)
+{
+    // Small values have a bucket each.
+    for (uint64_t value = 0; value < LatencyHistogram::SUB_BUCKETS; ++value)
+    {
+        ASSERT_EQ(LatencyHistogram::bucketFor(value), value);
+        ASSERT_EQ(LatencyHistogram::highestIn(value), value);
+    }
+
+    // Above that, buckets follow each other without gaps and stay within 1% of their values.
+    for (size_t bucket = LatencyHistogram::SUB_BUCKETS; bucket < LatencyHistogram::BUCKET_COUNT; ++bucket)
+    {
+        const uint64_t lowest = LatencyHistogram::highestIn(bucket - 1) + 1;
+        const uint64_t highest = LatencyHistogram::highestIn(bucket);
+
+        ASSERT_EQ(LatencyHistogram::bucketFor(lowest), bucket);
+        ASSERT_EQ(LatencyHistogram::bucketFor(highest), bucket);
+        ASSERT_LT(static_cast<double>(highest - lowest), static_cast<double>(lowest) / 100);
+    }
+
+    ASSERT_EQ(LatencyHistogram::bucketFor(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+    ASSERT_EQ(LatencyHistogram::highestIn(LatencyHistogram::BUCKET_COUNT - 1), UINT64_MAX);
+}
+
+TEST(LatencyHistogram, test_percentiles)
+{
+    LatencyHistogram histogram;
+
+    for (uint64_t value = 1; value <= 1000; ++value)
+    {
+        histogram.record(value);
+    }
+
+    ASSERT_EQ(histogram.count(), 1000);
+    ASSERT_EQ(histogram.min(), 1);
+    ASSERT_EQ(histogram.max(), 1000);
+    ASSERT_DOUBLE_EQ(histogram.mean(), 500.5);
+    ASSERT_EQ(histogram.percentile(0), 1);
+    ASSERT_EQ(histogram.percentile(100), 1000);
+
+    // Reported values are the top of the bucket holding the rank: never below it, and under 1% above.
+    for (double percent : {10.0, 50.0, 90.0, 99.0, 99.9})
+    {
+        const uint64_t exact = static_cast<uint64_t>(percent * 10);
+        ASSERT_GE(histogram.percentile(percent), exact);
+        ASSERT_LE(histogram.percentile(percent), exact + exact / 100);
+    }
+
+    // A tail far from the bulk shows up only in the highest percentiles.
+    LatencyHistogram tail;
+
+    for (int i = 0; i < 999; ++i)
+    {
+        tail.record(20000);
+    }
+
+    tail.record(5000000);
+    ASSERT_LT(tail.percentile(99), 20300);
+    ASSERT_LT(tail.percentile(99.9), 20300);
+    ASSERT_EQ(tail.percentile(99.99), 5000000);
+}
+
+TEST(LatencyHistogram, test_mergeAndReset)
+{
+    std::mt19937_64 random(7);
+    std::vector<uint64_t> values;
+    LatencyHistogram all;
+    LatencyHistogram parts[4];
+
+    for (size_t i = 0; i < 40000; ++i)
+    {
+        const uint64_t value = random() % 10000000;
+        values.push_back(value);
+        all.record(value);
+        parts[i % 4].record(value);
+    }
+
+    LatencyHistogram merged;
+    for (const LatencyHistogram &part : parts)
+    {
+        merged.merge(part);
+    }
+
+    ASSERT_EQ(merged.count(), all.count());
+    ASSERT_EQ(merged.min(), all.min());
+    ASSERT_EQ(merged.max(), all.max());
+
+    std::sort(values.begin(), values.end());
+
+    for (double percent : {50.0, 99.0, 99.9})
+    {
+        const uint64_t exact = values[static_cast<size_t>(percent / 100 * values.size()) - 1];
+        ASSERT_EQ(merged.percentile(percent), all.percentile(percent));
+        ASSERT_GE(merged.percentile(percent), exact);
+        ASSERT_LE(merged.percentile(percent), exact + exact / 100);
+    }
+
+    merged.reset();
+    ASSERT_EQ(merged.count(), 0);
+    ASSERT_EQ(merged.percentile(99), 0);
+    merged.record(42);
+    ASSERT_EQ(merged.min(), 42);
+    ASSERT_EQ(merged.percentile(50), 42);
+}